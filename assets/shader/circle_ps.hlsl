@@ -1,24 +1,31 @@
 //----------------------------------------------------------------------------
 // circle_ps.hlsl
-// 円描画用ピクセルシェーダー（UV座標で円形にクリップ）
+// 円描画用ピクセルシェーダー（中心からの距離で解析的に塗る）
+//
+// 外周・内周は1ピクセル幅でぼかす（fwidthで画面上の距離の変化量を取得）。
+// ぼかしは縁の内側で行うため、四角形を広げる必要はない。
 //----------------------------------------------------------------------------
 
 struct PSInput {
-    float4 position : SV_POSITION;
-    float2 texCoord : TEXCOORD0;
-    float4 color    : COLOR0;
+    float4 position   : SV_POSITION;
+    float2 local      : TEXCOORD0;
+    float  innerRatio : TEXCOORD1;
+    float4 color      : COLOR0;
 };
 
 float4 PSMain(PSInput input) : SV_TARGET {
-    // UV座標の中心からの距離を計算
-    float2 center = float2(0.5, 0.5);
-    float2 diff = input.texCoord - center;
-    float distSq = dot(diff, diff);
+    float dist = length(input.local);
+    float aa = max(fwidth(dist), 1e-5);
 
-    // 半径0.5の円の外側は破棄
-    if (distSq > 0.25) {  // 0.5 * 0.5 = 0.25
+    // 外周（dist <= 1）と内周（dist >= innerRatio）の被覆率
+    float coverage = saturate((1.0 - dist) / aa);
+    if (input.innerRatio > 0.0) {
+        coverage *= saturate((dist - input.innerRatio) / aa);
+    }
+
+    if (coverage <= 0.0) {
         discard;
     }
 
-    return input.color;
+    return float4(input.color.rgb, input.color.a * coverage);
 }
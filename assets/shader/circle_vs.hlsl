@@ -0,0 +1,42 @@
+//----------------------------------------------------------------------------
+// circle_vs.hlsl
+// 円描画用頂点シェーダー（インスタンス描画）
+//
+// 1円1インスタンスを受け取り、SV_VertexID(0-3)から外接四角形を展開する
+// （TRIANGLESTRIP, DrawInstanced(4, n)）。
+// 入力配置は CircleGeometry::CircleInstance と一致させること。
+//----------------------------------------------------------------------------
+
+cbuffer CBuffer : register(b0) {
+    matrix viewProjection;
+    float depth;
+    float3 padding;
+};
+
+struct VSInstance {
+    float2 center    : POSITION;   // 中心のワールド座標
+    float2 shape     : TEXCOORD0;  // 外側の半径, 輪の太さ（0で塗りつぶし）
+    float4 color     : COLOR0;
+    uint vertexId    : SV_VertexID;
+};
+
+struct VSOutput {
+    float4 position   : SV_POSITION;
+    float2 local      : TEXCOORD0;  // 中心からの位置（外側の半径を1とする）
+    float  innerRatio : TEXCOORD1;  // 内側の半径 / 外側の半径（0で塗りつぶし）
+    float4 color      : COLOR0;
+};
+
+VSOutput VSMain(VSInstance input) {
+    // 0:左上 1:右上 2:左下 3:右下
+    float2 corner = float2(input.vertexId & 1, input.vertexId >> 1) * 2.0 - 1.0;
+    float radius = input.shape.x;
+    float2 world = input.center + corner * radius;
+
+    VSOutput output;
+    output.position = mul(float4(world, depth, 1.0), viewProjection);
+    output.local = corner;
+    output.innerRatio = input.shape.y > 0.0 ? saturate(1.0 - input.shape.y / radius) : 0.0;
+    output.color = input.color;
+    return output;
+}
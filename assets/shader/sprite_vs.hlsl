@@ -1,20 +1,53 @@
 //----------------------------------------------------------------------------
 // sprite_vs.hlsl
 // SpriteBatch vertex shader
+//
+// SPRITE_INSTANCED=1: 1スプライト1インスタンスを受け取り、SV_VertexID(0-3)から
+// 四角形を展開する（TRIANGLESTRIP, DrawInstanced(4, n)）。
+// 入力配置は SpriteGeometry::SpriteInstance と一致させること。
 //----------------------------------------------------------------------------
 
 cbuffer CBuffer : register(b0) {
     matrix viewProjection;
 };
 
-struct VSInput {
-    float3 position : POSITION;
+struct VSOutput {
+    float4 position : SV_POSITION;
     float2 texCoord : TEXCOORD0;
     float4 color    : COLOR0;
 };
 
-struct VSOutput {
-    float4 position : SV_POSITION;
+#if SPRITE_INSTANCED
+
+struct VSInstance {
+    float2 position : POSITION;   // 原点のワールド座標
+    float4 rect     : TEXCOORD1;  // ローカル矩形 (x0, y0, x1, y1)
+    float2 rotDepth : TEXCOORD2;  // 回転（ラジアン）, 深度値
+    float4 uvRect   : TEXCOORD0;  // UV矩形 (u0, v0, u1, v1)
+    float4 color    : COLOR0;
+    uint vertexId   : SV_VertexID;
+};
+
+VSOutput VSMain(VSInstance input) {
+    // 0:左上 1:右上 2:左下 3:右下（頂点経路と同じ並び）
+    float2 corner = float2(input.vertexId & 1, input.vertexId >> 1);
+    float2 local = lerp(input.rect.xy, input.rect.zw, corner);
+
+    float s, c;
+    sincos(input.rotDepth.x, s, c);
+    float2 world = float2(local.x * c - local.y * s, local.x * s + local.y * c) + input.position;
+
+    VSOutput output;
+    output.position = mul(float4(world, input.rotDepth.y, 1.0), viewProjection);
+    output.texCoord = lerp(input.uvRect.xy, input.uvRect.zw, corner);
+    output.color = input.color;
+    return output;
+}
+
+#else
+
+struct VSInput {
+    float3 position : POSITION;
     float2 texCoord : TEXCOORD0;
     float4 color    : COLOR0;
 };
@@ -26,3 +59,5 @@ VSOutput VSMain(VSInput input) {
     output.color = input.color;
     return output;
 }
+
+#endif
@@ -16,6 +16,11 @@ workspace "HEW2026"
     -- 文字セット
     characterset "Unicode"
 
+    -- レイアウトに影響する設定（全プロジェクトで一致させる）
+    defines {
+        "COLLISION_LARGE_HANDLES=0"    -- 1: 32bitコライダーハンドル/64bitペアキー
+    }
+
     -- 共通設定
     filter "configurations:Debug"
         defines { "DEBUG", "_DEBUG" }
@@ -0,0 +1,145 @@
+//----------------------------------------------------------------------------
+//! @file   command_backend.cpp
+//! @brief  nullバックエンド実装
+//----------------------------------------------------------------------------
+#include "command_backend.h"
+#include <cstring>
+
+void NullCommandBackend::Clear()
+{
+    trace_.clear();
+    counts_.fill(0);
+    draws_.clear();
+    writes_.clear();
+    writeData_.clear();
+    vertexShader_ = nullptr;
+    pixelShader_ = nullptr;
+    texture_ = nullptr;
+    vertexBuffer_ = nullptr;
+    blendState_ = nullptr;
+}
+
+void NullCommandBackend::Record(CommandType type)
+{
+    trace_.push_back(type);
+    ++counts_[static_cast<size_t>(type)];
+}
+
+void NullCommandBackend::RecordDraw(CommandType type, uint32_t count, uint32_t instanceCount,
+                                    uint32_t start, int32_t baseVertex, uint32_t startInstance)
+{
+    Record(type);
+    draws_.push_back({ type, count, instanceCount, start, baseVertex, startInstance,
+                       vertexShader_, pixelShader_, texture_, vertexBuffer_, blendState_ });
+}
+
+void NullCommandBackend::SetPrimitiveTopology([[maybe_unused]] uint32_t topology)
+{
+    Record(CommandType::SetPrimitiveTopology);
+}
+
+void NullCommandBackend::SetInputLayout([[maybe_unused]] ID3D11InputLayout* inputLayout)
+{
+    Record(CommandType::SetInputLayout);
+}
+
+void NullCommandBackend::SetVertexBuffer(uint32_t slot, Buffer* buffer,
+                                         [[maybe_unused]] uint32_t stride, [[maybe_unused]] uint32_t offset)
+{
+    Record(CommandType::SetVertexBuffer);
+    if (slot == 0) vertexBuffer_ = buffer;
+}
+
+void NullCommandBackend::SetIndexBuffer([[maybe_unused]] Buffer* buffer,
+                                        [[maybe_unused]] uint32_t format, [[maybe_unused]] uint32_t offset)
+{
+    Record(CommandType::SetIndexBuffer);
+}
+
+void NullCommandBackend::SetShader(ShaderType stage, Shader* shader)
+{
+    Record(CommandType::SetShader);
+    if (stage == ShaderType::Vertex) vertexShader_ = shader;
+    if (stage == ShaderType::Pixel) pixelShader_ = shader;
+}
+
+void NullCommandBackend::SetConstantBuffer([[maybe_unused]] ShaderType stage,
+                                           [[maybe_unused]] uint32_t slot, [[maybe_unused]] Buffer* buffer)
+{
+    Record(CommandType::SetConstantBuffer);
+}
+
+void NullCommandBackend::SetShaderResource(ShaderType stage, uint32_t slot, Texture* texture)
+{
+    Record(CommandType::SetShaderResource);
+    if (stage == ShaderType::Pixel && slot == 0) texture_ = texture;
+}
+
+void NullCommandBackend::SetSampler([[maybe_unused]] ShaderType stage,
+                                    [[maybe_unused]] uint32_t slot, [[maybe_unused]] SamplerState* sampler)
+{
+    Record(CommandType::SetSampler);
+}
+
+void NullCommandBackend::SetBlendState(BlendState* state)
+{
+    Record(CommandType::SetBlendState);
+    blendState_ = state;
+}
+
+void NullCommandBackend::SetDepthStencilState([[maybe_unused]] DepthStencilState* state,
+                                              [[maybe_unused]] uint32_t stencilRef)
+{
+    Record(CommandType::SetDepthStencilState);
+}
+
+void NullCommandBackend::SetRasterizerState([[maybe_unused]] RasterizerState* state)
+{
+    Record(CommandType::SetRasterizerState);
+}
+
+void NullCommandBackend::UpdateConstantBuffer(Buffer* buffer, const void* data, uint32_t sizeInBytes)
+{
+    Record(CommandType::UpdateConstantBuffer);
+    writes_.push_back({ buffer, 0, 0, sizeInBytes, writeData_.size() });
+    const auto* bytes = static_cast<const std::byte*>(data);
+    writeData_.insert(writeData_.end(), bytes, bytes + sizeInBytes);
+}
+
+void* NullCommandBackend::BeginWrite(Buffer* buffer, uint32_t mapType,
+                                     uint32_t offsetInBytes, uint32_t sizeInBytes)
+{
+    Record(CommandType::WriteBuffer);
+    writes_.push_back({ buffer, mapType, offsetInBytes, sizeInBytes, writeData_.size() });
+    writeData_.resize(writeData_.size() + sizeInBytes);
+    return writeData_.data() + writes_.back().dataOffset;
+}
+
+void NullCommandBackend::EndWrite([[maybe_unused]] Buffer* buffer)
+{
+}
+
+void NullCommandBackend::Draw(uint32_t vertexCount, uint32_t startVertexLocation)
+{
+    RecordDraw(CommandType::Draw, vertexCount, 1, startVertexLocation, 0, 0);
+}
+
+void NullCommandBackend::DrawIndexed(uint32_t indexCount, uint32_t startIndexLocation, int32_t baseVertexLocation)
+{
+    RecordDraw(CommandType::DrawIndexed, indexCount, 1, startIndexLocation, baseVertexLocation, 0);
+}
+
+void NullCommandBackend::DrawInstanced(uint32_t vertexCountPerInstance, uint32_t instanceCount,
+                                       uint32_t startVertexLocation, uint32_t startInstanceLocation)
+{
+    RecordDraw(CommandType::DrawInstanced, vertexCountPerInstance, instanceCount,
+               startVertexLocation, 0, startInstanceLocation);
+}
+
+void NullCommandBackend::DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount,
+                                              uint32_t startIndexLocation, int32_t baseVertexLocation,
+                                              uint32_t startInstanceLocation)
+{
+    RecordDraw(CommandType::DrawIndexedInstanced, indexCountPerInstance, instanceCount,
+               startIndexLocation, baseVertexLocation, startInstanceLocation);
+}
@@ -0,0 +1,234 @@
+//----------------------------------------------------------------------------
+//! @file   command_backend.h
+//! @brief  描画コマンドの出力先インターフェースとnullバックエンド
+//!
+//! @details GraphicsContextの描画・ステート・バッファ更新のうち、
+//!          SpriteBatch等の描画システムが使う部分を抽象化する。
+//!          D3D11ヘッダーに依存しないため、nullバックエンドで
+//!          コマンド列をデバイスなしで取得・検証できる。
+//----------------------------------------------------------------------------
+#pragma once
+
+#include "dx11/compile/shader_type.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 前方宣言
+class Buffer;
+class Texture;
+class Shader;
+class BlendState;
+class DepthStencilState;
+class RasterizerState;
+class SamplerState;
+struct ID3D11InputLayout;
+
+//===========================================================================
+//! コマンド種別
+//===========================================================================
+enum class CommandType : uint16_t
+{
+    SetPrimitiveTopology,
+    SetInputLayout,
+    SetVertexBuffer,
+    SetIndexBuffer,
+    SetShader,
+    SetConstantBuffer,
+    SetShaderResource,
+    SetSampler,
+    SetBlendState,
+    SetDepthStencilState,
+    SetRasterizerState,
+    UpdateConstantBuffer,
+    WriteBuffer,
+    Draw,
+    DrawIndexed,
+    DrawInstanced,
+    DrawIndexedInstanced,
+
+    Count
+};
+
+//===========================================================================
+//! 描画コマンドの出力先
+//!
+//! @details 即時実行（ContextCommandBackend）、記録（CommandBuffer）、
+//!          取得のみ（NullCommandBackend）を同じ呼び出しで切り替える。
+//!          トポロジー・インデックス形式・マップ種別はD3D11の列挙値をそのまま渡す。
+//===========================================================================
+class ICommandBackend
+{
+public:
+    virtual ~ICommandBackend() = default;
+
+    //----------------------------------------------------------
+    //! @name   入力アセンブラ
+    //----------------------------------------------------------
+    //! @{
+
+    virtual void SetPrimitiveTopology(uint32_t topology) = 0;
+    virtual void SetInputLayout(ID3D11InputLayout* inputLayout) = 0;
+    virtual void SetVertexBuffer(uint32_t slot, Buffer* buffer, uint32_t stride, uint32_t offset = 0) = 0;
+    virtual void SetIndexBuffer(Buffer* buffer, uint32_t format, uint32_t offset = 0) = 0;
+
+    //! @}
+    //----------------------------------------------------------
+    //! @name   シェーダー・リソース
+    //----------------------------------------------------------
+    //! @{
+
+    virtual void SetShader(ShaderType stage, Shader* shader) = 0;
+    virtual void SetConstantBuffer(ShaderType stage, uint32_t slot, Buffer* buffer) = 0;
+    virtual void SetShaderResource(ShaderType stage, uint32_t slot, Texture* texture) = 0;
+    virtual void SetSampler(ShaderType stage, uint32_t slot, SamplerState* sampler) = 0;
+
+    //! @}
+    //----------------------------------------------------------
+    //! @name   出力マージャー・ラスタライザ
+    //----------------------------------------------------------
+    //! @{
+
+    virtual void SetBlendState(BlendState* state) = 0;
+    virtual void SetDepthStencilState(DepthStencilState* state, uint32_t stencilRef = 0) = 0;
+    virtual void SetRasterizerState(RasterizerState* state) = 0;
+
+    //! @}
+    //----------------------------------------------------------
+    //! @name   バッファ更新
+    //----------------------------------------------------------
+    //! @{
+
+    //! 定数バッファを更新（dataはこの呼び出しの間だけ参照する）
+    virtual void UpdateConstantBuffer(Buffer* buffer, const void* data, uint32_t sizeInBytes) = 0;
+
+    //! バッファへの書き込みを開始
+    //! @param [in] buffer 動的バッファ
+    //! @param [in] mapType D3D11_MAP値（WRITE_DISCARD / WRITE_NO_OVERWRITE）
+    //! @param [in] offsetInBytes 書き込み先の先頭オフセット
+    //! @param [in] sizeInBytes 書き込むサイズ
+    //! @return 書き込み先（EndWrite()まで有効、失敗時nullptr）
+    [[nodiscard]] virtual void* BeginWrite(Buffer* buffer, uint32_t mapType,
+                                           uint32_t offsetInBytes, uint32_t sizeInBytes) = 0;
+
+    //! バッファへの書き込みを終了
+    virtual void EndWrite(Buffer* buffer) = 0;
+
+    //! @}
+    //----------------------------------------------------------
+    //! @name   描画
+    //----------------------------------------------------------
+    //! @{
+
+    virtual void Draw(uint32_t vertexCount, uint32_t startVertexLocation = 0) = 0;
+    virtual void DrawIndexed(uint32_t indexCount, uint32_t startIndexLocation = 0, int32_t baseVertexLocation = 0) = 0;
+    virtual void DrawInstanced(uint32_t vertexCountPerInstance, uint32_t instanceCount,
+                               uint32_t startVertexLocation = 0, uint32_t startInstanceLocation = 0) = 0;
+    virtual void DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount,
+                                      uint32_t startIndexLocation = 0, int32_t baseVertexLocation = 0,
+                                      uint32_t startInstanceLocation = 0) = 0;
+
+    //! @}
+};
+
+//===========================================================================
+//! nullバックエンド
+//!
+//! @details GPUへは何も送らず、受け取ったコマンドの種別・描画時のステート・
+//!          書き込みデータを保持する。テストでコマンド列を検証するために使う。
+//!
+//! @code
+//!   NullCommandBackend capture;
+//!   commands.Submit(capture);
+//!   assert(capture.GetCount(CommandType::DrawIndexed) == 1);
+//! @endcode
+//===========================================================================
+class NullCommandBackend final : public ICommandBackend
+{
+public:
+    //! 描画時点のステート
+    struct DrawRecord
+    {
+        CommandType type;
+        uint32_t count;             //!< 頂点数またはインデックス数
+        uint32_t instanceCount;     //!< インスタンス数（非インスタンス描画は1）
+        uint32_t start;             //!< 開始頂点またはインデックス
+        int32_t baseVertex;
+        uint32_t startInstance;
+        Shader* vertexShader;
+        Shader* pixelShader;
+        Texture* texture;           //!< ピクセルシェーダーのスロット0
+        Buffer* vertexBuffer;       //!< スロット0
+        BlendState* blendState;
+    };
+
+    //! バッファ書き込み
+    struct WriteRecord
+    {
+        Buffer* buffer;
+        uint32_t mapType;
+        uint32_t offset;
+        uint32_t size;
+        size_t dataOffset;          //!< GetWriteData()内の位置
+    };
+
+    //! 保持内容を破棄
+    void Clear();
+
+    //! 受け取ったコマンドの種別（順番どおり）
+    [[nodiscard]] const std::vector<CommandType>& GetTrace() const noexcept { return trace_; }
+
+    //! 種別ごとの受け取り回数
+    [[nodiscard]] uint32_t GetCount(CommandType type) const noexcept {
+        return counts_[static_cast<size_t>(type)];
+    }
+
+    [[nodiscard]] const std::vector<DrawRecord>& GetDraws() const noexcept { return draws_; }
+    [[nodiscard]] const std::vector<WriteRecord>& GetWrites() const noexcept { return writes_; }
+
+    //! 書き込まれたデータ（バッファ書き込みと定数バッファ更新を連結）
+    [[nodiscard]] const std::vector<std::byte>& GetWriteData() const noexcept { return writeData_; }
+
+    // ICommandBackend
+    void SetPrimitiveTopology(uint32_t topology) override;
+    void SetInputLayout(ID3D11InputLayout* inputLayout) override;
+    void SetVertexBuffer(uint32_t slot, Buffer* buffer, uint32_t stride, uint32_t offset = 0) override;
+    void SetIndexBuffer(Buffer* buffer, uint32_t format, uint32_t offset = 0) override;
+    void SetShader(ShaderType stage, Shader* shader) override;
+    void SetConstantBuffer(ShaderType stage, uint32_t slot, Buffer* buffer) override;
+    void SetShaderResource(ShaderType stage, uint32_t slot, Texture* texture) override;
+    void SetSampler(ShaderType stage, uint32_t slot, SamplerState* sampler) override;
+    void SetBlendState(BlendState* state) override;
+    void SetDepthStencilState(DepthStencilState* state, uint32_t stencilRef = 0) override;
+    void SetRasterizerState(RasterizerState* state) override;
+    void UpdateConstantBuffer(Buffer* buffer, const void* data, uint32_t sizeInBytes) override;
+    [[nodiscard]] void* BeginWrite(Buffer* buffer, uint32_t mapType,
+                                   uint32_t offsetInBytes, uint32_t sizeInBytes) override;
+    void EndWrite(Buffer* buffer) override;
+    void Draw(uint32_t vertexCount, uint32_t startVertexLocation = 0) override;
+    void DrawIndexed(uint32_t indexCount, uint32_t startIndexLocation = 0, int32_t baseVertexLocation = 0) override;
+    void DrawInstanced(uint32_t vertexCountPerInstance, uint32_t instanceCount,
+                       uint32_t startVertexLocation = 0, uint32_t startInstanceLocation = 0) override;
+    void DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount,
+                              uint32_t startIndexLocation = 0, int32_t baseVertexLocation = 0,
+                              uint32_t startInstanceLocation = 0) override;
+
+private:
+    void Record(CommandType type);
+    void RecordDraw(CommandType type, uint32_t count, uint32_t instanceCount,
+                    uint32_t start, int32_t baseVertex, uint32_t startInstance);
+
+    std::vector<CommandType> trace_;
+    std::array<uint32_t, static_cast<size_t>(CommandType::Count)> counts_{};
+    std::vector<DrawRecord> draws_;
+    std::vector<WriteRecord> writes_;
+    std::vector<std::byte> writeData_;
+
+    // 描画記録用の現在ステート
+    Shader* vertexShader_ = nullptr;
+    Shader* pixelShader_ = nullptr;
+    Texture* texture_ = nullptr;
+    Buffer* vertexBuffer_ = nullptr;
+    BlendState* blendState_ = nullptr;
+};
@@ -0,0 +1,339 @@
+//----------------------------------------------------------------------------
+//! @file   command_buffer.cpp
+//! @brief  描画コマンドの記録と再生 実装
+//----------------------------------------------------------------------------
+#include "command_buffer.h"
+#include <cstring>
+#include <type_traits>
+
+namespace {
+
+//! コマンドの先頭（コマンド全体は8バイト境界に揃える）
+struct CommandHeader
+{
+    CommandType type;
+    uint16_t reserved;
+    uint32_t size;      //!< ヘッダーを含むサイズ
+};
+
+constexpr uint32_t kCommandAlignment = 8;
+
+constexpr uint32_t AlignCommandSize(uint32_t size) noexcept
+{
+    return (size + kCommandAlignment - 1) & ~(kCommandAlignment - 1);
+}
+
+//--------------------------------------------------------------
+// ペイロード
+//--------------------------------------------------------------
+struct TopologyCmd { uint32_t topology; };
+struct InputLayoutCmd { ID3D11InputLayout* inputLayout; };
+struct VertexBufferCmd { Buffer* buffer; uint32_t slot; uint32_t stride; uint32_t offset; };
+struct IndexBufferCmd { Buffer* buffer; uint32_t format; uint32_t offset; };
+struct ShaderCmd { Shader* shader; ShaderType stage; };
+struct ConstantBufferCmd { Buffer* buffer; ShaderType stage; uint32_t slot; };
+struct ShaderResourceCmd { Texture* texture; ShaderType stage; uint32_t slot; };
+struct SamplerCmd { SamplerState* sampler; ShaderType stage; uint32_t slot; };
+struct BlendStateCmd { BlendState* state; };
+struct DepthStencilStateCmd { DepthStencilState* state; uint32_t stencilRef; };
+struct RasterizerStateCmd { RasterizerState* state; };
+struct UpdateConstantBufferCmd { Buffer* buffer; uint32_t size; };      // 直後にデータ
+struct WriteBufferCmd { Buffer* buffer; uint32_t mapType; uint32_t offset; uint32_t size; };  // 直後にデータ
+struct DrawCmd { uint32_t vertexCount; uint32_t startVertex; };
+struct DrawIndexedCmd { uint32_t indexCount; uint32_t startIndex; int32_t baseVertex; };
+struct DrawInstancedCmd { uint32_t vertexCount; uint32_t instanceCount; uint32_t startVertex; uint32_t startInstance; };
+struct DrawIndexedInstancedCmd {
+    uint32_t indexCount; uint32_t instanceCount; uint32_t startIndex; int32_t baseVertex; uint32_t startInstance;
+};
+
+//! ペイロードを読み出す（記録領域のアラインメントに依存しない）
+template<typename T>
+T Read(const std::byte* payload) noexcept
+{
+    T value;
+    std::memcpy(&value, payload, sizeof(T));
+    return value;
+}
+
+} // namespace
+
+//============================================================================
+// 記録
+//============================================================================
+
+template<typename T>
+std::byte* CommandBuffer::Append(CommandType type, const T& payload, uint32_t extraBytes)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    const uint32_t size = AlignCommandSize(
+        static_cast<uint32_t>(sizeof(CommandHeader) + sizeof(T)) + extraBytes);
+    const size_t offset = data_.size();
+    data_.resize(offset + size);
+
+    const CommandHeader header{ type, 0, size };
+    std::byte* dst = data_.data() + offset;
+    std::memcpy(dst, &header, sizeof(header));
+    std::memcpy(dst + sizeof(header), &payload, sizeof(T));
+
+    ++stats_.recorded;
+    return dst + sizeof(header) + sizeof(T);
+}
+
+void CommandBuffer::Reset()
+{
+    data_.clear();
+    stats_ = {};
+    Invalidate();
+}
+
+void CommandBuffer::Invalidate()
+{
+    topology_ = {};
+    inputLayout_ = {};
+    vertexBuffers_ = {};
+    indexBuffer_ = {};
+    shaders_ = {};
+    constantBuffers_ = {};
+    shaderResources_ = {};
+    samplers_ = {};
+    blendState_ = {};
+    depthStencilState_ = {};
+    rasterizerState_ = {};
+}
+
+void CommandBuffer::SetPrimitiveTopology(uint32_t topology)
+{
+    if (!topology_.Update(topology)) { ++stats_.filtered; return; }
+    Append(CommandType::SetPrimitiveTopology, TopologyCmd{ topology });
+}
+
+void CommandBuffer::SetInputLayout(ID3D11InputLayout* inputLayout)
+{
+    if (!inputLayout_.Update(inputLayout)) { ++stats_.filtered; return; }
+    Append(CommandType::SetInputLayout, InputLayoutCmd{ inputLayout });
+}
+
+void CommandBuffer::SetVertexBuffer(uint32_t slot, Buffer* buffer, uint32_t stride, uint32_t offset)
+{
+    if (slot < kMaxVertexBufferSlots && !vertexBuffers_[slot].Update({ buffer, stride, offset })) {
+        ++stats_.filtered;
+        return;
+    }
+    Append(CommandType::SetVertexBuffer, VertexBufferCmd{ buffer, slot, stride, offset });
+}
+
+void CommandBuffer::SetIndexBuffer(Buffer* buffer, uint32_t format, uint32_t offset)
+{
+    if (!indexBuffer_.Update({ buffer, format, offset })) { ++stats_.filtered; return; }
+    Append(CommandType::SetIndexBuffer, IndexBufferCmd{ buffer, format, offset });
+}
+
+void CommandBuffer::SetShader(ShaderType stage, Shader* shader)
+{
+    if (IsTracked(stage, 0, 1) && !shaders_[static_cast<size_t>(stage)].Update(shader)) {
+        ++stats_.filtered;
+        return;
+    }
+    Append(CommandType::SetShader, ShaderCmd{ shader, stage });
+}
+
+void CommandBuffer::SetConstantBuffer(ShaderType stage, uint32_t slot, Buffer* buffer)
+{
+    if (IsTracked(stage, slot, kMaxConstantBufferSlots) &&
+        !constantBuffers_[static_cast<size_t>(stage)][slot].Update(buffer)) {
+        ++stats_.filtered;
+        return;
+    }
+    Append(CommandType::SetConstantBuffer, ConstantBufferCmd{ buffer, stage, slot });
+}
+
+void CommandBuffer::SetShaderResource(ShaderType stage, uint32_t slot, Texture* texture)
+{
+    if (IsTracked(stage, slot, kMaxShaderResourceSlots) &&
+        !shaderResources_[static_cast<size_t>(stage)][slot].Update(texture)) {
+        ++stats_.filtered;
+        return;
+    }
+    Append(CommandType::SetShaderResource, ShaderResourceCmd{ texture, stage, slot });
+}
+
+void CommandBuffer::SetSampler(ShaderType stage, uint32_t slot, SamplerState* sampler)
+{
+    if (IsTracked(stage, slot, kMaxSamplerSlots) &&
+        !samplers_[static_cast<size_t>(stage)][slot].Update(sampler)) {
+        ++stats_.filtered;
+        return;
+    }
+    Append(CommandType::SetSampler, SamplerCmd{ sampler, stage, slot });
+}
+
+void CommandBuffer::SetBlendState(BlendState* state)
+{
+    if (!blendState_.Update(state)) { ++stats_.filtered; return; }
+    Append(CommandType::SetBlendState, BlendStateCmd{ state });
+}
+
+void CommandBuffer::SetDepthStencilState(DepthStencilState* state, uint32_t stencilRef)
+{
+    if (!depthStencilState_.Update({ state, stencilRef })) { ++stats_.filtered; return; }
+    Append(CommandType::SetDepthStencilState, DepthStencilStateCmd{ state, stencilRef });
+}
+
+void CommandBuffer::SetRasterizerState(RasterizerState* state)
+{
+    if (!rasterizerState_.Update(state)) { ++stats_.filtered; return; }
+    Append(CommandType::SetRasterizerState, RasterizerStateCmd{ state });
+}
+
+void CommandBuffer::UpdateConstantBuffer(Buffer* buffer, const void* data, uint32_t sizeInBytes)
+{
+    // 内容はこの時点の値を複製する（呼び出し元のデータは後で変わってよい）
+    std::byte* dst = Append(CommandType::UpdateConstantBuffer, UpdateConstantBufferCmd{ buffer, sizeInBytes }, sizeInBytes);
+    std::memcpy(dst, data, sizeInBytes);
+    stats_.uploadBytes += sizeInBytes;
+}
+
+void* CommandBuffer::BeginWrite(Buffer* buffer, uint32_t mapType, uint32_t offsetInBytes, uint32_t sizeInBytes)
+{
+    stats_.uploadBytes += sizeInBytes;
+    return Append(CommandType::WriteBuffer, WriteBufferCmd{ buffer, mapType, offsetInBytes, sizeInBytes }, sizeInBytes);
+}
+
+void CommandBuffer::EndWrite([[maybe_unused]] Buffer* buffer)
+{
+}
+
+void CommandBuffer::Draw(uint32_t vertexCount, uint32_t startVertexLocation)
+{
+    Append(CommandType::Draw, DrawCmd{ vertexCount, startVertexLocation });
+    ++stats_.draws;
+}
+
+void CommandBuffer::DrawIndexed(uint32_t indexCount, uint32_t startIndexLocation, int32_t baseVertexLocation)
+{
+    Append(CommandType::DrawIndexed, DrawIndexedCmd{ indexCount, startIndexLocation, baseVertexLocation });
+    ++stats_.draws;
+}
+
+void CommandBuffer::DrawInstanced(uint32_t vertexCountPerInstance, uint32_t instanceCount,
+                                  uint32_t startVertexLocation, uint32_t startInstanceLocation)
+{
+    Append(CommandType::DrawInstanced,
+           DrawInstancedCmd{ vertexCountPerInstance, instanceCount, startVertexLocation, startInstanceLocation });
+    ++stats_.draws;
+}
+
+void CommandBuffer::DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount,
+                                         uint32_t startIndexLocation, int32_t baseVertexLocation,
+                                         uint32_t startInstanceLocation)
+{
+    Append(CommandType::DrawIndexedInstanced,
+           DrawIndexedInstancedCmd{ indexCountPerInstance, instanceCount, startIndexLocation,
+                                    baseVertexLocation, startInstanceLocation });
+    ++stats_.draws;
+}
+
+//============================================================================
+// 再生
+//============================================================================
+
+void CommandBuffer::Submit(ICommandBackend& backend) const
+{
+    const std::byte* cursor = data_.data();
+    const std::byte* const end = cursor + data_.size();
+
+    while (cursor < end) {
+        const auto header = Read<CommandHeader>(cursor);
+        const std::byte* payload = cursor + sizeof(CommandHeader);
+
+        switch (header.type) {
+        case CommandType::SetPrimitiveTopology:
+            backend.SetPrimitiveTopology(Read<TopologyCmd>(payload).topology);
+            break;
+        case CommandType::SetInputLayout:
+            backend.SetInputLayout(Read<InputLayoutCmd>(payload).inputLayout);
+            break;
+        case CommandType::SetVertexBuffer: {
+            const auto cmd = Read<VertexBufferCmd>(payload);
+            backend.SetVertexBuffer(cmd.slot, cmd.buffer, cmd.stride, cmd.offset);
+            break;
+        }
+        case CommandType::SetIndexBuffer: {
+            const auto cmd = Read<IndexBufferCmd>(payload);
+            backend.SetIndexBuffer(cmd.buffer, cmd.format, cmd.offset);
+            break;
+        }
+        case CommandType::SetShader: {
+            const auto cmd = Read<ShaderCmd>(payload);
+            backend.SetShader(cmd.stage, cmd.shader);
+            break;
+        }
+        case CommandType::SetConstantBuffer: {
+            const auto cmd = Read<ConstantBufferCmd>(payload);
+            backend.SetConstantBuffer(cmd.stage, cmd.slot, cmd.buffer);
+            break;
+        }
+        case CommandType::SetShaderResource: {
+            const auto cmd = Read<ShaderResourceCmd>(payload);
+            backend.SetShaderResource(cmd.stage, cmd.slot, cmd.texture);
+            break;
+        }
+        case CommandType::SetSampler: {
+            const auto cmd = Read<SamplerCmd>(payload);
+            backend.SetSampler(cmd.stage, cmd.slot, cmd.sampler);
+            break;
+        }
+        case CommandType::SetBlendState:
+            backend.SetBlendState(Read<BlendStateCmd>(payload).state);
+            break;
+        case CommandType::SetDepthStencilState: {
+            const auto cmd = Read<DepthStencilStateCmd>(payload);
+            backend.SetDepthStencilState(cmd.state, cmd.stencilRef);
+            break;
+        }
+        case CommandType::SetRasterizerState:
+            backend.SetRasterizerState(Read<RasterizerStateCmd>(payload).state);
+            break;
+        case CommandType::UpdateConstantBuffer: {
+            const auto cmd = Read<UpdateConstantBufferCmd>(payload);
+            backend.UpdateConstantBuffer(cmd.buffer, payload + sizeof(cmd), cmd.size);
+            break;
+        }
+        case CommandType::WriteBuffer: {
+            const auto cmd = Read<WriteBufferCmd>(payload);
+            void* dst = backend.BeginWrite(cmd.buffer, cmd.mapType, cmd.offset, cmd.size);
+            if (dst) {
+                std::memcpy(dst, payload + sizeof(cmd), cmd.size);
+                backend.EndWrite(cmd.buffer);
+            }
+            break;
+        }
+        case CommandType::Draw: {
+            const auto cmd = Read<DrawCmd>(payload);
+            backend.Draw(cmd.vertexCount, cmd.startVertex);
+            break;
+        }
+        case CommandType::DrawIndexed: {
+            const auto cmd = Read<DrawIndexedCmd>(payload);
+            backend.DrawIndexed(cmd.indexCount, cmd.startIndex, cmd.baseVertex);
+            break;
+        }
+        case CommandType::DrawInstanced: {
+            const auto cmd = Read<DrawInstancedCmd>(payload);
+            backend.DrawInstanced(cmd.vertexCount, cmd.instanceCount, cmd.startVertex, cmd.startInstance);
+            break;
+        }
+        case CommandType::DrawIndexedInstanced: {
+            const auto cmd = Read<DrawIndexedInstancedCmd>(payload);
+            backend.DrawIndexedInstanced(cmd.indexCount, cmd.instanceCount, cmd.startIndex,
+                                         cmd.baseVertex, cmd.startInstance);
+            break;
+        }
+        default:
+            break;
+        }
+
+        cursor += header.size;
+    }
+}
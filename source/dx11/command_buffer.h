@@ -0,0 +1,169 @@
+//----------------------------------------------------------------------------
+//! @file   command_buffer.h
+//! @brief  描画コマンドの記録と再生
+//!
+//! @details 描画・ステート・バッファ更新を線形のバイト列へ記録し、
+//!          Submit()で任意のICommandBackendへ順番どおりに再生する。
+//!          記録時に直前と同じバインドを除外するため、
+//!          冗長なステート変更の量をGPUなしで計測・検証できる。
+//----------------------------------------------------------------------------
+#pragma once
+
+#include "command_backend.h"
+
+//===========================================================================
+//! コマンドバッファ統計
+//===========================================================================
+struct CommandBufferStats
+{
+    uint32_t recorded = 0;      //!< 記録したコマンド数
+    uint32_t filtered = 0;      //!< 直前と同じため除外したバインド数
+    uint32_t draws = 0;         //!< 記録した描画コマンド数
+    uint32_t uploadBytes = 0;   //!< 定数バッファ更新・バッファ書き込みのデータ量
+};
+
+//===========================================================================
+//! コマンドバッファ
+//!
+//! @details ICommandBackendとして描画システムの出力先に指定すると、
+//!          即時実行の代わりにコマンドを記録する。
+//!          ステートの除外判定はバッファ内で記録済みの値とだけ比較するため、
+//!          Reset()/Invalidate()の後は最初のバインドを必ず記録する。
+//!
+//! @code
+//!   CommandBuffer commands;
+//!   SpriteBatch::Get().SetCommandTarget(&commands);
+//!   ...  // Begin()～End()
+//!   ContextCommandBackend context;
+//!   commands.Submit(context);  // GraphicsContextへ再生
+//!   commands.Reset();
+//! @endcode
+//===========================================================================
+class CommandBuffer final : public ICommandBackend
+{
+public:
+    //! 除外判定を行うスロット数（これ以上のスロットは常に記録）
+    static constexpr uint32_t kMaxVertexBufferSlots = 4;
+    static constexpr uint32_t kMaxConstantBufferSlots = 8;
+    static constexpr uint32_t kMaxShaderResourceSlots = 16;
+    static constexpr uint32_t kMaxSamplerSlots = 8;
+
+    CommandBuffer() = default;
+    ~CommandBuffer() override = default;
+
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    //! 記録内容・ステート・統計を破棄（確保済みのメモリは再利用する）
+    void Reset();
+
+    //! 記録済みステートを忘れる（外部でコンテキストのステートを変更した後に呼ぶ）
+    void Invalidate();
+
+    //! 記録したコマンドを順番どおりに再生
+    //! @param [in] backend 再生先
+    void Submit(ICommandBackend& backend) const;
+
+    //! 記録済みか
+    [[nodiscard]] bool IsEmpty() const noexcept { return data_.empty(); }
+
+    //! 記録データのサイズ（バイト）
+    [[nodiscard]] size_t GetByteSize() const noexcept { return data_.size(); }
+
+    //! 統計を取得
+    [[nodiscard]] const CommandBufferStats& GetStats() const noexcept { return stats_; }
+
+    // ICommandBackend（記録）
+    void SetPrimitiveTopology(uint32_t topology) override;
+    void SetInputLayout(ID3D11InputLayout* inputLayout) override;
+    void SetVertexBuffer(uint32_t slot, Buffer* buffer, uint32_t stride, uint32_t offset = 0) override;
+    void SetIndexBuffer(Buffer* buffer, uint32_t format, uint32_t offset = 0) override;
+    void SetShader(ShaderType stage, Shader* shader) override;
+    void SetConstantBuffer(ShaderType stage, uint32_t slot, Buffer* buffer) override;
+    void SetShaderResource(ShaderType stage, uint32_t slot, Texture* texture) override;
+    void SetSampler(ShaderType stage, uint32_t slot, SamplerState* sampler) override;
+    void SetBlendState(BlendState* state) override;
+    void SetDepthStencilState(DepthStencilState* state, uint32_t stencilRef = 0) override;
+    void SetRasterizerState(RasterizerState* state) override;
+    void UpdateConstantBuffer(Buffer* buffer, const void* data, uint32_t sizeInBytes) override;
+
+    //! @note 戻り値は記録領域を指すため、次のコマンドを記録する前に書き終えること
+    [[nodiscard]] void* BeginWrite(Buffer* buffer, uint32_t mapType,
+                                   uint32_t offsetInBytes, uint32_t sizeInBytes) override;
+    void EndWrite(Buffer* buffer) override;
+
+    void Draw(uint32_t vertexCount, uint32_t startVertexLocation = 0) override;
+    void DrawIndexed(uint32_t indexCount, uint32_t startIndexLocation = 0, int32_t baseVertexLocation = 0) override;
+    void DrawInstanced(uint32_t vertexCountPerInstance, uint32_t instanceCount,
+                       uint32_t startVertexLocation = 0, uint32_t startInstanceLocation = 0) override;
+    void DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount,
+                              uint32_t startIndexLocation = 0, int32_t baseVertexLocation = 0,
+                              uint32_t startInstanceLocation = 0) override;
+
+private:
+    //! 記録済みの値（knownがfalseなら未知）
+    template<typename T>
+    struct Cached
+    {
+        T value{};
+        bool known = false;
+
+        //! 値が変わる場合true（値を更新する）
+        bool Update(const T& v) noexcept {
+            if (known && value == v) return false;
+            value = v;
+            known = true;
+            return true;
+        }
+    };
+
+    struct VertexBinding
+    {
+        Buffer* buffer;
+        uint32_t stride;
+        uint32_t offset;
+        bool operator==(const VertexBinding&) const = default;
+    };
+
+    struct IndexBinding
+    {
+        Buffer* buffer;
+        uint32_t format;
+        uint32_t offset;
+        bool operator==(const IndexBinding&) const = default;
+    };
+
+    struct DepthBinding
+    {
+        DepthStencilState* state;
+        uint32_t stencilRef;
+        bool operator==(const DepthBinding&) const = default;
+    };
+
+    static constexpr size_t kStageCount = static_cast<size_t>(ShaderType::Count);
+
+    //! コマンドを追加し、ペイロード直後の可変長領域を返す
+    template<typename T>
+    std::byte* Append(CommandType type, const T& payload, uint32_t extraBytes = 0);
+
+    //! ステージ・スロットが除外判定の範囲内か
+    [[nodiscard]] static bool IsTracked(ShaderType stage, uint32_t slot, uint32_t maxSlots) noexcept {
+        return static_cast<size_t>(stage) < kStageCount && slot < maxSlots;
+    }
+
+    std::vector<std::byte> data_;
+    CommandBufferStats stats_;
+
+    // 記録済みステート
+    Cached<uint32_t> topology_;
+    Cached<ID3D11InputLayout*> inputLayout_;
+    std::array<Cached<VertexBinding>, kMaxVertexBufferSlots> vertexBuffers_;
+    Cached<IndexBinding> indexBuffer_;
+    std::array<Cached<Shader*>, kStageCount> shaders_;
+    std::array<std::array<Cached<Buffer*>, kMaxConstantBufferSlots>, kStageCount> constantBuffers_;
+    std::array<std::array<Cached<Texture*>, kMaxShaderResourceSlots>, kStageCount> shaderResources_;
+    std::array<std::array<Cached<SamplerState*>, kMaxSamplerSlots>, kStageCount> samplers_;
+    Cached<BlendState*> blendState_;
+    Cached<DepthBinding> depthStencilState_;
+    Cached<RasterizerState*> rasterizerState_;
+};
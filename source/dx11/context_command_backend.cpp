@@ -0,0 +1,142 @@
+//----------------------------------------------------------------------------
+//! @file   context_command_backend.cpp
+//! @brief  GraphicsContextバックエンド実装
+//----------------------------------------------------------------------------
+#include "dx11/context_command_backend.h"
+#include "dx11/graphics_context.h"
+
+void ContextCommandBackend::SetPrimitiveTopology(uint32_t topology)
+{
+    GraphicsContext::Get().SetPrimitiveTopology(static_cast<D3D11_PRIMITIVE_TOPOLOGY>(topology));
+}
+
+void ContextCommandBackend::SetInputLayout(ID3D11InputLayout* inputLayout)
+{
+    GraphicsContext::Get().SetInputLayout(inputLayout);
+}
+
+void ContextCommandBackend::SetVertexBuffer(uint32_t slot, Buffer* buffer, uint32_t stride, uint32_t offset)
+{
+    GraphicsContext::Get().SetVertexBuffer(slot, buffer, stride, offset);
+}
+
+void ContextCommandBackend::SetIndexBuffer(Buffer* buffer, uint32_t format, uint32_t offset)
+{
+    GraphicsContext::Get().SetIndexBuffer(buffer, static_cast<DXGI_FORMAT>(format), offset);
+}
+
+void ContextCommandBackend::SetShader(ShaderType stage, Shader* shader)
+{
+    auto& ctx = GraphicsContext::Get();
+    switch (stage) {
+    case ShaderType::Vertex:   ctx.SetVertexShader(shader); break;
+    case ShaderType::Pixel:    ctx.SetPixelShader(shader); break;
+    case ShaderType::Geometry: ctx.SetGeometryShader(shader); break;
+    case ShaderType::Hull:     ctx.SetHullShader(shader); break;
+    case ShaderType::Domain:   ctx.SetDomainShader(shader); break;
+    case ShaderType::Compute:  ctx.SetComputeShader(shader); break;
+    default: break;
+    }
+}
+
+void ContextCommandBackend::SetConstantBuffer(ShaderType stage, uint32_t slot, Buffer* buffer)
+{
+    auto& ctx = GraphicsContext::Get();
+    switch (stage) {
+    case ShaderType::Vertex:   ctx.SetVSConstantBuffer(slot, buffer); break;
+    case ShaderType::Pixel:    ctx.SetPSConstantBuffer(slot, buffer); break;
+    case ShaderType::Geometry: ctx.SetGSConstantBuffer(slot, buffer); break;
+    case ShaderType::Hull:     ctx.SetHSConstantBuffer(slot, buffer); break;
+    case ShaderType::Domain:   ctx.SetDSConstantBuffer(slot, buffer); break;
+    case ShaderType::Compute:  ctx.SetCSConstantBuffer(slot, buffer); break;
+    default: break;
+    }
+}
+
+void ContextCommandBackend::SetShaderResource(ShaderType stage, uint32_t slot, Texture* texture)
+{
+    auto& ctx = GraphicsContext::Get();
+    switch (stage) {
+    case ShaderType::Vertex:   ctx.SetVSShaderResource(slot, texture); break;
+    case ShaderType::Pixel:    ctx.SetPSShaderResource(slot, texture); break;
+    case ShaderType::Geometry: ctx.SetGSShaderResource(slot, texture); break;
+    case ShaderType::Hull:     ctx.SetHSShaderResource(slot, texture); break;
+    case ShaderType::Domain:   ctx.SetDSShaderResource(slot, texture); break;
+    case ShaderType::Compute:  ctx.SetCSShaderResource(slot, texture); break;
+    default: break;
+    }
+}
+
+void ContextCommandBackend::SetSampler(ShaderType stage, uint32_t slot, SamplerState* sampler)
+{
+    auto& ctx = GraphicsContext::Get();
+    switch (stage) {
+    case ShaderType::Vertex:   ctx.SetVSSampler(slot, sampler); break;
+    case ShaderType::Pixel:    ctx.SetPSSampler(slot, sampler); break;
+    case ShaderType::Geometry: ctx.SetGSSampler(slot, sampler); break;
+    case ShaderType::Hull:     ctx.SetHSSampler(slot, sampler); break;
+    case ShaderType::Domain:   ctx.SetDSSampler(slot, sampler); break;
+    case ShaderType::Compute:  ctx.SetCSSampler(slot, sampler); break;
+    default: break;
+    }
+}
+
+void ContextCommandBackend::SetBlendState(BlendState* state)
+{
+    GraphicsContext::Get().SetBlendState(state);
+}
+
+void ContextCommandBackend::SetDepthStencilState(DepthStencilState* state, uint32_t stencilRef)
+{
+    GraphicsContext::Get().SetDepthStencilState(state, stencilRef);
+}
+
+void ContextCommandBackend::SetRasterizerState(RasterizerState* state)
+{
+    GraphicsContext::Get().SetRasterizerState(state);
+}
+
+void ContextCommandBackend::UpdateConstantBuffer(Buffer* buffer, const void* data, uint32_t sizeInBytes)
+{
+    GraphicsContext::Get().UpdateConstantBuffer(buffer, data, sizeInBytes);
+}
+
+void* ContextCommandBackend::BeginWrite(Buffer* buffer, uint32_t mapType,
+                                        uint32_t offsetInBytes, [[maybe_unused]] uint32_t sizeInBytes)
+{
+    void* data = GraphicsContext::Get().MapBuffer(buffer, static_cast<D3D11_MAP>(mapType));
+    if (!data) {
+        return nullptr;
+    }
+    return static_cast<uint8_t*>(data) + offsetInBytes;
+}
+
+void ContextCommandBackend::EndWrite(Buffer* buffer)
+{
+    GraphicsContext::Get().UnmapBuffer(buffer);
+}
+
+void ContextCommandBackend::Draw(uint32_t vertexCount, uint32_t startVertexLocation)
+{
+    GraphicsContext::Get().Draw(vertexCount, startVertexLocation);
+}
+
+void ContextCommandBackend::DrawIndexed(uint32_t indexCount, uint32_t startIndexLocation, int32_t baseVertexLocation)
+{
+    GraphicsContext::Get().DrawIndexed(indexCount, startIndexLocation, baseVertexLocation);
+}
+
+void ContextCommandBackend::DrawInstanced(uint32_t vertexCountPerInstance, uint32_t instanceCount,
+                                          uint32_t startVertexLocation, uint32_t startInstanceLocation)
+{
+    GraphicsContext::Get().DrawInstanced(vertexCountPerInstance, instanceCount,
+                                         startVertexLocation, startInstanceLocation);
+}
+
+void ContextCommandBackend::DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount,
+                                                 uint32_t startIndexLocation, int32_t baseVertexLocation,
+                                                 uint32_t startInstanceLocation)
+{
+    GraphicsContext::Get().DrawIndexedInstanced(indexCountPerInstance, instanceCount,
+                                                startIndexLocation, baseVertexLocation, startInstanceLocation);
+}
@@ -0,0 +1,40 @@
+//----------------------------------------------------------------------------
+//! @file   context_command_backend.h
+//! @brief  GraphicsContextへ即時実行するコマンド出力先
+//----------------------------------------------------------------------------
+#pragma once
+
+#include "dx11/command_backend.h"
+
+//===========================================================================
+//! GraphicsContextバックエンド
+//!
+//! @details 受け取ったコマンドをそのままGraphicsContext（Immediate Context）へ発行する。
+//!          状態を持たないため、必要な場所で生成してよい。
+//===========================================================================
+class ContextCommandBackend final : public ICommandBackend
+{
+public:
+    void SetPrimitiveTopology(uint32_t topology) override;
+    void SetInputLayout(ID3D11InputLayout* inputLayout) override;
+    void SetVertexBuffer(uint32_t slot, Buffer* buffer, uint32_t stride, uint32_t offset = 0) override;
+    void SetIndexBuffer(Buffer* buffer, uint32_t format, uint32_t offset = 0) override;
+    void SetShader(ShaderType stage, Shader* shader) override;
+    void SetConstantBuffer(ShaderType stage, uint32_t slot, Buffer* buffer) override;
+    void SetShaderResource(ShaderType stage, uint32_t slot, Texture* texture) override;
+    void SetSampler(ShaderType stage, uint32_t slot, SamplerState* sampler) override;
+    void SetBlendState(BlendState* state) override;
+    void SetDepthStencilState(DepthStencilState* state, uint32_t stencilRef = 0) override;
+    void SetRasterizerState(RasterizerState* state) override;
+    void UpdateConstantBuffer(Buffer* buffer, const void* data, uint32_t sizeInBytes) override;
+    [[nodiscard]] void* BeginWrite(Buffer* buffer, uint32_t mapType,
+                                   uint32_t offsetInBytes, uint32_t sizeInBytes) override;
+    void EndWrite(Buffer* buffer) override;
+    void Draw(uint32_t vertexCount, uint32_t startVertexLocation = 0) override;
+    void DrawIndexed(uint32_t indexCount, uint32_t startIndexLocation = 0, int32_t baseVertexLocation = 0) override;
+    void DrawInstanced(uint32_t vertexCountPerInstance, uint32_t instanceCount,
+                       uint32_t startVertexLocation = 0, uint32_t startInstanceLocation = 0) override;
+    void DrawIndexedInstanced(uint32_t indexCountPerInstance, uint32_t instanceCount,
+                              uint32_t startIndexLocation = 0, int32_t baseVertexLocation = 0,
+                              uint32_t startInstanceLocation = 0) override;
+};
@@ -41,6 +41,9 @@ bool GraphicsContext::Initialize() noexcept
         return false;
     }
 
+    stateCache_.Invalidate();
+    stateCache_.ResetStats();
+    frameStats_ = {};
     return true;
 }
 
@@ -54,6 +57,29 @@ void GraphicsContext::Shutdown() noexcept
         context_->Flush();       // 保留中のコマンドをフラッシュ
     }
     context_.Reset();
+    stateCache_.Invalidate();
+}
+
+//===========================================================================
+// ステートキャッシュ
+//===========================================================================
+void GraphicsContext::ClearState()
+{
+    auto* ctx = context_.Get();
+    if (!ctx) return;
+    ctx->ClearState();
+    stateCache_.Invalidate();
+}
+
+void GraphicsContext::InvalidateStateCache() noexcept
+{
+    stateCache_.Invalidate();
+}
+
+void GraphicsContext::EndFrame() noexcept
+{
+    frameStats_ = stateCache_.GetStats();
+    stateCache_.ResetStats();
 }
 
 //===========================================================================
@@ -132,6 +158,7 @@ void GraphicsContext::SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology)
 {
     auto* ctx = context_.Get();
     if (!ctx) return;
+    if (!stateCache_.SetPrimitiveTopology(static_cast<uint32_t>(topology))) return;
     ctx->IASetPrimitiveTopology(topology);
 }
 
@@ -139,6 +166,7 @@ void GraphicsContext::SetInputLayout(ID3D11InputLayout* inputLayout)
 {
     auto* ctx = context_.Get();
     if (!ctx) return;
+    if (!stateCache_.SetInputLayout(inputLayout)) return;
     ctx->IASetInputLayout(inputLayout);
 }
 
@@ -190,6 +218,7 @@ void GraphicsContext::SetRenderTarget(Texture* renderTarget, Texture* depthStenc
     ID3D11RenderTargetView* rtv = renderTarget ? renderTarget->Rtv() : nullptr;
     ID3D11DepthStencilView* dsv = depthStencil ? depthStencil->Dsv() : nullptr;
     ctx->OMSetRenderTargets(renderTarget ? 1 : 0, &rtv, dsv);
+    stateCache_.InvalidateResources();
 }
 
 void GraphicsContext::SetRenderTargets(uint32_t count, Texture* const* renderTargets, Texture* depthStencil)
@@ -203,6 +232,7 @@ void GraphicsContext::SetRenderTargets(uint32_t count, Texture* const* renderTar
     }
     ID3D11DepthStencilView* dsv = depthStencil ? depthStencil->Dsv() : nullptr;
     ctx->OMSetRenderTargets(count, rtvs, dsv);
+    stateCache_.InvalidateResources();
 }
 
 void GraphicsContext::SetRenderTargetsAndUnorderedAccessViews(
@@ -219,6 +249,7 @@ void GraphicsContext::SetRenderTargetsAndUnorderedAccessViews(
     }
     ID3D11DepthStencilView* dsv = depthStencil ? depthStencil->Dsv() : nullptr;
     ctx->OMSetRenderTargetsAndUnorderedAccessViews(numRTVs, rtvs, dsv, uavStartSlot, numUAVs, uavs, uavInitialCounts);
+    stateCache_.InvalidateResources();
 }
 
 //===========================================================================
@@ -271,6 +302,7 @@ void GraphicsContext::SetVertexBuffer(uint32_t slot, Buffer* buffer, uint32_t st
     if (!ctx) return;
 
     ID3D11Buffer* buffers[] = { buffer ? buffer->Get() : nullptr };
+    if (!stateCache_.SetVertexBuffer(slot, buffers[0], stride, offset)) return;
     UINT strides[] = { stride };
     UINT offsets[] = { offset };
     ctx->IASetVertexBuffers(slot, 1, buffers, strides, offsets);
@@ -281,6 +313,7 @@ void GraphicsContext::SetVertexBuffers(uint32_t startSlot, uint32_t count,
 {
     auto* ctx = context_.Get();
     if (!ctx) return;
+    stateCache_.ForgetVertexBuffers(startSlot, count);
     ctx->IASetVertexBuffers(startSlot, count, buffers, strides, offsets);
 }
 
@@ -290,8 +323,10 @@ void GraphicsContext::SetIndexBuffer(Buffer* buffer, DXGI_FORMAT format, uint32_
     if (!ctx) return;
 
     if (buffer) {
+        if (!stateCache_.SetIndexBuffer(buffer->Get(), static_cast<uint32_t>(format), offset)) return;
         ctx->IASetIndexBuffer(buffer->Get(), format, offset);
     } else {
+        if (!stateCache_.SetIndexBuffer(nullptr, static_cast<uint32_t>(DXGI_FORMAT_R32_UINT), 0)) return;
         ctx->IASetIndexBuffer(nullptr, DXGI_FORMAT_R32_UINT, 0);
     }
 }
@@ -309,6 +344,7 @@ void GraphicsContext::SetStreamOutputTargets(uint32_t count, Buffer* const* buff
         d3dBuffers[i] = (buffers && buffers[i]) ? buffers[i]->Get() : nullptr;
     }
     ctx->SOSetTargets(count, d3dBuffers, offsets);
+    stateCache_.InvalidateResources();
 }
 
 //===========================================================================
@@ -393,6 +429,7 @@ void GraphicsContext::SetVSConstantBuffer(uint32_t slot, Buffer* buffer)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11Buffer* buffers[] = { buffer ? buffer->Get() : nullptr };
+    if (!stateCache_.SetConstantBuffer(ShaderType::Vertex, slot, buffers[0])) return;
     ctx->VSSetConstantBuffers(slot, 1, buffers);
 }
 
@@ -401,6 +438,7 @@ void GraphicsContext::SetPSConstantBuffer(uint32_t slot, Buffer* buffer)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11Buffer* buffers[] = { buffer ? buffer->Get() : nullptr };
+    if (!stateCache_.SetConstantBuffer(ShaderType::Pixel, slot, buffers[0])) return;
     ctx->PSSetConstantBuffers(slot, 1, buffers);
 }
 
@@ -409,6 +447,7 @@ void GraphicsContext::SetGSConstantBuffer(uint32_t slot, Buffer* buffer)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11Buffer* buffers[] = { buffer ? buffer->Get() : nullptr };
+    if (!stateCache_.SetConstantBuffer(ShaderType::Geometry, slot, buffers[0])) return;
     ctx->GSSetConstantBuffers(slot, 1, buffers);
 }
 
@@ -417,6 +456,7 @@ void GraphicsContext::SetHSConstantBuffer(uint32_t slot, Buffer* buffer)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11Buffer* buffers[] = { buffer ? buffer->Get() : nullptr };
+    if (!stateCache_.SetConstantBuffer(ShaderType::Hull, slot, buffers[0])) return;
     ctx->HSSetConstantBuffers(slot, 1, buffers);
 }
 
@@ -425,6 +465,7 @@ void GraphicsContext::SetDSConstantBuffer(uint32_t slot, Buffer* buffer)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11Buffer* buffers[] = { buffer ? buffer->Get() : nullptr };
+    if (!stateCache_.SetConstantBuffer(ShaderType::Domain, slot, buffers[0])) return;
     ctx->DSSetConstantBuffers(slot, 1, buffers);
 }
 
@@ -433,6 +474,7 @@ void GraphicsContext::SetCSConstantBuffer(uint32_t slot, Buffer* buffer)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11Buffer* buffers[] = { buffer ? buffer->Get() : nullptr };
+    if (!stateCache_.SetConstantBuffer(ShaderType::Compute, slot, buffers[0])) return;
     ctx->CSSetConstantBuffers(slot, 1, buffers);
 }
 
@@ -443,6 +485,7 @@ void GraphicsContext::SetVSShaderResourceView(uint32_t slot, ID3D11ShaderResourc
 {
     auto* ctx = context_.Get();
     if (!ctx) return;
+    if (!stateCache_.SetShaderResource(ShaderType::Vertex, slot, srv)) return;
     ctx->VSSetShaderResources(slot, 1, &srv);
 }
 
@@ -450,6 +493,7 @@ void GraphicsContext::SetPSShaderResourceView(uint32_t slot, ID3D11ShaderResourc
 {
     auto* ctx = context_.Get();
     if (!ctx) return;
+    if (!stateCache_.SetShaderResource(ShaderType::Pixel, slot, srv)) return;
     ctx->PSSetShaderResources(slot, 1, &srv);
 }
 
@@ -457,6 +501,7 @@ void GraphicsContext::SetGSShaderResourceView(uint32_t slot, ID3D11ShaderResourc
 {
     auto* ctx = context_.Get();
     if (!ctx) return;
+    if (!stateCache_.SetShaderResource(ShaderType::Geometry, slot, srv)) return;
     ctx->GSSetShaderResources(slot, 1, &srv);
 }
 
@@ -464,6 +509,7 @@ void GraphicsContext::SetHSShaderResourceView(uint32_t slot, ID3D11ShaderResourc
 {
     auto* ctx = context_.Get();
     if (!ctx) return;
+    if (!stateCache_.SetShaderResource(ShaderType::Hull, slot, srv)) return;
     ctx->HSSetShaderResources(slot, 1, &srv);
 }
 
@@ -471,6 +517,7 @@ void GraphicsContext::SetDSShaderResourceView(uint32_t slot, ID3D11ShaderResourc
 {
     auto* ctx = context_.Get();
     if (!ctx) return;
+    if (!stateCache_.SetShaderResource(ShaderType::Domain, slot, srv)) return;
     ctx->DSSetShaderResources(slot, 1, &srv);
 }
 
@@ -478,6 +525,7 @@ void GraphicsContext::SetCSShaderResourceView(uint32_t slot, ID3D11ShaderResourc
 {
     auto* ctx = context_.Get();
     if (!ctx) return;
+    if (!stateCache_.SetShaderResource(ShaderType::Compute, slot, srv)) return;
     ctx->CSSetShaderResources(slot, 1, &srv);
 }
 
@@ -489,6 +537,7 @@ void GraphicsContext::SetVSShaderResource(uint32_t slot, Texture* texture)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11ShaderResourceView* srvs[] = { texture ? texture->Srv() : nullptr };
+    if (!stateCache_.SetShaderResource(ShaderType::Vertex, slot, srvs[0])) return;
     ctx->VSSetShaderResources(slot, 1, srvs);
 }
 
@@ -497,6 +546,7 @@ void GraphicsContext::SetPSShaderResource(uint32_t slot, Texture* texture)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11ShaderResourceView* srvs[] = { texture ? texture->Srv() : nullptr };
+    if (!stateCache_.SetShaderResource(ShaderType::Pixel, slot, srvs[0])) return;
     ctx->PSSetShaderResources(slot, 1, srvs);
 }
 
@@ -505,6 +555,7 @@ void GraphicsContext::SetGSShaderResource(uint32_t slot, Texture* texture)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11ShaderResourceView* srvs[] = { texture ? texture->Srv() : nullptr };
+    if (!stateCache_.SetShaderResource(ShaderType::Geometry, slot, srvs[0])) return;
     ctx->GSSetShaderResources(slot, 1, srvs);
 }
 
@@ -513,6 +564,7 @@ void GraphicsContext::SetHSShaderResource(uint32_t slot, Texture* texture)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11ShaderResourceView* srvs[] = { texture ? texture->Srv() : nullptr };
+    if (!stateCache_.SetShaderResource(ShaderType::Hull, slot, srvs[0])) return;
     ctx->HSSetShaderResources(slot, 1, srvs);
 }
 
@@ -521,6 +573,7 @@ void GraphicsContext::SetDSShaderResource(uint32_t slot, Texture* texture)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11ShaderResourceView* srvs[] = { texture ? texture->Srv() : nullptr };
+    if (!stateCache_.SetShaderResource(ShaderType::Domain, slot, srvs[0])) return;
     ctx->DSSetShaderResources(slot, 1, srvs);
 }
 
@@ -529,6 +582,7 @@ void GraphicsContext::SetCSShaderResource(uint32_t slot, Texture* texture)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11ShaderResourceView* srvs[] = { texture ? texture->Srv() : nullptr };
+    if (!stateCache_.SetShaderResource(ShaderType::Compute, slot, srvs[0])) return;
     ctx->CSSetShaderResources(slot, 1, srvs);
 }
 
@@ -540,6 +594,7 @@ void GraphicsContext::SetVSShaderResource(uint32_t slot, Buffer* buffer)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11ShaderResourceView* srvs[] = { buffer ? buffer->Srv() : nullptr };
+    if (!stateCache_.SetShaderResource(ShaderType::Vertex, slot, srvs[0])) return;
     ctx->VSSetShaderResources(slot, 1, srvs);
 }
 
@@ -548,6 +603,7 @@ void GraphicsContext::SetPSShaderResource(uint32_t slot, Buffer* buffer)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11ShaderResourceView* srvs[] = { buffer ? buffer->Srv() : nullptr };
+    if (!stateCache_.SetShaderResource(ShaderType::Pixel, slot, srvs[0])) return;
     ctx->PSSetShaderResources(slot, 1, srvs);
 }
 
@@ -556,6 +612,7 @@ void GraphicsContext::SetGSShaderResource(uint32_t slot, Buffer* buffer)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11ShaderResourceView* srvs[] = { buffer ? buffer->Srv() : nullptr };
+    if (!stateCache_.SetShaderResource(ShaderType::Geometry, slot, srvs[0])) return;
     ctx->GSSetShaderResources(slot, 1, srvs);
 }
 
@@ -564,6 +621,7 @@ void GraphicsContext::SetHSShaderResource(uint32_t slot, Buffer* buffer)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11ShaderResourceView* srvs[] = { buffer ? buffer->Srv() : nullptr };
+    if (!stateCache_.SetShaderResource(ShaderType::Hull, slot, srvs[0])) return;
     ctx->HSSetShaderResources(slot, 1, srvs);
 }
 
@@ -572,6 +630,7 @@ void GraphicsContext::SetDSShaderResource(uint32_t slot, Buffer* buffer)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11ShaderResourceView* srvs[] = { buffer ? buffer->Srv() : nullptr };
+    if (!stateCache_.SetShaderResource(ShaderType::Domain, slot, srvs[0])) return;
     ctx->DSSetShaderResources(slot, 1, srvs);
 }
 
@@ -580,6 +639,7 @@ void GraphicsContext::SetCSShaderResource(uint32_t slot, Buffer* buffer)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11ShaderResourceView* srvs[] = { buffer ? buffer->Srv() : nullptr };
+    if (!stateCache_.SetShaderResource(ShaderType::Compute, slot, srvs[0])) return;
     ctx->CSSetShaderResources(slot, 1, srvs);
 }
 
@@ -591,6 +651,7 @@ void GraphicsContext::SetVSSampler(uint32_t slot, SamplerState* sampler)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11SamplerState* samplers[] = { sampler ? sampler->GetD3DSamplerState() : nullptr };
+    if (!stateCache_.SetSampler(ShaderType::Vertex, slot, samplers[0])) return;
     ctx->VSSetSamplers(slot, 1, samplers);
 }
 
@@ -599,6 +660,7 @@ void GraphicsContext::SetPSSampler(uint32_t slot, SamplerState* sampler)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11SamplerState* samplers[] = { sampler ? sampler->GetD3DSamplerState() : nullptr };
+    if (!stateCache_.SetSampler(ShaderType::Pixel, slot, samplers[0])) return;
     ctx->PSSetSamplers(slot, 1, samplers);
 }
 
@@ -607,6 +669,7 @@ void GraphicsContext::SetGSSampler(uint32_t slot, SamplerState* sampler)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11SamplerState* samplers[] = { sampler ? sampler->GetD3DSamplerState() : nullptr };
+    if (!stateCache_.SetSampler(ShaderType::Geometry, slot, samplers[0])) return;
     ctx->GSSetSamplers(slot, 1, samplers);
 }
 
@@ -615,6 +678,7 @@ void GraphicsContext::SetHSSampler(uint32_t slot, SamplerState* sampler)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11SamplerState* samplers[] = { sampler ? sampler->GetD3DSamplerState() : nullptr };
+    if (!stateCache_.SetSampler(ShaderType::Hull, slot, samplers[0])) return;
     ctx->HSSetSamplers(slot, 1, samplers);
 }
 
@@ -623,6 +687,7 @@ void GraphicsContext::SetDSSampler(uint32_t slot, SamplerState* sampler)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11SamplerState* samplers[] = { sampler ? sampler->GetD3DSamplerState() : nullptr };
+    if (!stateCache_.SetSampler(ShaderType::Domain, slot, samplers[0])) return;
     ctx->DSSetSamplers(slot, 1, samplers);
 }
 
@@ -631,6 +696,7 @@ void GraphicsContext::SetCSSampler(uint32_t slot, SamplerState* sampler)
     auto* ctx = context_.Get();
     if (!ctx) return;
     ID3D11SamplerState* samplers[] = { sampler ? sampler->GetD3DSamplerState() : nullptr };
+    if (!stateCache_.SetSampler(ShaderType::Compute, slot, samplers[0])) return;
     ctx->CSSetSamplers(slot, 1, samplers);
 }
 
@@ -644,21 +710,27 @@ void GraphicsContext::SetBlendState(BlendState* state, const float blendFactor[4
 
     static const float defaultBlendFactor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
     const float* factor = blendFactor ? blendFactor : defaultBlendFactor;
-    ctx->OMSetBlendState(state ? state->GetD3DBlendState() : nullptr, factor, sampleMask);
+    auto* d3dState = state ? state->GetD3DBlendState() : nullptr;
+    if (!stateCache_.SetBlendState(d3dState, factor, sampleMask)) return;
+    ctx->OMSetBlendState(d3dState, factor, sampleMask);
 }
 
 void GraphicsContext::SetDepthStencilState(DepthStencilState* state, uint32_t stencilRef)
 {
     auto* ctx = context_.Get();
     if (!ctx) return;
-    ctx->OMSetDepthStencilState(state ? state->GetD3DDepthStencilState() : nullptr, stencilRef);
+    auto* d3dState = state ? state->GetD3DDepthStencilState() : nullptr;
+    if (!stateCache_.SetDepthStencilState(d3dState, stencilRef)) return;
+    ctx->OMSetDepthStencilState(d3dState, stencilRef);
 }
 
 void GraphicsContext::SetRasterizerState(RasterizerState* state)
 {
     auto* ctx = context_.Get();
     if (!ctx) return;
-    ctx->RSSetState(state ? state->GetD3DRasterizerState() : nullptr);
+    auto* d3dState = state ? state->GetD3DRasterizerState() : nullptr;
+    if (!stateCache_.SetRasterizerState(d3dState)) return;
+    ctx->RSSetState(d3dState);
 }
 
 //===========================================================================
@@ -668,42 +740,54 @@ void GraphicsContext::SetVertexShader(Shader* shader)
 {
     auto* ctx = context_.Get();
     if (!ctx) return;
-    ctx->VSSetShader(shader ? shader->AsVs() : nullptr, nullptr, 0);
+    auto* d3dShader = shader ? shader->AsVs() : nullptr;
+    if (!stateCache_.SetShader(ShaderType::Vertex, d3dShader)) return;
+    ctx->VSSetShader(d3dShader, nullptr, 0);
 }
 
 void GraphicsContext::SetPixelShader(Shader* shader)
 {
     auto* ctx = context_.Get();
     if (!ctx) return;
-    ctx->PSSetShader(shader ? shader->AsPs() : nullptr, nullptr, 0);
+    auto* d3dShader = shader ? shader->AsPs() : nullptr;
+    if (!stateCache_.SetShader(ShaderType::Pixel, d3dShader)) return;
+    ctx->PSSetShader(d3dShader, nullptr, 0);
 }
 
 void GraphicsContext::SetGeometryShader(Shader* shader)
 {
     auto* ctx = context_.Get();
     if (!ctx) return;
-    ctx->GSSetShader(shader ? shader->AsGs() : nullptr, nullptr, 0);
+    auto* d3dShader = shader ? shader->AsGs() : nullptr;
+    if (!stateCache_.SetShader(ShaderType::Geometry, d3dShader)) return;
+    ctx->GSSetShader(d3dShader, nullptr, 0);
 }
 
 void GraphicsContext::SetHullShader(Shader* shader)
 {
     auto* ctx = context_.Get();
     if (!ctx) return;
-    ctx->HSSetShader(shader ? shader->AsHs() : nullptr, nullptr, 0);
+    auto* d3dShader = shader ? shader->AsHs() : nullptr;
+    if (!stateCache_.SetShader(ShaderType::Hull, d3dShader)) return;
+    ctx->HSSetShader(d3dShader, nullptr, 0);
 }
 
 void GraphicsContext::SetDomainShader(Shader* shader)
 {
     auto* ctx = context_.Get();
     if (!ctx) return;
-    ctx->DSSetShader(shader ? shader->AsDs() : nullptr, nullptr, 0);
+    auto* d3dShader = shader ? shader->AsDs() : nullptr;
+    if (!stateCache_.SetShader(ShaderType::Domain, d3dShader)) return;
+    ctx->DSSetShader(d3dShader, nullptr, 0);
 }
 
 void GraphicsContext::SetComputeShader(Shader* shader)
 {
     auto* ctx = context_.Get();
     if (!ctx) return;
-    ctx->CSSetShader(shader ? shader->AsCs() : nullptr, nullptr, 0);
+    auto* d3dShader = shader ? shader->AsCs() : nullptr;
+    if (!stateCache_.SetShader(ShaderType::Compute, d3dShader)) return;
+    ctx->CSSetShader(d3dShader, nullptr, 0);
 }
 
 //===========================================================================
@@ -715,6 +799,7 @@ void GraphicsContext::SetCSUnorderedAccessView(uint32_t slot, Texture* texture)
     if (!ctx) return;
     ID3D11UnorderedAccessView* uavs[] = { texture ? texture->Uav() : nullptr };
     ctx->CSSetUnorderedAccessViews(slot, 1, uavs, nullptr);
+    stateCache_.InvalidateResources();
 }
 
 void GraphicsContext::SetCSUnorderedAccessView(uint32_t slot, Buffer* buffer, uint32_t initialCount)
@@ -724,6 +809,7 @@ void GraphicsContext::SetCSUnorderedAccessView(uint32_t slot, Buffer* buffer, ui
     ID3D11UnorderedAccessView* uavs[] = { buffer ? buffer->Uav() : nullptr };
     UINT counts[] = { initialCount };
     ctx->CSSetUnorderedAccessViews(slot, 1, uavs, counts);
+    stateCache_.InvalidateResources();
 }
 
 void GraphicsContext::SetCSUnorderedAccessViewDirect(uint32_t slot, ID3D11UnorderedAccessView* uav, uint32_t initialCount)
@@ -732,6 +818,7 @@ void GraphicsContext::SetCSUnorderedAccessViewDirect(uint32_t slot, ID3D11Unorde
     if (!ctx) return;
     UINT counts[] = { initialCount };
     ctx->CSSetUnorderedAccessViews(slot, 1, &uav, counts);
+    stateCache_.InvalidateResources();
 }
 
 //===========================================================================
@@ -6,6 +6,7 @@
 
 #include "dx11/gpu_common.h"
 #include "dx11/gpu/gpu.h"
+#include "dx11/state_cache.h"
 
 // 既存クラス（state/）
 class BlendState;
@@ -16,6 +17,11 @@ class SamplerState;
 //===========================================================================
 //! グラフィックスコンテキスト
 //! @brief Immediate Contextのラッパー
+//!
+//! @details 入力アセンブラ・シェーダー・定数バッファ・SRV・サンプラー・
+//!          パイプラインステートはシャドウキャッシュと比較し、
+//!          設定済みの値と同じ場合はD3D11へ発行しない。
+//!          GetContext()で直接ステートを変更した場合はInvalidateStateCache()を呼ぶこと。
 //===========================================================================
 class GraphicsContext final : private NonCopyableNonMovable
 {
@@ -29,6 +35,28 @@ public:
     //! 終了処理
     void Shutdown() noexcept;
 
+    //----------------------------------------------------------
+    //! @name   ステートキャッシュ
+    //----------------------------------------------------------
+    //! @{
+
+    //! パイプラインから全状態をアンバインド（キャッシュも破棄）
+    void ClearState();
+
+    //! キャッシュを破棄（GetContext()で直接ステートを変更した後に呼ぶ）
+    void InvalidateStateCache() noexcept;
+
+    //! フレーム終了（バインド統計を確定して次フレーム用にリセット）
+    void EndFrame() noexcept;
+
+    //! 直前のフレームのバインド統計
+    [[nodiscard]] const StateBindStats& GetFrameStateStats() const noexcept { return frameStats_; }
+
+    //! 現在のフレームで集計中のバインド統計
+    [[nodiscard]] const StateBindStats& GetStateStats() const noexcept { return stateCache_.GetStats(); }
+
+    //!@}
+
     //----------------------------------------------------------
     //! @name   描画コマンド
     //----------------------------------------------------------
@@ -297,4 +325,6 @@ private:
     ~GraphicsContext() = default;
 
     ComPtr<ID3D11DeviceContext4> context_;
+    StateCache stateCache_;         //!< 設定済みステート
+    StateBindStats frameStats_;     //!< 直前のフレームの統計
 };
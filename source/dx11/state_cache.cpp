@@ -0,0 +1,38 @@
+//----------------------------------------------------------------------------
+//! @file   state_cache.cpp
+//! @brief  パイプラインステートのシャドウキャッシュ実装
+//----------------------------------------------------------------------------
+#include "state_cache.h"
+
+void StateCache::ForgetVertexBuffers(uint32_t startSlot, uint32_t count) noexcept
+{
+    for (uint32_t slot = startSlot; slot < startSlot + count && slot < kMaxVertexBufferSlots; ++slot) {
+        vertexBuffers_[slot].known = false;
+    }
+}
+
+void StateCache::Invalidate() noexcept
+{
+    topology_.known = false;
+    inputLayout_.known = false;
+    for (auto& shader : shaders_) shader.known = false;
+    for (auto& stage : constantBuffers_) {
+        for (auto& slot : stage) slot.known = false;
+    }
+    for (auto& stage : samplers_) {
+        for (auto& slot : stage) slot.known = false;
+    }
+    blendState_.known = false;
+    depthStencilState_.known = false;
+    rasterizerState_.known = false;
+    InvalidateResources();
+}
+
+void StateCache::InvalidateResources() noexcept
+{
+    for (auto& binding : vertexBuffers_) binding.known = false;
+    indexBuffer_.known = false;
+    for (auto& stage : shaderResources_) {
+        for (auto& slot : stage) slot.known = false;
+    }
+}
@@ -0,0 +1,261 @@
+//----------------------------------------------------------------------------
+//! @file   state_cache.h
+//! @brief  パイプラインステートのシャドウキャッシュ
+//!
+//! @details GraphicsContextがデバイスコンテキストへ設定した値を保持し、
+//!          同じ値の再設定を検出する。比較はD3D11オブジェクトのアドレスで行い、
+//!          D3D11ヘッダーに依存しないため、デバイスなしで動作を検証できる。
+//!          バインド中のオブジェクトはコンテキストが参照を保持するので、
+//!          同じアドレスが別オブジェクトに再利用されることはない。
+//----------------------------------------------------------------------------
+#pragma once
+
+#include "dx11/compile/shader_type.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+//===========================================================================
+//! バインドの分類
+//===========================================================================
+enum class StateBindCategory : uint8_t
+{
+    InputAssembler,     //!< トポロジー・入力レイアウト・頂点/インデックスバッファ
+    Shader,             //!< シェーダー
+    ConstantBuffer,     //!< 定数バッファ
+    ShaderResource,     //!< SRV
+    Sampler,            //!< サンプラー
+    PipelineState,      //!< ブレンド・深度ステンシル・ラスタライザ
+
+    Count
+};
+
+//! 分類名を取得
+[[nodiscard]] inline constexpr const char* GetStateBindCategoryName(StateBindCategory category) noexcept
+{
+    switch (category) {
+    case StateBindCategory::InputAssembler: return "InputAssembler";
+    case StateBindCategory::Shader:         return "Shader";
+    case StateBindCategory::ConstantBuffer: return "ConstantBuffer";
+    case StateBindCategory::ShaderResource: return "ShaderResource";
+    case StateBindCategory::Sampler:        return "Sampler";
+    case StateBindCategory::PipelineState:  return "PipelineState";
+    default:                                return "Unknown";
+    }
+}
+
+//===========================================================================
+//! バインド統計
+//===========================================================================
+struct StateBindStats
+{
+    static constexpr size_t kCategoryCount = static_cast<size_t>(StateBindCategory::Count);
+
+    std::array<uint32_t, kCategoryCount> issued{};   //!< コンテキストへ発行した回数
+    std::array<uint32_t, kCategoryCount> skipped{};  //!< 設定済みのため省略した回数
+
+    [[nodiscard]] uint32_t GetIssued(StateBindCategory category) const noexcept {
+        return issued[static_cast<size_t>(category)];
+    }
+    [[nodiscard]] uint32_t GetSkipped(StateBindCategory category) const noexcept {
+        return skipped[static_cast<size_t>(category)];
+    }
+
+    [[nodiscard]] uint32_t TotalIssued() const noexcept {
+        uint32_t total = 0;
+        for (uint32_t n : issued) total += n;
+        return total;
+    }
+    [[nodiscard]] uint32_t TotalSkipped() const noexcept {
+        uint32_t total = 0;
+        for (uint32_t n : skipped) total += n;
+        return total;
+    }
+};
+
+//===========================================================================
+//! シャドウステートキャッシュ
+//!
+//! @details 各Set系メソッドは値を記録し、コンテキストへの発行が必要ならtrueを返す。
+//!          追跡範囲外のスロットは常にtrue（発行）を返す。
+//!          キャッシュを経由せずにコンテキストを変更した場合はInvalidate()で忘れさせる。
+//!
+//! @code
+//!   if (cache_.SetInputLayout(layout)) {
+//!       ctx->IASetInputLayout(layout);
+//!   }
+//! @endcode
+//===========================================================================
+class StateCache
+{
+public:
+    //! 追跡するスロット数
+    static constexpr uint32_t kMaxVertexBufferSlots = 8;
+    static constexpr uint32_t kMaxConstantBufferSlots = 14;
+    static constexpr uint32_t kMaxShaderResourceSlots = 16;
+    static constexpr uint32_t kMaxSamplerSlots = 16;
+
+    //----------------------------------------------------------
+    //! @name   入力アセンブラ
+    //----------------------------------------------------------
+    //! @{
+
+    [[nodiscard]] bool SetPrimitiveTopology(uint32_t topology) noexcept {
+        return Tally(StateBindCategory::InputAssembler, topology_.Update(topology));
+    }
+    [[nodiscard]] bool SetInputLayout(const void* inputLayout) noexcept {
+        return Tally(StateBindCategory::InputAssembler, inputLayout_.Update(inputLayout));
+    }
+    [[nodiscard]] bool SetVertexBuffer(uint32_t slot, const void* buffer, uint32_t stride, uint32_t offset) noexcept {
+        if (slot >= kMaxVertexBufferSlots) return Tally(StateBindCategory::InputAssembler, true);
+        return Tally(StateBindCategory::InputAssembler, vertexBuffers_[slot].Update({ buffer, stride, offset }));
+    }
+    [[nodiscard]] bool SetIndexBuffer(const void* buffer, uint32_t format, uint32_t offset) noexcept {
+        return Tally(StateBindCategory::InputAssembler, indexBuffer_.Update({ buffer, format, offset }));
+    }
+
+    //! 頂点バッファを範囲指定で直接設定した（範囲内の記録を忘れる）
+    void ForgetVertexBuffers(uint32_t startSlot, uint32_t count) noexcept;
+
+    //! @}
+    //----------------------------------------------------------
+    //! @name   シェーダー・リソース
+    //----------------------------------------------------------
+    //! @{
+
+    [[nodiscard]] bool SetShader(ShaderType stage, const void* shader) noexcept {
+        if (!IsStage(stage)) return Tally(StateBindCategory::Shader, true);
+        return Tally(StateBindCategory::Shader, shaders_[Index(stage)].Update(shader));
+    }
+    [[nodiscard]] bool SetConstantBuffer(ShaderType stage, uint32_t slot, const void* buffer) noexcept {
+        if (!IsStage(stage) || slot >= kMaxConstantBufferSlots) return Tally(StateBindCategory::ConstantBuffer, true);
+        return Tally(StateBindCategory::ConstantBuffer, constantBuffers_[Index(stage)][slot].Update(buffer));
+    }
+    [[nodiscard]] bool SetShaderResource(ShaderType stage, uint32_t slot, const void* srv) noexcept {
+        if (!IsStage(stage) || slot >= kMaxShaderResourceSlots) return Tally(StateBindCategory::ShaderResource, true);
+        return Tally(StateBindCategory::ShaderResource, shaderResources_[Index(stage)][slot].Update(srv));
+    }
+    [[nodiscard]] bool SetSampler(ShaderType stage, uint32_t slot, const void* sampler) noexcept {
+        if (!IsStage(stage) || slot >= kMaxSamplerSlots) return Tally(StateBindCategory::Sampler, true);
+        return Tally(StateBindCategory::Sampler, samplers_[Index(stage)][slot].Update(sampler));
+    }
+
+    //! @}
+    //----------------------------------------------------------
+    //! @name   出力マージャー・ラスタライザ
+    //----------------------------------------------------------
+    //! @{
+
+    //! @param [in] blendFactor 4要素（nullptr不可）
+    [[nodiscard]] bool SetBlendState(const void* state, const float* blendFactor, uint32_t sampleMask) noexcept {
+        BlendBinding binding{ state, { blendFactor[0], blendFactor[1], blendFactor[2], blendFactor[3] }, sampleMask };
+        return Tally(StateBindCategory::PipelineState, blendState_.Update(binding));
+    }
+    [[nodiscard]] bool SetDepthStencilState(const void* state, uint32_t stencilRef) noexcept {
+        return Tally(StateBindCategory::PipelineState, depthStencilState_.Update({ state, stencilRef }));
+    }
+    [[nodiscard]] bool SetRasterizerState(const void* state) noexcept {
+        return Tally(StateBindCategory::PipelineState, rasterizerState_.Update(state));
+    }
+
+    //! @}
+    //----------------------------------------------------------
+    //! @name   キャッシュ・統計
+    //----------------------------------------------------------
+    //! @{
+
+    //! 全ての記録を忘れる（次の設定は必ず発行する）
+    void Invalidate() noexcept;
+
+    //! 出力側のバインド変更に伴い、入力リソースの記録を忘れる
+    //! @details レンダーターゲット・UAV・ストリーム出力に設定したリソースは
+    //!          D3D11が入力スロットから自動で外すため、SRVと頂点/インデックスバッファの
+    //!          記録が実際のバインドと食い違う。
+    void InvalidateResources() noexcept;
+
+    //! 統計をリセット
+    void ResetStats() noexcept { stats_ = {}; }
+
+    //! 統計を取得
+    [[nodiscard]] const StateBindStats& GetStats() const noexcept { return stats_; }
+
+    //! @}
+
+private:
+    //! 記録済みの値（knownがfalseなら未知）
+    template<typename T>
+    struct Cached
+    {
+        T value{};
+        bool known = false;
+
+        //! 値が変わる場合true（値を更新する）
+        bool Update(const T& v) noexcept {
+            if (known && value == v) return false;
+            value = v;
+            known = true;
+            return true;
+        }
+    };
+
+    struct VertexBinding
+    {
+        const void* buffer;
+        uint32_t stride;
+        uint32_t offset;
+        bool operator==(const VertexBinding&) const = default;
+    };
+
+    struct IndexBinding
+    {
+        const void* buffer;
+        uint32_t format;
+        uint32_t offset;
+        bool operator==(const IndexBinding&) const = default;
+    };
+
+    struct BlendBinding
+    {
+        const void* state;
+        std::array<float, 4> factor;
+        uint32_t sampleMask;
+        bool operator==(const BlendBinding&) const = default;
+    };
+
+    struct DepthBinding
+    {
+        const void* state;
+        uint32_t stencilRef;
+        bool operator==(const DepthBinding&) const = default;
+    };
+
+    static constexpr size_t kStageCount = static_cast<size_t>(ShaderType::Count);
+
+    [[nodiscard]] static bool IsStage(ShaderType stage) noexcept {
+        return static_cast<size_t>(stage) < kStageCount;
+    }
+    [[nodiscard]] static size_t Index(ShaderType stage) noexcept {
+        return static_cast<size_t>(stage);
+    }
+
+    //! 発行・省略を数えてそのまま返す
+    bool Tally(StateBindCategory category, bool issue) noexcept {
+        auto& counter = issue ? stats_.issued : stats_.skipped;
+        ++counter[static_cast<size_t>(category)];
+        return issue;
+    }
+
+    StateBindStats stats_;
+
+    Cached<uint32_t> topology_;
+    Cached<const void*> inputLayout_;
+    std::array<Cached<VertexBinding>, kMaxVertexBufferSlots> vertexBuffers_;
+    Cached<IndexBinding> indexBuffer_;
+    std::array<Cached<const void*>, kStageCount> shaders_;
+    std::array<std::array<Cached<const void*>, kMaxConstantBufferSlots>, kStageCount> constantBuffers_;
+    std::array<std::array<Cached<const void*>, kMaxShaderResourceSlots>, kStageCount> shaderResources_;
+    std::array<std::array<Cached<const void*>, kMaxSamplerSlots>, kStageCount> samplers_;
+    Cached<BlendBinding> blendState_;
+    Cached<DepthBinding> depthStencilState_;
+    Cached<const void*> rasterizerState_;
+};
@@ -5,25 +5,37 @@
 
 #include "collision_manager.h"
 #include "engine/component/collider2d.h"
+#include "common/logging/logging.h"
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 void CollisionManager::Initialize(int cellSize)
 {
-    cellSize_ = cellSize > 0 ? cellSize : CollisionConstants::kDefaultCellSize;
+    SetCellSize(cellSize);
     Clear();
 }
 
 void CollisionManager::Shutdown()
 {
+    StopWorkers();
     Clear();
 }
 
+CollisionManager::~CollisionManager()
+{
+    StopWorkers();
+}
+
 ColliderHandle CollisionManager::Register(Collider2D* collider)
 {
     if (!collider) return ColliderHandle{};
 
-    uint16_t index = AllocateIndex();
+    ColliderIndex index = AllocateIndex();
+    if (index == CollisionConstants::kInvalidIndex) {
+        LOG_WARN("[CollisionManager] コライダー数が上限に達しました");
+        return ColliderHandle{};
+    }
 
     // 配列サイズ確保
     size_t requiredSize = index + 1;
@@ -35,10 +47,17 @@ ColliderHandle CollisionManager::Register(Collider2D* collider)
         layer_.resize(requiredSize);
         mask_.resize(requiredSize);
         flags_.resize(requiredSize);
+        shape_.resize(requiredSize);
         offsetX_.resize(requiredSize);
         offsetY_.resize(requiredSize);
         sizeW_.resize(requiredSize);
         sizeH_.resize(requiredSize);
+        radius_.resize(requiredSize);
+        axisX_.resize(requiredSize);
+        axisY_.resize(requiredSize);
+        prevX_.resize(requiredSize);
+        prevY_.resize(requiredSize);
+        idleSteps_.resize(requiredSize);
         colliders_.resize(requiredSize);
         onCollision_.resize(requiredSize);
         onEnter_.resize(requiredSize);
@@ -53,17 +72,25 @@ ColliderHandle CollisionManager::Register(Collider2D* collider)
     halfH_[index] = 0.0f;
     layer_[index] = CollisionConstants::kDefaultLayer;
     mask_[index] = CollisionConstants::kDefaultMask;
-    flags_[index] = kFlagEnabled;
+    flags_[index] = kFlagEnabled | kFlagSweepReset;
+    shape_[index] = ColliderShape::Box;
     offsetX_[index] = 0.0f;
     offsetY_[index] = 0.0f;
     sizeW_[index] = 0.0f;
     sizeH_[index] = 0.0f;
+    radius_[index] = 0.0f;
+    axisX_[index] = 0.0f;
+    axisY_[index] = 0.0f;
+    prevX_[index] = 0.0f;
+    prevY_[index] = 0.0f;
+    idleSteps_[index] = 0;
     colliders_[index] = collider;
     onCollision_[index] = nullptr;
     onEnter_[index] = nullptr;
     onExit_[index] = nullptr;
 
     ++activeCount_;
+    sapDirty_ = true;
 
     return ColliderHandle{ index, generations_[index] };
 }
@@ -72,7 +99,7 @@ void CollisionManager::Unregister(ColliderHandle handle)
 {
     if (!IsValid(handle)) return;
 
-    uint16_t index = handle.index;
+    ColliderIndex index = handle.index;
 
     // 世代をインクリメント（古いハンドルを無効化）
     ++generations_[index];
@@ -82,10 +109,19 @@ void CollisionManager::Unregister(ColliderHandle handle)
     onCollision_[index] = nullptr;
     onEnter_[index] = nullptr;
     onExit_[index] = nullptr;
+    if ((flags_[index] & kFlagBullet) != 0) --bulletCount_;
+    if ((flags_[index] & kFlagRested) != 0) {
+        restDirty_ = true;  // 静止インデックスに残らないよう再構築
+        gridDirty_ = true;
+    }
     flags_[index] = 0;
 
-    FreeIndex(index);
+    // 世代が上限に達したスロットは再利用しない（ラップアラウンドで古いハンドルが蘇るのを防ぐ）
+    if (generations_[index] != CollisionConstants::kMaxGeneration) {
+        FreeIndex(index);
+    }
     --activeCount_;
+    sapDirty_ = true;
 }
 
 bool CollisionManager::IsValid(ColliderHandle handle) const noexcept
@@ -104,10 +140,17 @@ void CollisionManager::Clear()
     layer_.clear();
     mask_.clear();
     flags_.clear();
+    shape_.clear();
     offsetX_.clear();
     offsetY_.clear();
     sizeW_.clear();
     sizeH_.clear();
+    radius_.clear();
+    axisX_.clear();
+    axisY_.clear();
+    prevX_.clear();
+    prevY_.clear();
+    idleSteps_.clear();
     colliders_.clear();
     onCollision_.clear();
     onEnter_.clear();
@@ -116,22 +159,39 @@ void CollisionManager::Clear()
     freeIndices_.clear();
     activeCount_ = 0;
     grid_.clear();
+    cellEntries_.clear();
+    gridDirty_ = true;
+    visitStamp_.clear();
+    visitGeneration_ = 0;
+    sapEndpoints_.clear();
+    sapActive_.clear();
+    sapDirty_ = true;
     previousPairs_.clear();
+    contactEvents_.clear();
+    sweptHits_.clear();
+    bulletCount_ = 0;
+    restGrid_.clear();
+    restDirty_ = false;
+    awakeCount_ = 0;
+    sleepingCount_ = 0;
+    staticCount_ = 0;
     currentPairs_.clear();
-    testedPairs_.clear();
 }
 
-uint16_t CollisionManager::AllocateIndex()
+ColliderIndex CollisionManager::AllocateIndex()
 {
     if (!freeIndices_.empty()) {
-        uint16_t index = freeIndices_.back();
+        ColliderIndex index = freeIndices_.back();
         freeIndices_.pop_back();
         return index;
     }
-    return static_cast<uint16_t>(posX_.size());
+    if (posX_.size() >= CollisionConstants::kMaxColliders) {
+        return CollisionConstants::kInvalidIndex;
+    }
+    return static_cast<ColliderIndex>(posX_.size());
 }
 
-void CollisionManager::FreeIndex(uint16_t index)
+void CollisionManager::FreeIndex(ColliderIndex index)
 {
     freeIndices_.push_back(index);
 }
@@ -143,25 +203,64 @@ void CollisionManager::FreeIndex(uint16_t index)
 void CollisionManager::SetPosition(ColliderHandle handle, float x, float y)
 {
     if (!IsValid(handle)) return;
-    uint16_t i = handle.index;
-    posX_[i] = x + offsetX_[i];
-    posY_[i] = y + offsetY_[i];
+    ColliderIndex i = handle.index;
+    float px = x + offsetX_[i];
+    float py = y + offsetY_[i];
+    // 毎フレーム同じ値で同期されるので、変化した時だけ起こす
+    if (px == posX_[i] && py == posY_[i]) return;
+    posX_[i] = px;
+    posY_[i] = py;
+    Touch(i);
 }
 
 void CollisionManager::SetSize(ColliderHandle handle, float w, float h)
 {
     if (!IsValid(handle)) return;
-    uint16_t i = handle.index;
+    ColliderIndex i = handle.index;
+    shape_[i] = ColliderShape::Box;
     sizeW_[i] = w;
     sizeH_[i] = h;
     halfW_[i] = w * 0.5f;
     halfH_[i] = h * 0.5f;
+    Touch(i);
+}
+
+void CollisionManager::SetCircle(ColliderHandle handle, float radius)
+{
+    if (!IsValid(handle)) return;
+    ColliderIndex i = handle.index;
+    shape_[i] = ColliderShape::Circle;
+    radius_[i] = radius;
+    axisX_[i] = 0.0f;
+    axisY_[i] = 0.0f;
+    sizeW_[i] = radius * 2.0f;
+    sizeH_[i] = radius * 2.0f;
+    halfW_[i] = radius;
+    halfH_[i] = radius;
+    Touch(i);
+}
+
+void CollisionManager::SetCapsule(ColliderHandle handle, const Vector2& halfSegment, float radius)
+{
+    if (!IsValid(handle)) return;
+    ColliderIndex i = handle.index;
+    shape_[i] = ColliderShape::Capsule;
+    radius_[i] = radius;
+    axisX_[i] = halfSegment.x;
+    axisY_[i] = halfSegment.y;
+
+    // ブロードフェーズはバウンディングボックスのまま扱う
+    halfW_[i] = std::abs(halfSegment.x) + radius;
+    halfH_[i] = std::abs(halfSegment.y) + radius;
+    sizeW_[i] = halfW_[i] * 2.0f;
+    sizeH_[i] = halfH_[i] * 2.0f;
+    Touch(i);
 }
 
 void CollisionManager::SetOffset(ColliderHandle handle, float x, float y)
 {
     if (!IsValid(handle)) return;
-    uint16_t i = handle.index;
+    ColliderIndex i = handle.index;
     offsetX_[i] = x;
     offsetY_[i] = y;
 }
@@ -169,23 +268,29 @@ void CollisionManager::SetOffset(ColliderHandle handle, float x, float y)
 void CollisionManager::SetLayer(ColliderHandle handle, uint8_t layer)
 {
     if (!IsValid(handle)) return;
+    if (layer_[handle.index] == layer) return;
     layer_[handle.index] = layer;
+    Touch(handle.index);
 }
 
 void CollisionManager::SetMask(ColliderHandle handle, uint8_t mask)
 {
     if (!IsValid(handle)) return;
+    if (mask_[handle.index] == mask) return;
     mask_[handle.index] = mask;
+    Touch(handle.index);
 }
 
 void CollisionManager::SetEnabled(ColliderHandle handle, bool enabled)
 {
     if (!IsValid(handle)) return;
+    if (((flags_[handle.index] & kFlagEnabled) != 0) == enabled) return;
     if (enabled) {
         flags_[handle.index] |= kFlagEnabled;
     } else {
         flags_[handle.index] &= ~kFlagEnabled;
     }
+    Touch(handle.index);
 }
 
 void CollisionManager::SetTrigger(ColliderHandle handle, bool trigger)
@@ -198,6 +303,46 @@ void CollisionManager::SetTrigger(ColliderHandle handle, bool trigger)
     }
 }
 
+void CollisionManager::SetBullet(ColliderHandle handle, bool bullet)
+{
+    if (!IsValid(handle)) return;
+    uint8_t& flags = flags_[handle.index];
+    if (((flags & kFlagBullet) != 0) == bullet) return;
+
+    if (bullet) {
+        // 前ステップの位置が無いので、最初のステップは通常の判定のみ
+        flags |= kFlagBullet | kFlagSweepReset;
+        ++bulletCount_;
+    } else {
+        flags &= ~kFlagBullet;
+        --bulletCount_;
+    }
+}
+
+void CollisionManager::SetStatic(ColliderHandle handle, bool isStatic)
+{
+    if (!IsValid(handle)) return;
+    if (((flags_[handle.index] & kFlagStatic) != 0) == isStatic) return;
+    if (isStatic) {
+        flags_[handle.index] |= kFlagStatic;
+    } else {
+        flags_[handle.index] &= ~kFlagStatic;
+    }
+    Touch(handle.index);
+}
+
+void CollisionManager::Touch(ColliderIndex index)
+{
+    idleSteps_[index] = 0;
+    if ((flags_[index] & kFlagRested) == 0) return;
+
+    // 静止インデックスから起きているグリッドへ移す
+    flags_[index] &= ~kFlagRested;
+    restDirty_ = true;
+    gridDirty_ = true;
+    sapDirty_ = true;
+}
+
 void CollisionManager::SetOnCollision(ColliderHandle handle, CollisionCallback cb)
 {
     if (!IsValid(handle)) return;
@@ -223,7 +368,7 @@ void CollisionManager::SetOnCollisionExit(ColliderHandle handle, CollisionCallba
 AABB CollisionManager::GetAABB(ColliderHandle handle) const
 {
     if (!IsValid(handle)) return AABB{};
-    uint16_t i = handle.index;
+    ColliderIndex i = handle.index;
     AABB aabb;
     aabb.minX = posX_[i] - halfW_[i];
     aabb.minY = posY_[i] - halfH_[i];
@@ -235,14 +380,14 @@ AABB CollisionManager::GetAABB(ColliderHandle handle) const
 Vector2 CollisionManager::GetSize(ColliderHandle handle) const
 {
     if (!IsValid(handle)) return Vector2::Zero;
-    uint16_t i = handle.index;
+    ColliderIndex i = handle.index;
     return Vector2(sizeW_[i], sizeH_[i]);
 }
 
 Vector2 CollisionManager::GetOffset(ColliderHandle handle) const
 {
     if (!IsValid(handle)) return Vector2::Zero;
-    uint16_t i = handle.index;
+    ColliderIndex i = handle.index;
     return Vector2(offsetX_[i], offsetY_[i]);
 }
 
@@ -270,12 +415,56 @@ bool CollisionManager::IsTrigger(ColliderHandle handle) const
     return (flags_[handle.index] & kFlagTrigger) != 0;
 }
 
+bool CollisionManager::IsBullet(ColliderHandle handle) const
+{
+    if (!IsValid(handle)) return false;
+    return (flags_[handle.index] & kFlagBullet) != 0;
+}
+
+bool CollisionManager::IsStatic(ColliderHandle handle) const
+{
+    if (!IsValid(handle)) return false;
+    return (flags_[handle.index] & kFlagStatic) != 0;
+}
+
+bool CollisionManager::IsSleeping(ColliderHandle handle) const
+{
+    if (!IsValid(handle)) return false;
+    return (flags_[handle.index] & kFlagRested) != 0;
+}
+
 Collider2D* CollisionManager::GetCollider(ColliderHandle handle) const
 {
     if (!IsValid(handle)) return nullptr;
     return colliders_[handle.index];
 }
 
+ColliderShape CollisionManager::GetShape(ColliderHandle handle) const
+{
+    if (!IsValid(handle)) return ColliderShape::Box;
+    return shape_[handle.index];
+}
+
+float CollisionManager::GetRadius(ColliderHandle handle) const
+{
+    if (!IsValid(handle)) return 0.0f;
+    return radius_[handle.index];
+}
+
+CollisionShapes::ShapeData CollisionManager::GetShapeData(ColliderIndex i) const noexcept
+{
+    CollisionShapes::ShapeData data;
+    data.shape = shape_[i];
+    data.x = posX_[i];
+    data.y = posY_[i];
+    data.halfW = halfW_[i];
+    data.halfH = halfH_[i];
+    data.radius = radius_[i];
+    data.axisX = axisX_[i];
+    data.axisY = axisY_[i];
+    return data;
+}
+
 //----------------------------------------------------------------------------
 // 更新
 //----------------------------------------------------------------------------
@@ -283,6 +472,7 @@ Collider2D* CollisionManager::GetCollider(ColliderHandle handle) const
 void CollisionManager::Update(float deltaTime)
 {
     accumulator_ += deltaTime;
+    contactEvents_.clear();
 
     // 固定タイムステップで衝突判定を実行
     while (accumulator_ >= kFixedDeltaTime) {
@@ -291,58 +481,49 @@ void CollisionManager::Update(float deltaTime)
     }
 }
 
-void CollisionManager::FixedUpdate()
+void CollisionManager::SetBroadphaseMode(BroadphaseMode mode) noexcept
 {
-    // グリッド再構築
-    RebuildGrid();
+    if (broadphaseMode_ == mode) return;
+    broadphaseMode_ = mode;
+    sapDirty_ = true;
+    gridDirty_ = true;
+}
 
+void CollisionManager::FixedUpdate()
+{
     // ペア入れ替え
     std::swap(previousPairs_, currentPairs_);
     currentPairs_.clear();
-    testedPairs_.clear();
 
-    // グリッドセルごとに衝突判定
-    for (auto& [cell, indexList] : grid_) {
-        size_t count = indexList.size();
-        if (count < 2) continue;
-
-        for (size_t i = 0; i + 1 < count; ++i) {
-            for (size_t j = i + 1; j < count; ++j) {
-                uint16_t idxA = indexList[i];
-                uint16_t idxB = indexList[j];
-
-                // 有効性チェック
-                if ((flags_[idxA] & kFlagEnabled) == 0) continue;
-                if ((flags_[idxB] & kFlagEnabled) == 0) continue;
-
-                // 重複スキップ用キー
-                uint32_t pairKey = MakePairKey(idxA, idxB);
-
-                // レイヤーマスクチェック
-                bool canCollide = (mask_[idxA] & layer_[idxB]) != 0 ||
-                                  (mask_[idxB] & layer_[idxA]) != 0;
-                if (!canCollide) continue;
-
-                // AABB交差判定（インライン展開）
-                float minAX = posX_[idxA] - halfW_[idxA];
-                float maxAX = posX_[idxA] + halfW_[idxA];
-                float minAY = posY_[idxA] - halfH_[idxA];
-                float maxAY = posY_[idxA] + halfH_[idxA];
-
-                float minBX = posX_[idxB] - halfW_[idxB];
-                float maxBX = posX_[idxB] + halfW_[idxB];
-                float minBY = posY_[idxB] - halfH_[idxB];
-                float maxBY = posY_[idxB] + halfH_[idxB];
-
-                bool intersects = minAX < maxBX && maxAX > minBX &&
-                                  minAY < maxBY && maxAY > minBY;
-
-                if (intersects) {
-                    testedPairs_.push_back(pairKey);  // O(1)
-                    currentPairs_.push_back(pairKey); // O(1)
-                }
-            }
+    if (restDirty_) {
+        RebuildRestGrid();
+    }
+
+    // 起きているコライダー同士
+    switch (broadphaseMode_) {
+    case BroadphaseMode::SweepAndPrune:
+        UpdateSweepAndPrune();
+        CollectPairsSweepAndPrune();
+        gridDirty_ = true;  // クエリ用グリッドは必要になった時点で再構築
+        break;
+    case BroadphaseMode::Grid:
+    default:
+        RebuildGrid();
+        if (workers_.empty()) {
+            CollectPairsGrid();
+        } else {
+            CollectPairsGridParallel();
         }
+        break;
+    }
+
+    // 起きているコライダーと静止インデックス
+    CollectPairsRested();
+
+    // 弾丸の掃引判定（ブロードフェーズの結果に追加）
+    sweptHits_.clear();
+    if (bulletCount_ > 0) {
+        CollectSweptPairs();
     }
 
     // ソート + 重複削除（まとめて処理）
@@ -352,6 +533,459 @@ void CollisionManager::FixedUpdate()
         currentPairs_.end()
     );
 
+    // イベント列を出力してから、互換用にコールバックへ配信
+    size_t firstEvent = contactEvents_.size();
+    EmitContactEvents();
+    if (callbacksEnabled_) {
+        InvokeCallbacks(firstEvent);
+    }
+
+    UpdateRestStates();
+}
+
+bool CollisionManager::TestPair(ColliderIndex idxA, ColliderIndex idxB) const noexcept
+{
+    // レイヤーマスクチェック
+    bool canCollide = (mask_[idxA] & layer_[idxB]) != 0 ||
+                      (mask_[idxB] & layer_[idxA]) != 0;
+    if (!canCollide) return false;
+
+    // AABB交差判定（インライン展開）
+    float minAX = posX_[idxA] - halfW_[idxA];
+    float maxAX = posX_[idxA] + halfW_[idxA];
+    float minAY = posY_[idxA] - halfH_[idxA];
+    float maxAY = posY_[idxA] + halfH_[idxA];
+
+    float minBX = posX_[idxB] - halfW_[idxB];
+    float maxBX = posX_[idxB] + halfW_[idxB];
+    float minBY = posY_[idxB] - halfH_[idxB];
+    float maxBY = posY_[idxB] + halfH_[idxB];
+
+    if (!(minAX < maxBX && maxAX > minBX &&
+          minAY < maxBY && maxAY > minBY)) return false;
+
+    // 矩形以外を含むペアのみ形状判定
+    if (shape_[idxA] == ColliderShape::Box && shape_[idxB] == ColliderShape::Box) return true;
+    return TestShapes(idxA, idxB);
+}
+
+void CollisionManager::CollectPairsGrid()
+{
+    if (workspaces_.empty()) workspaces_.resize(1);
+    PairWorkspace& ws = workspaces_[0];
+
+    // グリッドセルごとに衝突判定
+    if (denseGrid_) {
+        size_t cellCount = cellStart_.size() - 1;
+        for (size_t c = 0; c < cellCount; ++c) {
+            uint32_t begin = cellStart_[c];
+            CollectPairsInCell(cellEntries_.data() + begin, cellStart_[c + 1] - begin, ws, currentPairs_);
+        }
+        return;
+    }
+
+    for (auto& [cell, indexList] : grid_) {
+        CollectPairsInCell(indexList.data(), indexList.size(), ws, currentPairs_);
+    }
+}
+
+void CollisionManager::CollectPairsInCell(const ColliderIndex* indexList, size_t count,
+                                          PairWorkspace& ws, std::vector<ColliderPairKey>& out) const
+{
+    static_assert(CollisionSimd::kFlagEnabled == kFlagEnabled, "enabled flag must match the SIMD kernel");
+
+    if (count < 2) return;
+
+    // セル内のコライダーを連続配置に集める（候補をまとめてSIMD判定するため）
+    CollisionSimd::CandidateBlock& block = ws.block;
+    block.Resize(count);
+    for (size_t k = 0; k < count; ++k) {
+        ColliderIndex idx = indexList[k];
+        block.posX[k] = posX_[idx];
+        block.posY[k] = posY_[idx];
+        block.halfW[k] = halfW_[idx];
+        block.halfH[k] = halfH_[idx];
+        block.layer[k] = layer_[idx];
+        block.mask[k] = mask_[idx];
+        block.flags[k] = flags_[idx];
+    }
+    ws.hits.resize(count);
+
+    for (size_t i = 0; i + 1 < count; ++i) {
+        // 有効性チェック（相手側はカーネル内で判定）
+        if ((block.flags[i] & kFlagEnabled) == 0) continue;
+
+        CollisionSimd::Probe probe;
+        probe.posX = block.posX[i];
+        probe.posY = block.posY[i];
+        probe.halfW = block.halfW[i];
+        probe.halfH = block.halfH[i];
+        probe.layer = block.layer[i];
+        probe.mask = block.mask[i];
+
+        size_t hitCount = CollisionSimd::OverlapBlock(probe, block, i + 1, count, ws.hits.data());
+        bool probeIsBox = shape_[indexList[i]] == ColliderShape::Box;
+        for (size_t h = 0; h < hitCount; ++h) {
+            ColliderIndex other = indexList[ws.hits[h]];
+            // AABBが重なっても、矩形以外を含むペアは形状で再判定
+            if (!(probeIsBox && shape_[other] == ColliderShape::Box) &&
+                !TestShapes(indexList[i], other)) continue;
+            out.push_back(MakePairKey(indexList[i], other)); // O(1)
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+// 並列ペア収集
+//----------------------------------------------------------------------------
+
+namespace {
+constexpr size_t kCellChunkSize = 32;  //!< ワーカーが一度に取るセル数
+} // namespace
+
+void CollisionManager::SetWorkerCount(uint32_t count)
+{
+    uint32_t workerThreads = count > 1 ? count - 1 : 0;
+    if (workerThreads == workers_.size()) return;
+
+    StopWorkers();
+
+    stopWorkers_ = false;
+    workspaces_.resize(workerThreads + 1);
+    workers_.reserve(workerThreads);
+    for (uint32_t i = 0; i < workerThreads; ++i) {
+        // インデックス0は呼び出し元スレッド
+        workers_.emplace_back(&CollisionManager::WorkerLoop, this, i + 1);
+    }
+}
+
+void CollisionManager::StopWorkers()
+{
+    if (workers_.empty()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(workMutex_);
+        stopWorkers_ = true;
+    }
+    workCv_.notify_all();
+
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+    workspaces_.resize(1);
+    stopWorkers_ = false;
+    workGeneration_ = 0;  // 新しいワーカーは世代0から待機を始める
+}
+
+void CollisionManager::WorkerLoop(uint32_t workerIndex)
+{
+    uint64_t seenGeneration = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(workMutex_);
+            workCv_.wait(lock, [&] { return stopWorkers_ || workGeneration_ != seenGeneration; });
+            if (stopWorkers_) return;
+            seenGeneration = workGeneration_;
+        }
+
+        CollectPairsWorker(workerIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(workMutex_);
+            if (--pendingWorkers_ == 0) {
+                doneCv_.notify_one();
+            }
+        }
+    }
+}
+
+void CollisionManager::CollectPairsWorker(uint32_t workerIndex)
+{
+    PairWorkspace& ws = workspaces_[workerIndex];
+    std::vector<ColliderPairKey>& out = ws.pairs;
+    size_t cellCount = denseGrid_ ? cellStart_.size() - 1 : hashCells_.size();
+
+    // 偏りを吸収するため固定分割ではなくチャンクを取り合う
+    for (;;) {
+        size_t begin = nextCellChunk_.fetch_add(kCellChunkSize, std::memory_order_relaxed);
+        if (begin >= cellCount) break;
+        size_t end = (std::min)(begin + kCellChunkSize, cellCount);
+
+        for (size_t c = begin; c < end; ++c) {
+            if (denseGrid_) {
+                uint32_t first = cellStart_[c];
+                CollectPairsInCell(cellEntries_.data() + first, cellStart_[c + 1] - first, ws, out);
+            } else {
+                const std::vector<ColliderIndex>& list = *hashCells_[c];
+                CollectPairsInCell(list.data(), list.size(), ws, out);
+            }
+        }
+    }
+}
+
+void CollisionManager::CollectPairsGridParallel()
+{
+    // 空間ハッシュはセル一覧を配列化してから分配
+    hashCells_.clear();
+    if (!denseGrid_) {
+        for (const auto& [cell, indexList] : grid_) {
+            if (indexList.size() >= 2) hashCells_.push_back(&indexList);
+        }
+    }
+
+    for (PairWorkspace& ws : workspaces_) {
+        ws.pairs.clear();
+    }
+    nextCellChunk_.store(0, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(workMutex_);
+        pendingWorkers_ = static_cast<uint32_t>(workers_.size());
+        ++workGeneration_;
+    }
+    workCv_.notify_all();
+
+    // 呼び出し元スレッドも参加
+    CollectPairsWorker(0);
+
+    {
+        std::unique_lock<std::mutex> lock(workMutex_);
+        doneCv_.wait(lock, [&] { return pendingWorkers_ == 0; });
+    }
+
+    // スレッド毎のリストを結合（後段のソートで順序は決定的になる）
+    for (const PairWorkspace& ws : workspaces_) {
+        currentPairs_.insert(currentPairs_.end(), ws.pairs.begin(), ws.pairs.end());
+    }
+}
+
+void CollisionManager::CollectPairsSweepAndPrune()
+{
+    // 端点を左から走査し、区間が重なっている間だけアクティブ集合に保持
+    sapActive_.clear();
+
+    for (const SapEndpoint& ep : sapEndpoints_) {
+        ColliderIndex idx = ep.index;
+        if ((flags_[idx] & kFlagEnabled) == 0) continue;
+
+        if (ep.isMax) {
+            // 最大端: アクティブ集合から除去（順序は不要なのでswap-pop）
+            auto it = std::find(sapActive_.begin(), sapActive_.end(), idx);
+            if (it != sapActive_.end()) {
+                *it = sapActive_.back();
+                sapActive_.pop_back();
+            }
+            continue;
+        }
+
+        // 最小端: X区間が重なる全コライダーと判定
+        for (ColliderIndex other : sapActive_) {
+            if (TestPair(idx, other)) {
+                currentPairs_.push_back(MakePairKey(idx, other));
+            }
+        }
+        sapActive_.push_back(idx);
+    }
+}
+
+//----------------------------------------------------------------------------
+// 静止/スリープ
+//----------------------------------------------------------------------------
+
+void CollisionManager::CollectPairsRested()
+{
+    // 静止同士のペアは前回の結果を引き継ぐ（どちらも変化していない）
+    for (ColliderPairKey key : previousPairs_) {
+        ColliderIndex a = GetFirstIndex(key);
+        ColliderIndex b = GetSecondIndex(key);
+        constexpr uint8_t kRestedEnabled = kFlagRested | kFlagEnabled;
+        if ((flags_[a] & kRestedEnabled) == kRestedEnabled &&
+            (flags_[b] & kRestedEnabled) == kRestedEnabled &&
+            colliders_[a] && colliders_[b]) {
+            currentPairs_.push_back(key);
+        }
+    }
+
+    if (restGrid_.empty()) return;
+
+    // 起きているコライダーのみ静止インデックスと判定
+    size_t count = colliders_.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (!colliders_[i]) continue;
+        if ((flags_[i] & (kFlagEnabled | kFlagRested)) != kFlagEnabled) continue;
+
+        ColliderIndex idx = static_cast<ColliderIndex>(i);
+        Cell c0 = ToCell(posX_[i] - halfW_[i], posY_[i] - halfH_[i]);
+        Cell c1 = ToCell(posX_[i] + halfW_[i] - 0.001f, posY_[i] + halfH_[i] - 0.001f);
+
+        for (int cy = c0.y; cy <= c1.y; ++cy) {
+            for (int cx = c0.x; cx <= c1.x; ++cx) {
+                auto it = restGrid_.find({cx, cy});
+                if (it == restGrid_.end()) continue;
+                for (ColliderIndex other : it->second) {
+                    if (TestPair(idx, other)) {
+                        currentPairs_.push_back(MakePairKey(idx, other));
+                    }
+                }
+            }
+        }
+    }
+}
+
+void CollisionManager::UpdateRestStates()
+{
+    awakeCount_ = 0;
+    sleepingCount_ = 0;
+    staticCount_ = 0;
+
+    size_t count = colliders_.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (!colliders_[i]) continue;
+        uint8_t& flags = flags_[i];
+
+        if ((flags & kFlagRested) == 0) {
+            if (idleSteps_[i] < UINT32_MAX) ++idleSteps_[i];
+
+            // 静的コライダーは変化のあったステップの直後に、動的は一定ステップ変化が無ければ静止させる
+            bool rest = (flags & kFlagStatic) != 0 ||
+                        (sleepThreshold_ > 0 && idleSteps_[i] >= sleepThreshold_);
+            if (rest) {
+                flags |= kFlagRested;
+                restDirty_ = true;
+                gridDirty_ = true;
+                sapDirty_ = true;
+            }
+        }
+
+        if ((flags & kFlagRested) == 0) {
+            ++awakeCount_;
+        } else if ((flags & kFlagStatic) != 0) {
+            ++staticCount_;
+        } else {
+            ++sleepingCount_;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+// 連続衝突判定
+//----------------------------------------------------------------------------
+
+namespace {
+
+//! @brief 移動する矩形と静止矩形の衝突時刻（相手をMinkowski和で拡張したスラブ法）
+//! @param x0,y0 移動開始時の中心
+//! @param dx,dy 1ステップの移動量
+//! @param sumHalfW,sumHalfH 両者の半サイズの和
+//! @param bx,by 相手の中心
+//! @param[out] toi 衝突時刻（0〜1、開始時に重なっていれば0）
+//! @return 接触のみを除き、移動中に重なる場合true
+[[nodiscard]] bool SweepAABB(float x0, float y0, float dx, float dy,
+                             float sumHalfW, float sumHalfH, float bx, float by, float& toi) noexcept
+{
+    float tEnter = -std::numeric_limits<float>::infinity();
+    float tExit = std::numeric_limits<float>::infinity();
+
+    auto axis = [&](float p, float d, float c, float h) {
+        if (d == 0.0f) return std::abs(p - c) < h;  // 平行: 常に重なっている必要がある
+        float t1 = (c - h - p) / d;
+        float t2 = (c + h - p) / d;
+        if (t1 > t2) std::swap(t1, t2);
+        tEnter = (std::max)(tEnter, t1);
+        tExit = (std::min)(tExit, t2);
+        return true;
+    };
+    if (!axis(x0, dx, bx, sumHalfW) || !axis(y0, dy, by, sumHalfH)) return false;
+
+    // 区間が空（接触のみを含む）または範囲外
+    if (tEnter >= tExit || tEnter >= 1.0f || tExit <= 0.0f) return false;
+
+    toi = (std::max)(tEnter, 0.0f);
+    return true;
+}
+
+} // namespace
+
+void CollisionManager::CollectSweptPairs()
+{
+    EnsureGrid();
+
+    for (size_t i = 0; i < flags_.size(); ++i) {
+        const uint8_t flags = flags_[i];
+        if ((flags & kFlagBullet) == 0) continue;
+
+        ColliderIndex a = static_cast<ColliderIndex>(i);
+        float x0 = prevX_[a];
+        float y0 = prevY_[a];
+        float x1 = posX_[a];
+        float y1 = posY_[a];
+
+        // 次ステップ用に現在位置を保存
+        prevX_[a] = x1;
+        prevY_[a] = y1;
+        flags_[a] &= ~kFlagSweepReset;
+
+        // 登録直後・無効は通常の判定のみ（静止中の弾丸は移動量0なので下で除外される）
+        if ((flags & kFlagSweepReset) != 0 || (flags & kFlagEnabled) == 0) continue;
+        float dx = x1 - x0;
+        float dy = y1 - y0;
+        if (dx == 0.0f && dy == 0.0f) continue;
+
+        float hw = halfW_[a];
+        float hh = halfH_[a];
+        ForEachCandidate((std::min)(x0, x1) - hw, (std::min)(y0, y1) - hh,
+                         (std::max)(x0, x1) + hw, (std::max)(y0, y1) + hh,
+                         CollisionConstants::kDefaultMask, [&](ColliderIndex b) {
+            if (b == a) return;
+            bool canCollide = (mask_[a] & layer_[b]) != 0 ||
+                              (mask_[b] & layer_[a]) != 0;
+            if (!canCollide) return;
+
+            float toi = 0.0f;
+            if (SweepAABB(x0, y0, dx, dy, hw + halfW_[b], hh + halfH_[b], posX_[b], posY_[b], toi)) {
+                ColliderPairKey key = MakePairKey(a, b);
+                currentPairs_.push_back(key);
+                sweptHits_.push_back({ toi, key });
+            }
+        });
+    }
+
+    // キー順に並べ、同一ペア（弾丸同士）は早い方の衝突時刻を残す
+    std::sort(sweptHits_.begin(), sweptHits_.end(), [](const SweptHit& l, const SweptHit& r) {
+        return l.key != r.key ? l.key < r.key : l.toi < r.toi;
+    });
+    sweptHits_.erase(
+        std::unique(sweptHits_.begin(), sweptHits_.end(),
+                    [](const SweptHit& l, const SweptHit& r) { return l.key == r.key; }),
+        sweptHits_.end()
+    );
+}
+
+void CollisionManager::EmitContactEvents()
+{
+    auto emit = [this](ColliderPairKey key, ContactType type) {
+        ColliderIndex a = GetFirstIndex(key);
+        ColliderIndex b = GetSecondIndex(key);
+        if (!colliders_[a] || !colliders_[b]) return;  // 解除済み
+        contactEvents_.push_back({
+            ColliderHandle{ a, generations_[a] }, ColliderHandle{ b, generations_[b] },
+            type, layer_[a], layer_[b] });
+    };
+
+    // 掃引判定で見つかったペアのEnterは後で衝突時刻順に出力する
+    deferredEnters_.clear();
+    size_t sweptIdx = 0;
+    auto enterOrDefer = [&](ColliderPairKey key) {
+        // sweptHits_もキー順なので、マージと同じ向きに進めるだけで検索できる
+        while (sweptIdx < sweptHits_.size() && sweptHits_[sweptIdx].key < key) ++sweptIdx;
+        if (sweptIdx < sweptHits_.size() && sweptHits_[sweptIdx].key == key) {
+            deferredEnters_.push_back(sweptHits_[sweptIdx]);
+        } else {
+            emit(key, ContactType::Enter);
+        }
+    };
+
     // Enter/Stay/Exit判定（マージ比較）
     size_t prevIdx = 0, currIdx = 0;
     size_t prevSize = previousPairs_.size();
@@ -359,226 +993,260 @@ void CollisionManager::FixedUpdate()
 
     while (prevIdx < prevSize || currIdx < currSize) {
         if (prevIdx >= prevSize) {
-            // Enter
-            uint32_t key = currentPairs_[currIdx++];
-            uint16_t a = GetFirstIndex(key);
-            uint16_t b = GetSecondIndex(key);
-            Collider2D* colA = colliders_[a];
-            Collider2D* colB = colliders_[b];
-            if (colA && colB) {
-                if (onEnter_[a]) onEnter_[a](colA, colB);
-                if (onEnter_[b]) onEnter_[b](colB, colA);
-                if (onCollision_[a]) onCollision_[a](colA, colB);
-                if (onCollision_[b]) onCollision_[b](colB, colA);
-            }
+            enterOrDefer(currentPairs_[currIdx++]);
         }
         else if (currIdx >= currSize) {
-            // Exit
-            uint32_t key = previousPairs_[prevIdx++];
-            uint16_t a = GetFirstIndex(key);
-            uint16_t b = GetSecondIndex(key);
-            Collider2D* colA = colliders_[a];
-            Collider2D* colB = colliders_[b];
-            if (colA && colB) {
-                if (onExit_[a]) onExit_[a](colA, colB);
-                if (onExit_[b]) onExit_[b](colB, colA);
-            }
+            emit(previousPairs_[prevIdx++], ContactType::Exit);
         }
         else {
-            uint32_t prevKey = previousPairs_[prevIdx];
-            uint32_t currKey = currentPairs_[currIdx];
+            ColliderPairKey prevKey = previousPairs_[prevIdx];
+            ColliderPairKey currKey = currentPairs_[currIdx];
 
             if (prevKey < currKey) {
-                // Exit
-                uint16_t a = GetFirstIndex(prevKey);
-                uint16_t b = GetSecondIndex(prevKey);
-                Collider2D* colA = colliders_[a];
-                Collider2D* colB = colliders_[b];
-                if (colA && colB) {
-                    if (onExit_[a]) onExit_[a](colA, colB);
-                    if (onExit_[b]) onExit_[b](colB, colA);
-                }
+                emit(prevKey, ContactType::Exit);
                 ++prevIdx;
             }
             else if (prevKey > currKey) {
-                // Enter
-                uint16_t a = GetFirstIndex(currKey);
-                uint16_t b = GetSecondIndex(currKey);
-                Collider2D* colA = colliders_[a];
-                Collider2D* colB = colliders_[b];
-                if (colA && colB) {
-                    if (onEnter_[a]) onEnter_[a](colA, colB);
-                    if (onEnter_[b]) onEnter_[b](colB, colA);
-                    if (onCollision_[a]) onCollision_[a](colA, colB);
-                    if (onCollision_[b]) onCollision_[b](colB, colA);
-                }
+                enterOrDefer(currKey);
                 ++currIdx;
             }
             else {
-                // Stay
-                uint16_t a = GetFirstIndex(currKey);
-                uint16_t b = GetSecondIndex(currKey);
-                Collider2D* colA = colliders_[a];
-                Collider2D* colB = colliders_[b];
-                if (colA && colB) {
-                    if (onCollision_[a]) onCollision_[a](colA, colB);
-                    if (onCollision_[b]) onCollision_[b](colB, colA);
-                }
+                emit(currKey, ContactType::Stay);
                 ++prevIdx;
                 ++currIdx;
             }
         }
     }
+
+    // 弾丸のEnterを衝突時刻順に出力（同時刻はキー順）
+    std::sort(deferredEnters_.begin(), deferredEnters_.end(), [](const SweptHit& l, const SweptHit& r) {
+        return l.toi != r.toi ? l.toi < r.toi : l.key < r.key;
+    });
+    for (const SweptHit& hit : deferredEnters_) {
+        emit(hit.key, ContactType::Enter);
+    }
+}
+
+void CollisionManager::InvokeCallbacks(size_t first)
+{
+    for (size_t i = first; i < contactEvents_.size(); ++i) {
+        const ContactEvent ev = contactEvents_[i];
+
+        // コールバック内で解除されたコライダーには配信しないよう、毎回ハンドルを検証する
+        auto call = [&](std::vector<CollisionCallback>& callbacks, ColliderIndex self, ColliderIndex other) {
+            if (!IsValid(ev.a) || !IsValid(ev.b)) return;
+            if (callbacks[self]) callbacks[self](colliders_[self], colliders_[other]);
+        };
+
+        switch (ev.type) {
+        case ContactType::Enter:
+            call(onEnter_, ev.a.index, ev.b.index);
+            call(onEnter_, ev.b.index, ev.a.index);
+            [[fallthrough]];
+        case ContactType::Stay:
+            call(onCollision_, ev.a.index, ev.b.index);
+            call(onCollision_, ev.b.index, ev.a.index);
+            break;
+        case ContactType::Exit:
+            call(onExit_, ev.a.index, ev.b.index);
+            call(onExit_, ev.b.index, ev.a.index);
+            break;
+        }
+    }
 }
 
 //----------------------------------------------------------------------------
 // クエリ
 //----------------------------------------------------------------------------
 
-void CollisionManager::QueryAABB(const AABB& aabb, std::vector<Collider2D*>& results, uint8_t layerMask)
+uint32_t CollisionManager::NextVisitStamp()
 {
-    results.clear();
-
-    Cell c0 = ToCell(aabb.minX, aabb.minY);
-    Cell c1 = ToCell(aabb.maxX - 0.001f, aabb.maxY - 0.001f);
-
-    // 重複チェック用
-    std::vector<uint16_t> checked;
-
-    for (int cy = c0.y; cy <= c1.y; ++cy) {
-        for (int cx = c0.x; cx <= c1.x; ++cx) {
-            auto it = grid_.find({cx, cy});
-            if (it == grid_.end()) continue;
-
-            for (uint16_t idx : it->second) {
-                if ((flags_[idx] & kFlagEnabled) == 0) continue;
-                if ((layer_[idx] & layerMask) == 0) continue;
-
-                // 重複チェック（push_back + 後でソート）
-                checked.push_back(idx);
-            }
-        }
+    if (visitStamp_.size() < posX_.size()) {
+        visitStamp_.resize(posX_.size(), 0);
     }
-
-    // 重複削除
-    std::sort(checked.begin(), checked.end());
-    checked.erase(std::unique(checked.begin(), checked.end()), checked.end());
-
-    // AABB判定
-    for (uint16_t idx : checked) {
-        float minX = posX_[idx] - halfW_[idx];
-        float maxX = posX_[idx] + halfW_[idx];
-        float minY = posY_[idx] - halfH_[idx];
-        float maxY = posY_[idx] + halfH_[idx];
-
-        if (aabb.minX < maxX && aabb.maxX > minX &&
-            aabb.minY < maxY && aabb.maxY > minY) {
-            results.push_back(colliders_[idx]);
-        }
+    // 一巡したら古いスタンプと衝突しないよう全クリア
+    if (++visitGeneration_ == 0) {
+        std::fill(visitStamp_.begin(), visitStamp_.end(), 0u);
+        visitGeneration_ = 1;
     }
+    return visitGeneration_;
 }
 
-void CollisionManager::QueryPoint(const Vector2& point, std::vector<Collider2D*>& results, uint8_t layerMask)
+template<typename Fn>
+void CollisionManager::ForEachCandidate(float minX, float minY, float maxX, float maxY,
+                                        uint8_t layerMask, Fn&& fn)
 {
-    results.clear();
+    const uint32_t stamp = NextVisitStamp();
+    ForEachInCells(minX, minY, maxX, maxY, [&](ColliderIndex idx) {
+        // 複数セルにまたがるコライダーは最初の1回だけ処理
+        if (visitStamp_[idx] == stamp) return;
+        visitStamp_[idx] = stamp;
+
+        if ((flags_[idx] & kFlagEnabled) == 0) return;
+        if ((layer_[idx] & layerMask) == 0) return;
+        fn(idx);
+    });
+}
 
-    Cell cell = ToCell(point.x, point.y);
-    auto it = grid_.find(cell);
-    if (it == grid_.end()) return;
+void CollisionManager::FlushQueryHits(std::vector<Collider2D*>& out)
+{
+    // セルの走査順ではなくインデックス順で返す（「最初のヒット」を使う呼び出し側のため）
+    std::sort(queryHits_.begin(), queryHits_.end());
+    for (ColliderIndex idx : queryHits_) {
+        out.push_back(colliders_[idx]);
+    }
+    queryHits_.clear();
+}
 
-    for (uint16_t idx : it->second) {
-        if ((flags_[idx] & kFlagEnabled) == 0) continue;
-        if ((layer_[idx] & layerMask) == 0) continue;
+void CollisionManager::AppendQueryAABB(const AABB& aabb, uint8_t layerMask, std::vector<Collider2D*>& out)
+{
+    // 形状判定（クエリ範囲を矩形形状として扱う）
+    CollisionShapes::ShapeData query;
+    query.x = (aabb.minX + aabb.maxX) * 0.5f;
+    query.y = (aabb.minY + aabb.maxY) * 0.5f;
+    query.halfW = (aabb.maxX - aabb.minX) * 0.5f;
+    query.halfH = (aabb.maxY - aabb.minY) * 0.5f;
+
+    ForEachCandidate(aabb.minX, aabb.minY, aabb.maxX - 0.001f, aabb.maxY - 0.001f, layerMask,
+        [&](ColliderIndex idx) {
+            if (CollisionShapes::Overlap(query, GetShapeData(idx))) {
+                queryHits_.push_back(idx);
+            }
+        });
+    FlushQueryHits(out);
+}
 
-        float minX = posX_[idx] - halfW_[idx];
-        float maxX = posX_[idx] + halfW_[idx];
-        float minY = posY_[idx] - halfH_[idx];
-        float maxY = posY_[idx] + halfH_[idx];
+void CollisionManager::AppendQueryPoint(const Vector2& point, uint8_t layerMask, std::vector<Collider2D*>& out)
+{
+    // 単一セルなので重複は発生しない
+    ForEachInCells(point.x, point.y, point.x, point.y, [&](ColliderIndex idx) {
+        if ((flags_[idx] & kFlagEnabled) == 0) return;
+        if ((layer_[idx] & layerMask) == 0) return;
 
-        if (point.x >= minX && point.x < maxX &&
-            point.y >= minY && point.y < maxY) {
-            results.push_back(colliders_[idx]);
+        if (CollisionShapes::ContainsPoint(GetShapeData(idx), point.x, point.y)) {
+            queryHits_.push_back(idx);
         }
-    }
+    });
+    FlushQueryHits(out);
 }
 
-void CollisionManager::QueryLineSegment(const Vector2& start, const Vector2& end,
-                                        std::vector<Collider2D*>& results, uint8_t layerMask)
+void CollisionManager::AppendQueryLineSegment(const Vector2& start, const Vector2& end, uint8_t layerMask,
+                                              std::vector<Collider2D*>& out)
 {
-    results.clear();
-
     // 線分のバウンディングボックスを計算
     float minX = (std::min)(start.x, end.x);
     float maxX = (std::max)(start.x, end.x);
     float minY = (std::min)(start.y, end.y);
     float maxY = (std::max)(start.y, end.y);
 
-    Cell c0 = ToCell(minX, minY);
-    Cell c1 = ToCell(maxX, maxY);
+    // 線分が通過する可能性のあるセルを走査し、形状と交差判定（矩形はLiang-Barsky）
+    ForEachCandidate(minX, minY, maxX, maxY, layerMask, [&](ColliderIndex idx) {
+        float t = 0.0f;
+        if (CollisionShapes::RaycastShape(GetShapeData(idx), start.x, start.y, end.x, end.y, t)) {
+            queryHits_.push_back(idx);
+        }
+    });
+    FlushQueryHits(out);
+}
 
-    // 重複チェック用
-    std::vector<uint16_t> checked;
+void CollisionManager::QueryAABB(const AABB& aabb, std::vector<Collider2D*>& results, uint8_t layerMask)
+{
+    results.clear();
+    EnsureGrid();
+    AppendQueryAABB(aabb, layerMask, results);
+}
 
-    // 線分が通過する可能性のあるセルを走査
-    for (int cy = c0.y; cy <= c1.y; ++cy) {
-        for (int cx = c0.x; cx <= c1.x; ++cx) {
-            auto it = grid_.find({cx, cy});
-            if (it == grid_.end()) continue;
+void CollisionManager::QueryPoint(const Vector2& point, std::vector<Collider2D*>& results, uint8_t layerMask)
+{
+    results.clear();
+    EnsureGrid();
+    AppendQueryPoint(point, layerMask, results);
+}
 
-            for (uint16_t idx : it->second) {
-                if ((flags_[idx] & kFlagEnabled) == 0) continue;
-                if ((layer_[idx] & layerMask) == 0) continue;
-                checked.push_back(idx);
+void CollisionManager::QueryCircle(const Vector2& center, float radius,
+                                   std::vector<Collider2D*>& results, uint8_t layerMask)
+{
+    results.clear();
+    EnsureGrid();
+
+    CollisionShapes::ShapeData query;
+    query.shape = ColliderShape::Circle;
+    query.x = center.x;
+    query.y = center.y;
+    query.halfW = radius;
+    query.halfH = radius;
+    query.radius = radius;
+
+    ForEachCandidate(center.x - radius, center.y - radius, center.x + radius, center.y + radius, layerMask,
+        [&](ColliderIndex idx) {
+            if (CollisionShapes::Overlap(query, GetShapeData(idx))) {
+                queryHits_.push_back(idx);
             }
-        }
-    }
+        });
+    FlushQueryHits(results);
+}
 
-    // 重複削除
-    std::sort(checked.begin(), checked.end());
-    checked.erase(std::unique(checked.begin(), checked.end()), checked.end());
+void CollisionManager::QueryLineSegment(const Vector2& start, const Vector2& end,
+                                        std::vector<Collider2D*>& results, uint8_t layerMask)
+{
+    results.clear();
+    EnsureGrid();
+    AppendQueryLineSegment(start, end, layerMask, results);
+}
 
-    // 線分とAABBの交差判定（Liang-Barsky アルゴリズム）
-    for (uint16_t idx : checked) {
-        float boxMinX = posX_[idx] - halfW_[idx];
-        float boxMaxX = posX_[idx] + halfW_[idx];
-        float boxMinY = posY_[idx] - halfH_[idx];
-        float boxMaxY = posY_[idx] + halfH_[idx];
+//----------------------------------------------------------------------------
+// バッチクエリ
+//----------------------------------------------------------------------------
 
-        // 線分のパラメトリック方程式: P(t) = start + t * (end - start), t ∈ [0, 1]
-        float dx = end.x - start.x;
-        float dy = end.y - start.y;
+void CollisionManager::QueryAABBBatch(std::span<const AABB> queries, QueryBatchResult& out, uint8_t layerMask)
+{
+    EnsureGrid();
+    out.hits.clear();
+    out.offsets.assign(1, 0u);
+    out.offsets.reserve(queries.size() + 1);
+
+    for (const AABB& aabb : queries) {
+        AppendQueryAABB(aabb, layerMask, out.hits);
+        out.offsets.push_back(static_cast<uint32_t>(out.hits.size()));
+    }
+}
 
-        float tMin = 0.0f;
-        float tMax = 1.0f;
+void CollisionManager::QueryPointBatch(std::span<const Vector2> points, QueryBatchResult& out, uint8_t layerMask)
+{
+    EnsureGrid();
+    out.hits.clear();
+    out.offsets.assign(1, 0u);
+    out.offsets.reserve(points.size() + 1);
+
+    for (const Vector2& point : points) {
+        AppendQueryPoint(point, layerMask, out.hits);
+        out.offsets.push_back(static_cast<uint32_t>(out.hits.size()));
+    }
+}
 
-        // X軸方向
-        if (std::abs(dx) < 1e-8f) {
-            // 線分がX軸に平行
-            if (start.x < boxMinX || start.x > boxMaxX) continue;
-        } else {
-            float t1 = (boxMinX - start.x) / dx;
-            float t2 = (boxMaxX - start.x) / dx;
-            if (t1 > t2) std::swap(t1, t2);
-            tMin = (std::max)(tMin, t1);
-            tMax = (std::min)(tMax, t2);
-            if (tMin > tMax) continue;
-        }
+void CollisionManager::QueryLineSegmentBatch(std::span<const LineSegment> segments, QueryBatchResult& out,
+                                             uint8_t layerMask)
+{
+    EnsureGrid();
+    out.hits.clear();
+    out.offsets.assign(1, 0u);
+    out.offsets.reserve(segments.size() + 1);
+
+    for (const LineSegment& seg : segments) {
+        AppendQueryLineSegment(seg.start, seg.end, layerMask, out.hits);
+        out.offsets.push_back(static_cast<uint32_t>(out.hits.size()));
+    }
+}
 
-        // Y軸方向
-        if (std::abs(dy) < 1e-8f) {
-            // 線分がY軸に平行
-            if (start.y < boxMinY || start.y > boxMaxY) continue;
-        } else {
-            float t1 = (boxMinY - start.y) / dy;
-            float t2 = (boxMaxY - start.y) / dy;
-            if (t1 > t2) std::swap(t1, t2);
-            tMin = (std::max)(tMin, t1);
-            tMax = (std::min)(tMax, t2);
-            if (tMin > tMax) continue;
-        }
+void CollisionManager::RaycastFirstBatch(std::span<const LineSegment> segments, std::vector<RaycastHit>& hits,
+                                         uint8_t layerMask)
+{
+    EnsureGrid();
+    hits.resize(segments.size());
 
-        // 交差している
-        results.push_back(colliders_[idx]);
+    for (size_t i = 0; i < segments.size(); ++i) {
+        std::optional<RaycastHit> hit = FindFirstHit(segments[i].start, segments[i].end, layerMask);
+        hits[i] = hit ? *hit : RaycastHit{};
     }
 }
 
@@ -594,7 +1262,111 @@ CollisionManager::Cell CollisionManager::ToCell(float x, float y) const noexcept
     };
 }
 
+CollisionManager::Cell CollisionManager::ToDenseCell(float x, float y) const noexcept
+{
+    Cell c = ToCell(x - worldMinX_, y - worldMinY_);
+    c.x = (std::clamp)(c.x, 0, denseCols_ - 1);
+    c.y = (std::clamp)(c.y, 0, denseRows_ - 1);
+    return c;
+}
+
+template<typename Fn>
+void CollisionManager::ForEachInCells(float minX, float minY, float maxX, float maxY, Fn&& fn) const
+{
+    if (denseGrid_) {
+        Cell c0 = ToDenseCell(minX, minY);
+        Cell c1 = ToDenseCell(maxX, maxY);
+        for (int cy = c0.y; cy <= c1.y; ++cy) {
+            size_t row = static_cast<size_t>(cy) * denseCols_;
+            uint32_t begin = cellStart_[row + c0.x];
+            uint32_t end = cellStart_[row + c1.x + 1];
+            // 同じ行の連続セルはエントリも連続している
+            for (uint32_t e = begin; e < end; ++e) {
+                fn(cellEntries_[e]);
+            }
+        }
+    }
+
+    Cell c0 = ToCell(minX, minY);
+    Cell c1 = ToCell(maxX, maxY);
+
+    if (!denseGrid_) {
+        for (int cy = c0.y; cy <= c1.y; ++cy) {
+            for (int cx = c0.x; cx <= c1.x; ++cx) {
+                auto it = grid_.find({cx, cy});
+                if (it == grid_.end()) continue;
+                for (ColliderIndex idx : it->second) {
+                    fn(idx);
+                }
+            }
+        }
+    }
+
+    // 静止インデックス
+    if (restGrid_.empty()) return;
+    for (int cy = c0.y; cy <= c1.y; ++cy) {
+        for (int cx = c0.x; cx <= c1.x; ++cx) {
+            auto it = restGrid_.find({cx, cy});
+            if (it == restGrid_.end()) continue;
+            for (ColliderIndex idx : it->second) {
+                fn(idx);
+            }
+        }
+    }
+}
+
+void CollisionManager::SetWorldBounds(const AABB& bounds)
+{
+    float width = bounds.maxX - bounds.minX;
+    float height = bounds.maxY - bounds.minY;
+    if (width <= 0.0f || height <= 0.0f) {
+        ClearWorldBounds();
+        return;
+    }
+
+    worldMinX_ = bounds.minX;
+    worldMinY_ = bounds.minY;
+    worldWidth_ = width;
+    worldHeight_ = height;
+    denseCols_ = static_cast<int>(std::ceil(width / static_cast<float>(cellSize_)));
+    denseRows_ = static_cast<int>(std::ceil(height / static_cast<float>(cellSize_)));
+
+    // セル数は固定なのでここで一度だけ確保
+    size_t cellCount = static_cast<size_t>(denseCols_) * denseRows_;
+    cellStart_.assign(cellCount + 1, 0);
+    cellCursor_.assign(cellCount, 0);
+    cellEntries_.clear();
+
+    denseGrid_ = true;
+    grid_.clear();
+    gridDirty_ = true;
+    restDirty_ = true;
+}
+
+void CollisionManager::ClearWorldBounds()
+{
+    denseGrid_ = false;
+    denseCols_ = 0;
+    denseRows_ = 0;
+    cellStart_.clear();
+    cellCursor_.clear();
+    cellEntries_.clear();
+    gridDirty_ = true;
+    restDirty_ = true;
+}
+
 void CollisionManager::RebuildGrid()
+{
+    gridDirty_ = false;
+
+    if (denseGrid_) {
+        RebuildDenseGrid();
+    } else {
+        RebuildHashGrid();
+    }
+}
+
+void CollisionManager::RebuildHashGrid()
 {
     for (auto& [cell, indexList] : grid_) {
         indexList.clear();
@@ -603,7 +1375,7 @@ void CollisionManager::RebuildGrid()
     size_t count = colliders_.size();
     for (size_t i = 0; i < count; ++i) {
         if (!colliders_[i]) continue;
-        if ((flags_[i] & kFlagEnabled) == 0) continue;
+        if ((flags_[i] & (kFlagEnabled | kFlagRested)) != kFlagEnabled) continue;
 
         float minX = posX_[i] - halfW_[i];
         float maxX = posX_[i] + halfW_[i];
@@ -615,18 +1387,160 @@ void CollisionManager::RebuildGrid()
 
         for (int cy = c0.y; cy <= c1.y; ++cy) {
             for (int cx = c0.x; cx <= c1.x; ++cx) {
-                grid_[{cx, cy}].push_back(static_cast<uint16_t>(i));
+                grid_[{cx, cy}].push_back(static_cast<ColliderIndex>(i));
             }
         }
     }
 }
 
+void CollisionManager::RebuildDenseGrid()
+{
+    size_t cellCount = cellCursor_.size();
+    std::fill(cellStart_.begin(), cellStart_.end(), 0u);
+
+    // パス1: セル毎の要素数をカウント
+    size_t count = colliders_.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (!colliders_[i]) continue;
+        if ((flags_[i] & (kFlagEnabled | kFlagRested)) != kFlagEnabled) continue;
+
+        Cell c0 = ToDenseCell(posX_[i] - halfW_[i], posY_[i] - halfH_[i]);
+        Cell c1 = ToDenseCell(posX_[i] + halfW_[i] - 0.001f, posY_[i] + halfH_[i] - 0.001f);
+
+        for (int cy = c0.y; cy <= c1.y; ++cy) {
+            size_t row = static_cast<size_t>(cy) * denseCols_;
+            for (int cx = c0.x; cx <= c1.x; ++cx) {
+                ++cellStart_[row + cx + 1];
+            }
+        }
+    }
+
+    // プレフィックスサム → 各セルの開始オフセット
+    for (size_t c = 0; c < cellCount; ++c) {
+        cellStart_[c + 1] += cellStart_[c];
+        cellCursor_[c] = cellStart_[c];
+    }
+    cellEntries_.resize(cellStart_[cellCount]);
+
+    // パス2: インデックス順に書き込み（セル内はインデックス昇順になる）
+    for (size_t i = 0; i < count; ++i) {
+        if (!colliders_[i]) continue;
+        if ((flags_[i] & (kFlagEnabled | kFlagRested)) != kFlagEnabled) continue;
+
+        Cell c0 = ToDenseCell(posX_[i] - halfW_[i], posY_[i] - halfH_[i]);
+        Cell c1 = ToDenseCell(posX_[i] + halfW_[i] - 0.001f, posY_[i] + halfH_[i] - 0.001f);
+
+        for (int cy = c0.y; cy <= c1.y; ++cy) {
+            size_t row = static_cast<size_t>(cy) * denseCols_;
+            for (int cx = c0.x; cx <= c1.x; ++cx) {
+                cellEntries_[cellCursor_[row + cx]++] = static_cast<ColliderIndex>(i);
+            }
+        }
+    }
+}
+
+void CollisionManager::RebuildRestGrid()
+{
+    restDirty_ = false;
+
+    // セルのバケットは残して再利用（静止インデックスはメンバー変化時のみ再構築）
+    for (auto& [cell, indexList] : restGrid_) {
+        indexList.clear();
+    }
+
+    size_t count = colliders_.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (!colliders_[i]) continue;
+        if ((flags_[i] & (kFlagEnabled | kFlagRested)) != (kFlagEnabled | kFlagRested)) continue;
+
+        Cell c0 = ToCell(posX_[i] - halfW_[i], posY_[i] - halfH_[i]);
+        Cell c1 = ToCell(posX_[i] + halfW_[i] - 0.001f, posY_[i] + halfH_[i] - 0.001f);
+
+        for (int cy = c0.y; cy <= c1.y; ++cy) {
+            for (int cx = c0.x; cx <= c1.x; ++cx) {
+                restGrid_[{cx, cy}].push_back(static_cast<ColliderIndex>(i));
+            }
+        }
+    }
+}
+
+void CollisionManager::EnsureGrid()
+{
+    if (restDirty_) {
+        RebuildRestGrid();
+    }
+    if (gridDirty_) {
+        RebuildGrid();
+    }
+}
+
+//----------------------------------------------------------------------------
+// Sweep and Prune
+//----------------------------------------------------------------------------
+
+namespace {
+
+//! 端点の順序（同値の場合は最大端を先に置き、接触のみのペアを除外）
+template<typename Endpoint>
+[[nodiscard]] inline bool SapLess(const Endpoint& a, const Endpoint& b) noexcept
+{
+    if (a.value != b.value) return a.value < b.value;
+    return a.isMax > b.isMax;
+}
+
+} // namespace
+
+void CollisionManager::UpdateSweepAndPrune()
+{
+    if (sapDirty_) {
+        // 登録/解除があった場合のみ端点を作り直す
+        sapEndpoints_.clear();
+        size_t count = colliders_.size();
+        for (size_t i = 0; i < count; ++i) {
+            if (!colliders_[i]) continue;
+            if ((flags_[i] & kFlagRested) != 0) continue;  // 静止中は静止インデックス側で判定
+            ColliderIndex idx = static_cast<ColliderIndex>(i);
+            sapEndpoints_.push_back({ posX_[i] - halfW_[i], idx, 0 });
+            sapEndpoints_.push_back({ posX_[i] + halfW_[i], idx, 1 });
+        }
+        std::sort(sapEndpoints_.begin(), sapEndpoints_.end(),
+            [](const SapEndpoint& a, const SapEndpoint& b) { return SapLess(a, b); });
+        sapDirty_ = false;
+        return;
+    }
+
+    // 端点値をSoAから更新
+    for (SapEndpoint& ep : sapEndpoints_) {
+        ColliderIndex idx = ep.index;
+        ep.value = ep.isMax ? posX_[idx] + halfW_[idx] : posX_[idx] - halfW_[idx];
+    }
+
+    // 挿入ソート（前ステップからの移動量が小さければほぼO(n)）
+    size_t n = sapEndpoints_.size();
+    for (size_t i = 1; i < n; ++i) {
+        SapEndpoint key = sapEndpoints_[i];
+        size_t j = i;
+        while (j > 0 && SapLess(key, sapEndpoints_[j - 1])) {
+            sapEndpoints_[j] = sapEndpoints_[j - 1];
+            --j;
+        }
+        sapEndpoints_[j] = key;
+    }
+}
+
 //----------------------------------------------------------------------------
 // レイキャスト
 //----------------------------------------------------------------------------
 
 std::optional<RaycastHit> CollisionManager::RaycastFirst(
     const Vector2& start, const Vector2& end, uint8_t layerMask)
+{
+    EnsureGrid();
+    return FindFirstHit(start, end, layerMask);
+}
+
+std::optional<RaycastHit> CollisionManager::FindFirstHit(
+    const Vector2& start, const Vector2& end, uint8_t layerMask)
 {
     // 線分のバウンディングボックスを計算
     float minX = (std::min)(start.x, end.x);
@@ -634,79 +1548,31 @@ std::optional<RaycastHit> CollisionManager::RaycastFirst(
     float minY = (std::min)(start.y, end.y);
     float maxY = (std::max)(start.y, end.y);
 
-    Cell c0 = ToCell(minX, minY);
-    Cell c1 = ToCell(maxX, maxY);
-
-    // 重複チェック用
-    std::vector<uint16_t> checked;
-
-    for (int cy = c0.y; cy <= c1.y; ++cy) {
-        for (int cx = c0.x; cx <= c1.x; ++cx) {
-            auto it = grid_.find({cx, cy});
-            if (it == grid_.end()) continue;
-
-            for (uint16_t idx : it->second) {
-                if ((flags_[idx] & kFlagEnabled) == 0) continue;
-                if ((layer_[idx] & layerMask) == 0) continue;
-                checked.push_back(idx);
-            }
-        }
-    }
-
-    // 重複削除
-    std::sort(checked.begin(), checked.end());
-    checked.erase(std::unique(checked.begin(), checked.end()), checked.end());
-
     float dx = end.x - start.x;
     float dy = end.y - start.y;
     float lineLength = std::sqrt(dx * dx + dy * dy);
 
     std::optional<RaycastHit> closestHit;
     float closestT = 2.0f;  // 1.0より大きい初期値
+    ColliderIndex closestIndex = CollisionConstants::kInvalidIndex;
 
-    for (uint16_t idx : checked) {
-        float boxMinX = posX_[idx] - halfW_[idx];
-        float boxMaxX = posX_[idx] + halfW_[idx];
-        float boxMinY = posY_[idx] - halfH_[idx];
-        float boxMaxY = posY_[idx] + halfH_[idx];
-
+    ForEachCandidate(minX, minY, maxX, maxY, layerMask, [&](ColliderIndex idx) {
         float tMin = 0.0f;
-        float tMax = 1.0f;
-
-        // X軸方向
-        if (std::abs(dx) < 1e-8f) {
-            if (start.x < boxMinX || start.x > boxMaxX) continue;
-        } else {
-            float t1 = (boxMinX - start.x) / dx;
-            float t2 = (boxMaxX - start.x) / dx;
-            if (t1 > t2) std::swap(t1, t2);
-            tMin = (std::max)(tMin, t1);
-            tMax = (std::min)(tMax, t2);
-            if (tMin > tMax) continue;
-        }
-
-        // Y軸方向
-        if (std::abs(dy) < 1e-8f) {
-            if (start.y < boxMinY || start.y > boxMaxY) continue;
-        } else {
-            float t1 = (boxMinY - start.y) / dy;
-            float t2 = (boxMaxY - start.y) / dy;
-            if (t1 > t2) std::swap(t1, t2);
-            tMin = (std::max)(tMin, t1);
-            tMax = (std::min)(tMax, t2);
-            if (tMin > tMax) continue;
+        if (!CollisionShapes::RaycastShape(GetShapeData(idx), start.x, start.y, end.x, end.y, tMin)) {
+            return;
         }
 
-        // 交差している & より近い場合
-        if (tMin < closestT) {
+        // より近い場合（同距離ならインデックスの小さい方を採用し、走査順に依存させない）
+        if (tMin < closestT || (tMin == closestT && idx < closestIndex)) {
             closestT = tMin;
+            closestIndex = idx;
             RaycastHit hit;
             hit.collider = colliders_[idx];
             hit.distance = tMin * lineLength;
             hit.point = Vector2(start.x + dx * tMin, start.y + dy * tMin);
             closestHit = hit;
         }
-    }
+    });
 
     return closestHit;
 }
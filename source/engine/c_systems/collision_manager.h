@@ -3,30 +3,85 @@
 //! @brief  衝突判定マネージャー（DOD設計）
 //!
 //! @note スレッドセーフではない。メインスレッドからのみ呼び出すこと。
+//!       SetWorkerCount()で有効にした並列モードでも、ワーカーが扱うのは
+//!       ペア収集のみで、コールバックは常に呼び出し元スレッドで発火する。
 //----------------------------------------------------------------------------
 #pragma once
 
 #include "common/utility/non_copyable.h"
 #include "engine/math/math_types.h"
+#include "collision_simd.h"
+#include "collision_shapes.h"
 #include <vector>
 #include <unordered_map>
 #include <functional>
 #include <cstdint>
 #include <optional>
+#include <span>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 class Collider2D;
 class GameObject;
 
+//============================================================================
+// ハンドル幅
+//============================================================================
+
+//! @def COLLISION_LARGE_HANDLES
+//! 1を定義すると32bitインデックス/世代と64bitペアキーを使用する。
+//! 0では16bitのままとし、小規模シーンのキャッシュ使用量を抑える。
+//! ハンドルと構造体のレイアウトが変わるため、premake5.luaのworkspaceで
+//! 全プロジェクト共通に定義する（翻訳単位ごとの既定値は持たない）。
+#ifndef COLLISION_LARGE_HANDLES
+#error "COLLISION_LARGE_HANDLES が未定義です（premake5.luaのworkspaceで定義すること）"
+#endif
+static_assert(COLLISION_LARGE_HANDLES == 0 || COLLISION_LARGE_HANDLES == 1,
+              "COLLISION_LARGE_HANDLES は0か1であること");
+
+// 翻訳単位間で値が食い違ったらリンクエラーにする
+#if defined(_MSC_VER)
+#if COLLISION_LARGE_HANDLES
+#pragma detect_mismatch("COLLISION_LARGE_HANDLES", "1")
+#else
+#pragma detect_mismatch("COLLISION_LARGE_HANDLES", "0")
+#endif
+#endif
+
+#if COLLISION_LARGE_HANDLES
+using ColliderIndex = uint32_t;      //!< SoA配列インデックス
+using ColliderGeneration = uint32_t; //!< ハンドル世代
+using ColliderPairKey = uint64_t;    //!< 2インデックスを詰めたペアキー
+#else
+using ColliderIndex = uint16_t;
+using ColliderGeneration = uint16_t;
+using ColliderPairKey = uint32_t;
+#endif
+
 //============================================================================
 // 定数定義
 //============================================================================
 namespace CollisionConstants {
-    static constexpr uint16_t kInvalidIndex = UINT16_MAX;   //!< 無効なインデックス
+    static constexpr ColliderIndex kInvalidIndex = static_cast<ColliderIndex>(~ColliderIndex{0});  //!< 無効なインデックス
+    static constexpr size_t kMaxColliders = kInvalidIndex;  //!< 同時登録可能な最大数
+    static constexpr ColliderGeneration kMaxGeneration = static_cast<ColliderGeneration>(~ColliderGeneration{0});  //!< 世代の上限（到達したスロットは再利用しない）
     static constexpr uint8_t kDefaultLayer = 0x01;          //!< デフォルトレイヤー
     static constexpr uint8_t kDefaultMask = 0xFF;           //!< デフォルトマスク（全レイヤーと衝突）
     static constexpr int kDefaultCellSize = 256;            //!< デフォルトセルサイズ
+    static constexpr uint32_t kDefaultSleepSteps = 0;       //!< スリープまでのステップ数の既定値（0: スリープしない）
+    static constexpr uint32_t kRecommendedSleepSteps = 30;  //!< スリープを有効にする場合の目安（0.5秒）
 }
 
+//============================================================================
+//! @brief ブロードフェーズ方式
+//============================================================================
+enum class BroadphaseMode : uint8_t {
+    Grid,           //!< 空間ハッシュグリッド（毎ステップ再構築）
+    SweepAndPrune,  //!< X軸端点ソートの差分更新（挿入ソート）
+};
+
 //============================================================================
 //! @brief コライダーハンドル
 //!
@@ -34,8 +89,8 @@ namespace CollisionConstants {
 //! 実データはCollisionManagerが所有する。
 //============================================================================
 struct ColliderHandle {
-    uint16_t index = CollisionConstants::kInvalidIndex;  //!< データ配列へのインデックス
-    uint16_t generation = 0;                              //!< 世代（再利用検出用）
+    ColliderIndex index = CollisionConstants::kInvalidIndex;  //!< データ配列へのインデックス
+    ColliderGeneration generation = 0;                         //!< 世代（再利用検出用）
 
     [[nodiscard]] bool IsValid() const noexcept {
         return index != CollisionConstants::kInvalidIndex;
@@ -44,6 +99,7 @@ struct ColliderHandle {
         return index == other.index && generation == other.generation;
     }
 };
+static_assert(sizeof(ColliderHandle) == sizeof(ColliderIndex) * 2, "ColliderHandle must stay packed");
 
 //============================================================================
 //! @brief AABB（軸平行境界ボックス）
@@ -85,6 +141,35 @@ struct AABB {
 //============================================================================
 using CollisionCallback = std::function<void(Collider2D*, Collider2D*)>;
 
+//============================================================================
+//! @brief 接触イベント種別
+//============================================================================
+enum class ContactType : uint8_t {
+    Enter,  //!< 接触開始
+    Stay,   //!< 接触継続
+    Exit,   //!< 接触終了
+};
+
+//============================================================================
+//! @brief 接触イベント（固定ステップ毎にまとめて出力される）
+//!
+//! aは常にインデックスの小さい側。レイヤーを持たせているので、
+//! ハンドルを引き直さずにレイヤーの組み合わせで絞り込める。
+//============================================================================
+struct ContactEvent {
+    ColliderHandle a;
+    ColliderHandle b;
+    ContactType type = ContactType::Enter;
+    uint8_t layerA = 0;
+    uint8_t layerB = 0;
+
+    //! @brief レイヤーの組み合わせが一致するか（順不同）
+    [[nodiscard]] bool Matches(uint8_t layer0, uint8_t layer1) const noexcept {
+        return ((layerA & layer0) && (layerB & layer1)) ||
+               ((layerA & layer1) && (layerB & layer0));
+    }
+};
+
 //============================================================================
 //! @brief レイキャストヒット情報
 //============================================================================
@@ -94,6 +179,27 @@ struct RaycastHit {
     Vector2 point;                   //!< ヒット座標
 };
 
+//============================================================================
+//! @brief バッチクエリの結果（呼び出し側が所有し、呼び出し間で再利用する）
+//!
+//! 全クエリのヒットを1本の配列に連結し、クエリiの結果は
+//! hits[offsets[i]] 〜 hits[offsets[i + 1] - 1] に格納される。
+//! クエリ毎のヒットは単発クエリと同じくインデックスの昇順。
+//============================================================================
+struct QueryBatchResult {
+    std::vector<Collider2D*> hits;   //!< 全クエリのヒット（連結）
+    std::vector<uint32_t> offsets;   //!< クエリ毎の開始位置（クエリ数 + 1）
+
+    [[nodiscard]] size_t GetQueryCount() const noexcept {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+
+    //! @brief クエリiのヒット一覧
+    [[nodiscard]] std::span<Collider2D* const> Get(size_t i) const noexcept {
+        return { hits.data() + offsets[i], offsets[i + 1] - offsets[i] };
+    }
+};
+
 //============================================================================
 //! @brief 衝突判定マネージャー（DOD設計）
 //!
@@ -142,6 +248,28 @@ public:
     void SetEnabled(ColliderHandle handle, bool enabled);
     void SetTrigger(ColliderHandle handle, bool trigger);
 
+    //! @brief 連続衝突判定（弾丸モード）を設定
+    //! @details 前ステップの位置から現在位置までの掃引AABBで衝突時刻を求め、
+    //!          1ステップで相手をすり抜ける高速な物体でもEnterを取りこぼさない。
+    //!          相手は現在位置で静止しているものとして扱う（形状はバウンディングで判定）。
+    //!          弾丸のEnterは通常のEnterの後に、衝突時刻順で出力される。
+    void SetBullet(ColliderHandle handle, bool bullet);
+
+    //! @brief 静的コライダーに設定（ステージの壁・装飾など動かないもの）
+    //! @details 静的/スリープ中のコライダーは毎ステップ再構築しない静止インデックスに置き、
+    //!          起きているコライダーとのみ判定する。静止同士のペアは前回の結果（Stay）を引き継ぐ。
+    //!          位置・サイズ・レイヤー等が変わると、そのステップだけ起きた状態で判定される。
+    void SetStatic(ColliderHandle handle, bool isStatic);
+
+    //! @brief 円形状に設定（SetSizeを呼ぶと矩形に戻る）
+    //! @param radius 半径（バウンディングボックスは2r四方）
+    void SetCircle(ColliderHandle handle, float radius);
+
+    //! @brief カプセル形状に設定（SetSizeを呼ぶと矩形に戻る）
+    //! @param halfSegment 中心から線分の端点へのベクトル（線分は中心±halfSegment）
+    //! @param radius 半径
+    void SetCapsule(ColliderHandle handle, const Vector2& halfSegment, float radius);
+
     void SetOnCollision(ColliderHandle handle, CollisionCallback cb);
     void SetOnCollisionEnter(ColliderHandle handle, CollisionCallback cb);
     void SetOnCollisionExit(ColliderHandle handle, CollisionCallback cb);
@@ -157,7 +285,12 @@ public:
     [[nodiscard]] uint8_t GetMask(ColliderHandle handle) const;
     [[nodiscard]] bool IsEnabled(ColliderHandle handle) const;
     [[nodiscard]] bool IsTrigger(ColliderHandle handle) const;
+    [[nodiscard]] bool IsBullet(ColliderHandle handle) const;
+    [[nodiscard]] bool IsStatic(ColliderHandle handle) const;
+    [[nodiscard]] bool IsSleeping(ColliderHandle handle) const;  //!< 静止インデックスにいるか（静的を含む）
     [[nodiscard]] Collider2D* GetCollider(ColliderHandle handle) const;
+    [[nodiscard]] ColliderShape GetShape(ColliderHandle handle) const;
+    [[nodiscard]] float GetRadius(ColliderHandle handle) const;
 
     //------------------------------------------------------------------------
     // 更新
@@ -167,6 +300,19 @@ public:
     //! @param deltaTime フレームの経過時間
     void Update(float deltaTime);
 
+    //! @brief 直前のUpdate()で実行した全ステップの接触イベント
+    //! @details 次のUpdate()の開始時にクリアされる。Enter/Stay/Exitの順序は
+    //!          コールバックの発火順と同じ。
+    [[nodiscard]] std::span<const ContactEvent> GetContactEvents() const noexcept {
+        return contactEvents_;
+    }
+
+    //! @brief 接触イベントからコライダー毎のコールバックを呼ぶか（デフォルト: true）
+    //! @details falseにするとイベント列のみを出力し、ゲーム側の反応は
+    //!          GetContactEvents()をまとめて処理するシステムに任せる。
+    void SetCallbacksEnabled(bool enabled) noexcept { callbacksEnabled_ = enabled; }
+    [[nodiscard]] bool IsCallbacksEnabled() const noexcept { return callbacksEnabled_; }
+
     //! @brief 固定タイムステップの間隔を取得
     [[nodiscard]] static constexpr float GetFixedDeltaTime() noexcept { return kFixedDeltaTime; }
 
@@ -174,14 +320,61 @@ public:
     // 設定・統計
     //------------------------------------------------------------------------
 
+    //! @brief セルサイズを設定（グリッドと静止インデックスは次の判定/クエリで作り直す）
     void SetCellSize(int size) noexcept {
         cellSize_ = size > 0 ? size : CollisionConstants::kDefaultCellSize;
+        grid_.clear();
+        restGrid_.clear();
+        gridDirty_ = true;
+        restDirty_ = true;
+        if (denseGrid_) SetWorldBounds(AABB(worldMinX_, worldMinY_,
+            worldWidth_, worldHeight_));
     }
     [[nodiscard]] int GetCellSize() const noexcept { return cellSize_; }
     [[nodiscard]] size_t GetColliderCount() const noexcept { return activeCount_; }
 
+    //! @brief 境界付きワールドを設定し、密なフラットグリッドを使用
+    //! @param bounds ワールド範囲（範囲外のコライダーは端のセルに丸め込む）
+    //! @details セルオフセット配列 + 連続インデックス配列（カウンティングソート）で
+    //!          グリッドを構築し、ハッシュ参照とセル毎のヒープ確保を無くす。
+    void SetWorldBounds(const AABB& bounds);
+
+    //! @brief 境界なし（空間ハッシュ）グリッドに戻す
+    void ClearWorldBounds();
+
+    //! @brief 境界付きワールド（密グリッド）モードか
+    [[nodiscard]] bool HasWorldBounds() const noexcept { return denseGrid_; }
+
+    //! @brief ペア収集のワーカースレッド数を設定（グリッド方式のみ）
+    //! @param count 呼び出し元スレッドを含む総数（1以下でシングルスレッド）
+    //! @details セルを複数スレッドに分配し、スレッド毎のペアリストを
+    //!          結合・ソートするため結果は決定的。
+    void SetWorkerCount(uint32_t count);
+    [[nodiscard]] uint32_t GetWorkerCount() const noexcept {
+        return static_cast<uint32_t>(workers_.size()) + 1;
+    }
+
+    //! @brief 変化の無い動的コライダーがスリープするまでのステップ数（0でスリープしない）
+    //! @details デフォルトは0（オプトイン）。有効にする場合はkRecommendedSleepStepsが目安。
+    //!          SetPosition/SetSize等で値が変わると自動的に起きる。
+    //!          静的コライダー（SetStatic）はこの設定に関わらず静止インデックスに置かれる。
+    void SetSleepThreshold(uint32_t steps) noexcept { sleepThreshold_ = steps; }
+    [[nodiscard]] uint32_t GetSleepThreshold() const noexcept { return sleepThreshold_; }
+
+    //! @brief 直前の固定ステップ終了時点の内訳
+    [[nodiscard]] size_t GetAwakeCount() const noexcept { return awakeCount_; }
+    [[nodiscard]] size_t GetSleepingCount() const noexcept { return sleepingCount_; }
+    [[nodiscard]] size_t GetStaticCount() const noexcept { return staticCount_; }
+
+    //! @brief ブロードフェーズ方式を設定
+    //! @note どちらの方式でもEnter/Stay/Exitの結果は同一
+    void SetBroadphaseMode(BroadphaseMode mode) noexcept;
+    [[nodiscard]] BroadphaseMode GetBroadphaseMode() const noexcept { return broadphaseMode_; }
+
     //------------------------------------------------------------------------
     // クエリ
+    //   結果はコライダーのインデックス（登録スロット）の昇順で返す。
+    //   グリッドの走査順・静止インデックスの有無には依存しない。
     //------------------------------------------------------------------------
 
     //! @brief AABB範囲内のコライダーを検索
@@ -201,6 +394,15 @@ public:
                           std::vector<Collider2D*>& results,
                           uint8_t layerMask = CollisionConstants::kDefaultMask);
 
+    //! @brief 円と交差するコライダーを検索
+    //! @param center 円の中心
+    //! @param radius 円の半径
+    //! @param results 結果を格納するベクター
+    //! @param layerMask 検索対象のレイヤーマスク
+    void QueryCircle(const Vector2& center, float radius,
+                     std::vector<Collider2D*>& results,
+                     uint8_t layerMask = CollisionConstants::kDefaultMask);
+
     //! @brief レイキャストで最初にヒットしたコライダーを取得
     //! @param start 線分の始点
     //! @param end 線分の終点
@@ -210,29 +412,111 @@ public:
         const Vector2& start, const Vector2& end,
         uint8_t layerMask = CollisionConstants::kDefaultMask);
 
+    //------------------------------------------------------------------------
+    // バッチクエリ
+    //   グリッドの確認と作業領域の確保を1回にまとめ、多数のクエリを一括処理する。
+    //   結果はoutに連結して書き込む（outの容量は呼び出し間で再利用される）。
+    //------------------------------------------------------------------------
+
+    void QueryAABBBatch(std::span<const AABB> queries, QueryBatchResult& out,
+                        uint8_t layerMask = CollisionConstants::kDefaultMask);
+
+    void QueryPointBatch(std::span<const Vector2> points, QueryBatchResult& out,
+                         uint8_t layerMask = CollisionConstants::kDefaultMask);
+
+    void QueryLineSegmentBatch(std::span<const LineSegment> segments, QueryBatchResult& out,
+                               uint8_t layerMask = CollisionConstants::kDefaultMask);
+
+    //! @brief 複数のレイキャストを一括実行
+    //! @param hits 線分毎のヒット情報（ヒットなしはcollider == nullptr）
+    void RaycastFirstBatch(std::span<const LineSegment> segments, std::vector<RaycastHit>& hits,
+                           uint8_t layerMask = CollisionConstants::kDefaultMask);
+
 private:
     CollisionManager() = default;
-    ~CollisionManager() = default;
+    ~CollisionManager();
 
     //! @brief 固定タイムステップの衝突判定（内部用）
     void FixedUpdate();
 
+    //! @brief グリッドのセル単位で衝突ペアを収集
+    void CollectPairsGrid();
+
+    //! @brief ペア収集の作業領域（スレッド毎に1つ）
+    struct PairWorkspace {
+        std::vector<ColliderPairKey> pairs;     //!< 収集したペア（並列時のみ使用）
+        CollisionSimd::CandidateBlock block;    //!< セル内コライダーの連続コピー
+        std::vector<uint32_t> hits;             //!< カーネルの出力
+    };
+
+    //! @brief 1セル内の全ペアを判定（セルをSoAに集めてブロック単位で判定）
+    void CollectPairsInCell(const ColliderIndex* indexList, size_t count,
+                            PairWorkspace& ws, std::vector<ColliderPairKey>& out) const;
+
+    //! @brief 複数スレッドでセルを分担してペアを収集
+    void CollectPairsGridParallel();
+
+    //! @brief 1スレッド分のペア収集（セルをチャンク単位で取り合う）
+    void CollectPairsWorker(uint32_t workerIndex);
+
+    //! @brief ワーカースレッドのメインループ
+    void WorkerLoop(uint32_t workerIndex);
+
+    //! @brief ワーカースレッドを停止・合流
+    void StopWorkers();
+
+    //! @brief Sweep and Pruneで衝突ペアを収集
+    void CollectPairsSweepAndPrune();
+
+    //! @brief 弾丸コライダーの掃引判定でペアを追加（衝突時刻を記録）
+    void CollectSweptPairs();
+
+    //! @brief 起きているコライダーと静止インデックスの判定、静止同士のペアの引き継ぎ
+    void CollectPairsRested();
+
+    //! @brief 変化の無いコライダーを静止インデックスへ移し、内訳を集計
+    void UpdateRestStates();
+
+    //! @brief 値の変更を記録し、静止中なら起こす
+    void Touch(ColliderIndex index);
+
+    //! @brief 前回/今回のペアを比較してEnter/Stay/Exitをイベント列に出力
+    void EmitContactEvents();
+
+    //! @brief イベント列から各コライダーのコールバックを呼ぶ（互換用）
+    //! @param first 今回のステップで出力した最初のイベント
+    void InvokeCallbacks(size_t first);
+
+    //! @brief 2つのコライダーが衝突しているか判定（レイヤー + AABB + 形状）
+    [[nodiscard]] bool TestPair(ColliderIndex a, ColliderIndex b) const noexcept;
+
+    //! @brief 形状判定用のデータを取り出す
+    [[nodiscard]] CollisionShapes::ShapeData GetShapeData(ColliderIndex i) const noexcept;
+
+    //! @brief AABBが重なったペアの形状判定（どちらかが矩形以外の場合のみ呼ぶ）
+    [[nodiscard]] bool TestShapes(ColliderIndex a, ColliderIndex b) const noexcept {
+        return CollisionShapes::Overlap(GetShapeData(a), GetShapeData(b));
+    }
+
     //------------------------------------------------------------------------
     // インデックス管理
     //------------------------------------------------------------------------
 
-    [[nodiscard]] uint16_t AllocateIndex();
-    void FreeIndex(uint16_t index);
+    //! @return 割り当てたインデックス（上限到達時はkInvalidIndex）
+    [[nodiscard]] ColliderIndex AllocateIndex();
+    void FreeIndex(ColliderIndex index);
+
+    static constexpr int kIndexBits = sizeof(ColliderIndex) * 8;
 
-    [[nodiscard]] static uint32_t MakePairKey(uint16_t a, uint16_t b) noexcept {
-        if (a > b) { uint16_t t = a; a = b; b = t; }
-        return (static_cast<uint32_t>(a) << 16) | b;
+    [[nodiscard]] static ColliderPairKey MakePairKey(ColliderIndex a, ColliderIndex b) noexcept {
+        if (a > b) { ColliderIndex t = a; a = b; b = t; }
+        return (static_cast<ColliderPairKey>(a) << kIndexBits) | b;
     }
-    [[nodiscard]] static uint16_t GetFirstIndex(uint32_t key) noexcept {
-        return static_cast<uint16_t>(key >> 16);
+    [[nodiscard]] static ColliderIndex GetFirstIndex(ColliderPairKey key) noexcept {
+        return static_cast<ColliderIndex>(key >> kIndexBits);
     }
-    [[nodiscard]] static uint16_t GetSecondIndex(uint32_t key) noexcept {
-        return static_cast<uint16_t>(key & 0xFFFF);
+    [[nodiscard]] static ColliderIndex GetSecondIndex(ColliderPairKey key) noexcept {
+        return static_cast<ColliderIndex>(key);
     }
 
     //------------------------------------------------------------------------
@@ -257,6 +541,56 @@ private:
 
     [[nodiscard]] Cell ToCell(float x, float y) const noexcept;
     void RebuildGrid();
+    void RebuildHashGrid();
+    void RebuildDenseGrid();
+
+    //! @brief 密グリッドのセル座標（範囲外は端にクランプ）
+    [[nodiscard]] Cell ToDenseCell(float x, float y) const noexcept;
+
+    //! @brief 矩形が重なるセルに登録された全インデックスを列挙（静止インデックスを含む、重複あり）
+    template<typename Fn>
+    void ForEachInCells(float minX, float minY, float maxX, float maxY, Fn&& fn) const;
+
+    //! @brief 静止インデックスを再構築（メンバーが変わった時のみ）
+    void RebuildRestGrid();
+
+    //! @brief クエリ前にグリッドが最新であることを保証
+    void EnsureGrid();
+
+    //------------------------------------------------------------------------
+    // クエリ内部処理（結果を追加のみ行う。EnsureGrid()は呼び出し側で済ませる）
+    //------------------------------------------------------------------------
+
+    //! @brief 新しい訪問スタンプを発行（一巡したら訪問配列をクリア）
+    [[nodiscard]] uint32_t NextVisitStamp();
+
+    //! @brief 矩形のセルに含まれる有効なコライダーを重複なしで列挙
+    template<typename Fn>
+    void ForEachCandidate(float minX, float minY, float maxX, float maxY, uint8_t layerMask, Fn&& fn);
+
+    //! @brief 収集したヒットをインデックス順に並べてoutへ追加
+    void FlushQueryHits(std::vector<Collider2D*>& out);
+
+    void AppendQueryAABB(const AABB& aabb, uint8_t layerMask, std::vector<Collider2D*>& out);
+    void AppendQueryPoint(const Vector2& point, uint8_t layerMask, std::vector<Collider2D*>& out);
+    void AppendQueryLineSegment(const Vector2& start, const Vector2& end, uint8_t layerMask,
+                                std::vector<Collider2D*>& out);
+    [[nodiscard]] std::optional<RaycastHit> FindFirstHit(const Vector2& start, const Vector2& end,
+                                                         uint8_t layerMask);
+
+    //------------------------------------------------------------------------
+    // Sweep and Prune
+    //------------------------------------------------------------------------
+
+    //! @brief X軸上の端点
+    struct SapEndpoint {
+        float value;
+        ColliderIndex index;
+        uint8_t isMax;      //!< 1なら最大端
+    };
+
+    //! @brief 端点値を更新し、挿入ソートで並びを修復
+    void UpdateSweepAndPrune();
 
     //------------------------------------------------------------------------
     // Structure of Arrays（SoA）- コライダーデータ
@@ -270,6 +604,7 @@ private:
     std::vector<uint8_t> layer_;        //!< レイヤー
     std::vector<uint8_t> mask_;         //!< マスク
     std::vector<uint8_t> flags_;        //!< enabled(bit0), trigger(bit1)
+    std::vector<ColliderShape> shape_;  //!< 形状（halfW/halfHは常にバウンディング）
 
     // ウォームデータ（登録時・イベント時）
     std::vector<float> offsetX_;        //!< オフセットX
@@ -277,6 +612,11 @@ private:
     std::vector<float> sizeW_;          //!< 元サイズ幅
     std::vector<float> sizeH_;          //!< 元サイズ高さ
 
+    // 形状データ（矩形以外のナローフェーズ時のみ）
+    std::vector<float> radius_;         //!< 半径（Circle/Capsule）
+    std::vector<float> axisX_;          //!< カプセル線分の半ベクトルX
+    std::vector<float> axisY_;          //!< カプセル線分の半ベクトルY
+
     // コールドデータ（イベント発火時のみ）
     std::vector<Collider2D*> colliders_;           //!< Collider2Dへの参照
     std::vector<CollisionCallback> onCollision_;
@@ -284,24 +624,88 @@ private:
     std::vector<CollisionCallback> onExit_;
 
     // 世代管理（ハンドル有効性チェック用）
-    std::vector<uint16_t> generations_;
+    std::vector<ColliderGeneration> generations_;
 
     // フリーリスト
-    std::vector<uint16_t> freeIndices_;
+    std::vector<ColliderIndex> freeIndices_;
     size_t activeCount_ = 0;
 
     // 空間ハッシュグリッド
     int cellSize_ = CollisionConstants::kDefaultCellSize;
-    std::unordered_map<Cell, std::vector<uint16_t>, CellHash> grid_;
+    std::unordered_map<Cell, std::vector<ColliderIndex>, CellHash> grid_;
+    bool gridDirty_ = true;             //!< クエリ前に再構築が必要か
+
+    // クエリの重複排除（インデックス毎の訪問スタンプ）
+    std::vector<uint32_t> visitStamp_;
+    uint32_t visitGeneration_ = 0;
+    std::vector<ColliderIndex> queryHits_;  //!< 1クエリ分のヒット（インデックス順に整列して返す）
+
+    // 密グリッド（境界付きワールド）
+    bool denseGrid_ = false;
+    float worldMinX_ = 0.0f;
+    float worldMinY_ = 0.0f;
+    float worldWidth_ = 0.0f;
+    float worldHeight_ = 0.0f;
+    int denseCols_ = 0;
+    int denseRows_ = 0;
+    std::vector<uint32_t> cellStart_;        //!< セル毎の開始オフセット（セル数 + 1）
+    std::vector<ColliderIndex> cellEntries_; //!< セル順に並べたインデックス
+    std::vector<uint32_t> cellCursor_;       //!< 構築時の書き込み位置
+
+    // ブロードフェーズ
+    BroadphaseMode broadphaseMode_ = BroadphaseMode::Grid;
+    std::vector<SapEndpoint> sapEndpoints_;  //!< X軸端点（ソート済み）
+    std::vector<ColliderIndex> sapActive_;        //!< スイープ中のアクティブ集合
+    bool sapDirty_ = true;                   //!< 登録/解除により端点の再生成が必要か
 
     // 衝突ペア（ソート済み）
-    std::vector<uint32_t> previousPairs_;
-    std::vector<uint32_t> currentPairs_;
-    std::vector<uint32_t> testedPairs_;
+    std::vector<ColliderPairKey> previousPairs_;
+    std::vector<ColliderPairKey> currentPairs_;
+
+    // 連続衝突判定（弾丸）
+    //! @brief 掃引判定で見つかったペアと衝突時刻（0〜1）
+    struct SweptHit {
+        float toi;
+        ColliderPairKey key;
+    };
+    std::vector<float> prevX_;              //!< 前ステップの位置X（弾丸のみ使用）
+    std::vector<float> prevY_;              //!< 前ステップの位置Y（弾丸のみ使用）
+    std::vector<SweptHit> sweptHits_;       //!< キー順（同一キーは最小の衝突時刻のみ）
+    std::vector<SweptHit> deferredEnters_;  //!< 衝突時刻順に出力するEnter
+    size_t bulletCount_ = 0;
+
+    // 静止/スリープ
+    std::vector<uint32_t> idleSteps_;       //!< 変化の無かった連続ステップ数
+    std::unordered_map<Cell, std::vector<ColliderIndex>, CellHash> restGrid_;  //!< 静止インデックス
+    bool restDirty_ = false;                //!< 静止インデックスの再構築が必要か
+    uint32_t sleepThreshold_ = CollisionConstants::kDefaultSleepSteps;
+    size_t awakeCount_ = 0;
+    size_t sleepingCount_ = 0;
+    size_t staticCount_ = 0;
+
+    // 接触イベント
+    std::vector<ContactEvent> contactEvents_;
+    bool callbacksEnabled_ = true;
+
+    // 並列ペア収集
+    std::vector<std::thread> workers_;
+    std::vector<PairWorkspace> workspaces_;                  //!< スレッド毎の作業領域（0は呼び出し元）
+    std::vector<const std::vector<ColliderIndex>*> hashCells_; //!< 空間ハッシュのセル一覧（分配用）
+    std::atomic<size_t> nextCellChunk_{ 0 };                 //!< 次に処理するセルチャンク
+    std::mutex workMutex_;
+    std::condition_variable workCv_;
+    std::condition_variable doneCv_;
+    uint64_t workGeneration_ = 0;   //!< 発行済みジョブ番号
+    uint32_t pendingWorkers_ = 0;   //!< 未完了ワーカー数
+    bool stopWorkers_ = false;
 
     // フラグビット定義
     static constexpr uint8_t kFlagEnabled = 0x01;
     static constexpr uint8_t kFlagTrigger = 0x02;
+    static constexpr uint8_t kFlagBullet = 0x04;
+    static constexpr uint8_t kFlagSweepReset = 0x08;  //!< 前ステップの位置が無効（登録直後など）
+    static constexpr uint8_t kFlagStatic = 0x10;      //!< 静的コライダー
+    static constexpr uint8_t kFlagRested = 0x20;      //!< 静止インデックスにいる（静的 or スリープ中）
 
     // 固定タイムステップ
     static constexpr float kFixedDeltaTime = 1.0f / 60.0f;  //!< 60Hz
@@ -0,0 +1,272 @@
+//----------------------------------------------------------------------------
+//! @file   collision_shapes.h
+//! @brief  コライダー形状と形状ペア判定（仮想関数なしのディスパッチ）
+//!
+//! @details 円はカプセルの軸長0として扱い、判定は
+//!          「矩形」と「丸め線分（円/カプセル）」の組み合わせに帰着させる。
+//!          重なり判定は接触のみ（距離0）を含まない（AABBの判定と同じ規約）。
+//----------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <utility>
+
+//============================================================================
+//! @brief コライダー形状
+//============================================================================
+enum class ColliderShape : uint8_t {
+    Box,        //!< 軸平行矩形（halfW/halfH）
+    Circle,     //!< 円（radius）
+    Capsule,    //!< カプセル（中心±axis の線分 + radius）
+};
+
+namespace CollisionShapes {
+
+//============================================================================
+//! @brief 判定用の形状データ（SoAから1コライダー分を取り出したもの）
+//============================================================================
+struct ShapeData {
+    ColliderShape shape = ColliderShape::Box;
+    float x = 0.0f;         //!< 中心X
+    float y = 0.0f;         //!< 中心Y
+    float halfW = 0.0f;     //!< 半幅（Boxのみ）
+    float halfH = 0.0f;     //!< 半高さ（Boxのみ）
+    float radius = 0.0f;    //!< 半径（Circle/Capsule）
+    float axisX = 0.0f;     //!< 線分の半ベクトルX（Capsule）
+    float axisY = 0.0f;     //!< 線分の半ベクトルY（Capsule）
+};
+
+//----------------------------------------------------------------------------
+// 距離関数
+//----------------------------------------------------------------------------
+
+//! @brief 点と線分の距離の2乗
+[[nodiscard]] inline float SegmentPointDistSq(float ax, float ay, float bx, float by,
+                                              float px, float py) noexcept
+{
+    float dx = bx - ax;
+    float dy = by - ay;
+    float lenSq = dx * dx + dy * dy;
+    float t = 0.0f;
+    if (lenSq > 1e-12f) {
+        t = ((px - ax) * dx + (py - ay) * dy) / lenSq;
+        t = (std::clamp)(t, 0.0f, 1.0f);
+    }
+    float cx = ax + dx * t - px;
+    float cy = ay + dy * t - py;
+    return cx * cx + cy * cy;
+}
+
+//! @brief 点と矩形の距離の2乗（内部なら0）
+[[nodiscard]] inline float BoxPointDistSq(float minX, float minY, float maxX, float maxY,
+                                          float px, float py) noexcept
+{
+    float dx = (std::max)({ minX - px, 0.0f, px - maxX });
+    float dy = (std::max)({ minY - py, 0.0f, py - maxY });
+    return dx * dx + dy * dy;
+}
+
+//! @brief 線分同士が交差するか（端点の接触を含む）
+[[nodiscard]] inline bool SegmentsIntersect(float ax, float ay, float bx, float by,
+                                            float cx, float cy, float dx, float dy) noexcept
+{
+    auto cross = [](float ox, float oy, float px, float py, float qx, float qy) {
+        return (px - ox) * (qy - oy) - (py - oy) * (qx - ox);
+    };
+    float d1 = cross(cx, cy, dx, dy, ax, ay);
+    float d2 = cross(cx, cy, dx, dy, bx, by);
+    float d3 = cross(ax, ay, bx, by, cx, cy);
+    float d4 = cross(ax, ay, bx, by, dx, dy);
+    return ((d1 > 0.0f && d2 < 0.0f) || (d1 < 0.0f && d2 > 0.0f)) &&
+           ((d3 > 0.0f && d4 < 0.0f) || (d3 < 0.0f && d4 > 0.0f));
+}
+
+//! @brief 線分同士の距離の2乗
+[[nodiscard]] inline float SegmentSegmentDistSq(float ax, float ay, float bx, float by,
+                                                float cx, float cy, float dx, float dy) noexcept
+{
+    if (SegmentsIntersect(ax, ay, bx, by, cx, cy, dx, dy)) return 0.0f;
+    // 交差しない2D線分の最短距離は、いずれかの端点ともう一方の線分の間に現れる
+    return (std::min)({ SegmentPointDistSq(cx, cy, dx, dy, ax, ay),
+                        SegmentPointDistSq(cx, cy, dx, dy, bx, by),
+                        SegmentPointDistSq(ax, ay, bx, by, cx, cy),
+                        SegmentPointDistSq(ax, ay, bx, by, dx, dy) });
+}
+
+//! @brief 線分と矩形の交差区間をLiang-Barskyで求める
+//! @param[out] tEnter 進入パラメータ（0〜1）
+//! @return 交差する場合true（端点が内部にある場合も含む）
+[[nodiscard]] inline bool SegmentBoxClip(float ax, float ay, float bx, float by,
+                                         float minX, float minY, float maxX, float maxY,
+                                         float& tEnter) noexcept
+{
+    float dx = bx - ax;
+    float dy = by - ay;
+    float tMin = 0.0f;
+    float tMax = 1.0f;
+
+    // X軸方向
+    if (std::abs(dx) < 1e-8f) {
+        if (ax < minX || ax > maxX) return false;
+    } else {
+        float t1 = (minX - ax) / dx;
+        float t2 = (maxX - ax) / dx;
+        if (t1 > t2) std::swap(t1, t2);
+        tMin = (std::max)(tMin, t1);
+        tMax = (std::min)(tMax, t2);
+        if (tMin > tMax) return false;
+    }
+
+    // Y軸方向
+    if (std::abs(dy) < 1e-8f) {
+        if (ay < minY || ay > maxY) return false;
+    } else {
+        float t1 = (minY - ay) / dy;
+        float t2 = (maxY - ay) / dy;
+        if (t1 > t2) std::swap(t1, t2);
+        tMin = (std::max)(tMin, t1);
+        tMax = (std::min)(tMax, t2);
+        if (tMin > tMax) return false;
+    }
+
+    tEnter = tMin;
+    return true;
+}
+
+//! @brief 線分と矩形の距離の2乗（交差していれば0）
+[[nodiscard]] inline float SegmentBoxDistSq(float ax, float ay, float bx, float by,
+                                            float minX, float minY, float maxX, float maxY) noexcept
+{
+    float t = 0.0f;
+    if (SegmentBoxClip(ax, ay, bx, by, minX, minY, maxX, maxY, t)) return 0.0f;
+    return (std::min)({ BoxPointDistSq(minX, minY, maxX, maxY, ax, ay),
+                        BoxPointDistSq(minX, minY, maxX, maxY, bx, by),
+                        SegmentPointDistSq(ax, ay, bx, by, minX, minY),
+                        SegmentPointDistSq(ax, ay, bx, by, maxX, minY),
+                        SegmentPointDistSq(ax, ay, bx, by, minX, maxY),
+                        SegmentPointDistSq(ax, ay, bx, by, maxX, maxY) });
+}
+
+//----------------------------------------------------------------------------
+// 形状ペア判定
+//----------------------------------------------------------------------------
+
+//! @brief 2形状の重なり判定（形状ペアでswitchディスパッチ）
+[[nodiscard]] inline bool Overlap(const ShapeData& a, const ShapeData& b) noexcept
+{
+    // 矩形を常に左側に寄せて組み合わせを減らす
+    if (a.shape != ColliderShape::Box && b.shape == ColliderShape::Box) {
+        return Overlap(b, a);
+    }
+
+    if (a.shape == ColliderShape::Box) {
+        float minX = a.x - a.halfW;
+        float maxX = a.x + a.halfW;
+        float minY = a.y - a.halfH;
+        float maxY = a.y + a.halfH;
+
+        switch (b.shape) {
+        case ColliderShape::Box:
+            return minX < b.x + b.halfW && maxX > b.x - b.halfW &&
+                   minY < b.y + b.halfH && maxY > b.y - b.halfH;
+        case ColliderShape::Circle:
+            return BoxPointDistSq(minX, minY, maxX, maxY, b.x, b.y) < b.radius * b.radius;
+        case ColliderShape::Capsule:
+            return SegmentBoxDistSq(b.x - b.axisX, b.y - b.axisY, b.x + b.axisX, b.y + b.axisY,
+                                    minX, minY, maxX, maxY) < b.radius * b.radius;
+        }
+        return false;
+    }
+
+    // 円/カプセル同士
+    float r = a.radius + b.radius;
+    if (a.shape == ColliderShape::Circle && b.shape == ColliderShape::Circle) {
+        float dx = a.x - b.x;
+        float dy = a.y - b.y;
+        return dx * dx + dy * dy < r * r;
+    }
+    return SegmentSegmentDistSq(a.x - a.axisX, a.y - a.axisY, a.x + a.axisX, a.y + a.axisY,
+                                b.x - b.axisX, b.y - b.axisY, b.x + b.axisX, b.y + b.axisY) < r * r;
+}
+
+//! @brief 点が形状に含まれるか（矩形は既存クエリと同じ半開区間）
+[[nodiscard]] inline bool ContainsPoint(const ShapeData& s, float px, float py) noexcept
+{
+    switch (s.shape) {
+    case ColliderShape::Box:
+        return px >= s.x - s.halfW && px < s.x + s.halfW &&
+               py >= s.y - s.halfH && py < s.y + s.halfH;
+    case ColliderShape::Circle:
+    case ColliderShape::Capsule:
+        return SegmentPointDistSq(s.x - s.axisX, s.y - s.axisY, s.x + s.axisX, s.y + s.axisY,
+                                  px, py) <= s.radius * s.radius;
+    }
+    return false;
+}
+
+//! @brief 線分と形状の最初の交差パラメータを求める
+//! @param[out] tHit 始点からの交差位置（0〜1、始点が内部なら0）
+//! @return 交差する場合true
+[[nodiscard]] inline bool RaycastShape(const ShapeData& s, float ax, float ay, float bx, float by,
+                                       float& tHit) noexcept
+{
+    if (s.shape == ColliderShape::Box) {
+        return SegmentBoxClip(ax, ay, bx, by, s.x - s.halfW, s.y - s.halfH,
+                              s.x + s.halfW, s.y + s.halfH, tHit);
+    }
+
+    float rSq = s.radius * s.radius;
+    float p0x = s.x - s.axisX, p0y = s.y - s.axisY;
+    float p1x = s.x + s.axisX, p1y = s.y + s.axisY;
+
+    if (SegmentPointDistSq(p0x, p0y, p1x, p1y, ax, ay) <= rSq) {
+        tHit = 0.0f;
+        return true;
+    }
+    if (SegmentSegmentDistSq(ax, ay, bx, by, p0x, p0y, p1x, p1y) > rSq) {
+        return false;
+    }
+
+    float dx = bx - ax;
+    float dy = by - ay;
+    float best = 2.0f;
+
+    // 両端の円との交差
+    auto circle = [&](float cx, float cy) {
+        float fx = ax - cx;
+        float fy = ay - cy;
+        float qa = dx * dx + dy * dy;
+        float qb = 2.0f * (fx * dx + fy * dy);
+        float qc = fx * fx + fy * fy - rSq;
+        float disc = qb * qb - 4.0f * qa * qc;
+        if (qa < 1e-12f || disc < 0.0f) return;
+        float t = (-qb - std::sqrt(disc)) / (2.0f * qa);
+        if (t >= 0.0f && t <= 1.0f) best = (std::min)(best, t);
+    };
+    circle(p0x, p0y);
+    if (s.shape == ColliderShape::Capsule) {
+        circle(p1x, p1y);
+
+        // 側面（線分を半径分だけ太らせた矩形）との交差をローカル座標で判定
+        float len = std::sqrt(s.axisX * s.axisX + s.axisY * s.axisY);
+        if (len > 1e-6f) {
+            float ux = s.axisX / len, uy = s.axisY / len;
+            float lax = (ax - s.x) * ux + (ay - s.y) * uy;
+            float lay = -(ax - s.x) * uy + (ay - s.y) * ux;
+            float lbx = (bx - s.x) * ux + (by - s.y) * uy;
+            float lby = -(bx - s.x) * uy + (by - s.y) * ux;
+            float t = 0.0f;
+            if (SegmentBoxClip(lax, lay, lbx, lby, -len, -s.radius, len, s.radius, t)) {
+                best = (std::min)(best, t);
+            }
+        }
+    }
+
+    if (best > 1.0f) return false;
+    tHit = best;
+    return true;
+}
+
+} // namespace CollisionShapes
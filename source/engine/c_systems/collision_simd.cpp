@@ -0,0 +1,177 @@
+//----------------------------------------------------------------------------
+//! @file   collision_simd.cpp
+//! @brief  AABB重なり判定カーネル実装
+//----------------------------------------------------------------------------
+
+#include "collision_simd.h"
+
+#if COLLISION_SIMD
+#include <immintrin.h>
+#endif
+
+namespace CollisionSimd {
+
+namespace {
+
+//! 1候補分の判定（スカラー実装とSIMDの端数処理で共用）
+[[nodiscard]] inline bool OverlapOne(const Probe& p, const CandidateBlock& b, size_t j) noexcept
+{
+    if ((b.flags[j] & kFlagEnabled) == 0) return false;
+    if ((p.mask & b.layer[j]) == 0 && (b.mask[j] & p.layer) == 0) return false;
+
+    float minAX = p.posX - p.halfW;
+    float maxAX = p.posX + p.halfW;
+    float minAY = p.posY - p.halfH;
+    float maxAY = p.posY + p.halfH;
+
+    float minBX = b.posX[j] - b.halfW[j];
+    float maxBX = b.posX[j] + b.halfW[j];
+    float minBY = b.posY[j] - b.halfH[j];
+    float maxBY = b.posY[j] + b.halfH[j];
+
+    return minAX < maxBX && maxAX > minBX &&
+           minAY < maxBY && maxAY > minBY;
+}
+
+#if COLLISION_SIMD
+//! ビットマスクの立っているレーンを出力
+inline size_t EmitLanes(uint32_t bits, size_t base, uint32_t* out, size_t n) noexcept
+{
+    while (bits) {
+        uint32_t lane = 0;
+        while ((bits & (1u << lane)) == 0) ++lane;
+        out[n++] = static_cast<uint32_t>(base + lane);
+        bits &= bits - 1;
+    }
+    return n;
+}
+#endif
+
+} // namespace
+
+size_t GetLaneWidth() noexcept
+{
+#if COLLISION_SIMD && defined(__AVX2__)
+    return 8;
+#elif COLLISION_SIMD
+    return 4;
+#else
+    return 1;
+#endif
+}
+
+size_t OverlapBlockScalar(const Probe& probe, const CandidateBlock& block,
+                          size_t begin, size_t end, uint32_t* out) noexcept
+{
+    size_t n = 0;
+    for (size_t j = begin; j < end; ++j) {
+        if (OverlapOne(probe, block, j)) {
+            out[n++] = static_cast<uint32_t>(j);
+        }
+    }
+    return n;
+}
+
+#if COLLISION_SIMD
+
+#if defined(__AVX2__)
+
+size_t OverlapBlockSimd(const Probe& probe, const CandidateBlock& block,
+                        size_t begin, size_t end, uint32_t* out) noexcept
+{
+    const __m256 minAX = _mm256_set1_ps(probe.posX - probe.halfW);
+    const __m256 maxAX = _mm256_set1_ps(probe.posX + probe.halfW);
+    const __m256 minAY = _mm256_set1_ps(probe.posY - probe.halfH);
+    const __m256 maxAY = _mm256_set1_ps(probe.posY + probe.halfH);
+    const __m256i layerA = _mm256_set1_epi32(static_cast<int>(probe.layer));
+    const __m256i maskA = _mm256_set1_epi32(static_cast<int>(probe.mask));
+    const __m256i enabled = _mm256_set1_epi32(static_cast<int>(kFlagEnabled));
+    const __m256i zero = _mm256_setzero_si256();
+
+    size_t n = 0;
+    size_t j = begin;
+    for (; j + 8 <= end; j += 8) {
+        __m256 bx = _mm256_loadu_ps(&block.posX[j]);
+        __m256 by = _mm256_loadu_ps(&block.posY[j]);
+        __m256 bw = _mm256_loadu_ps(&block.halfW[j]);
+        __m256 bh = _mm256_loadu_ps(&block.halfH[j]);
+
+        __m256 hit = _mm256_and_ps(
+            _mm256_and_ps(_mm256_cmp_ps(minAX, _mm256_add_ps(bx, bw), _CMP_LT_OQ),
+                          _mm256_cmp_ps(maxAX, _mm256_sub_ps(bx, bw), _CMP_GT_OQ)),
+            _mm256_and_ps(_mm256_cmp_ps(minAY, _mm256_add_ps(by, bh), _CMP_LT_OQ),
+                          _mm256_cmp_ps(maxAY, _mm256_sub_ps(by, bh), _CMP_GT_OQ)));
+
+        __m256i layerB = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&block.layer[j]));
+        __m256i maskB = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&block.mask[j]));
+        __m256i flagsB = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&block.flags[j]));
+
+        __m256i layerHit = _mm256_or_si256(_mm256_and_si256(maskA, layerB), _mm256_and_si256(maskB, layerA));
+        __m256i reject = _mm256_or_si256(_mm256_cmpeq_epi32(layerHit, zero),
+                                         _mm256_cmpeq_epi32(_mm256_and_si256(flagsB, enabled), zero));
+
+        uint32_t bits = static_cast<uint32_t>(_mm256_movemask_ps(hit)) &
+                        ~static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(reject)));
+        n = EmitLanes(bits, j, out, n);
+    }
+
+    // 端数はスカラーで処理
+    for (; j < end; ++j) {
+        if (OverlapOne(probe, block, j)) out[n++] = static_cast<uint32_t>(j);
+    }
+    return n;
+}
+
+#else
+
+size_t OverlapBlockSimd(const Probe& probe, const CandidateBlock& block,
+                        size_t begin, size_t end, uint32_t* out) noexcept
+{
+    const __m128 minAX = _mm_set1_ps(probe.posX - probe.halfW);
+    const __m128 maxAX = _mm_set1_ps(probe.posX + probe.halfW);
+    const __m128 minAY = _mm_set1_ps(probe.posY - probe.halfH);
+    const __m128 maxAY = _mm_set1_ps(probe.posY + probe.halfH);
+    const __m128i layerA = _mm_set1_epi32(static_cast<int>(probe.layer));
+    const __m128i maskA = _mm_set1_epi32(static_cast<int>(probe.mask));
+    const __m128i enabled = _mm_set1_epi32(static_cast<int>(kFlagEnabled));
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t n = 0;
+    size_t j = begin;
+    for (; j + 4 <= end; j += 4) {
+        __m128 bx = _mm_loadu_ps(&block.posX[j]);
+        __m128 by = _mm_loadu_ps(&block.posY[j]);
+        __m128 bw = _mm_loadu_ps(&block.halfW[j]);
+        __m128 bh = _mm_loadu_ps(&block.halfH[j]);
+
+        __m128 hit = _mm_and_ps(
+            _mm_and_ps(_mm_cmplt_ps(minAX, _mm_add_ps(bx, bw)),
+                       _mm_cmpgt_ps(maxAX, _mm_sub_ps(bx, bw))),
+            _mm_and_ps(_mm_cmplt_ps(minAY, _mm_add_ps(by, bh)),
+                       _mm_cmpgt_ps(maxAY, _mm_sub_ps(by, bh))));
+
+        __m128i layerB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&block.layer[j]));
+        __m128i maskB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&block.mask[j]));
+        __m128i flagsB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&block.flags[j]));
+
+        __m128i layerHit = _mm_or_si128(_mm_and_si128(maskA, layerB), _mm_and_si128(maskB, layerA));
+        __m128i reject = _mm_or_si128(_mm_cmpeq_epi32(layerHit, zero),
+                                      _mm_cmpeq_epi32(_mm_and_si128(flagsB, enabled), zero));
+
+        uint32_t bits = static_cast<uint32_t>(_mm_movemask_ps(hit)) &
+                        ~static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(reject)));
+        n = EmitLanes(bits, j, out, n);
+    }
+
+    // 端数はスカラーで処理
+    for (; j < end; ++j) {
+        if (OverlapOne(probe, block, j)) out[n++] = static_cast<uint32_t>(j);
+    }
+    return n;
+}
+
+#endif // __AVX2__
+
+#endif // COLLISION_SIMD
+
+} // namespace CollisionSimd
@@ -0,0 +1,100 @@
+//----------------------------------------------------------------------------
+//! @file   collision_simd.h
+//! @brief  AABB重なり判定カーネル（SIMD / スカラー）
+//!
+//! @details 1つのコライダーと、SoAで連続配置した候補ブロックを一括判定する。
+//!          レイヤー/マスクと有効フラグのフィルタも同じカーネル内で行う。
+//!          実装はビルド時にCOLLISION_SIMDで選択する。
+//----------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//! @def COLLISION_SIMD
+//! 1でSSE2（AVX2有効時は8幅）カーネルを使用、0でスカラー実装のみ。
+//! 未定義の場合はターゲットの命令セットから自動判定する。
+#ifndef COLLISION_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLLISION_SIMD 1
+#else
+#define COLLISION_SIMD 0
+#endif
+#endif
+
+namespace CollisionSimd {
+
+//! @brief 有効フラグ（CollisionManagerのkFlagEnabledと同値）
+constexpr uint32_t kFlagEnabled = 0x01;
+
+//============================================================================
+//! @brief 判定元のコライダー
+//============================================================================
+struct Probe {
+    float posX = 0.0f;
+    float posY = 0.0f;
+    float halfW = 0.0f;
+    float halfH = 0.0f;
+    uint32_t layer = 0;
+    uint32_t mask = 0;
+};
+
+//============================================================================
+//! @brief 候補ブロック（セル内のコライダーを連続配置したSoA）
+//!
+//! レイヤー/マスク/フラグはSIMDの整数演算で扱えるよう32bitに広げて保持する。
+//============================================================================
+struct CandidateBlock {
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<float> halfW;
+    std::vector<float> halfH;
+    std::vector<uint32_t> layer;
+    std::vector<uint32_t> mask;
+    std::vector<uint32_t> flags;
+
+    void Resize(size_t count) {
+        posX.resize(count);
+        posY.resize(count);
+        halfW.resize(count);
+        halfH.resize(count);
+        layer.resize(count);
+        mask.resize(count);
+        flags.resize(count);
+    }
+
+    [[nodiscard]] size_t Size() const noexcept { return posX.size(); }
+};
+
+//! @brief SIMDカーネルの幅（スカラー実装では1）
+[[nodiscard]] size_t GetLaneWidth() noexcept;
+
+//! @brief スカラー実装
+//! @param probe 判定元
+//! @param block 候補ブロック
+//! @param begin 判定開始位置
+//! @param end 判定終了位置（含まない）
+//! @param out 重なった候補のブロック内位置（end - begin 要素以上確保すること）
+//! @return 重なった候補の数
+size_t OverlapBlockScalar(const Probe& probe, const CandidateBlock& block,
+                          size_t begin, size_t end, uint32_t* out) noexcept;
+
+#if COLLISION_SIMD
+//! @brief SIMD実装（引数と結果はスカラー実装と同一）
+size_t OverlapBlockSimd(const Probe& probe, const CandidateBlock& block,
+                        size_t begin, size_t end, uint32_t* out) noexcept;
+#endif
+
+//! @brief ビルド設定で選択された実装
+inline size_t OverlapBlock(const Probe& probe, const CandidateBlock& block,
+                           size_t begin, size_t end, uint32_t* out) noexcept
+{
+#if COLLISION_SIMD
+    return OverlapBlockSimd(probe, block, begin, end, out);
+#else
+    return OverlapBlockScalar(probe, block, begin, end, out);
+#endif
+}
+
+} // namespace CollisionSimd
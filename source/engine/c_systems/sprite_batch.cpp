@@ -12,6 +12,7 @@
 #include "engine/shader/shader_manager.h"
 #include "common/logging/logging.h"
 #include <algorithm>
+#include <cassert>
 
 //============================================================================
 // SpriteBatch 実装
@@ -27,35 +28,10 @@ bool SpriteBatch::Initialize() {
         return false;
     }
 
-    // 頂点バッファ（動的）
-    vertexBuffer_ = Buffer::CreateVertex(
-        sizeof(SpriteVertex) * 4 * MaxSpritesPerBatch,
-        sizeof(SpriteVertex),
-        true  // dynamic
-    );
-    if (!vertexBuffer_) {
-        LOG_ERROR("SpriteBatch: 頂点バッファ作成失敗");
-        return false;
-    }
-
-    // インデックスバッファ（静的）
-    std::vector<uint16_t> indices(6 * MaxSpritesPerBatch);
-    for (uint32_t i = 0; i < MaxSpritesPerBatch; ++i) {
-        uint16_t baseVertex = static_cast<uint16_t>(i * 4);
-        indices[i * 6 + 0] = baseVertex + 0;
-        indices[i * 6 + 1] = baseVertex + 1;
-        indices[i * 6 + 2] = baseVertex + 2;
-        indices[i * 6 + 3] = baseVertex + 2;
-        indices[i * 6 + 4] = baseVertex + 1;
-        indices[i * 6 + 5] = baseVertex + 3;
-    }
-    indexBuffer_ = Buffer::CreateIndex(
-        static_cast<uint32_t>(sizeof(uint16_t) * indices.size()),
-        false,  // not dynamic
-        indices.data()
-    );
-    if (!indexBuffer_) {
-        LOG_ERROR("SpriteBatch: インデックスバッファ作成失敗");
+    // 頂点/インデックスバッファ（必要に応じてEnd()で拡張）
+    // インスタンスバッファはインスタンスモードで最初に描画するときに作る
+    if (!CreateBatchBuffers(SpriteRing::kInitialCapacity)) {
+        LOG_ERROR("SpriteBatch: バッチ用バッファ作成失敗");
         return false;
     }
 
@@ -72,8 +48,9 @@ bool SpriteBatch::Initialize() {
         return false;
     }
 
-    spriteQueue_.reserve(MaxSpritesPerBatch);
-    sortIndices_.reserve(MaxSpritesPerBatch);
+    spriteQueue_.reserve(SpriteRing::kInitialCapacity);
+    sortKeys_.reserve(SpriteRing::kInitialCapacity);
+    sortScratch_.reserve(SpriteRing::kInitialCapacity);
     initialized_ = true;
     LOG_INFO("SpriteBatch: 初期化完了");
     return true;
@@ -111,9 +88,165 @@ bool SpriteBatch::CreateShaders() {
         return false;
     }
 
+    CreateInstancedShader();
     return true;
 }
 
+void SpriteBatch::CreateInstancedShader() {
+    auto& shaderMgr = ShaderManager::Get();
+
+    // 同じシェーダーをインスタンス入力版としてコンパイル
+    instanceVertexShader_ = shaderMgr.LoadVertexShader("sprite_vs.hlsl", { ShaderDefine("SPRITE_INSTANCED") });
+    if (!instanceVertexShader_) {
+        LOG_WARN("SpriteBatch: インスタンス描画用シェーダーのロードに失敗（頂点モードのみ使用可能）");
+        return;
+    }
+
+    // SpriteGeometry::SpriteInstanceと同じ配置
+    D3D11_INPUT_ELEMENT_DESC inputElements[] = {
+        { "POSITION", 0, DXGI_FORMAT_R32G32_FLOAT,       0, 0,  D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "TEXCOORD", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 8,  D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "TEXCOORD", 2, DXGI_FORMAT_R32G32_FLOAT,       0, 24, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "TEXCOORD", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 32, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "COLOR",    0, DXGI_FORMAT_R8G8B8A8_UNORM,     0, 48, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+    };
+
+    instanceInputLayout_ = shaderMgr.CreateInputLayout(
+        instanceVertexShader_.get(),
+        inputElements,
+        _countof(inputElements)
+    );
+    if (!instanceInputLayout_) {
+        LOG_WARN("SpriteBatch: インスタンス入力レイアウト作成失敗（頂点モードのみ使用可能）");
+        instanceVertexShader_.reset();
+    }
+}
+
+bool SpriteBatch::CreateBatchBuffers(uint32_t capacity) {
+    // 全て作成できた場合のみ差し替える（失敗時は現在のバッファを維持）
+    BufferPtr vertexBuffer = Buffer::CreateVertex(
+        static_cast<uint32_t>(sizeof(SpriteVertex) * 4 * capacity),
+        sizeof(SpriteVertex),
+        true  // dynamic
+    );
+    if (!vertexBuffer) {
+        LOG_ERROR("SpriteBatch: 頂点バッファ作成失敗");
+        return false;
+    }
+
+    // インデックスは静的ブロック用に先に大きくなっている場合がある
+    BufferPtr indexBuffer;
+    if (capacity > indexCapacity_) {
+        indexBuffer = CreateQuadIndexBuffer(capacity);
+        if (!indexBuffer) {
+            return false;
+        }
+        indexBuffer_ = std::move(indexBuffer);
+        indexCapacity_ = capacity;
+    }
+
+    vertexBuffer_ = std::move(vertexBuffer);
+    capacity_ = capacity;
+    vertexRing_.Reset(capacity);
+    return true;
+}
+
+BufferPtr SpriteBatch::CreateQuadIndexBuffer(uint32_t capacity) {
+    // インデックスバッファ（静的、32bit）
+    std::vector<uint32_t> indices(static_cast<size_t>(6) * capacity);
+    for (uint32_t i = 0; i < capacity; ++i) {
+        uint32_t baseVertex = i * 4;
+        indices[i * 6 + 0] = baseVertex + 0;
+        indices[i * 6 + 1] = baseVertex + 1;
+        indices[i * 6 + 2] = baseVertex + 2;
+        indices[i * 6 + 3] = baseVertex + 2;
+        indices[i * 6 + 4] = baseVertex + 1;
+        indices[i * 6 + 5] = baseVertex + 3;
+    }
+    BufferPtr indexBuffer = Buffer::CreateIndex(
+        static_cast<uint32_t>(sizeof(uint32_t) * indices.size()),
+        false,  // not dynamic
+        indices.data()
+    );
+    if (!indexBuffer) {
+        LOG_ERROR("SpriteBatch: インデックスバッファ作成失敗");
+    }
+    return indexBuffer;
+}
+
+void SpriteBatch::EnsureCapacity(uint32_t spriteCount) {
+    const uint32_t newCapacity = SpriteRing::GrowCapacity(capacity_, spriteCount);
+    if (newCapacity == capacity_) {
+        return;
+    }
+
+    if (CreateBatchBuffers(newCapacity)) {
+        ++growCount_;
+        LOG_INFO("SpriteBatch: バッファを拡張 (" + std::to_string(newCapacity) + " sprites)");
+    } else {
+        // 拡張できなければ現在の容量で分割して転送する
+        LOG_WARN("SpriteBatch: バッファ拡張に失敗（分割して転送します）");
+    }
+}
+
+void SpriteBatch::EnsureIndexCapacity(uint32_t spriteCount) {
+    const uint32_t newCapacity = SpriteRing::GrowCapacity(indexCapacity_, spriteCount);
+    if (newCapacity == indexCapacity_) {
+        return;
+    }
+
+    // 動的バッファには触れない（静的ブロックはインデックスだけを共有する）
+    if (BufferPtr indexBuffer = CreateQuadIndexBuffer(newCapacity)) {
+        indexBuffer_ = std::move(indexBuffer);
+        indexCapacity_ = newCapacity;
+        ++growCount_;
+        LOG_INFO("SpriteBatch: インデックスバッファを拡張 (" + std::to_string(newCapacity) + " sprites)");
+    }
+}
+
+void SpriteBatch::EnsureInstanceCapacity(uint32_t spriteCount) {
+    // 初回は初期容量で作成（頂点/遅延モードだけなら作らない）
+    const uint32_t newCapacity = instanceBuffer_
+        ? SpriteRing::GrowCapacity(instanceCapacity_, spriteCount)
+        : SpriteRing::GrowCapacity(SpriteRing::kInitialCapacity, spriteCount);
+    if (instanceBuffer_ && newCapacity == instanceCapacity_) {
+        return;
+    }
+
+    BufferPtr instanceBuffer = Buffer::CreateVertex(
+        static_cast<uint32_t>(sizeof(SpriteInstance) * newCapacity),
+        sizeof(SpriteInstance),
+        true  // dynamic
+    );
+    if (!instanceBuffer) {
+        // 既存のバッファがあれば現在の容量で分割して転送する
+        LOG_WARN("SpriteBatch: インスタンスバッファ作成失敗");
+        return;
+    }
+
+    if (instanceBuffer_) {
+        ++growCount_;
+        LOG_INFO("SpriteBatch: インスタンスバッファを拡張 (" + std::to_string(newCapacity) + " sprites)");
+    }
+    instanceBuffer_ = std::move(instanceBuffer);
+    instanceCapacity_ = newCapacity;
+    instanceRing_.Reset(newCapacity);
+}
+
+void* SpriteBatch::MapRing(Buffer* buffer, SpriteRing::Cursor& ring, uint32_t elementSize,
+                           uint32_t count, uint32_t& outFirst) {
+    const auto alloc = ring.Allocate(count);
+    void* data = Commands().BeginWrite(
+        buffer, alloc.discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE,
+        alloc.first * elementSize, count * elementSize);
+    if (!data) {
+        return nullptr;
+    }
+    ++mapCount_;
+    outFirst = alloc.first;
+    return data;
+}
+
 void SpriteBatch::Shutdown() {
     if (!initialized_) return;
 
@@ -135,22 +268,38 @@ void SpriteBatch::Shutdown() {
         UINT strides[1] = { 0 };
         UINT offsets[1] = { 0 };
         d3dCtx->IASetVertexBuffers(0, 1, nullBuffers, strides, offsets);
-        d3dCtx->IASetIndexBuffer(nullptr, DXGI_FORMAT_R16_UINT, 0);
+        d3dCtx->IASetIndexBuffer(nullptr, DXGI_FORMAT_R32_UINT, 0);
         ID3D11Buffer* nullCB[1] = { nullptr };
         d3dCtx->VSSetConstantBuffers(0, 1, nullCB);
         ID3D11ShaderResourceView* nullSRV[1] = { nullptr };
         d3dCtx->PSSetShaderResources(0, 1, nullSRV);
         d3dCtx->Flush();
+        ctx.InvalidateStateCache();
     }
 
     vertexBuffer_.reset();
     indexBuffer_.reset();
+    instanceBuffer_.reset();
+    instanceCapacity_ = 0;
+    instanceVertexShader_.reset();
+    instanceInputLayout_.Reset();
     constantBuffer_.reset();
     vertexShader_.reset();
     pixelShader_.reset();
     inputLayout_.Reset();
     spriteQueue_.clear();
-    sortIndices_.clear();
+    paramQueue_.clear();
+    batches_.clear();
+    sortKeys_.clear();
+    sortScratch_.clear();
+    capacity_ = 0;
+    indexCapacity_ = 0;
+    textureSortIds_.clear();
+    staticBlocks_.clear();
+    staticDraws_.clear();
+    staticKeys_.clear();
+    staticParams_.clear();
+    recordingStatic_ = false;
 
     initialized_ = false;
     LOG_INFO("SpriteBatch: シャットダウン完了");
@@ -158,10 +307,24 @@ void SpriteBatch::Shutdown() {
 
 void SpriteBatch::SetCamera(Camera2D& camera) {
     cbufferData_.viewProjection = camera.GetViewProjectionMatrix();
+
+    // カリング用の表示範囲（回転を含めて囲むAABB）
+    const float zoom = camera.GetZoom();
+    const float invZoom = zoom > 0.0f ? 1.0f / zoom : 1.0f;
+    const Vector2 center = camera.GetPosition();
+    viewRect_ = SpriteGeometry::MakeViewRect(
+        center.x, center.y,
+        camera.GetViewportWidth() * 0.5f * invZoom,
+        camera.GetViewportHeight() * 0.5f * invZoom,
+        camera.GetRotation());
+    hasViewRect_ = true;
 }
 
 void SpriteBatch::SetViewProjection(const Matrix& viewProjection) {
     cbufferData_.viewProjection = viewProjection;
+
+    // 表示範囲が分からないためカリングしない
+    hasViewRect_ = false;
 }
 
 void SpriteBatch::Begin() {
@@ -173,10 +336,24 @@ void SpriteBatch::Begin() {
         LOG_WARN("SpriteBatch: 既にBegin()が呼ばれています");
         return;
     }
+    if (recordingStatic_) {
+        LOG_WARN("SpriteBatch: 静的ブロックの記録中です（EndStatic()を先に呼んでください）");
+        return;
+    }
 
     spriteQueue_.clear();
+    paramQueue_.clear();
+    sortKeys_.clear();
+    textureSortIds_.clear();
+    lastSortTexture_ = nullptr;
+    lastSortTextureId_ = 0;
     drawCallCount_ = 0;
     spriteCount_ = 0;
+    mapCount_ = 0;
+    culledCount_ = 0;
+    submittedCount_ = 0;
+    staticSpriteCount_ = 0;
+    staticDraws_.clear();
     isBegun_ = true;
 }
 
@@ -192,7 +369,7 @@ void SpriteBatch::Draw(
     int sortingLayer,
     int orderInLayer)
 {
-    if (!isBegun_) {
+    if (!isBegun_ && !recordingStatic_) {
         LOG_WARN("SpriteBatch: Begin()が呼ばれていません");
         return;
     }
@@ -204,56 +381,38 @@ void SpriteBatch::Draw(
     float texWidth = static_cast<float>(texture->Width());
     float texHeight = static_cast<float>(texture->Height());
 
+    SpriteParams params;
+    params.texture = texture;
+    params.posX = position.x;
+    params.posY = position.y;
+
     // UV座標（テクスチャ全体を使用）
-    float u0 = 0.0f;
-    float v0 = 0.0f;
-    float u1 = 1.0f;
-    float v1 = 1.0f;
+    params.u0 = 0.0f;
+    params.v0 = 0.0f;
+    params.u1 = 1.0f;
+    params.v1 = 1.0f;
 
     // 反転
-    if (flipX) std::swap(u0, u1);
-    if (flipY) std::swap(v0, v1);
+    if (flipX) std::swap(params.u0, params.u1);
+    if (flipY) std::swap(params.v0, params.v1);
 
     // スプライトサイズ
     float width = texWidth * scale.x;
     float height = texHeight * scale.y;
 
-    // 4頂点の計算（原点を考慮）
-    float x0 = -origin.x * scale.x;
-    float y0 = -origin.y * scale.y;
-    float x1 = x0 + width;
-    float y1 = y0 + height;
+    // 4頂点の矩形（原点を考慮）
+    params.x0 = -origin.x * scale.x;
+    params.y0 = -origin.y * scale.y;
+    params.x1 = params.x0 + width;
+    params.y1 = params.y0 + height;
 
-    // 回転行列
-    float cosR = std::cos(rotation);
-    float sinR = std::sin(rotation);
-
-    auto rotatePoint = [&](float x, float y) -> Vector2 {
-        return Vector2(
-            x * cosR - y * sinR + position.x,
-            x * sinR + y * cosR + position.y
-        );
-    };
-
-    SpriteInfo info;
-    info.texture = texture;
-    info.sortingLayer = sortingLayer;
-    info.orderInLayer = orderInLayer;
-
-    Vector2 p0 = rotatePoint(x0, y0);
-    Vector2 p1 = rotatePoint(x1, y0);
-    Vector2 p2 = rotatePoint(x0, y1);
-    Vector2 p3 = rotatePoint(x1, y1);
+    params.rotation = rotation;
+    params.color = color;
 
     // sortingLayer/orderInLayerから深度値を計算
-    float z = CalculateDepth(sortingLayer, orderInLayer);
+    params.depth = CalculateDepth(sortingLayer, orderInLayer);
 
-    info.vertices[0] = { Vector3(p0.x, p0.y, z), Vector2(u0, v0), color };
-    info.vertices[1] = { Vector3(p1.x, p1.y, z), Vector2(u1, v0), color };
-    info.vertices[2] = { Vector3(p2.x, p2.y, z), Vector2(u0, v1), color };
-    info.vertices[3] = { Vector3(p3.x, p3.y, z), Vector2(u1, v1), color };
-
-    spriteQueue_.push_back(info);
+    Enqueue(params, sortingLayer, orderInLayer);
 }
 
 void SpriteBatch::Draw(
@@ -269,7 +428,7 @@ void SpriteBatch::Draw(
     int sortingLayer,
     int orderInLayer)
 {
-    if (!isBegun_) {
+    if (!isBegun_ && !recordingStatic_) {
         LOG_WARN("SpriteBatch: Begin()が呼ばれていません");
         return;
     }
@@ -284,60 +443,42 @@ void SpriteBatch::Draw(
         return;
     }
 
+    SpriteParams params;
+    params.texture = texture;
+    params.posX = position.x;
+    params.posY = position.y;
+
     // ソース矩形からUV座標を計算（ピクセル→正規化）
-    float u0 = sourceRect.x / texWidth;
-    float v0 = sourceRect.y / texHeight;
-    float u1 = (sourceRect.x + sourceRect.z) / texWidth;
-    float v1 = (sourceRect.y + sourceRect.w) / texHeight;
+    params.u0 = sourceRect.x / texWidth;
+    params.v0 = sourceRect.y / texHeight;
+    params.u1 = (sourceRect.x + sourceRect.z) / texWidth;
+    params.v1 = (sourceRect.y + sourceRect.w) / texHeight;
 
     // 反転
-    if (flipX) std::swap(u0, u1);
-    if (flipY) std::swap(v0, v1);
+    if (flipX) std::swap(params.u0, params.u1);
+    if (flipY) std::swap(params.v0, params.v1);
 
     // スプライトサイズ（ソース矩形のサイズを使用）
     float width = sourceRect.z * scale.x;
     float height = sourceRect.w * scale.y;
 
-    // 4頂点の計算（原点を考慮）
-    float x0 = -origin.x * scale.x;
-    float y0 = -origin.y * scale.y;
-    float x1 = x0 + width;
-    float y1 = y0 + height;
+    // 4頂点の矩形（原点を考慮）
+    params.x0 = -origin.x * scale.x;
+    params.y0 = -origin.y * scale.y;
+    params.x1 = params.x0 + width;
+    params.y1 = params.y0 + height;
 
-    // 回転行列
-    float cosR = std::cos(rotation);
-    float sinR = std::sin(rotation);
-
-    auto rotatePoint = [&](float x, float y) -> Vector2 {
-        return Vector2(
-            x * cosR - y * sinR + position.x,
-            x * sinR + y * cosR + position.y
-        );
-    };
-
-    SpriteInfo info;
-    info.texture = texture;
-    info.sortingLayer = sortingLayer;
-    info.orderInLayer = orderInLayer;
-
-    Vector2 p0 = rotatePoint(x0, y0);
-    Vector2 p1 = rotatePoint(x1, y0);
-    Vector2 p2 = rotatePoint(x0, y1);
-    Vector2 p3 = rotatePoint(x1, y1);
+    params.rotation = rotation;
+    params.color = color;
 
     // sortingLayer/orderInLayerから深度値を計算
-    float z = CalculateDepth(sortingLayer, orderInLayer);
-
-    info.vertices[0] = { Vector3(p0.x, p0.y, z), Vector2(u0, v0), color };
-    info.vertices[1] = { Vector3(p1.x, p1.y, z), Vector2(u1, v0), color };
-    info.vertices[2] = { Vector3(p2.x, p2.y, z), Vector2(u0, v1), color };
-    info.vertices[3] = { Vector3(p3.x, p3.y, z), Vector2(u1, v1), color };
+    params.depth = CalculateDepth(sortingLayer, orderInLayer);
 
-    spriteQueue_.push_back(info);
+    Enqueue(params, sortingLayer, orderInLayer);
 }
 
 void SpriteBatch::Draw(const SpriteRenderer& renderer, const Transform2D& transform) {
-    if (!isBegun_ || !renderer.GetTexture()) {
+    if ((!isBegun_ && !recordingStatic_) || !renderer.GetTexture()) {
         return;
     }
 
@@ -360,6 +501,15 @@ void SpriteBatch::Draw(const SpriteRenderer& renderer, const Transform2D& transf
     // SpriteRendererのpivotを使用（なければ左上原点）
     Vector2 pivot = renderer.GetPivot();
 
+    // アトラス上の領域はソース矩形として描画
+    if (renderer.HasRegion()) {
+        Draw(texture, position, renderer.GetSourceRect(), renderer.GetColor(),
+             rotation, pivot, scale,
+             renderer.IsFlipX(), renderer.IsFlipY(),
+             renderer.GetSortingLayer(), renderer.GetOrderInLayer());
+        return;
+    }
+
     Draw(texture, position, renderer.GetColor(),
          rotation, pivot, scale,
          renderer.IsFlipX(), renderer.IsFlipY(),
@@ -367,7 +517,7 @@ void SpriteBatch::Draw(const SpriteRenderer& renderer, const Transform2D& transf
 }
 
 void SpriteBatch::Draw(const SpriteRenderer& renderer, const Transform2D& transform, const Animator& animator) {
-    if (!isBegun_ || !renderer.GetTexture()) {
+    if ((!isBegun_ && !recordingStatic_) || !renderer.GetTexture()) {
         return;
     }
 
@@ -377,9 +527,23 @@ void SpriteBatch::Draw(const SpriteRenderer& renderer, const Transform2D& transf
     Vector2 uvCoord = animator.GetUVCoord();
     Vector2 uvSize = animator.GetUVSize();
 
-    // フレームサイズ（テクスチャサイズ * UVサイズ）
-    float frameWidth = static_cast<float>(texture->Width()) * std::abs(uvSize.x);
-    float frameHeight = static_cast<float>(texture->Height()) * std::abs(uvSize.y);
+    // シート全体の大きさ（アトラス上の領域があればその大きさ）
+    const bool hasRegion = renderer.HasRegion();
+    const Vector4& src = renderer.GetSourceRect();
+    float sheetWidth = hasRegion ? src.z : static_cast<float>(texture->Width());
+    float sheetHeight = hasRegion ? src.w : static_cast<float>(texture->Height());
+
+    // フレームサイズ（シートサイズ * UVサイズ）
+    float frameWidth = sheetWidth * std::abs(uvSize.x);
+    float frameHeight = sheetHeight * std::abs(uvSize.y);
+
+    // シート内UVをアトラスページ上のUVへ変換
+    if (hasRegion) {
+        const float invW = 1.0f / static_cast<float>(texture->Width());
+        const float invH = 1.0f / static_cast<float>(texture->Height());
+        uvCoord = Vector2((src.x + uvCoord.x * src.z) * invW, (src.y + uvCoord.y * src.w) * invH);
+        uvSize = Vector2(uvSize.x * src.z * invW, uvSize.y * src.w * invH);
+    }
 
     // Transform2Dからパラメータ取得
     Vector2 position = transform.GetPosition();
@@ -401,56 +565,41 @@ void SpriteBatch::Draw(const SpriteRenderer& renderer, const Transform2D& transf
         origin = Vector2(frameWidth * 0.5f, frameHeight * 0.5f);
     }
 
+    SpriteParams params;
+    params.texture = texture;
+    params.posX = position.x;
+    params.posY = position.y;
+
     // スプライトサイズ
     float width = frameWidth * scale.x;
     float height = frameHeight * scale.y;
 
-    // 4頂点の計算（原点を考慮）
-    float x0 = -origin.x * scale.x;
-    float y0 = -origin.y * scale.y;
-    float x1 = x0 + width;
-    float y1 = y0 + height;
-
-    // 回転行列
-    float cosR = std::cos(rotation);
-    float sinR = std::sin(rotation);
-
-    auto rotatePoint = [&](float x, float y) -> Vector2 {
-        return Vector2(
-            x * cosR - y * sinR + position.x,
-            x * sinR + y * cosR + position.y
-        );
-    };
+    // 4頂点の矩形（原点を考慮）
+    params.x0 = -origin.x * scale.x;
+    params.y0 = -origin.y * scale.y;
+    params.x1 = params.x0 + width;
+    params.y1 = params.y0 + height;
 
     // UV座標（反転考慮）
-    float u0 = uvCoord.x;
-    float v0 = uvCoord.y;
-    float u1 = uvCoord.x + uvSize.x;
-    float v1 = uvCoord.y + uvSize.y;
+    params.u0 = uvCoord.x;
+    params.v0 = uvCoord.y;
+    params.u1 = uvCoord.x + uvSize.x;
+    params.v1 = uvCoord.y + uvSize.y;
 
     // SpriteRendererの反転
-    if (renderer.IsFlipX()) std::swap(u0, u1);
-    if (renderer.IsFlipY()) std::swap(v0, v1);
+    if (renderer.IsFlipX()) std::swap(params.u0, params.u1);
+    if (renderer.IsFlipY()) std::swap(params.v0, params.v1);
 
-    SpriteInfo info;
-    info.texture = texture;
-    info.sortingLayer = renderer.GetSortingLayer();
-    info.orderInLayer = renderer.GetOrderInLayer();
+    const int sortingLayer = renderer.GetSortingLayer();
+    const int orderInLayer = renderer.GetOrderInLayer();
 
-    Vector2 p0 = rotatePoint(x0, y0);
-    Vector2 p1 = rotatePoint(x1, y0);
-    Vector2 p2 = rotatePoint(x0, y1);
-    Vector2 p3 = rotatePoint(x1, y1);
+    params.rotation = rotation;
+    params.color = renderer.GetColor();
 
     // sortingLayer/orderInLayerから深度値を計算
-    float z = CalculateDepth(info.sortingLayer, info.orderInLayer);
-
-    info.vertices[0] = { Vector3(p0.x, p0.y, z), Vector2(u0, v0), renderer.GetColor() };
-    info.vertices[1] = { Vector3(p1.x, p1.y, z), Vector2(u1, v0), renderer.GetColor() };
-    info.vertices[2] = { Vector3(p2.x, p2.y, z), Vector2(u0, v1), renderer.GetColor() };
-    info.vertices[3] = { Vector3(p3.x, p3.y, z), Vector2(u1, v1), renderer.GetColor() };
+    params.depth = CalculateDepth(sortingLayer, orderInLayer);
 
-    spriteQueue_.push_back(info);
+    Enqueue(params, sortingLayer, orderInLayer);
 }
 
 void SpriteBatch::End() {
@@ -459,14 +608,115 @@ void SpriteBatch::End() {
         return;
     }
 
-    if (!spriteQueue_.empty()) {
+    // 静的ブロック（背景）を先に描画
+    if (!staticDraws_.empty()) {
+        FlushStatic();
+    }
+
+    if (!sortKeys_.empty()) {
         SortSprites();
-        FlushBatch();
+        if (mode_ == SpriteBatchMode::Instanced && !customVertexShader_) {
+            FlushInstanced();
+        } else {
+            // カスタム頂点シェーダーは頂点入力を前提とするため、
+            // インスタンスモードでもparamQueue_を頂点に展開して描画
+            FlushBatch();
+        }
     }
 
     isBegun_ = false;
 }
 
+void SpriteBatch::BeginStatic() {
+    if (!initialized_) {
+        LOG_WARN("SpriteBatch: 初期化されていません");
+        return;
+    }
+    if (isBegun_ || recordingStatic_) {
+        LOG_WARN("SpriteBatch: BeginStatic()はBegin()～End()の外で1回ずつ呼んでください");
+        return;
+    }
+
+    staticKeys_.clear();
+    staticParams_.clear();
+    textureSortIds_.clear();
+    lastSortTexture_ = nullptr;
+    lastSortTextureId_ = 0;
+    recordingStatic_ = true;
+}
+
+SpriteBatch::StaticBlockId SpriteBatch::EndStatic() {
+    if (!recordingStatic_) {
+        LOG_WARN("SpriteBatch: BeginStatic()が呼ばれていません");
+        return kInvalidStaticBlock;
+    }
+    recordingStatic_ = false;
+
+    if (staticKeys_.empty()) {
+        return kInvalidStaticBlock;
+    }
+
+    StaticBlockEntry entry;
+    SpriteStatic::Build(staticKeys_, staticParams_, SpriteStatic::kMaxSpritesPerRange, entry.block);
+    entry.spriteCount = entry.block.GetSpriteCount();
+    staticKeys_.clear();
+    staticParams_.clear();
+
+    // 共有インデックスバッファ（0起点の四角形パターン）を範囲の先頭オフセットで使う
+    EnsureIndexCapacity(entry.spriteCount);
+    if (entry.spriteCount > indexCapacity_) {
+        LOG_ERROR("SpriteBatch: 静的ブロックがインデックスバッファの容量を超えています");
+        return kInvalidStaticBlock;
+    }
+
+    entry.vertexBuffer = Buffer::CreateVertex(
+        static_cast<uint32_t>(sizeof(SpriteVertex) * entry.block.vertices.size()),
+        sizeof(SpriteVertex), false, entry.block.vertices.data());
+    if (!entry.vertexBuffer) {
+        LOG_ERROR("SpriteBatch: 静的頂点バッファの作成に失敗");
+        return kInvalidStaticBlock;
+    }
+
+    // 転送後は範囲と境界だけを保持
+    std::vector<SpriteVertex>().swap(entry.block.vertices);
+
+    // 解放済みのスロットを再利用
+    for (StaticBlockId id = 0; id < staticBlocks_.size(); ++id) {
+        if (!staticBlocks_[id].vertexBuffer) {
+            staticBlocks_[id] = std::move(entry);
+            return id;
+        }
+    }
+    staticBlocks_.push_back(std::move(entry));
+    return static_cast<StaticBlockId>(staticBlocks_.size() - 1);
+}
+
+void SpriteBatch::DrawStatic(StaticBlockId id) {
+    if (!isBegun_) {
+        LOG_WARN("SpriteBatch: Begin()が呼ばれていません");
+        return;
+    }
+    if (id >= staticBlocks_.size() || !staticBlocks_[id].vertexBuffer) {
+        return;
+    }
+    staticDraws_.push_back(id);
+}
+
+void SpriteBatch::ReleaseStatic(StaticBlockId id) {
+    if (id >= staticBlocks_.size()) {
+        return;
+    }
+    staticBlocks_[id] = StaticBlockEntry{};
+}
+
+void SpriteBatch::SetCommandTarget(ICommandBackend* target) {
+    if (isBegun_) {
+        LOG_WARN("SpriteBatch: コマンド出力先の切り替えはBegin()の前に行ってください");
+        return;
+    }
+    commandTarget_ = target;
+}
+
 void SpriteBatch::SetCustomShaders(Shader* vs, Shader* ps) {
     customVertexShader_ = vs;
     customPixelShader_ = ps;
@@ -493,112 +743,270 @@ void SpriteBatch::ClearCustomSamplerState() {
     customSamplerState_ = nullptr;
 }
 
-void SpriteBatch::SortSprites() {
-    // インデックス配列を初期化
-    uint32_t count = static_cast<uint32_t>(spriteQueue_.size());
-    sortIndices_.resize(count);
-    for (uint32_t i = 0; i < count; ++i) {
-        sortIndices_[i] = i;
-    }
-
-    // インデックスをソート（SpriteInfo自体は移動しない）
-    std::stable_sort(sortIndices_.begin(), sortIndices_.end(),
-        [this](uint32_t a, uint32_t b) {
-            const SpriteInfo& sa = spriteQueue_[a];
-            const SpriteInfo& sb = spriteQueue_[b];
-            if (sa.sortingLayer != sb.sortingLayer) {
-                return sa.sortingLayer < sb.sortingLayer;
-            }
-            return sa.orderInLayer < sb.orderInLayer;
-        });
+void SpriteBatch::SetTextureSortEnabled(bool enabled) {
+    if (isBegun_) {
+        LOG_WARN("SpriteBatch: テクスチャソートの切り替えはBegin()の前に行ってください");
+        return;
+    }
+    textureSortEnabled_ = enabled;
 }
 
-void SpriteBatch::FlushBatch() {
-    if (spriteQueue_.empty()) return;
+void SpriteBatch::SetMode(SpriteBatchMode mode) {
+    if (isBegun_) {
+        LOG_WARN("SpriteBatch: モードの切り替えはBegin()の前に行ってください");
+        return;
+    }
+    if (mode == SpriteBatchMode::Instanced && !instanceVertexShader_) {
+        LOG_WARN("SpriteBatch: インスタンス描画が利用できないため頂点モードを使用します");
+        mode = SpriteBatchMode::Vertex;
+    }
+    mode_ = mode;
+}
 
-    auto& ctx = GraphicsContext::Get();
+void SpriteBatch::Enqueue(const SpriteParams& params, int sortingLayer, int orderInLayer) {
+    assert(SpriteSort::IsSortOrderInRange(sortingLayer) && SpriteSort::IsSortOrderInRange(orderInLayer) &&
+           "SpriteBatch: sortingLayer/orderInLayerは-32768～32767の範囲で指定すること");
+
+    // 静的ブロックの記録中はカリングせずに保持（カメラは後から動く）
+    if (recordingStatic_) {
+        const size_t sequence = staticKeys_.size();
+        if (sequence >= SpriteSort::kMaxSequence) {
+            LOG_WARN("SpriteBatch: 静的ブロックの最大スプライト数を超えました");
+            return;
+        }
+        const uint32_t textureId = textureSortEnabled_ ? TextureSortId(params.texture) : 0;
+        staticKeys_.push_back(SpriteSort::MakeKey(
+            sortingLayer, orderInLayer, textureId, static_cast<uint32_t>(sequence)));
+        staticParams_.push_back(params);
+        return;
+    }
+
+    // 画面外のスプライトはソート・頂点生成・転送の前に除外
+    if (cullingEnabled_ && hasViewRect_ && !SpriteGeometry::IsVisible(params, viewRect_)) {
+        ++culledCount_;
+        return;
+    }
+    ++submittedCount_;
+
+    const size_t sequence = sortKeys_.size();
+    if (sequence >= SpriteSort::kMaxSequence) {
+        LOG_WARN("SpriteBatch: 1フレームの最大スプライト数を超えました");
+        return;
+    }
+
+    const uint32_t textureId = textureSortEnabled_ ? TextureSortId(params.texture) : 0;
+    sortKeys_.push_back(SpriteSort::MakeKey(
+        sortingLayer, orderInLayer, textureId, static_cast<uint32_t>(sequence)));
+
+    if (mode_ != SpriteBatchMode::Vertex) {
+        // 頂点展開はGPU側、またはEnd()で整列後に行う
+        paramQueue_.push_back(params);
+        return;
+    }
+
+    SpriteInfo info;
+    info.texture = params.texture;
+    SpriteGeometry::ExpandQuad(params, info.vertices);
+    spriteQueue_.push_back(info);
+}
+
+uint32_t SpriteBatch::TextureSortId(Texture* texture) {
+    // 連続して同じテクスチャが来ることが多いので直前の結果を再利用
+    if (texture == lastSortTexture_) {
+        return lastSortTextureId_;
+    }
+
+    // 初出順に番号を振る（フレーム内でのみ有効）
+    auto it = textureSortIds_.try_emplace(
+        texture, static_cast<uint32_t>(textureSortIds_.size())).first;
+    lastSortTexture_ = texture;
+    lastSortTextureId_ = it->second;
+    return lastSortTextureId_;
+}
+
+void SpriteBatch::SortSprites() {
+    // キーのみを整列（SpriteInfo自体は移動せず、キー下位の投入順から参照する）
+    SpriteSort::RadixSort(sortKeys_, sortScratch_);
+}
+
+void SpriteBatch::BindVertexPipeline(Buffer* vertexBuffer) {
+    ICommandBackend& commands = Commands();
 
     // 定数バッファ更新
-    ctx.UpdateConstantBuffer(constantBuffer_.get(), cbufferData_);
+    commands.UpdateConstantBuffer(constantBuffer_.get(), &cbufferData_, sizeof(cbufferData_));
 
     // パイプライン設定
-    ctx.SetInputLayout(inputLayout_.Get());
-    ctx.SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    commands.SetInputLayout(inputLayout_.Get());
+    commands.SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
-    ctx.SetVertexBuffer(0, vertexBuffer_.get(), sizeof(SpriteVertex));
-    ctx.SetIndexBuffer(indexBuffer_.get(), DXGI_FORMAT_R16_UINT, 0);
+    commands.SetVertexBuffer(0, vertexBuffer, sizeof(SpriteVertex));
+    commands.SetIndexBuffer(indexBuffer_.get(), DXGI_FORMAT_R32_UINT, 0);
 
     // カスタムシェーダーがあれば使用、なければデフォルト
     Shader* vs = customVertexShader_ ? customVertexShader_ : vertexShader_.get();
     Shader* ps = customPixelShader_ ? customPixelShader_ : pixelShader_.get();
 
-    ctx.SetVertexShader(vs);
-    ctx.SetVSConstantBuffer(0, constantBuffer_.get());
+    commands.SetShader(ShaderType::Vertex, vs);
+    commands.SetConstantBuffer(ShaderType::Vertex, 0, constantBuffer_.get());
 
-    ctx.SetPixelShader(ps);
+    commands.SetShader(ShaderType::Pixel, ps);
 
     // RenderStateManagerからステートを取得
     auto& rsm = RenderStateManager::Get();
 
     // カスタムサンプラーステートがあれば使用、なければデフォルト
     SamplerState* ss = customSamplerState_ ? customSamplerState_ : rsm.GetLinearWrap();
-    ctx.SetPSSampler(0, ss);
+    commands.SetSampler(ShaderType::Pixel, 0, ss);
 
     // カスタムブレンドステートがあれば使用、なければデフォルト
     BlendState* bs = customBlendState_ ? customBlendState_ : rsm.GetAlphaBlend();
-    ctx.SetBlendState(bs);
-    ctx.SetDepthStencilState(rsm.GetDepthLessEqual());
-    ctx.SetRasterizerState(rsm.GetNoCull());
-
-    // バッチ描画
-    Texture* currentTexture = nullptr;
-    uint32_t batchStart = 0;
-    uint32_t spriteIndex = 0;
-
-    // 頂点データをマップ
-    auto* vertices = static_cast<SpriteVertex*>(ctx.MapBuffer(vertexBuffer_.get()));
-    if (!vertices) {
-        LOG_ERROR("SpriteBatch: 頂点バッファのマップに失敗");
-        return;
-    }
+    commands.SetBlendState(bs);
+    commands.SetDepthStencilState(rsm.GetDepthLessEqual());
+    commands.SetRasterizerState(rsm.GetNoCull());
+}
 
-    for (uint32_t idx : sortIndices_) {
-        const SpriteInfo& sprite = spriteQueue_[idx];
+void SpriteBatch::FlushBatch() {
+    if (sortKeys_.empty()) return;
+
+    ICommandBackend& commands = Commands();
+
+    // 全スプライトを1回のマップで転送できるよう容量を確保（縮小はしない）
+    const uint32_t total = static_cast<uint32_t>(sortKeys_.size());
+    EnsureCapacity(total);
+
+    BindVertexPipeline(vertexBuffer_.get());
 
-        // テクスチャが変わったらフラッシュ
-        if (currentTexture && sprite.texture != currentTexture) {
-            ctx.UnmapBuffer(vertexBuffer_.get());
+    // 通常は1チャンク。最大容量を超える場合のみ分割
+    for (uint32_t chunkStart = 0; chunkStart < total; chunkStart += capacity_) {
+        const uint32_t chunkCount = (std::min)(capacity_, total - chunkStart);
 
-            ctx.SetPSShaderResource(0, currentTexture);
+        // 頂点データをマップ（リングの空きに追記）
+        uint32_t ringFirst = 0;
+        auto* vertices = static_cast<SpriteVertex*>(MapRing(
+            vertexBuffer_.get(), vertexRing_, sizeof(SpriteVertex) * 4, chunkCount, ringFirst));
+        if (!vertices) {
+            LOG_ERROR("SpriteBatch: 頂点バッファのマップに失敗");
+            return;
+        }
+
+        if (!paramQueue_.empty()) {
+            // 遅延展開: マップしたバッファへ整列順に直接書き込む
+            const auto keys = std::span<const uint64_t>(sortKeys_).subspan(chunkStart, chunkCount);
+            SpriteGeometry::ExpandQuadsParallel(keys, paramQueue_, vertices);
+            SpriteGeometry::BuildInstanceBatches(keys, paramQueue_, 0, batches_);
+        } else {
+            // 頂点コピーとテクスチャ単位のバッチ分割
+            batches_.clear();
+            for (uint32_t i = 0; i < chunkCount; ++i) {
+                const SpriteInfo& sprite = spriteQueue_[SpriteSort::IndexOf(sortKeys_[chunkStart + i])];
+                if (batches_.empty() || batches_.back().texture != sprite.texture) {
+                    batches_.push_back({ sprite.texture, i, 0 });
+                }
+                ++batches_.back().count;
+                memcpy(&vertices[i * 4], sprite.vertices, sizeof(SpriteVertex) * 4);
+            }
+        }
+        commands.EndWrite(vertexBuffer_.get());
 
-            uint32_t indexCount = (spriteIndex - batchStart) * 6;
-            ctx.DrawIndexed(indexCount, batchStart * 6, 0);
+        // バッチ描画（インデックスは0起点、リング位置はベース頂点で指定）
+        for (const auto& batch : batches_) {
+            commands.SetShaderResource(ShaderType::Pixel, 0, batch.texture);
+            commands.DrawIndexed(batch.count * 6, batch.first * 6, static_cast<int32_t>(ringFirst * 4));
             ++drawCallCount_;
+        }
+        spriteCount_ += chunkCount;
+    }
+}
+
+void SpriteBatch::FlushStatic() {
+    ICommandBackend& commands = Commands();
 
-            // 再マップ
-            vertices = static_cast<SpriteVertex*>(ctx.MapBuffer(vertexBuffer_.get()));
-            if (!vertices) break;
+    for (StaticBlockId id : staticDraws_) {
+        const StaticBlockEntry& entry = staticBlocks_[id];
+        if (!entry.vertexBuffer) continue;  // Begin()後に解放された
 
-            batchStart = spriteIndex;
+        // 表示範囲に掛かる範囲だけを選ぶ（スプライト単位の処理はしない）
+        if (cullingEnabled_ && hasViewRect_) {
+            SpriteStatic::SelectVisible(entry.block, viewRect_, batches_);
+        } else {
+            SpriteStatic::SelectAll(entry.block, batches_);
         }
+        if (batches_.empty()) continue;
 
-        currentTexture = sprite.texture;
+        BindVertexPipeline(entry.vertexBuffer.get());
+        for (const auto& batch : batches_) {
+            commands.SetShaderResource(ShaderType::Pixel, 0, batch.texture);
+            commands.DrawIndexed(batch.count * 6, batch.first * 6, 0);
+            ++drawCallCount_;
+            staticSpriteCount_ += batch.count;
+        }
+    }
+}
+
+void SpriteBatch::FlushInstanced() {
+    if (paramQueue_.empty()) return;
 
-        // 頂点コピー
-        memcpy(&vertices[spriteIndex * 4], sprite.vertices, sizeof(SpriteVertex) * 4);
-        ++spriteIndex;
-        ++spriteCount_;
+    ICommandBackend& commands = Commands();
+
+    // 全スプライトを1回のマップで転送できるよう容量を確保（縮小はしない）
+    const uint32_t total = static_cast<uint32_t>(sortKeys_.size());
+    EnsureInstanceCapacity(total);
+    if (!instanceBuffer_) {
+        LOG_ERROR("SpriteBatch: インスタンスバッファがありません");
+        return;
     }
 
-    // 最後のバッチを描画
-    if (spriteIndex > batchStart && currentTexture) {
-        ctx.UnmapBuffer(vertexBuffer_.get());
+    // 定数バッファ更新
+    commands.UpdateConstantBuffer(constantBuffer_.get(), &cbufferData_, sizeof(cbufferData_));
+
+    // パイプライン設定（四角形は頂点シェーダーでSV_VertexIDから展開）
+    commands.SetInputLayout(instanceInputLayout_.Get());
+    commands.SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+    commands.SetVertexBuffer(0, instanceBuffer_.get(), sizeof(SpriteInstance));
+
+    commands.SetShader(ShaderType::Vertex, instanceVertexShader_.get());
+    commands.SetConstantBuffer(ShaderType::Vertex, 0, constantBuffer_.get());
 
-        ctx.SetPSShaderResource(0, currentTexture);
+    Shader* ps = customPixelShader_ ? customPixelShader_ : pixelShader_.get();
+    commands.SetShader(ShaderType::Pixel, ps);
 
-        uint32_t indexCount = (spriteIndex - batchStart) * 6;
-        ctx.DrawIndexed(indexCount, batchStart * 6, 0);
-        ++drawCallCount_;
+    auto& rsm = RenderStateManager::Get();
+    SamplerState* ss = customSamplerState_ ? customSamplerState_ : rsm.GetLinearWrap();
+    commands.SetSampler(ShaderType::Pixel, 0, ss);
+    BlendState* bs = customBlendState_ ? customBlendState_ : rsm.GetAlphaBlend();
+    commands.SetBlendState(bs);
+    commands.SetDepthStencilState(rsm.GetDepthLessEqual());
+    commands.SetRasterizerState(rsm.GetNoCull());
+
+    // テクスチャ切り替え位置とバッファ容量でバッチを分割
+    SpriteGeometry::BuildInstanceBatches(sortKeys_, paramQueue_, instanceCapacity_, batches_);
+
+    size_t batchIndex = 0;
+    for (uint32_t chunkStart = 0; chunkStart < total; chunkStart += instanceCapacity_) {
+        const uint32_t chunkCount = (std::min)(instanceCapacity_, total - chunkStart);
+
+        // リングの空きに追記
+        uint32_t ringFirst = 0;
+        auto* instances = static_cast<SpriteInstance*>(MapRing(
+            instanceBuffer_.get(), instanceRing_, sizeof(SpriteInstance), chunkCount, ringFirst));
+        if (!instances) {
+            LOG_ERROR("SpriteBatch: インスタンスバッファのマップに失敗");
+            return;
+        }
+        SpriteGeometry::PackInstances(
+            std::span<const uint64_t>(sortKeys_).subspan(chunkStart, chunkCount),
+            paramQueue_, instances);
+        commands.EndWrite(instanceBuffer_.get());
+
+        // このチャンクに含まれるバッチを描画
+        const uint32_t chunkEnd = chunkStart + chunkCount;
+        for (; batchIndex < batches_.size() && batches_[batchIndex].first < chunkEnd; ++batchIndex) {
+            const auto& batch = batches_[batchIndex];
+            commands.SetShaderResource(ShaderType::Pixel, 0, batch.texture);
+            commands.DrawInstanced(4, batch.count, 0, ringFirst + (batch.first - chunkStart));
+            ++drawCallCount_;
+        }
+        spriteCount_ += chunkCount;
     }
 }
 
@@ -8,9 +8,15 @@
 #include "dx11/gpu/buffer.h"
 #include "dx11/gpu/shader.h"
 #include "dx11/gpu/texture.h"
+#include "dx11/context_command_backend.h"
 #include "engine/math/math_types.h"
 #include "engine/math/color.h"
 #include "engine/component/sprite_renderer.h"
+#include "sprite_sort.h"
+#include "sprite_geometry.h"
+#include "sprite_ring.h"
+#include "sprite_static.h"
+#include <unordered_map>
 #include <vector>
 
 // 前方宣言
@@ -19,6 +25,15 @@ class Camera2D;
 class BlendState;
 class SamplerState;
 
+//============================================================================
+//! @brief スプライトの転送方式
+//============================================================================
+enum class SpriteBatchMode : uint8_t {
+    Vertex,     //!< Draw()で4頂点に展開して転送（既定）
+    Instanced,  //!< 1スプライト1インスタンスを転送し、頂点シェーダーで展開
+    Deferred,   //!< Draw()はパラメータのみ記録し、End()で整列後に並列展開して転送
+};
+
 //============================================================================
 //! @brief スプライトバッチ描画システム
 //!
@@ -29,9 +44,6 @@ class SamplerState;
 #pragma warning(disable: 4324) // structure was padded due to alignment specifier
 class SpriteBatch final : private NonCopyableNonMovable {
 public:
-    //! @brief 1回のバッチで描画できる最大スプライト数
-    static constexpr uint32_t MaxSpritesPerBatch = 2048;
-
     //------------------------------------------------------------------------
     //! @brief シングルトンインスタンス取得
     //------------------------------------------------------------------------
@@ -54,12 +66,14 @@ public:
     //------------------------------------------------------------------------
     //! @brief カメラを設定
     //! @param camera 2Dカメラ
+    //! @note 表示範囲も保持し、範囲外のスプライトはDraw()時点で除外する
     //------------------------------------------------------------------------
     void SetCamera(Camera2D& camera);
 
     //------------------------------------------------------------------------
     //! @brief ビュープロジェクション行列を直接設定
     //! @param viewProjection ビュープロジェクション行列（転置済み）
+    //! @note 表示範囲が不明になるため、次のSetCamera()までカリングしない
     //------------------------------------------------------------------------
     void SetViewProjection(const Matrix& viewProjection);
 
@@ -95,8 +109,8 @@ public:
     //! @param scale スケール
     //! @param flipX X反転
     //! @param flipY Y反転
-    //! @param sortingLayer ソーティングレイヤー
-    //! @param orderInLayer レイヤー内順序
+    //! @param sortingLayer ソーティングレイヤー（-32768～32767）
+    //! @param orderInLayer レイヤー内順序（-32768～32767）
     //------------------------------------------------------------------------
     void Draw(
         Texture* texture,
@@ -130,6 +144,37 @@ public:
     //------------------------------------------------------------------------
     void End();
 
+    //------------------------------------------------------------------------
+    //! @brief 静的ブロックのID
+    //------------------------------------------------------------------------
+    using StaticBlockId = uint32_t;
+    static constexpr StaticBlockId kInvalidStaticBlock = UINT32_MAX;
+
+    //------------------------------------------------------------------------
+    //! @brief 静的スプライトの記録を開始
+    //! @note Begin()～End()の外で呼ぶ。EndStatic()までのDraw()は
+    //!       描画キューではなく静的ブロックに記録される（カリングしない）。
+    //------------------------------------------------------------------------
+    void BeginStatic();
+
+    //------------------------------------------------------------------------
+    //! @brief 記録を終了し、整列・頂点展開したブロックをGPUへ転送
+    //! @return ブロックID（記録が空、または作成に失敗した場合はkInvalidStaticBlock）
+    //------------------------------------------------------------------------
+    [[nodiscard]] StaticBlockId EndStatic();
+
+    //------------------------------------------------------------------------
+    //! @brief 静的ブロックを描画（Begin()～End()の間で呼ぶ）
+    //! @note End()で動的スプライトより先に、表示範囲に掛かる範囲だけを描画する。
+    //!       スプライト単位の処理は行わないため、背景など奥のレイヤー向け。
+    //------------------------------------------------------------------------
+    void DrawStatic(StaticBlockId id);
+
+    //------------------------------------------------------------------------
+    //! @brief 静的ブロックを解放
+    //------------------------------------------------------------------------
+    void ReleaseStatic(StaticBlockId id);
+
     //------------------------------------------------------------------------
     //! @brief カスタムシェーダーを設定（次のEnd()で使用）
     //! @param vs 頂点シェーダー（nullptrでデフォルト）
@@ -164,35 +209,116 @@ public:
     //------------------------------------------------------------------------
     void ClearCustomSamplerState();
 
+    //------------------------------------------------------------------------
+    //! @brief 転送方式を設定
+    //! @param mode 転送方式（Begin()の前に設定する）
+    //! @note Instancedはシェーダーの準備に失敗した場合は無視される。
+    //!       カスタム頂点シェーダー使用時は自動的に頂点経路で描画する。
+    //------------------------------------------------------------------------
+    void SetMode(SpriteBatchMode mode);
+    [[nodiscard]] SpriteBatchMode GetMode() const noexcept { return mode_; }
+
+    //------------------------------------------------------------------------
+    //! @brief 画面外カリングの有効/無効を設定（既定は有効）
+    //------------------------------------------------------------------------
+    void SetCullingEnabled(bool enabled) noexcept { cullingEnabled_ = enabled; }
+    [[nodiscard]] bool IsCullingEnabled() const noexcept { return cullingEnabled_; }
+
+    //------------------------------------------------------------------------
+    //! @brief 同じ描画順のスプライトをテクスチャ別にまとめるか設定
+    //! @param enabled trueで同じsortingLayer/orderInLayer内をテクスチャ単位で並べる
+    //! @note 描画コールは減るが、同じ深度で重なるスプライトの前後が
+    //!       投入順でなくなるため既定は無効。Begin()の前に設定する。
+    //------------------------------------------------------------------------
+    void SetTextureSortEnabled(bool enabled);
+    [[nodiscard]] bool IsTextureSortEnabled() const noexcept { return textureSortEnabled_; }
+
+    //------------------------------------------------------------------------
+    //! @brief 描画コマンドの出力先を設定
+    //! @param target 出力先（nullptrでGraphicsContextへ即時発行）
+    //! @note CommandBufferを指定すると記録のみ行う。バッファ容量の拡張や
+    //!       ReleaseStatic()で記録済みのバッファが無効になるため、
+    //!       記録したコマンドは次のBegin()までに再生すること。Begin()の前に設定する。
+    //------------------------------------------------------------------------
+    void SetCommandTarget(ICommandBackend* target);
+
     //------------------------------------------------------------------------
     //! @brief 描画統計を取得
     //------------------------------------------------------------------------
     [[nodiscard]] uint32_t GetDrawCallCount() const noexcept { return drawCallCount_; }
     [[nodiscard]] uint32_t GetSpriteCount() const noexcept { return spriteCount_; }
 
+    //! @brief 直近のBegin()以降にカリングで除外した/キューに入れたスプライト数
+    [[nodiscard]] uint32_t GetCulledCount() const noexcept { return culledCount_; }
+    [[nodiscard]] uint32_t GetSubmittedCount() const noexcept { return submittedCount_; }
+
+    //! @brief 直近のEnd()で描画した静的スプライト数
+    [[nodiscard]] uint32_t GetStaticSpriteCount() const noexcept { return staticSpriteCount_; }
+
+    //! @brief 直近のBegin()～End()で頂点/インスタンスバッファをマップした回数
+    [[nodiscard]] uint32_t GetMapCount() const noexcept { return mapCount_; }
+
+    //! @brief 1回のマップで転送できるスプライト数（必要に応じて拡張される）
+    [[nodiscard]] uint32_t GetCapacity() const noexcept { return capacity_; }
+
+    //! @brief インスタンスバッファの容量（インスタンスモードで描画するまで0）
+    [[nodiscard]] uint32_t GetInstanceCapacity() const noexcept { return instanceCapacity_; }
+
+    //! @brief 初期化後にバッファを拡張した回数
+    [[nodiscard]] uint32_t GetGrowCount() const noexcept { return growCount_; }
+
 private:
     SpriteBatch() = default;
     ~SpriteBatch() = default;
 
-    //! @brief スプライト頂点データ
-    struct SpriteVertex {
-        Vector3 position;
-        Vector2 texCoord;
-        Color color;
-    };
+    using SpriteVertex = SpriteGeometry::SpriteVertex;
+    using SpriteParams = SpriteGeometry::SpriteParams;
+    using SpriteInstance = SpriteGeometry::SpriteInstance;
 
-    //! @brief スプライト情報（ソート用）
+    //! @brief スプライト情報（描画順はsortKeys_側に持つ）
     struct SpriteInfo {
         Texture* texture;
         SpriteVertex vertices[4];
-        int sortingLayer;
-        int orderInLayer;
     };
 
     bool CreateShaders();
+    void CreateInstancedShader();
+
+    //! @brief 指定容量で頂点バッファを作成（インデックスが足りなければ作り直す）
+    //! @return 失敗した場合は現在のバッファを維持してfalse
+    bool CreateBatchBuffers(uint32_t capacity);
+
+    //! @brief capacity個分の四角形インデックス（0起点）を持つ静的バッファを作成
+    [[nodiscard]] BufferPtr CreateQuadIndexBuffer(uint32_t capacity);
+
+    //! @brief spriteCount個を1回で転送できるまで頂点/インデックスを拡張（縮小はしない）
+    void EnsureCapacity(uint32_t spriteCount);
+
+    //! @brief 静的ブロック用にインデックスだけを拡張（動的バッファは拡張しない）
+    void EnsureIndexCapacity(uint32_t spriteCount);
+
+    //! @brief インスタンスバッファを作成・拡張（インスタンスモードの描画時のみ）
+    void EnsureInstanceCapacity(uint32_t spriteCount);
+
+    //! @brief リングの空き領域への書き込みを開始（Commands().EndWrite()で終了）
+    //! @param[out] outFirst 書き込み先頭の要素位置
+    //! @return 書き込み先（失敗時nullptr）
+    void* MapRing(Buffer* buffer, SpriteRing::Cursor& ring, uint32_t elementSize,
+                  uint32_t count, uint32_t& outFirst);
+
+    //! @brief 頂点入力の描画パイプラインを設定（FlushBatch/FlushStatic共通）
+    void BindVertexPipeline(Buffer* vertexBuffer);
     void FlushBatch();
+    void FlushInstanced();
+    void FlushStatic();
     void SortSprites();
 
+    //! @brief スプライトをキューに追加し、ソートキーを作成
+    void Enqueue(const SpriteParams& params, int sortingLayer, int orderInLayer);
+
+    //! @brief テクスチャのフレーム内ソートIDを取得
+    [[nodiscard]] uint32_t TextureSortId(Texture* texture);
+
     //! @brief sortingLayer/orderInLayerから深度値を計算
     //! @param sortingLayer ソーティングレイヤー（大きいほど手前）
     //! @param orderInLayer レイヤー内の順序（大きいほど手前）
@@ -204,14 +330,48 @@ private:
     BufferPtr indexBuffer_;
     BufferPtr constantBuffer_;
 
+    // バッファ容量とリング書き込み位置
+    uint32_t capacity_ = 0;          //!< 頂点バッファ（スプライト数）
+    uint32_t indexCapacity_ = 0;     //!< インデックスバッファ（capacity_以上）
+    uint32_t instanceCapacity_ = 0;  //!< インスタンスバッファ（未作成なら0）
+    SpriteRing::Cursor vertexRing_;
+    SpriteRing::Cursor instanceRing_;
+
     // シェーダー（dx11/gpu/）
     ShaderPtr vertexShader_;
     ShaderPtr pixelShader_;
     ComPtr<ID3D11InputLayout> inputLayout_;
 
+    // インスタンス描画用（準備できなかった場合はnullptr）
+    BufferPtr instanceBuffer_;
+    ShaderPtr instanceVertexShader_;
+    ComPtr<ID3D11InputLayout> instanceInputLayout_;
+
     // スプライトキュー
-    std::vector<SpriteInfo> spriteQueue_;
-    std::vector<uint32_t> sortIndices_;  //!< ソート用インデックス配列
+    std::vector<SpriteInfo> spriteQueue_;     //!< 頂点モードのキュー
+    std::vector<SpriteParams> paramQueue_;    //!< インスタンス/遅延モードのキュー
+    std::vector<SpriteGeometry::InstanceBatch> batches_;  //!< 描画コール単位の範囲
+    SpriteBatchMode mode_ = SpriteBatchMode::Vertex;
+    std::vector<uint64_t> sortKeys_;     //!< ソートキー（SpriteSort::MakeKey）
+    std::vector<uint64_t> sortScratch_;  //!< 基数ソート作業領域
+
+    // テクスチャ別グループ化
+    bool textureSortEnabled_ = false;
+    std::unordered_map<Texture*, uint32_t> textureSortIds_;
+    Texture* lastSortTexture_ = nullptr;
+    uint32_t lastSortTextureId_ = 0;
+
+    // 静的ブロック
+    struct StaticBlockEntry {
+        SpriteStatic::Block block;   //!< 範囲と境界（頂点は転送後に解放）
+        BufferPtr vertexBuffer;      //!< 変更しない頂点バッファ
+        uint32_t spriteCount = 0;
+    };
+    std::vector<StaticBlockEntry> staticBlocks_;   //!< ID = インデックス（解放済みはvertexBufferがnull）
+    std::vector<StaticBlockId> staticDraws_;       //!< このフレームに描画するブロック
+    std::vector<uint64_t> staticKeys_;             //!< 記録中のソートキー
+    std::vector<SpriteParams> staticParams_;       //!< 記録中のパラメータ
+    bool recordingStatic_ = false;
 
     // 定数バッファデータ
     struct alignas(16) CBufferData {
@@ -219,6 +379,11 @@ private:
     };
     CBufferData cbufferData_;
 
+    // カリング
+    SpriteGeometry::ViewRect viewRect_{};
+    bool hasViewRect_ = false;
+    bool cullingEnabled_ = true;
+
     // 状態
     bool isBegun_ = false;
     bool initialized_ = false;
@@ -233,8 +398,21 @@ private:
     // カスタムサンプラーステート（nullptrの場合はデフォルト使用）
     SamplerState* customSamplerState_ = nullptr;
 
+    // 描画コマンドの出力先（nullptrの場合はGraphicsContextへ即時発行）
+    ICommandBackend* commandTarget_ = nullptr;
+    ContextCommandBackend contextBackend_;
+
+    [[nodiscard]] ICommandBackend& Commands() noexcept {
+        return commandTarget_ ? *commandTarget_ : contextBackend_;
+    }
+
     // 統計
     uint32_t drawCallCount_ = 0;
     uint32_t spriteCount_ = 0;
+    uint32_t mapCount_ = 0;
+    uint32_t growCount_ = 0;
+    uint32_t culledCount_ = 0;
+    uint32_t submittedCount_ = 0;
+    uint32_t staticSpriteCount_ = 0;
 };
 #pragma warning(pop)
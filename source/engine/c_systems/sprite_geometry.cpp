@@ -0,0 +1,164 @@
+//----------------------------------------------------------------------------
+//! @file   sprite_geometry.cpp
+//! @brief  スプライトの頂点展開とインスタンスパック実装
+//----------------------------------------------------------------------------
+
+#include "sprite_geometry.h"
+#include "sprite_sort.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <execution>
+
+namespace SpriteGeometry {
+
+void ExpandQuad(const SpriteParams& params, SpriteVertex* out) noexcept
+{
+    // 回転行列
+    const float cosR = std::cos(params.rotation);
+    const float sinR = std::sin(params.rotation);
+
+    auto rotatePoint = [&](float x, float y) -> Vector2 {
+        return Vector2(
+            x * cosR - y * sinR + params.posX,
+            x * sinR + y * cosR + params.posY
+        );
+    };
+
+    const Vector2 p0 = rotatePoint(params.x0, params.y0);
+    const Vector2 p1 = rotatePoint(params.x1, params.y0);
+    const Vector2 p2 = rotatePoint(params.x0, params.y1);
+    const Vector2 p3 = rotatePoint(params.x1, params.y1);
+    const float z = params.depth;
+
+    out[0] = { Vector3(p0.x, p0.y, z), Vector2(params.u0, params.v0), params.color };
+    out[1] = { Vector3(p1.x, p1.y, z), Vector2(params.u1, params.v0), params.color };
+    out[2] = { Vector3(p2.x, p2.y, z), Vector2(params.u0, params.v1), params.color };
+    out[3] = { Vector3(p3.x, p3.y, z), Vector2(params.u1, params.v1), params.color };
+}
+
+void ExpandQuads(std::span<const uint64_t> sortedKeys,
+                 std::span<const SpriteParams> params,
+                 SpriteVertex* dst) noexcept
+{
+    for (size_t i = 0; i < sortedKeys.size(); ++i) {
+        ExpandQuad(params[SpriteSort::IndexOf(sortedKeys[i])], dst + i * 4);
+    }
+}
+
+void ExpandQuadsParallel(std::span<const uint64_t> sortedKeys,
+                         std::span<const SpriteParams> params,
+                         SpriteVertex* dst)
+{
+    if (sortedKeys.size() < kParallelExpandThreshold) {
+        ExpandQuads(sortedKeys, params, dst);
+        return;
+    }
+
+    // 連続した範囲に分けて並列に展開する。要素のアドレスから位置を逆算すると、
+    // 並列アルゴリズムが要素をコピーして渡した場合に壊れるため、範囲は値で持つ
+    struct Range { size_t begin; size_t end; };
+    constexpr size_t kChunkCount = 64;
+    std::array<Range, kChunkCount> ranges;
+    const size_t count = sortedKeys.size();
+    for (size_t c = 0; c < kChunkCount; ++c) {
+        ranges[c] = { count * c / kChunkCount, count * (c + 1) / kChunkCount };
+    }
+
+    std::for_each(std::execution::par, ranges.begin(), ranges.end(),
+        [sortedKeys, params, dst](const Range& range) {
+            for (size_t i = range.begin; i < range.end; ++i) {
+                ExpandQuad(params[SpriteSort::IndexOf(sortedKeys[i])], dst + i * 4);
+            }
+        });
+}
+
+bool IsVisible(const SpriteParams& params, const ViewRect& view) noexcept
+{
+    float minX, minY, maxX, maxY;
+    if (params.rotation == 0.0f) {
+        // 負のスケールでは x1 < x0 になり得る
+        minX = params.posX + (std::min)(params.x0, params.x1);
+        maxX = params.posX + (std::max)(params.x0, params.x1);
+        minY = params.posY + (std::min)(params.y0, params.y1);
+        maxY = params.posY + (std::max)(params.y0, params.y1);
+    } else {
+        // 原点から最も遠い角までの距離を半径とする外接円
+        const float farX = (std::max)(std::abs(params.x0), std::abs(params.x1));
+        const float farY = (std::max)(std::abs(params.y0), std::abs(params.y1));
+        const float radius = std::sqrt(farX * farX + farY * farY);
+        minX = params.posX - radius;
+        maxX = params.posX + radius;
+        minY = params.posY - radius;
+        maxY = params.posY + radius;
+    }
+    return maxX >= view.minX && minX <= view.maxX &&
+           maxY >= view.minY && minY <= view.maxY;
+}
+
+ViewRect MakeViewRect(float centerX, float centerY,
+                      float halfWidth, float halfHeight, float rotation) noexcept
+{
+    const float c = std::abs(std::cos(rotation));
+    const float s = std::abs(std::sin(rotation));
+    const float extentX = c * halfWidth + s * halfHeight;
+    const float extentY = s * halfWidth + c * halfHeight;
+    return { centerX - extentX, centerY - extentY, centerX + extentX, centerY + extentY };
+}
+
+uint32_t PackColor(const Color& color) noexcept
+{
+    auto toByte = [](float v) -> uint32_t {
+        v = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+        return static_cast<uint32_t>(v * 255.0f + 0.5f);
+    };
+    return toByte(color.x) | (toByte(color.y) << 8) | (toByte(color.z) << 16) | (toByte(color.w) << 24);
+}
+
+SpriteInstance PackInstance(const SpriteParams& params) noexcept
+{
+    SpriteInstance inst;
+    inst.position[0] = params.posX;
+    inst.position[1] = params.posY;
+    inst.rect[0] = params.x0;
+    inst.rect[1] = params.y0;
+    inst.rect[2] = params.x1;
+    inst.rect[3] = params.y1;
+    inst.rotDepth[0] = params.rotation;
+    inst.rotDepth[1] = params.depth;
+    inst.uvRect[0] = params.u0;
+    inst.uvRect[1] = params.v0;
+    inst.uvRect[2] = params.u1;
+    inst.uvRect[3] = params.v1;
+    inst.color = PackColor(params.color);
+    return inst;
+}
+
+void PackInstances(std::span<const uint64_t> sortedKeys,
+                   std::span<const SpriteParams> params,
+                   SpriteInstance* dst) noexcept
+{
+    for (size_t i = 0; i < sortedKeys.size(); ++i) {
+        dst[i] = PackInstance(params[SpriteSort::IndexOf(sortedKeys[i])]);
+    }
+}
+
+void BuildInstanceBatches(std::span<const uint64_t> sortedKeys,
+                          std::span<const SpriteParams> params,
+                          uint32_t maxPerChunk,
+                          std::vector<InstanceBatch>& batches)
+{
+    batches.clear();
+    const uint32_t count = static_cast<uint32_t>(sortedKeys.size());
+    for (uint32_t i = 0; i < count; ++i) {
+        Texture* texture = params[SpriteSort::IndexOf(sortedKeys[i])].texture;
+        const bool chunkStart = maxPerChunk > 0 && (i % maxPerChunk) == 0;
+        if (batches.empty() || chunkStart || batches.back().texture != texture) {
+            batches.push_back({ texture, i, 1 });
+        } else {
+            ++batches.back().count;
+        }
+    }
+}
+
+} // namespace SpriteGeometry
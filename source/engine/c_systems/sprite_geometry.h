@@ -0,0 +1,158 @@
+//----------------------------------------------------------------------------
+//! @file   sprite_geometry.h
+//! @brief  スプライトの頂点展開とインスタンスパック（CPUステージ）
+//!
+//! @details SpriteBatchがDraw()で記録するスプライトパラメータと、
+//!          そこから作る2種類のGPU入力（4頂点 / 1インスタンス）を定義する。
+//!          D3D11に依存しないため、バイト配置やバッチ分割をデバイスなしで検証できる。
+//----------------------------------------------------------------------------
+#pragma once
+
+#include "engine/math/math_types.h"
+#include "engine/math/color.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class Texture;
+
+namespace SpriteGeometry {
+
+//----------------------------------------------------------------------------
+//! @brief スプライト1枚分の描画パラメータ
+//!
+//! 原点・スケール・反転を適用済みの値を持つ。回転のみ未適用。
+//----------------------------------------------------------------------------
+struct SpriteParams {
+    Texture* texture;
+    float posX, posY;        //!< 原点のワールド座標
+    float x0, y0, x1, y1;    //!< 回転前のローカル矩形（原点基準、スケール適用済み）
+    float rotation;          //!< 回転（ラジアン）
+    float depth;             //!< 深度値（CalculateDepth）
+    float u0, v0, u1, v1;    //!< UV矩形（反転適用済み）
+    Color color;
+};
+
+//! @brief スプライト頂点（sprite_vs.hlslの頂点入力）
+struct SpriteVertex {
+    Vector3 position;
+    Vector2 texCoord;
+    Color color;
+};
+
+//----------------------------------------------------------------------------
+//! @brief スプライトインスタンス（sprite_vs.hlsl SPRITE_INSTANCEDの入力）
+//!
+//! 頂点4つ（144バイト）の代わりに1レコード（52バイト）を転送し、
+//! 四角形への展開は頂点シェーダーで行う。
+//----------------------------------------------------------------------------
+struct SpriteInstance {
+    float position[2];   //!< POSITION0  原点のワールド座標
+    float rect[4];       //!< TEXCOORD1  ローカル矩形 (x0, y0, x1, y1)
+    float rotDepth[2];   //!< TEXCOORD2  回転（ラジアン）, 深度値
+    float uvRect[4];     //!< TEXCOORD0  UV矩形 (u0, v0, u1, v1)
+    uint32_t color;      //!< COLOR0     R8G8B8A8_UNORM
+};
+static_assert(sizeof(SpriteInstance) == 52, "SpriteInstanceのサイズが入力レイアウトと一致しません");
+static_assert(offsetof(SpriteInstance, rect) == 8);
+static_assert(offsetof(SpriteInstance, rotDepth) == 24);
+static_assert(offsetof(SpriteInstance, uvRect) == 32);
+static_assert(offsetof(SpriteInstance, color) == 48);
+
+//! @brief カリング用の表示範囲（ワールド座標のAABB）
+struct ViewRect {
+    float minX, minY, maxX, maxY;
+};
+
+//! @brief 同じテクスチャで連続するスプライトの範囲（1描画コール分）
+struct InstanceBatch {
+    Texture* texture;
+    uint32_t first;      //!< 整列後の先頭位置
+    uint32_t count;
+};
+
+//----------------------------------------------------------------------------
+//! @brief パラメータを4頂点に展開（左上, 右上, 左下, 右下）
+//! @param params スプライトパラメータ
+//! @param out 出力先（4要素）
+//----------------------------------------------------------------------------
+void ExpandQuad(const SpriteParams& params, SpriteVertex* out) noexcept;
+
+//! @brief これ未満のスプライト数ではExpandQuadsParallelを直列で実行する
+constexpr size_t kParallelExpandThreshold = 4096;
+
+//----------------------------------------------------------------------------
+//! @brief 整列済みキーの順に4頂点へ展開
+//! @param sortedKeys 整列済みソートキー（SpriteSort::MakeKey）
+//! @param params キュー上のパラメータ（キーの投入順で参照）
+//! @param dst 出力先（sortedKeys.size() * 4要素、マップしたバッファを直接渡せる）
+//----------------------------------------------------------------------------
+void ExpandQuads(std::span<const uint64_t> sortedKeys,
+                 std::span<const SpriteParams> params,
+                 SpriteVertex* dst) noexcept;
+
+//----------------------------------------------------------------------------
+//! @brief ExpandQuadsの並列版
+//! @note 各スプライトの書き込み先は整列後の位置で決まるため、
+//!       出力はExpandQuadsとバイト単位で一致する。
+//!       kParallelExpandThreshold未満は直列で展開する。
+//----------------------------------------------------------------------------
+void ExpandQuadsParallel(std::span<const uint64_t> sortedKeys,
+                         std::span<const SpriteParams> params,
+                         SpriteVertex* dst);
+
+//----------------------------------------------------------------------------
+//! @brief スプライトが表示範囲に掛かる可能性があるか判定
+//! @param params スプライトパラメータ
+//! @param view 表示範囲
+//! @return 範囲外と確定できる場合のみfalse
+//! @note 回転なしは矩形そのもの、回転ありは原点中心の外接円で判定する（三角関数不要）。
+//!       見えているスプライトをfalseにすることはない。
+//----------------------------------------------------------------------------
+[[nodiscard]] bool IsVisible(const SpriteParams& params, const ViewRect& view) noexcept;
+
+//----------------------------------------------------------------------------
+//! @brief 回転したカメラの表示範囲を囲むAABBを計算
+//! @param centerX, centerY カメラ中心（ワールド座標）
+//! @param halfWidth, halfHeight 表示範囲の半分の大きさ（ズーム適用済み）
+//! @param rotation カメラの回転（ラジアン）
+//----------------------------------------------------------------------------
+[[nodiscard]] ViewRect MakeViewRect(float centerX, float centerY,
+                                    float halfWidth, float halfHeight, float rotation) noexcept;
+
+//----------------------------------------------------------------------------
+//! @brief 色をR8G8B8A8_UNORMにパック（各成分は0～1にクランプ）
+//----------------------------------------------------------------------------
+[[nodiscard]] uint32_t PackColor(const Color& color) noexcept;
+
+//----------------------------------------------------------------------------
+//! @brief パラメータを1インスタンスにパック
+//----------------------------------------------------------------------------
+[[nodiscard]] SpriteInstance PackInstance(const SpriteParams& params) noexcept;
+
+//----------------------------------------------------------------------------
+//! @brief 整列済みキーの順にインスタンスをパック
+//! @param sortedKeys 整列済みソートキー（SpriteSort::MakeKey）
+//! @param params キュー上のパラメータ（キーの投入順で参照）
+//! @param dst 出力先（sortedKeys.size()要素、マップしたバッファを直接渡せる）
+//----------------------------------------------------------------------------
+void PackInstances(std::span<const uint64_t> sortedKeys,
+                   std::span<const SpriteParams> params,
+                   SpriteInstance* dst) noexcept;
+
+//----------------------------------------------------------------------------
+//! @brief 整列済みキーから描画コール単位のバッチを作成
+//! @param sortedKeys 整列済みソートキー
+//! @param params キュー上のパラメータ
+//! @param maxPerChunk 1回のマップで転送できる最大インスタンス数（0で分割なし）
+//! @param[out] batches バッチ一覧（クリアしてから追加）
+//! @note テクスチャが変わる位置と、maxPerChunkの倍数の位置で分割する。
+//!       1バッチが2つのチャンクにまたがることはない。
+//----------------------------------------------------------------------------
+void BuildInstanceBatches(std::span<const uint64_t> sortedKeys,
+                          std::span<const SpriteParams> params,
+                          uint32_t maxPerChunk,
+                          std::vector<InstanceBatch>& batches);
+
+} // namespace SpriteGeometry
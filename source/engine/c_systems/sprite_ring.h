@@ -0,0 +1,80 @@
+//----------------------------------------------------------------------------
+//! @file   sprite_ring.h
+//! @brief  SpriteBatchの動的バッファ容量とリング書き込み位置の管理
+//!
+//! @details バッファ自体は持たず、容量の成長方針と書き込み位置の決定だけを行う。
+//!          追記できる間はD3D11_MAP_WRITE_NO_OVERWRITE、
+//!          末尾を越える場合は先頭に戻ってD3D11_MAP_WRITE_DISCARDでマップする。
+//----------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+
+namespace SpriteRing {
+
+//! @brief 初期容量（スプライト数）
+constexpr uint32_t kInitialCapacity = 2048;
+
+//! @brief 最大容量（スプライト数）。頂点バッファで約75MB
+//! @note これを超える数はEnd()内で複数回に分けて転送する
+constexpr uint32_t kMaxCapacity = 1u << 19;
+
+//----------------------------------------------------------------------------
+//! @brief 必要数を満たす新しい容量を計算
+//! @param current 現在の容量
+//! @param required 1回で転送したいスプライト数
+//! @return 新しい容量（2のべき乗、kMaxCapacityが上限）。拡張不要ならcurrent
+//----------------------------------------------------------------------------
+[[nodiscard]] constexpr uint32_t GrowCapacity(uint32_t current, uint32_t required) noexcept
+{
+    if (required <= current || current >= kMaxCapacity) {
+        return current;
+    }
+    uint32_t capacity = current > 0 ? current : kInitialCapacity;
+    while (capacity < required && capacity < kMaxCapacity) {
+        capacity *= 2;
+    }
+    return capacity < kMaxCapacity ? capacity : kMaxCapacity;
+}
+
+//----------------------------------------------------------------------------
+//! @brief リングバッファの書き込み位置
+//----------------------------------------------------------------------------
+class Cursor {
+public:
+    //! @brief 確保結果
+    struct Allocation {
+        uint32_t first;  //!< 書き込み先頭（要素単位）
+        bool discard;    //!< trueならDISCARD、falseならNO_OVERWRITEでマップする
+    };
+
+    //! @brief 容量を設定し、先頭に戻す（バッファを作り直したとき）
+    void Reset(uint32_t capacity) noexcept
+    {
+        capacity_ = capacity;
+        position_ = 0;
+    }
+
+    //! @brief count要素分の領域を確保
+    //! @pre count <= 容量
+    [[nodiscard]] Allocation Allocate(uint32_t count) noexcept
+    {
+        // 先頭から書く場合は必ずDISCARD（GPUが使用中の領域を上書きしない）
+        if (position_ == 0 || position_ + count > capacity_) {
+            position_ = count;
+            return { 0, true };
+        }
+        const uint32_t first = position_;
+        position_ += count;
+        return { first, false };
+    }
+
+    [[nodiscard]] uint32_t GetCapacity() const noexcept { return capacity_; }
+    [[nodiscard]] uint32_t GetPosition() const noexcept { return position_; }
+
+private:
+    uint32_t capacity_ = 0;
+    uint32_t position_ = 0;
+};
+
+} // namespace SpriteRing
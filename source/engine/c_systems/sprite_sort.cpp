@@ -0,0 +1,79 @@
+//----------------------------------------------------------------------------
+//! @file   sprite_sort.cpp
+//! @brief  スプライト描画順の基数ソート実装
+//----------------------------------------------------------------------------
+
+#include "sprite_sort.h"
+#include <algorithm>
+
+namespace SpriteSort {
+
+namespace {
+
+constexpr uint32_t kDigitBits = 8;
+constexpr uint32_t kDigitCount = 64 / kDigitBits;
+constexpr uint32_t kBucketCount = 1u << kDigitBits;
+
+//! 小さい入力は挿入ソートの方が速い
+constexpr size_t kSmallSortThreshold = 64;
+
+} // namespace
+
+void RadixSort(std::vector<uint64_t>& keys, std::vector<uint64_t>& scratch)
+{
+    const size_t count = keys.size();
+    if (count < 2) return;
+
+    if (count <= kSmallSortThreshold) {
+        for (size_t i = 1; i < count; ++i) {
+            const uint64_t k = keys[i];
+            size_t j = i;
+            for (; j > 0 && keys[j - 1] > k; --j) {
+                keys[j] = keys[j - 1];
+            }
+            keys[j] = k;
+        }
+        return;
+    }
+
+    // 全桁のヒストグラムを1回の走査で作成
+    uint32_t histogram[kDigitCount][kBucketCount] = {};
+    for (uint64_t k : keys) {
+        for (uint32_t d = 0; d < kDigitCount; ++d) {
+            ++histogram[d][(k >> (d * kDigitBits)) & (kBucketCount - 1)];
+        }
+    }
+
+    scratch.resize(count);
+    uint64_t* src = keys.data();
+    uint64_t* dst = scratch.data();
+
+    for (uint32_t d = 0; d < kDigitCount; ++d) {
+        uint32_t* counts = histogram[d];
+        const uint32_t shift = d * kDigitBits;
+
+        // 全キーが同じ桁値ならこのパスは不要
+        if (counts[(src[0] >> shift) & (kBucketCount - 1)] == count) continue;
+
+        // 出力位置（排他的プレフィックス和）
+        uint32_t offset = 0;
+        for (uint32_t b = 0; b < kBucketCount; ++b) {
+            const uint32_t c = counts[b];
+            counts[b] = offset;
+            offset += c;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            const uint64_t k = src[i];
+            dst[counts[(k >> shift) & (kBucketCount - 1)]++] = k;
+        }
+        std::swap(src, dst);
+    }
+
+    // 奇数回スワップした場合は結果が作業領域側にある
+    if (src != keys.data()) {
+        std::copy(src, src + count, keys.data());
+    }
+}
+
+} // namespace SpriteSort
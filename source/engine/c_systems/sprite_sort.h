@@ -0,0 +1,91 @@
+//----------------------------------------------------------------------------
+//! @file   sprite_sort.h
+//! @brief  スプライト描画順の64bitソートキーと基数ソート
+//!
+//! @details SpriteBatchの描画キューを並べ替えるCPUステージ。
+//!          1スプライトにつき1つの64bitキーを作り、LSD基数ソートで整列する。
+//!          キーの下位ビットに投入順を含むため、整列後のキーから
+//!          そのままキュー上のインデックスを復元できる。
+//!          D3D11に依存しないため、デバイスなしでテスト可能。
+//----------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace SpriteSort {
+
+//----------------------------------------------------------------------------
+// キーのビット配置（上位から比較される）
+//
+//   [63..48] sortingLayer   符号反転した16bit（kMinSortOrder～kMaxSortOrder）
+//   [47..32] orderInLayer   符号反転した16bit（kMinSortOrder～kMaxSortOrder）
+//   [31..22] textureId      10bit（テクスチャ別グループ化用、未使用時は0）
+//   [21.. 0] sequence       22bit（投入順 = キュー上のインデックス）
+//----------------------------------------------------------------------------
+
+constexpr uint32_t kSequenceBits = 22;
+constexpr uint32_t kTextureBits = 10;
+constexpr uint32_t kOrderShift = 32;
+constexpr uint32_t kLayerShift = 48;
+
+//! @brief 1回のソートで扱える最大スプライト数
+constexpr uint32_t kMaxSequence = 1u << kSequenceBits;
+
+//! @brief テクスチャIDの最大値（超えた分はこの値に丸める）
+constexpr uint32_t kMaxTextureId = (1u << kTextureBits) - 1;
+
+constexpr uint64_t kSequenceMask = (uint64_t{1} << kSequenceBits) - 1;
+
+//! @brief sortingLayer/orderInLayerとして区別できる範囲（キーの16bit幅）
+constexpr int kMinSortOrder = -32768;
+constexpr int kMaxSortOrder = 32767;
+
+//! @brief sortingLayer/orderInLayerがキーで区別できる範囲内か
+[[nodiscard]] constexpr bool IsSortOrderInRange(int value) noexcept
+{
+    return value >= kMinSortOrder && value <= kMaxSortOrder;
+}
+
+//! @brief 符号付き値を16bitにし、符号なし比較で順序が保たれる形にする
+//! @note 範囲外の値はクランプされ、同じ端の値と同順（投入順）になる。
+//!       SpriteRendererのセッターとSpriteBatchの投入時にアサートで検出する。
+[[nodiscard]] constexpr uint64_t BiasSigned16(int value) noexcept
+{
+    const int clamped = value < kMinSortOrder ? kMinSortOrder : (value > kMaxSortOrder ? kMaxSortOrder : value);
+    return static_cast<uint64_t>(static_cast<uint16_t>(clamped) ^ 0x8000u);
+}
+
+//----------------------------------------------------------------------------
+//! @brief ソートキーを作成
+//! @param sortingLayer ソーティングレイヤー（小さいほど先に描画）
+//! @param orderInLayer レイヤー内順序（小さいほど先に描画）
+//! @param textureId テクスチャID（同じ描画順のスプライトをテクスチャ別にまとめる）
+//! @param sequence 投入順（キュー上のインデックス）
+//----------------------------------------------------------------------------
+[[nodiscard]] constexpr uint64_t MakeKey(int sortingLayer, int orderInLayer,
+                                         uint32_t textureId, uint32_t sequence) noexcept
+{
+    const uint64_t tex = textureId > kMaxTextureId ? kMaxTextureId : textureId;
+    return (BiasSigned16(sortingLayer) << kLayerShift) |
+           (BiasSigned16(orderInLayer) << kOrderShift) |
+           (tex << kSequenceBits) |
+           (static_cast<uint64_t>(sequence) & kSequenceMask);
+}
+
+//! @brief キーからキュー上のインデックスを取得
+[[nodiscard]] constexpr uint32_t IndexOf(uint64_t key) noexcept
+{
+    return static_cast<uint32_t>(key & kSequenceMask);
+}
+
+//----------------------------------------------------------------------------
+//! @brief キー配列をLSD基数ソート（8bit桁 × 最大8パス）
+//! @param keys 整列対象（結果もここに入る）
+//! @param scratch 作業領域（呼び出し間で再利用する）
+//! @note 全キーで同じ値の桁はパスを省略する。
+//!       キーは一意（投入順を含む）なので安定性は問題にならない。
+//----------------------------------------------------------------------------
+void RadixSort(std::vector<uint64_t>& keys, std::vector<uint64_t>& scratch);
+
+} // namespace SpriteSort
@@ -0,0 +1,89 @@
+//----------------------------------------------------------------------------
+//! @file   sprite_static.cpp
+//! @brief  静的スプライトブロック実装
+//----------------------------------------------------------------------------
+
+#include "sprite_static.h"
+#include "sprite_sort.h"
+#include <algorithm>
+
+namespace SpriteStatic {
+
+namespace {
+
+//! 範囲を描画リストへ追加（直前と連続する同じテクスチャなら結合）
+void AppendDraw(const Range& range, std::vector<SpriteGeometry::InstanceBatch>& draws)
+{
+    if (!draws.empty()) {
+        auto& last = draws.back();
+        if (last.texture == range.texture && last.first + last.count == range.first) {
+            last.count += range.count;
+            return;
+        }
+    }
+    draws.push_back({ range.texture, range.first, range.count });
+}
+
+} // namespace
+
+void Build(std::span<const uint64_t> keys,
+           std::span<const SpriteGeometry::SpriteParams> params,
+           uint32_t maxPerRange,
+           Block& out)
+{
+    out.vertices.clear();
+    out.ranges.clear();
+    if (keys.empty()) return;
+
+    std::vector<uint64_t> sorted(keys.begin(), keys.end());
+    std::vector<uint64_t> scratch;
+    SpriteSort::RadixSort(sorted, scratch);
+
+    out.vertices.resize(sorted.size() * 4);
+    SpriteGeometry::ExpandQuads(sorted, params, out.vertices.data());
+
+    if (maxPerRange == 0) maxPerRange = kMaxSpritesPerRange;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(sorted.size()); ++i) {
+        Texture* texture = params[SpriteSort::IndexOf(sorted[i])].texture;
+        if (out.ranges.empty() || out.ranges.back().texture != texture ||
+            out.ranges.back().count >= maxPerRange) {
+            const auto& p = out.vertices[i * 4].position;
+            out.ranges.push_back({ texture, i, 0, { p.x, p.y, p.x, p.y } });
+        }
+
+        // 回転後の4頂点で境界を広げる（判定は厳密）
+        Range& range = out.ranges.back();
+        for (uint32_t v = 0; v < 4; ++v) {
+            const auto& p = out.vertices[i * 4 + v].position;
+            range.bounds.minX = (std::min)(range.bounds.minX, p.x);
+            range.bounds.minY = (std::min)(range.bounds.minY, p.y);
+            range.bounds.maxX = (std::max)(range.bounds.maxX, p.x);
+            range.bounds.maxY = (std::max)(range.bounds.maxY, p.y);
+        }
+        ++range.count;
+    }
+}
+
+void SelectVisible(const Block& block,
+                   const SpriteGeometry::ViewRect& view,
+                   std::vector<SpriteGeometry::InstanceBatch>& draws)
+{
+    draws.clear();
+    for (const Range& range : block.ranges) {
+        const auto& b = range.bounds;
+        if (b.maxX < view.minX || b.minX > view.maxX || b.maxY < view.minY || b.minY > view.maxY) {
+            continue;
+        }
+        AppendDraw(range, draws);
+    }
+}
+
+void SelectAll(const Block& block, std::vector<SpriteGeometry::InstanceBatch>& draws)
+{
+    draws.clear();
+    for (const Range& range : block.ranges) {
+        AppendDraw(range, draws);
+    }
+}
+
+} // namespace SpriteStatic
@@ -0,0 +1,73 @@
+//----------------------------------------------------------------------------
+//! @file   sprite_static.h
+//! @brief  静的スプライトブロック（一度だけ展開して保持する頂点列）
+//!
+//! @details 初期化後に変化しない背景・装飾を、整列・頂点展開済みの状態で保持する。
+//!          毎フレームの処理は範囲ごとの境界と表示範囲の比較だけになる。
+//!          D3D11に依存しないため、構築と範囲選択をデバイスなしで検証できる。
+//----------------------------------------------------------------------------
+#pragma once
+
+#include "sprite_geometry.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace SpriteStatic {
+
+//! @brief 1範囲の最大スプライト数（カリングの粒度）
+constexpr uint32_t kMaxSpritesPerRange = 16;
+
+//----------------------------------------------------------------------------
+//! @brief 整列順で連続し、同じテクスチャを使うスプライトの範囲
+//----------------------------------------------------------------------------
+struct Range {
+    Texture* texture;
+    uint32_t first;                  //!< ブロック内の先頭スプライト
+    uint32_t count;
+    SpriteGeometry::ViewRect bounds; //!< 範囲内の全頂点を囲むAABB
+};
+
+//----------------------------------------------------------------------------
+//! @brief 静的スプライトブロック
+//----------------------------------------------------------------------------
+struct Block {
+    std::vector<SpriteGeometry::SpriteVertex> vertices;  //!< 整列順の頂点（1スプライト4頂点）
+    std::vector<Range> ranges;                           //!< 整列順に並んだ範囲
+
+    [[nodiscard]] uint32_t GetSpriteCount() const noexcept {
+        return static_cast<uint32_t>(vertices.size() / 4);
+    }
+};
+
+//----------------------------------------------------------------------------
+//! @brief スプライトを整列・展開してブロックを作成
+//! @param keys ソートキー（SpriteSort::MakeKey、未整列でよい）
+//! @param params キーの投入順に対応するパラメータ
+//! @param maxPerRange 1範囲の最大スプライト数
+//! @param[out] out 作成したブロック（内容は置き換える）
+//! @note 範囲はテクスチャが変わる位置とmaxPerRangeごとに区切る。
+//!       描画順は動的経路（SpriteBatch::End）と同じになる。
+//----------------------------------------------------------------------------
+void Build(std::span<const uint64_t> keys,
+           std::span<const SpriteGeometry::SpriteParams> params,
+           uint32_t maxPerRange,
+           Block& out);
+
+//----------------------------------------------------------------------------
+//! @brief 表示範囲に掛かる範囲を描画コール単位で取得
+//! @param block ブロック
+//! @param view 表示範囲
+//! @param[out] draws 描画範囲（クリアしてから追加）。
+//!             隣接する同じテクスチャの範囲は1つにまとめる
+//----------------------------------------------------------------------------
+void SelectVisible(const Block& block,
+                   const SpriteGeometry::ViewRect& view,
+                   std::vector<SpriteGeometry::InstanceBatch>& draws);
+
+//----------------------------------------------------------------------------
+//! @brief 全範囲を描画コール単位で取得（カリングなし）
+//----------------------------------------------------------------------------
+void SelectAll(const Block& block, std::vector<SpriteGeometry::InstanceBatch>& draws);
+
+} // namespace SpriteStatic
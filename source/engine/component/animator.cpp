@@ -4,6 +4,7 @@
 //----------------------------------------------------------------------------
 
 #include "animator.h"
+#include "engine/texture/texture_atlas.h"
 #include <cassert>
 
 Animator::Animator(uint8_t rows, uint8_t cols, uint8_t frameInterval)
@@ -152,6 +153,15 @@ Vector4 Animator::GetSourceRect(float textureWidth, float textureHeight) const
     return Vector4(x, y, frameWidth, frameHeight);
 }
 
+Vector4 Animator::GetSourceRect(const TextureRegion& region) const
+{
+    Vector4 rect = GetSourceRect(static_cast<float>(region.rect.width),
+                                 static_cast<float>(region.rect.height));
+    rect.x += static_cast<float>(region.rect.x);
+    rect.y += static_cast<float>(region.rect.y);
+    return rect;
+}
+
 uint8_t Animator::GetCurrentRowFrameLimit() const
 {
     if (currentRow_ >= kMaxRows) return colCount_;
@@ -9,6 +9,8 @@
 #include <cstdint>
 #include <array>
 
+struct TextureRegion;
+
 //============================================================================
 //! @brief スプライトシートアニメーションコンポーネント
 //!
@@ -143,6 +145,11 @@ public:
     //! @return (x, y, width, height)
     [[nodiscard]] Vector4 GetSourceRect(float textureWidth, float textureHeight) const;
 
+    //! @brief アトラス上の領域内で現在フレームのソース矩形を取得（ピクセル単位）
+    //! @param region スプライトシートの領域（TextureManager::AddToAtlas）
+    //! @return region.texture上の(x, y, width, height)
+    [[nodiscard]] Vector4 GetSourceRect(const TextureRegion& region) const;
+
 private:
     //! @brief 現在行の有効フレーム数を取得
     [[nodiscard]] uint8_t GetCurrentRowFrameLimit() const;
@@ -6,6 +6,7 @@
 #include "collider2d.h"
 #include "transform2d.h"
 #include "game_object.h"
+#include <cmath>
 
 Collider2D::Collider2D(const Vector2& size, const Vector2& offset)
     : initSize_(size), initOffset_(offset)
@@ -19,10 +20,17 @@ void Collider2D::OnAttach()
 
     // 初期値を設定
     mgr.SetSize(handle_, initSize_.x, initSize_.y);
+    if (initShape_ == ColliderShape::Circle) {
+        mgr.SetCircle(handle_, initRadius_);
+    } else if (initShape_ == ColliderShape::Capsule) {
+        mgr.SetCapsule(handle_, initAxis_, initRadius_);
+    }
     mgr.SetOffset(handle_, initOffset_.x, initOffset_.y);
     mgr.SetLayer(handle_, initLayer_);
     mgr.SetMask(handle_, initMask_);
     mgr.SetTrigger(handle_, initTrigger_);
+    mgr.SetBullet(handle_, initBullet_);
+    mgr.SetStatic(handle_, initStatic_);
 }
 
 void Collider2D::OnDetach()
@@ -66,6 +74,7 @@ void Collider2D::SetPosition(const Vector2& pos)
 void Collider2D::SetSize(float width, float height)
 {
     initSize_ = Vector2(width, height);  // 常に保存
+    initShape_ = ColliderShape::Box;
     if (handle_.IsValid()) {
         CollisionManager::Get().SetSize(handle_, width, height);
     }
@@ -116,6 +125,49 @@ void Collider2D::SetBounds(const Vector2& min, const Vector2& max)
     SetOffset(offset);
 }
 
+//----------------------------------------------------------------------------
+// 形状
+//----------------------------------------------------------------------------
+
+void Collider2D::SetCircle(float radius)
+{
+    initShape_ = ColliderShape::Circle;  // 常に保存
+    initRadius_ = radius;
+    initAxis_ = Vector2::Zero;
+    initSize_ = Vector2(radius * 2.0f, radius * 2.0f);
+    if (handle_.IsValid()) {
+        CollisionManager::Get().SetCircle(handle_, radius);
+    }
+}
+
+void Collider2D::SetCapsule(const Vector2& halfSegment, float radius)
+{
+    initShape_ = ColliderShape::Capsule;  // 常に保存
+    initRadius_ = radius;
+    initAxis_ = halfSegment;
+    initSize_ = Vector2((std::abs(halfSegment.x) + radius) * 2.0f,
+                        (std::abs(halfSegment.y) + radius) * 2.0f);
+    if (handle_.IsValid()) {
+        CollisionManager::Get().SetCapsule(handle_, halfSegment, radius);
+    }
+}
+
+ColliderShape Collider2D::GetShape() const
+{
+    if (handle_.IsValid()) {
+        return CollisionManager::Get().GetShape(handle_);
+    }
+    return initShape_;
+}
+
+float Collider2D::GetRadius() const
+{
+    if (handle_.IsValid()) {
+        return CollisionManager::Get().GetRadius(handle_);
+    }
+    return initRadius_;
+}
+
 //----------------------------------------------------------------------------
 // レイヤーとマスク
 //----------------------------------------------------------------------------
@@ -180,6 +232,48 @@ bool Collider2D::IsTrigger() const
     return initTrigger_;
 }
 
+//----------------------------------------------------------------------------
+// 弾丸モード
+//----------------------------------------------------------------------------
+
+void Collider2D::SetBullet(bool bullet)
+{
+    if (handle_.IsValid()) {
+        CollisionManager::Get().SetBullet(handle_, bullet);
+    } else {
+        initBullet_ = bullet;
+    }
+}
+
+bool Collider2D::IsBullet() const
+{
+    if (handle_.IsValid()) {
+        return CollisionManager::Get().IsBullet(handle_);
+    }
+    return initBullet_;
+}
+
+//----------------------------------------------------------------------------
+// 静的コライダー
+//----------------------------------------------------------------------------
+
+void Collider2D::SetStatic(bool isStatic)
+{
+    if (handle_.IsValid()) {
+        CollisionManager::Get().SetStatic(handle_, isStatic);
+    } else {
+        initStatic_ = isStatic;
+    }
+}
+
+bool Collider2D::IsStatic() const
+{
+    if (handle_.IsValid()) {
+        return CollisionManager::Get().IsStatic(handle_);
+    }
+    return initStatic_;
+}
+
 //----------------------------------------------------------------------------
 // 有効/無効
 //----------------------------------------------------------------------------
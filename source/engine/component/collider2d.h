@@ -1,6 +1,6 @@
 //----------------------------------------------------------------------------
 //! @file   collider2d.h
-//! @brief  2D当たり判定コンポーネント（AABB）
+//! @brief  2D当たり判定コンポーネント（AABB/円/カプセル）
 //----------------------------------------------------------------------------
 #pragma once
 
@@ -61,6 +61,22 @@ public:
     //------------------------------------------------------------------------
     void SetBounds(const Vector2& min, const Vector2& max);
 
+    //------------------------------------------------------------------------
+    // 形状（デフォルトは矩形。SetSize/SetBoundsで矩形に戻る）
+    //------------------------------------------------------------------------
+
+    //! @brief 円形状に設定
+    //! @param radius 半径
+    void SetCircle(float radius);
+
+    //! @brief カプセル形状に設定
+    //! @param halfSegment 中心から線分の端点へのベクトル
+    //! @param radius 半径
+    void SetCapsule(const Vector2& halfSegment, float radius);
+
+    [[nodiscard]] ColliderShape GetShape() const;
+    [[nodiscard]] float GetRadius() const;
+
     //------------------------------------------------------------------------
     // レイヤーとマスク
     //------------------------------------------------------------------------
@@ -80,6 +96,21 @@ public:
     void SetTrigger(bool trigger);
     [[nodiscard]] bool IsTrigger() const;
 
+    //------------------------------------------------------------------------
+    // 弾丸モード（連続衝突判定）
+    //------------------------------------------------------------------------
+
+    //! @brief 高速移動でのすり抜けを防ぐ掃引判定を有効化
+    void SetBullet(bool bullet);
+    [[nodiscard]] bool IsBullet() const;
+
+    //------------------------------------------------------------------------
+    // 静的コライダー（動かない壁・装飾など）
+    //------------------------------------------------------------------------
+
+    void SetStatic(bool isStatic);
+    [[nodiscard]] bool IsStatic() const;
+
     //------------------------------------------------------------------------
     // 有効/無効
     //------------------------------------------------------------------------
@@ -137,9 +168,14 @@ private:
     // 初期化用の一時保存（OnAttach前に設定された値を保持）
     Vector2 initSize_ = Vector2::Zero;
     Vector2 initOffset_ = Vector2::Zero;
+    ColliderShape initShape_ = ColliderShape::Box;
+    float initRadius_ = 0.0f;
+    Vector2 initAxis_ = Vector2::Zero;
     uint8_t initLayer_ = CollisionConstants::kDefaultLayer;
     uint8_t initMask_ = CollisionConstants::kDefaultMask;
     bool initTrigger_ = false;
+    bool initBullet_ = false;
+    bool initStatic_ = false;
     bool syncWithTransform_ = true;  //!< Transform2Dと自動同期するか
 
     void* userData_ = nullptr;  //!< ユーザー定義データ
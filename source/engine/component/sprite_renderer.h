@@ -7,6 +7,9 @@
 #include "component.h"
 #include "engine/math/color.h"
 #include "engine/math/math_types.h"
+#include "engine/texture/texture_atlas.h"
+#include "engine/c_systems/sprite_sort.h"
+#include <cassert>
 
 // 前方宣言
 class Texture;
@@ -33,7 +36,24 @@ public:
     //------------------------------------------------------------------------
 
     [[nodiscard]] Texture* GetTexture() const noexcept { return texture_; }
-    void SetTexture(Texture* texture) noexcept { texture_ = texture; }
+    void SetTexture(Texture* texture) noexcept {
+        texture_ = texture;
+        sourceRect_ = Vector4::Zero;
+    }
+
+    //! @brief テクスチャ上の領域を設定（TextureManager::AddToAtlasの戻り値）
+    //! @note テクスチャはアトラスページになり、描画サイズ・UVは領域基準になる。
+    //!       Animatorのフレーム分割も領域内で行われる。
+    void SetRegion(const TextureRegion& region) noexcept {
+        texture_ = region.texture;
+        sourceRect_ = region.SourceRect();
+    }
+
+    //! @brief 領域のソース矩形を取得（ピクセル、(x, y, width, height)）
+    [[nodiscard]] const Vector4& GetSourceRect() const noexcept { return sourceRect_; }
+
+    //! @brief 領域が設定されているか（falseならテクスチャ全体を使用）
+    [[nodiscard]] bool HasRegion() const noexcept { return sourceRect_.z > 0.0f && sourceRect_.w > 0.0f; }
 
     //------------------------------------------------------------------------
     // カラー
@@ -53,13 +73,21 @@ public:
 
     //------------------------------------------------------------------------
     // 描画順（レイヤー）
+    //   有効範囲は -32768～32767（SpriteSort::kMinSortOrder～kMaxSortOrder）。
+    //   ソートキーの16bit幅に収まらない値は区別されず、投入順に並ぶ。
     //------------------------------------------------------------------------
 
     [[nodiscard]] int GetSortingLayer() const noexcept { return sortingLayer_; }
-    void SetSortingLayer(int layer) noexcept { sortingLayer_ = layer; }
+    void SetSortingLayer(int layer) noexcept {
+        assert(SpriteSort::IsSortOrderInRange(layer) && "SetSortingLayer: -32768～32767の範囲外です");
+        sortingLayer_ = layer;
+    }
 
     [[nodiscard]] int GetOrderInLayer() const noexcept { return orderInLayer_; }
-    void SetOrderInLayer(int order) noexcept { orderInLayer_ = order; }
+    void SetOrderInLayer(int order) noexcept {
+        assert(SpriteSort::IsSortOrderInRange(order) && "SetOrderInLayer: -32768～32767の範囲外です");
+        orderInLayer_ = order;
+    }
 
     //------------------------------------------------------------------------
     // 反転
@@ -123,6 +151,7 @@ public:
 
 private:
     Texture* texture_ = nullptr;
+    Vector4 sourceRect_ = Vector4::Zero;  //!< テクスチャ上の領域（0でテクスチャ全体）
     Color color_ = Colors::White;    //!< 乗算カラー
     Vector2 size_ = Vector2::Zero;   //!< カスタムサイズ（0,0でテクスチャサイズ）
     Vector2 pivot_ = Vector2::Zero;  //!< スプライトの原点（0,0で左上）
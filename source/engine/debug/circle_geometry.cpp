@@ -0,0 +1,51 @@
+//----------------------------------------------------------------------------
+//! @file   circle_geometry.cpp
+//! @brief  円インスタンスのパックと描画範囲の分割
+//----------------------------------------------------------------------------
+
+#include "circle_geometry.h"
+#include <algorithm>
+
+namespace CircleGeometry {
+
+CircleInstance MakeFilled(const Vector2& center, float radius, const Color& color) noexcept
+{
+    return { { center.x, center.y }, radius, 0.0f, { color.x, color.y, color.z, color.w } };
+}
+
+CircleInstance MakeOutline(const Vector2& center, float radius,
+                           const Color& color, float lineWidth) noexcept
+{
+    const float halfWidth = (std::max)(lineWidth, 0.0f) * 0.5f;
+    const float outer = radius + halfWidth;
+
+    // 内側の半径が0以下なら穴は無い
+    const float thickness = (radius - halfWidth > 0.0f) ? halfWidth * 2.0f : 0.0f;
+    return { { center.x, center.y }, outer, thickness, { color.x, color.y, color.z, color.w } };
+}
+
+bool IsDrawable(const CircleInstance& circle) noexcept
+{
+    return circle.radius > 0.0f && circle.color[3] > 0.0f;
+}
+
+bool IsVisible(const CircleInstance& circle, const SpriteGeometry::ViewRect& view) noexcept
+{
+    return circle.center[0] + circle.radius >= view.minX && circle.center[0] - circle.radius <= view.maxX &&
+           circle.center[1] + circle.radius >= view.minY && circle.center[1] - circle.radius <= view.maxY;
+}
+
+void PlanDraws(uint32_t count, SpriteRing::Cursor& ring, std::vector<DrawRange>& ranges)
+{
+    ranges.clear();
+    const uint32_t capacity = ring.GetCapacity();
+    if (capacity == 0) return;
+
+    for (uint32_t source = 0; source < count; source += capacity) {
+        const uint32_t chunk = (std::min)(capacity, count - source);
+        const auto alloc = ring.Allocate(chunk);
+        ranges.push_back({ source, alloc.first, chunk, alloc.discard });
+    }
+}
+
+} // namespace CircleGeometry
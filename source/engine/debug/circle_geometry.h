@@ -0,0 +1,78 @@
+//----------------------------------------------------------------------------
+//! @file   circle_geometry.h
+//! @brief  円インスタンスのパックと描画範囲の分割（CPUステージ）
+//!
+//! @details CircleRendererが1円1インスタンスで転送するレコードと、
+//!          それをリングバッファへ詰めて描画コールに分ける処理を定義する。
+//!          D3D11に依存しないため、バイト配置や分割をデバイスなしで検証できる。
+//----------------------------------------------------------------------------
+#pragma once
+
+#include "engine/math/math_types.h"
+#include "engine/math/color.h"
+#include "engine/c_systems/sprite_geometry.h"
+#include "engine/c_systems/sprite_ring.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace CircleGeometry {
+
+//----------------------------------------------------------------------------
+//! @brief 円インスタンス（circle_vs.hlslの入力）
+//!
+//! 四角形への展開は頂点シェーダー、縁の判定と輪郭のぼかしは
+//! ピクセルシェーダーで距離から解析的に行う。
+//----------------------------------------------------------------------------
+struct CircleInstance {
+    float center[2];     //!< POSITION0  中心のワールド座標
+    float radius;        //!< TEXCOORD0.x 外側の半径
+    float thickness;     //!< TEXCOORD0.y 輪の太さ（0で塗りつぶし）
+    float color[4];      //!< COLOR0
+};
+static_assert(sizeof(CircleInstance) == 32, "CircleInstanceのサイズが入力レイアウトと一致しません");
+static_assert(offsetof(CircleInstance, radius) == 8);
+static_assert(offsetof(CircleInstance, color) == 16);
+
+//! @brief 1回のマップで転送し、1描画コールで描く範囲
+struct DrawRange {
+    uint32_t source;     //!< キュー上の先頭位置
+    uint32_t ringFirst;  //!< バッファ上の先頭位置（StartInstanceLocation）
+    uint32_t count;
+    bool discard;        //!< trueならDISCARD、falseならNO_OVERWRITEでマップする
+};
+
+//----------------------------------------------------------------------------
+//! @brief 塗りつぶし円を作成
+//----------------------------------------------------------------------------
+[[nodiscard]] CircleInstance MakeFilled(const Vector2& center, float radius, const Color& color) noexcept;
+
+//----------------------------------------------------------------------------
+//! @brief 円の枠線を作成
+//! @param radius 線の中心の半径（線はradius ± lineWidth / 2に掛かる）
+//! @param lineWidth 線の太さ
+//! @note 線が中心まで届く場合は塗りつぶし円になる
+//----------------------------------------------------------------------------
+[[nodiscard]] CircleInstance MakeOutline(const Vector2& center, float radius,
+                                         const Color& color, float lineWidth) noexcept;
+
+//----------------------------------------------------------------------------
+//! @brief 描画する意味があるか（半径が正で、完全に透明でない）
+//----------------------------------------------------------------------------
+[[nodiscard]] bool IsDrawable(const CircleInstance& circle) noexcept;
+
+//----------------------------------------------------------------------------
+//! @brief 円の外接矩形が表示範囲に掛かるか
+//----------------------------------------------------------------------------
+[[nodiscard]] bool IsVisible(const CircleInstance& circle, const SpriteGeometry::ViewRect& view) noexcept;
+
+//----------------------------------------------------------------------------
+//! @brief キューをリングバッファへの転送範囲に分割
+//! @param count キュー上の円の数
+//! @param ring リングの書き込み位置（容量設定済み、確保した分だけ進む）
+//! @param[out] ranges 転送範囲（クリアしてから追加）
+//! @note 容量以内なら1範囲（1描画コール）になる。容量を超える分だけ分割する。
+//----------------------------------------------------------------------------
+void PlanDraws(uint32_t count, SpriteRing::Cursor& ring, std::vector<DrawRange>& ranges);
+
+} // namespace CircleGeometry
@@ -6,11 +6,14 @@
 
 #ifdef _DEBUG
 
-#include "dx11/graphics_context.h"
 #include "engine/shader/shader_manager.h"
 #include "engine/component/camera2d.h"
 #include "common/logging/logging.h"
 #include <d3d11.h>
+#include <cstring>
+#include <string>
+
+using CircleGeometry::CircleInstance;
 
 //----------------------------------------------------------------------------
 CircleRenderer& CircleRenderer::Get()
@@ -27,7 +30,7 @@ bool CircleRenderer::Initialize()
     ShaderManager& shaderMgr = ShaderManager::Get();
 
     // シェーダー読み込み
-    vertexShader_ = shaderMgr.LoadVertexShader("sprite_vs.hlsl");
+    vertexShader_ = shaderMgr.LoadVertexShader("circle_vs.hlsl");
     pixelShader_ = shaderMgr.LoadPixelShader("circle_ps.hlsl");
 
     if (!vertexShader_ || !pixelShader_) {
@@ -35,11 +38,11 @@ bool CircleRenderer::Initialize()
         return false;
     }
 
-    // 入力レイアウト作成
+    // 入力レイアウト作成（CircleGeometry::CircleInstanceと一致）
     D3D11_INPUT_ELEMENT_DESC inputElements[] = {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 20, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "POSITION", 0, DXGI_FORMAT_R32G32_FLOAT,       0, 0,  D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,       0, 8,  D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
     };
 
     inputLayout_ = shaderMgr.CreateInputLayout(
@@ -52,28 +55,27 @@ bool CircleRenderer::Initialize()
         return false;
     }
 
-    // 頂点バッファ（1つの四角形 = 4頂点）
-    vertexBuffer_ = Buffer::CreateVertex(
-        sizeof(CircleVertex) * 4,
-        sizeof(CircleVertex),
-        true,    // dynamic
-        nullptr  // no initial data
+    // インスタンスバッファ（動的）
+    instanceBuffer_ = Buffer::CreateVertex(
+        static_cast<uint32_t>(sizeof(CircleInstance) * kInitialCapacity),
+        sizeof(CircleInstance),
+        true  // dynamic
     );
-
-    // インデックスバッファ
-    uint16_t indices[6] = { 0, 1, 2, 2, 1, 3 };
-    indexBuffer_ = Buffer::CreateIndex(sizeof(indices), false, indices);
+    if (!instanceBuffer_) {
+        LOG_ERROR("[CircleRenderer] インスタンスバッファ作成失敗");
+        return false;
+    }
+    instanceRing_.Reset(kInitialCapacity);
 
     // 定数バッファ
-    constantBuffer_ = Buffer::CreateConstant(sizeof(Matrix));
+    constantBuffer_ = Buffer::CreateConstant(sizeof(CircleConstants));
 
     // パイプラインステート
     blendState_ = BlendState::CreateAlphaBlend();
-    samplerState_ = SamplerState::CreateDefault();
     rasterizerState_ = RasterizerState::CreateNoCull();
     depthStencilState_ = DepthStencilState::CreateLessEqual();
 
-    if (!blendState_ || !samplerState_ || !rasterizerState_ || !depthStencilState_) {
+    if (!blendState_ || !rasterizerState_ || !depthStencilState_) {
         LOG_ERROR("[CircleRenderer] パイプラインステート作成失敗");
         return false;
     }
@@ -89,14 +91,14 @@ void CircleRenderer::Shutdown()
     vertexShader_.reset();
     pixelShader_.reset();
     inputLayout_.Reset();
-    vertexBuffer_.reset();
-    indexBuffer_.reset();
+    instanceBuffer_.reset();
     constantBuffer_.reset();
+    instanceRing_.Reset(0);
     blendState_.reset();
-    samplerState_.reset();
     rasterizerState_.reset();
     depthStencilState_.reset();
     instances_.clear();
+    ranges_.clear();
     initialized_ = false;
 }
 
@@ -113,7 +115,18 @@ void CircleRenderer::Begin(const Camera2D& camera)
     isBegun_ = true;
 
     // ビュープロジェクション行列を取得
-    constantData_ = Matrix(camera.GetViewProjectionMatrix());
+    constantData_.viewProjection = Matrix(camera.GetViewProjectionMatrix());
+    constantData_.depth = 0.85f;  // 手前に描画
+
+    // カリング用の表示範囲（回転を含めて囲むAABB）
+    const float zoom = camera.GetZoom();
+    const float invZoom = zoom > 0.0f ? 1.0f / zoom : 1.0f;
+    const Vector2 center = camera.GetPosition();
+    viewRect_ = SpriteGeometry::MakeViewRect(
+        center.x, center.y,
+        camera.GetViewportWidth() * 0.5f * invZoom,
+        camera.GetViewportHeight() * 0.5f * invZoom,
+        camera.GetRotation());
 }
 
 //----------------------------------------------------------------------------
@@ -124,60 +137,106 @@ void CircleRenderer::DrawFilled(
 {
     if (!isBegun_) return;
 
-    instances_.push_back({ center, radius, color });
+    Enqueue(CircleGeometry::MakeFilled(center, radius, color));
+}
+
+//----------------------------------------------------------------------------
+void CircleRenderer::DrawOutline(
+    const Vector2& center,
+    float radius,
+    const Color& color,
+    float lineWidth)
+{
+    if (!isBegun_) return;
+
+    Enqueue(CircleGeometry::MakeOutline(center, radius, color, lineWidth));
+}
+
+//----------------------------------------------------------------------------
+void CircleRenderer::Enqueue(const CircleInstance& circle)
+{
+    if (!CircleGeometry::IsDrawable(circle) || !CircleGeometry::IsVisible(circle, viewRect_)) {
+        return;
+    }
+    instances_.push_back(circle);
+}
+
+//----------------------------------------------------------------------------
+void CircleRenderer::EnsureCapacity(uint32_t circleCount)
+{
+    const uint32_t capacity = instanceRing_.GetCapacity();
+    const uint32_t newCapacity = SpriteRing::GrowCapacity(capacity, circleCount);
+    if (newCapacity == capacity) {
+        return;
+    }
+
+    BufferPtr instanceBuffer = Buffer::CreateVertex(
+        static_cast<uint32_t>(sizeof(CircleInstance) * newCapacity),
+        sizeof(CircleInstance),
+        true  // dynamic
+    );
+    if (!instanceBuffer) {
+        // 拡張できなければ現在の容量で分割して転送する
+        LOG_WARN("[CircleRenderer] インスタンスバッファ拡張に失敗（分割して転送します）");
+        return;
+    }
+
+    instanceBuffer_ = std::move(instanceBuffer);
+    instanceRing_.Reset(newCapacity);
+    LOG_INFO("[CircleRenderer] インスタンスバッファを拡張 (" + std::to_string(newCapacity) + " circles)");
 }
 
 //----------------------------------------------------------------------------
 void CircleRenderer::End()
 {
+    drawCallCount_ = 0;
+    circleCount_ = 0;
+
     if (!isBegun_ || instances_.empty()) {
         isBegun_ = false;
         return;
     }
 
-    GraphicsContext& ctx = GraphicsContext::Get();
+    ICommandBackend& commands = commandTarget_ ? *commandTarget_ : contextBackend_;
+
+    // 全ての円を1回で転送できるよう容量を確保（縮小はしない）
+    const uint32_t total = static_cast<uint32_t>(instances_.size());
+    EnsureCapacity(total);
 
     // 定数バッファ更新
-    ctx.UpdateBuffer(constantBuffer_.get(), &constantData_, sizeof(Matrix));
-
-    // パイプライン設定
-    ctx.SetInputLayout(inputLayout_.Get());
-    ctx.SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    ctx.SetVertexBuffer(0, vertexBuffer_.get(), sizeof(CircleVertex));
-    ctx.SetIndexBuffer(indexBuffer_.get(), DXGI_FORMAT_R16_UINT, 0);
-
-    ctx.SetVertexShader(vertexShader_.get());
-    ctx.SetVSConstantBuffer(0, constantBuffer_.get());
-
-    ctx.SetPixelShader(pixelShader_.get());
-    ctx.SetPSSampler(0, samplerState_.get());
-
-    ctx.SetBlendState(blendState_.get());
-    ctx.SetDepthStencilState(depthStencilState_.get());
-    ctx.SetRasterizerState(rasterizerState_.get());
-
-    // 各円を描画
-    for (const CircleInstance& inst : instances_) {
-        float left = inst.center.x - inst.radius;
-        float top = inst.center.y - inst.radius;
-        float right = inst.center.x + inst.radius;
-        float bottom = inst.center.y + inst.radius;
-        float z = 0.85f;  // 手前に描画
-
-        CircleVertex vertices[4] = {
-            { Vector3(left, top, z),     Vector2(0.0f, 0.0f), inst.color },
-            { Vector3(right, top, z),    Vector2(1.0f, 0.0f), inst.color },
-            { Vector3(left, bottom, z),  Vector2(0.0f, 1.0f), inst.color },
-            { Vector3(right, bottom, z), Vector2(1.0f, 1.0f), inst.color }
-        };
-
-        auto* mappedVerts = static_cast<CircleVertex*>(ctx.MapBuffer(vertexBuffer_.get()));
-        if (mappedVerts) {
-            memcpy(mappedVerts, vertices, sizeof(vertices));
-            ctx.UnmapBuffer(vertexBuffer_.get());
+    commands.UpdateConstantBuffer(constantBuffer_.get(), &constantData_, sizeof(CircleConstants));
+
+    // パイプライン設定（四角形は頂点シェーダーでSV_VertexIDから展開）
+    commands.SetInputLayout(inputLayout_.Get());
+    commands.SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+    commands.SetVertexBuffer(0, instanceBuffer_.get(), sizeof(CircleInstance));
+
+    commands.SetShader(ShaderType::Vertex, vertexShader_.get());
+    commands.SetConstantBuffer(ShaderType::Vertex, 0, constantBuffer_.get());
+    commands.SetShader(ShaderType::Pixel, pixelShader_.get());
+
+    commands.SetBlendState(blendState_.get());
+    commands.SetDepthStencilState(depthStencilState_.get());
+    commands.SetRasterizerState(rasterizerState_.get());
+
+    // リングの空きに追記し、転送範囲ごとに1回描画（通常は1範囲）
+    CircleGeometry::PlanDraws(total, instanceRing_, ranges_);
+    for (const CircleGeometry::DrawRange& range : ranges_) {
+        auto* mapped = static_cast<CircleInstance*>(commands.BeginWrite(
+            instanceBuffer_.get(),
+            range.discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE,
+            range.ringFirst * static_cast<uint32_t>(sizeof(CircleInstance)),
+            range.count * static_cast<uint32_t>(sizeof(CircleInstance))));
+        if (!mapped) {
+            LOG_ERROR("[CircleRenderer] インスタンスバッファのマップに失敗");
+            break;
         }
+        memcpy(mapped, instances_.data() + range.source, sizeof(CircleInstance) * range.count);
+        commands.EndWrite(instanceBuffer_.get());
 
-        ctx.DrawIndexed(6);
+        commands.DrawInstanced(4, range.count, 0, range.ringFirst);
+        ++drawCallCount_;
+        circleCount_ += range.count;
     }
 
     instances_.clear();
@@ -1,6 +1,10 @@
 //----------------------------------------------------------------------------
 //! @file   circle_renderer.h
 //! @brief  円描画クラス（シェーダーベース）
+//!
+//! @details 1円を1インスタンス（CircleGeometry::CircleInstance）として転送し、
+//!          End()で全ての円を1回の描画コールで描く。
+//!          塗りつぶしと枠線はピクセルシェーダーが距離から解析的に塗り分ける。
 //----------------------------------------------------------------------------
 #pragma once
 
@@ -11,9 +15,10 @@
 #include "dx11/gpu/buffer.h"
 #include "dx11/gpu/shader.h"
 #include "dx11/state/blend_state.h"
-#include "dx11/state/sampler_state.h"
 #include "dx11/state/rasterizer_state.h"
 #include "dx11/state/depth_stencil_state.h"
+#include "dx11/context_command_backend.h"
+#include "circle_geometry.h"
 #include <vector>
 #include <wrl/client.h>
 
@@ -37,49 +42,85 @@ public:
         const Color& color
     );
 
+    //! @brief 円の枠線を描画
+    //! @param radius 線の中心の半径
+    //! @param lineWidth 線の太さ
+    void DrawOutline(
+        const Vector2& center,
+        float radius,
+        const Color& color,
+        float lineWidth
+    );
+
     //! @brief バッチ描画開始
     void Begin(const class Camera2D& camera);
 
     //! @brief バッチ描画終了（実際に描画）
     void End();
 
+    //! @brief Begin()～End()の間か
+    [[nodiscard]] bool IsBegun() const noexcept { return isBegun_; }
+
+    //! @brief 描画コマンドの出力先を設定（nullptrでGraphicsContextへ即時発行）
+    void SetCommandTarget(ICommandBackend* target) { commandTarget_ = target; }
+
+    //! @brief 直前のEnd()の描画コール数
+    [[nodiscard]] uint32_t GetDrawCallCount() const noexcept { return drawCallCount_; }
+
+    //! @brief 直前のEnd()で描画した円の数（カリング後）
+    [[nodiscard]] uint32_t GetCircleCount() const noexcept { return circleCount_; }
+
 private:
     CircleRenderer() = default;
     ~CircleRenderer() = default;
     CircleRenderer(const CircleRenderer&) = delete;
     CircleRenderer& operator=(const CircleRenderer&) = delete;
 
-    struct CircleVertex {
-        Vector3 position;
-        Vector2 texCoord;
-        Color color;
+    //! 定数バッファ（circle_vs.hlsl CBuffer）
+    struct CircleConstants {
+        Matrix viewProjection;
+        float depth;
+        float padding[3];
     };
+    static_assert(sizeof(CircleConstants) % 16 == 0, "定数バッファは16バイト単位");
 
-    struct CircleInstance {
-        Vector2 center;
-        float radius;
-        Color color;
-    };
+    //! インスタンスバッファの初期容量（円の数）
+    static constexpr uint32_t kInitialCapacity = 256;
+
+    //! 表示範囲内なら追加
+    void Enqueue(const CircleGeometry::CircleInstance& circle);
+
+    //! 必要数を満たすようインスタンスバッファを作り直す
+    void EnsureCapacity(uint32_t circleCount);
 
     // GPUリソース
     ShaderPtr vertexShader_;
     ShaderPtr pixelShader_;
     Microsoft::WRL::ComPtr<ID3D11InputLayout> inputLayout_;
-    BufferPtr vertexBuffer_;
-    BufferPtr indexBuffer_;
+    BufferPtr instanceBuffer_;
     BufferPtr constantBuffer_;
+    SpriteRing::Cursor instanceRing_;
 
     // パイプラインステート
     std::unique_ptr<BlendState> blendState_;
-    std::unique_ptr<SamplerState> samplerState_;
     std::unique_ptr<RasterizerState> rasterizerState_;
     std::unique_ptr<DepthStencilState> depthStencilState_;
 
-    std::vector<CircleInstance> instances_;
+    // 描画コマンドの出力先
+    ICommandBackend* commandTarget_ = nullptr;
+    ContextCommandBackend contextBackend_;
+
+    std::vector<CircleGeometry::CircleInstance> instances_;
+    std::vector<CircleGeometry::DrawRange> ranges_;
+    SpriteGeometry::ViewRect viewRect_{};
     bool isBegun_ = false;
     bool initialized_ = false;
 
-    Matrix constantData_{};
+    CircleConstants constantData_{};
+
+    // 統計
+    uint32_t drawCallCount_ = 0;
+    uint32_t circleCount_ = 0;
 };
 
 #endif // _DEBUG
@@ -141,6 +141,14 @@ void DebugDraw::DrawCircleOutline(
     int segments,
     float lineWidth)
 {
+    // 円描画パス中はインスタンス1つで描く（分割数は不要）
+    CircleRenderer& circles = CircleRenderer::Get();
+    if (circles.IsBegun()) {
+        circles.DrawOutline(center, radius, color, lineWidth);
+        return;
+    }
+
+    // SpriteBatchのパスでは線分で近似する
     if (segments < 3) segments = 3;
 
     constexpr float kPi = 3.14159265358979323846f;
@@ -60,6 +60,8 @@ public:
     //! @param color 色
     //! @param segments 分割数（デフォルト32）
     //! @param lineWidth 線の太さ
+    //! @note CircleRendererのBegin()～End()の間はインスタンス描画になり、segmentsは使わない。
+    //!       それ以外（スプライトと前後関係を合わせたいSpriteBatchパス）では線分で近似する
     void DrawCircleOutline(
         const Vector2& center,
         float radius,
@@ -123,6 +123,7 @@ void RenderStateManager::Shutdown()
         d3dCtx->PSSetSamplers(0, 1, nullSamplers);
         d3dCtx->VSSetSamplers(0, 1, nullSamplers);
         d3dCtx->Flush();
+        GraphicsContext::Get().InvalidateStateCache();
     }
 
     // 深度ステンシルステート
@@ -102,8 +102,8 @@ void Application::Shutdown() noexcept
 
     // パイプラインから全リソースをアンバインドしてから解放
     auto& ctx = GraphicsContext::Get();
+    ctx.ClearState();
     if (auto* d3dCtx = ctx.GetContext()) {
-        d3dCtx->ClearState();
         d3dCtx->Flush();
     }
 
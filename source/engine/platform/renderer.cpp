@@ -163,6 +163,9 @@ void Renderer::Present()
     }
 
     swapChain_->Present(vsync_);
+
+    // バインド統計をフレーム単位で確定
+    GraphicsContext::Get().EndFrame();
 }
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,170 @@
+//----------------------------------------------------------------------------
+//! @file   texture_atlas.cpp
+//! @brief  テクスチャアトラスの矩形パッキング実装
+//----------------------------------------------------------------------------
+#include "texture_atlas.h"
+#include <algorithm>
+#include <numeric>
+
+//============================================================================
+// TextureRegion
+//============================================================================
+
+TextureRegion TextureRegion::FromRect(Texture* texture, const AtlasRect& rect,
+                                      uint32_t pageWidth, uint32_t pageHeight) noexcept
+{
+    TextureRegion region;
+    region.texture = texture;
+    region.rect = rect;
+    const float invW = 1.0f / static_cast<float>(pageWidth);
+    const float invH = 1.0f / static_cast<float>(pageHeight);
+    region.u0 = static_cast<float>(rect.x) * invW;
+    region.v0 = static_cast<float>(rect.y) * invH;
+    region.u1 = static_cast<float>(rect.x + rect.width) * invW;
+    region.v1 = static_cast<float>(rect.y + rect.height) * invH;
+    return region;
+}
+
+//============================================================================
+// SkylinePacker
+//============================================================================
+
+void SkylinePacker::Reset(uint32_t width, uint32_t height)
+{
+    width_ = width;
+    height_ = height;
+    usedArea_ = 0;
+    skyline_.clear();
+    skyline_.push_back({ 0, 0, width });
+}
+
+float SkylinePacker::GetOccupancy() const noexcept
+{
+    const uint64_t area = static_cast<uint64_t>(width_) * height_;
+    return area > 0 ? static_cast<float>(static_cast<double>(usedArea_) / static_cast<double>(area)) : 0.0f;
+}
+
+bool SkylinePacker::Fit(size_t index, uint32_t width, uint32_t height, uint32_t& outY) const
+{
+    const uint32_t x = skyline_[index].x;
+    if (x + width > width_) return false;
+
+    // 幅widthが掛かる線分のうち最も高い上端に載る
+    uint32_t y = 0;
+    uint32_t remaining = width;
+    for (size_t i = index; remaining > 0; ++i) {
+        y = (std::max)(y, skyline_[i].y);
+        if (y + height > height_) return false;
+        remaining -= (std::min)(remaining, skyline_[i].width);
+    }
+    outY = y;
+    return true;
+}
+
+bool SkylinePacker::Pack(uint32_t width, uint32_t height, AtlasRect& out)
+{
+    if (width == 0 || height == 0) return false;
+
+    // 上端が最も低くなる位置、同じなら線分幅が狭い位置（隙間が小さい）
+    size_t bestIndex = skyline_.size();
+    uint32_t bestTop = UINT32_MAX;
+    uint32_t bestWidth = UINT32_MAX;
+    uint32_t bestY = 0;
+    for (size_t i = 0; i < skyline_.size(); ++i) {
+        uint32_t y = 0;
+        if (!Fit(i, width, height, y)) continue;
+        const uint32_t top = y + height;
+        if (top < bestTop || (top == bestTop && skyline_[i].width < bestWidth)) {
+            bestIndex = i;
+            bestTop = top;
+            bestWidth = skyline_[i].width;
+            bestY = y;
+        }
+    }
+    if (bestIndex == skyline_.size()) return false;
+
+    out = { skyline_[bestIndex].x, bestY, width, height };
+    usedArea_ += static_cast<uint64_t>(width) * height;
+
+    // 新しい線分を挿入し、覆われた線分を削る
+    skyline_.insert(skyline_.begin() + static_cast<ptrdiff_t>(bestIndex), { out.x, bestTop, width });
+    const uint32_t right = out.x + width;
+    size_t i = bestIndex + 1;
+    while (i < skyline_.size() && skyline_[i].x < right) {
+        const uint32_t nodeRight = skyline_[i].x + skyline_[i].width;
+        if (nodeRight <= right) {
+            skyline_.erase(skyline_.begin() + static_cast<ptrdiff_t>(i));
+        } else {
+            skyline_[i].width = nodeRight - right;
+            skyline_[i].x = right;
+            break;
+        }
+    }
+
+    // 同じ高さで隣接する線分を統合
+    for (size_t j = 0; j + 1 < skyline_.size();) {
+        if (skyline_[j].y == skyline_[j + 1].y) {
+            skyline_[j].width += skyline_[j + 1].width;
+            skyline_.erase(skyline_.begin() + static_cast<ptrdiff_t>(j + 1));
+        } else {
+            ++j;
+        }
+    }
+    return true;
+}
+
+//============================================================================
+// PackAtlasRects
+//============================================================================
+
+void SortForAtlasPacking(std::span<const AtlasRect> sizes, std::vector<uint32_t>& order)
+{
+    // 大きい順に入れるとスカイラインの段差が小さくなる。
+    // 同じ大きさは入力順にして、結果を入力だけで決める
+    order.resize(sizes.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        if (sizes[a].height != sizes[b].height) return sizes[a].height > sizes[b].height;
+        if (sizes[a].width != sizes[b].width) return sizes[a].width > sizes[b].width;
+        return a < b;
+    });
+}
+
+uint32_t PackAtlasRects(
+    std::span<const AtlasRect> sizes,
+    uint32_t pageWidth,
+    uint32_t pageHeight,
+    uint32_t padding,
+    std::vector<AtlasPlacement>& placements)
+{
+    placements.assign(sizes.size(), AtlasPlacement{});
+    if (sizes.empty()) return 0;
+    if (pageWidth <= padding || pageHeight <= padding) return 0;
+
+    std::vector<uint32_t> order;
+    SortForAtlasPacking(sizes, order);
+
+    // 各矩形の右下にpaddingを付けて配置し、ページ左上をpaddingずらす
+    std::vector<SkylinePacker> pages;
+    for (uint32_t index : order) {
+        const uint32_t w = sizes[index].width + padding;
+        const uint32_t h = sizes[index].height + padding;
+
+        AtlasRect rect;
+        size_t page = 0;
+        for (; page < pages.size(); ++page) {
+            if (pages[page].Pack(w, h, rect)) break;
+        }
+        if (page == pages.size()) {
+            pages.emplace_back(pageWidth - padding, pageHeight - padding);
+            if (!pages.back().Pack(w, h, rect)) {
+                return 0;  // 空のページにも入らない
+            }
+        }
+
+        placements[index].page = static_cast<uint32_t>(page);
+        placements[index].rect = { rect.x + padding, rect.y + padding,
+                                   sizes[index].width, sizes[index].height };
+    }
+    return static_cast<uint32_t>(pages.size());
+}
@@ -0,0 +1,155 @@
+//----------------------------------------------------------------------------
+//! @file   texture_atlas.h
+//! @brief  テクスチャアトラスの矩形パッキング（CPUのみ）
+//!
+//! @details TextureManagerが小さいテクスチャを共有ページへまとめるときの
+//!          配置計算を行う。D3D11に依存しないため、デバイスなしで検証できる。
+//----------------------------------------------------------------------------
+#pragma once
+
+#include "engine/math/math_types.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class Texture;
+
+//===========================================================================
+//! アトラス上の矩形（ピクセル単位）
+//===========================================================================
+struct AtlasRect
+{
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+//===========================================================================
+//! パッキング結果（PackAtlasRectsの出力）
+//===========================================================================
+struct AtlasPlacement
+{
+    uint32_t page = 0;      //!< ページ番号
+    AtlasRect rect;         //!< ページ内の配置（パディングを含まない）
+};
+
+//===========================================================================
+//! テクスチャ上の領域
+//!
+//! アトラスに入ったテクスチャはページと部分矩形、
+//! 入らなかったテクスチャは元テクスチャ全体を指す。
+//===========================================================================
+struct TextureRegion
+{
+    Texture* texture = nullptr;     //!< 描画に使うテクスチャ（アトラスページまたは元テクスチャ）
+    AtlasRect rect;                 //!< texture内のピクセル矩形
+    float u0 = 0.0f, v0 = 0.0f;     //!< 左上UV
+    float u1 = 1.0f, v1 = 1.0f;     //!< 右下UV
+
+    //! 有効な領域か
+    [[nodiscard]] bool IsValid() const noexcept { return texture != nullptr; }
+
+    //! ソース矩形を取得 (x, y, width, height)
+    [[nodiscard]] Vector4 SourceRect() const noexcept {
+        return Vector4(static_cast<float>(rect.x), static_cast<float>(rect.y),
+                       static_cast<float>(rect.width), static_cast<float>(rect.height));
+    }
+
+    //! 領域内の正規化座標(0～1)をtextureのUVへ変換
+    [[nodiscard]] Vector2 MapUV(float u, float v) const noexcept {
+        return Vector2(u0 + (u1 - u0) * u, v0 + (v1 - v0) * v);
+    }
+
+    //! ページ内の矩形から領域を作成
+    [[nodiscard]] static TextureRegion FromRect(Texture* texture, const AtlasRect& rect,
+                                                uint32_t pageWidth, uint32_t pageHeight) noexcept;
+};
+
+//===========================================================================
+//! スカイライン法による矩形パッカー
+//!
+//! @details ページ上端から見た「積み上がった高さ」を線分列で保持し、
+//!          配置後の上端が最も低くなる位置（同じ高さなら線分幅が狭い位置）へ置く。
+//!          線分の上に生じた隙間は再利用しないが、高さ順に入れれば充填率は高い。
+//!
+//! @code
+//!   SkylinePacker packer(1024, 1024);
+//!   AtlasRect rect;
+//!   if (packer.Pack(64, 32, rect)) { ... }
+//! @endcode
+//===========================================================================
+class SkylinePacker final
+{
+public:
+    SkylinePacker() = default;
+
+    //! コンストラクタ
+    //! @param [in] width ページ幅
+    //! @param [in] height ページ高さ
+    SkylinePacker(uint32_t width, uint32_t height) { Reset(width, height); }
+
+    //! 空のページに戻す
+    void Reset(uint32_t width, uint32_t height);
+
+    //! 矩形を配置
+    //! @param [in] width 幅
+    //! @param [in] height 高さ
+    //! @param [out] out 配置位置
+    //! @return 入らない場合false（状態は変化しない）
+    [[nodiscard]] bool Pack(uint32_t width, uint32_t height, AtlasRect& out);
+
+    [[nodiscard]] uint32_t GetWidth() const noexcept { return width_; }
+    [[nodiscard]] uint32_t GetHeight() const noexcept { return height_; }
+
+    //! 配置済み面積
+    [[nodiscard]] uint64_t GetUsedArea() const noexcept { return usedArea_; }
+
+    //! 充填率（配置済み面積 / ページ面積）
+    [[nodiscard]] float GetOccupancy() const noexcept;
+
+private:
+    //! スカイラインの線分（x～x+widthの上端がy）
+    struct Node
+    {
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+    };
+
+    //! index番目の線分から幅widthを置いたときの上端を求める
+    //! @return 入らない場合false
+    [[nodiscard]] bool Fit(size_t index, uint32_t width, uint32_t height, uint32_t& outY) const;
+
+    std::vector<Node> skyline_;
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    uint64_t usedArea_ = 0;
+};
+
+//===========================================================================
+//! パッキング順を求める（高さ→幅の降順、同じ大きさは入力順）
+//!
+//! @param [in] sizes 各矩形の大きさ（width/heightのみ参照）
+//! @param [out] order 配置するsizesのインデックス順
+//===========================================================================
+void SortForAtlasPacking(std::span<const AtlasRect> sizes, std::vector<uint32_t>& order);
+
+//===========================================================================
+//! 複数の矩形をまとめてページへ配置
+//!
+//! @param [in] sizes 各矩形の大きさ（width/heightのみ参照）
+//! @param [in] pageWidth ページ幅
+//! @param [in] pageHeight ページ高さ
+//! @param [in] padding 矩形同士・ページ端との間隔（フィルタリングのにじみ防止）
+//! @param [out] placements sizesと同じ順の配置結果
+//! @return 使用したページ数（ページに収まらない矩形があれば0）
+//!
+//! @note SortForAtlasPackingの順に配置する。入力が同じなら結果は常に同じ。
+//===========================================================================
+[[nodiscard]] uint32_t PackAtlasRects(
+    std::span<const AtlasRect> sizes,
+    uint32_t pageWidth,
+    uint32_t pageHeight,
+    uint32_t padding,
+    std::vector<AtlasPlacement>& placements);
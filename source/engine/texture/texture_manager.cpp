@@ -25,6 +25,20 @@
 
 namespace
 {
+    //! アトラスへコピーできるフォーマットか（ページと同じフォーマットで部分コピーする）
+    [[nodiscard]] bool IsAtlasFormat(DXGI_FORMAT format)
+    {
+        switch (format) {
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+            return true;
+        default:
+            return false;
+        }
+    }
+
     std::string GetFileExtension(const std::string& path)
     {
         size_t pos = path.rfind('.');
@@ -139,6 +153,7 @@ void TextureManager::Initialize(IReadableFileSystem* fileSystem)
 
 void TextureManager::Shutdown()
 {
+    ClearAtlas();
     if (cache_) {
         cache_->Clear();
     }
@@ -527,6 +542,174 @@ TextureCacheStats TextureManager::GetCacheStats() const
     return stats_;
 }
 
+//----------------------------------------------------------------------------
+// テクスチャアトラス
+//----------------------------------------------------------------------------
+
+TextureRegion TextureManager::AddToAtlas(const TexturePtr& texture)
+{
+    if (!texture) return {};
+
+    auto it = atlasEntries_.find(texture.get());
+    if (it != atlasEntries_.end()) {
+        if (!it->second.source.expired()) {
+            return it->second.region;
+        }
+        // 同じアドレスに別のテクスチャが作られた
+        // （ページ上の古い領域はReleaseUnusedAtlasPages()でページごと回収する）
+        atlasEntries_.erase(it);
+    }
+
+    TextureRegion region = PackIntoAtlas(texture);
+    if (region.texture != texture.get()) {
+        atlasEntries_[texture.get()] = AtlasEntry{ texture, region };
+    }
+    return region;
+}
+
+void TextureManager::AddToAtlas(std::span<const TexturePtr> textures, std::vector<TextureRegion>& regions)
+{
+    std::vector<AtlasRect> sizes(textures.size());
+    for (size_t i = 0; i < textures.size(); ++i) {
+        if (textures[i]) {
+            sizes[i].width = textures[i]->Width();
+            sizes[i].height = textures[i]->Height();
+        }
+    }
+
+    std::vector<uint32_t> order;
+    SortForAtlasPacking(sizes, order);
+
+    regions.assign(textures.size(), TextureRegion{});
+    for (uint32_t index : order) {
+        regions[index] = AddToAtlas(textures[index]);
+    }
+}
+
+TextureRegion TextureManager::FindAtlasRegion(Texture* texture) const
+{
+    auto it = atlasEntries_.find(texture);
+    if (it != atlasEntries_.end() && !it->second.source.expired()) {
+        return it->second.region;
+    }
+    return WholeTextureRegion(texture);
+}
+
+void TextureManager::ClearAtlas()
+{
+    atlasEntries_.clear();
+    atlasPages_.clear();
+}
+
+size_t TextureManager::ReleaseUnusedAtlasPages()
+{
+    // 元テクスチャが解放された登録を削除し、残りをページごとに数える
+    std::unordered_map<Texture*, uint32_t> liveCounts;
+    for (auto it = atlasEntries_.begin(); it != atlasEntries_.end();) {
+        if (it->second.source.expired()) {
+            it = atlasEntries_.erase(it);
+        } else {
+            ++liveCounts[it->second.region.texture];
+            ++it;
+        }
+    }
+
+    const size_t before = atlasPages_.size();
+    std::erase_if(atlasPages_, [&](const AtlasPage& page) {
+        return liveCounts.find(page.texture.get()) == liveCounts.end();
+    });
+
+    const size_t released = before - atlasPages_.size();
+    if (released > 0) {
+        LOG_INFO("[TextureManager] アトラスページ解放: " + std::to_string(released) +
+                 " (残り " + std::to_string(atlasPages_.size()) + ")");
+    }
+    return released;
+}
+
+TextureAtlasStats TextureManager::GetAtlasStats() const
+{
+    TextureAtlasStats result;
+    result.pageCount = atlasPages_.size();
+    result.regionCount = atlasEntries_.size();
+    if (!atlasPages_.empty()) {
+        float total = 0.0f;
+        for (const AtlasPage& page : atlasPages_) {
+            total += page.packer.GetOccupancy();
+        }
+        result.occupancy = total / static_cast<float>(atlasPages_.size());
+    }
+    return result;
+}
+
+TextureRegion TextureManager::WholeTextureRegion(Texture* texture)
+{
+    TextureRegion region;
+    region.texture = texture;
+    if (texture) {
+        region.rect = { 0, 0, texture->Width(), texture->Height() };
+    }
+    return region;
+}
+
+TextureRegion TextureManager::PackIntoAtlas(const TexturePtr& texture)
+{
+    const uint32_t width = texture->Width();
+    const uint32_t height = texture->Height();
+    const DXGI_FORMAT format = texture->Format();
+    if (!texture->Is2D() || !IsAtlasFormat(format) ||
+        width > kAtlasMaxTextureSize || height > kAtlasMaxTextureSize) {
+        return WholeTextureRegion(texture.get());
+    }
+
+    auto* context = GraphicsContext::Get().GetContext();
+    if (!context) return WholeTextureRegion(texture.get());
+
+    // 右下にパディングを付けて配置し、ページ左上をパディング分ずらす
+    const uint32_t packW = width + kAtlasPadding;
+    const uint32_t packH = height + kAtlasPadding;
+
+    AtlasRect rect;
+    AtlasPage* target = nullptr;
+    for (AtlasPage& page : atlasPages_) {
+        if (page.format == format && page.packer.Pack(packW, packH, rect)) {
+            target = &page;
+            break;
+        }
+    }
+
+    if (!target) {
+        // 透明で初期化した新しいページ（パディング部分が透明になる）
+        std::vector<uint8_t> clear(static_cast<size_t>(kAtlasPageSize) * kAtlasPageSize * 4, 0);
+        TexturePtr pageTexture = Create2D(kAtlasPageSize, kAtlasPageSize, format,
+            D3D11_BIND_SHADER_RESOURCE, clear.data(), kAtlasPageSize * 4);
+        if (!pageTexture) {
+            LOG_ERROR("[TextureManager] アトラスページの作成に失敗");
+            return WholeTextureRegion(texture.get());
+        }
+
+        AtlasPage page;
+        page.texture = std::move(pageTexture);
+        page.packer.Reset(kAtlasPageSize - kAtlasPadding, kAtlasPageSize - kAtlasPadding);
+        page.format = format;
+        atlasPages_.push_back(std::move(page));
+        target = &atlasPages_.back();
+        if (!target->packer.Pack(packW, packH, rect)) {
+            return WholeTextureRegion(texture.get());
+        }
+        LOG_INFO("[TextureManager] アトラスページ追加: " + std::to_string(atlasPages_.size()));
+    }
+
+    const AtlasRect placed{ rect.x + kAtlasPadding, rect.y + kAtlasPadding, width, height };
+    context->CopySubresourceRegion(
+        target->texture->Get(), 0,
+        placed.x, placed.y, 0,
+        texture->Get(), 0,
+        nullptr);
+
+    return TextureRegion::FromRect(target->texture.get(), placed, kAtlasPageSize, kAtlasPageSize);
+}
+
 ITextureLoader* TextureManager::GetLoaderForExtension(const std::string& path) const
 {
     std::string ext = GetFileExtension(path);
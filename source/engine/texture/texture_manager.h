@@ -6,8 +6,12 @@
 
 #include "dx11/gpu_common.h"
 #include "dx11/gpu/gpu.h"
+#include "texture_atlas.h"
 #include <memory>
+#include <span>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class IReadableFileSystem;
 class ITextureLoader;
@@ -29,6 +33,16 @@ struct TextureCacheStats
     }
 };
 
+//===========================================================================
+//! アトラス統計情報
+//===========================================================================
+struct TextureAtlasStats
+{
+    size_t pageCount = 0;             //!< ページ数
+    size_t regionCount = 0;           //!< 登録済みテクスチャ数
+    float occupancy = 0.0f;           //!< 全ページの平均充填率
+};
+
 //===========================================================================
 //! テクスチャマネージャー（シングルトン）
 //!
@@ -166,6 +180,50 @@ public:
     [[nodiscard]] TextureCacheStats GetCacheStats() const;
 
     //!@}
+    //----------------------------------------------------------
+    //! @name   テクスチャアトラス
+    //----------------------------------------------------------
+    //!@{
+
+    //! アトラスページの大きさ
+    static constexpr uint32_t kAtlasPageSize = 2048;
+
+    //! アトラスに入れるテクスチャの最大辺（これより大きいものは単独のまま）
+    static constexpr uint32_t kAtlasMaxTextureSize = 512;
+
+    //! アトラス内の間隔（ピクセル）
+    static constexpr uint32_t kAtlasPadding = 2;
+
+    //! テクスチャをアトラスページへコピーし、その領域を取得
+    //! @param [in] texture 元テクスチャ（8bit RGBA/BGRA、kAtlasMaxTextureSize以下）
+    //! @return アトラス上の領域。対象外・失敗時は元テクスチャ全体の領域
+    //! @note 同じテクスチャは2回目以降、登録済みの領域を返す。
+    //!       SpriteRenderer::SetRegion()、SpriteBatch::Draw()のソース矩形にそのまま渡せる。
+    [[nodiscard]] TextureRegion AddToAtlas(const TexturePtr& texture);
+
+    //! 複数のテクスチャをまとめてアトラスへ追加
+    //! @param [in] textures 元テクスチャ
+    //! @param [out] regions texturesと同じ順の領域
+    //! @note 大きい順に配置するため、1枚ずつ追加するより充填率が高い
+    void AddToAtlas(std::span<const TexturePtr> textures, std::vector<TextureRegion>& regions);
+
+    //! 登録済みの領域を取得
+    //! @return 未登録なら元テクスチャ全体の領域
+    [[nodiscard]] TextureRegion FindAtlasRegion(Texture* texture) const;
+
+    //! アトラスを破棄（取得済みの領域は無効になる）
+    void ClearAtlas();
+
+    //! 元テクスチャが全て解放されたページを破棄
+    //! @return 破棄したページ数
+    //! @note 領域を使う側は元テクスチャも保持しておくこと（元が解放された領域のページは破棄される）。
+    //!       シーン・ステージの終了時など、描画中でないときに呼ぶ。
+    size_t ReleaseUnusedAtlasPages();
+
+    //! アトラス統計を取得
+    [[nodiscard]] TextureAtlasStats GetAtlasStats() const;
+
+    //!@}
 
 private:
     TextureManager() = default;
@@ -180,6 +238,27 @@ private:
         bool sRGB,
         bool generateMips) const;
 
+    //! アトラスページ
+    struct AtlasPage
+    {
+        TexturePtr texture;
+        SkylinePacker packer;
+        DXGI_FORMAT format;
+    };
+
+    //! アトラス登録情報
+    struct AtlasEntry
+    {
+        std::weak_ptr<Texture> source;   //!< 元テクスチャ（解放後のアドレス再利用を検出）
+        TextureRegion region;
+    };
+
+    //! 元テクスチャ全体を指す領域
+    [[nodiscard]] static TextureRegion WholeTextureRegion(Texture* texture);
+
+    //! 元テクスチャを空きのあるページへコピー
+    [[nodiscard]] TextureRegion PackIntoAtlas(const TexturePtr& texture);
+
     bool initialized_ = false;
     IReadableFileSystem* fileSystem_ = nullptr;
     std::unique_ptr<ITextureLoader> ddsLoader_;
@@ -188,4 +267,8 @@ private:
 
     // 統計情報
     mutable TextureCacheStats stats_;
+
+    // テクスチャアトラス
+    std::vector<AtlasPage> atlasPages_;
+    std::unordered_map<Texture*, AtlasEntry> atlasEntries_;
 };
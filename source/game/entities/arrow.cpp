@@ -44,6 +44,7 @@ void Arrow::Initialize(const Vector2& startPos, const Vector2& targetPos)
     collider_ = gameObject_->AddComponent<Collider2D>(Vector2(20.0f, 10.0f));
     collider_->SetLayer(CollisionLayer::Arrow);
     collider_->SetMask(CollisionLayer::ArrowMask);
+    collider_->SetBullet(true);  // 低フレームレートでも標的をすり抜けない
 
     // 衝突コールバック設定
     collider_->SetOnCollisionEnter([this](Collider2D* /*self*/, Collider2D* other) {
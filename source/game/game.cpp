@@ -58,6 +58,12 @@ bool Game::Initialize()
     fsManager.Mount("shaders", std::make_unique<HostFileSystem>(assetsRoot + L"shader/"));
     fsManager.Mount("textures", std::make_unique<HostFileSystem>(assetsRoot + L"texture/"));
     fsManager.Mount("stages", std::make_unique<HostFileSystem>(assetsRoot + L"stages/"));
+    // イベントログ等の出力先（captures/はリポジトリに含めない）
+    std::wstring capturesRoot = projectRoot + L"captures/";
+    if (!FileSystemManager::CreateDirectories(capturesRoot)) {
+        LOG_WARN("[Game] Failed to create " + PathUtility::toNarrowString(capturesRoot));
+    }
+    fsManager.Mount("captures", std::make_unique<HostFileSystem>(capturesRoot));
 
     // 4. TextureManager初期化
     auto* textureFs = fsManager.GetFileSystem("textures");
@@ -97,8 +103,8 @@ bool Game::Initialize()
 void Game::Shutdown() noexcept
 {
     // パイプラインから全リソースをアンバインド（テクスチャ解放前に必須）
+    GraphicsContext::Get().ClearState();
     if (auto* ctx = GraphicsContext::Get().GetContext()) {
-        ctx->ClearState();
         ctx->Flush();
     }
 
@@ -4,8 +4,54 @@
 //----------------------------------------------------------------------------
 #include "engine/platform/application.h"
 #include "game.h"
+#include "engine/fs/path_utility.h"
+#include "game/systems/event/event_trace_inspector.h"
 
 #include <Windows.h>
+#include <shellapi.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+//! ウィンドウ・デバイスを作らずに実行して終了する起動引数
+struct ToolOption
+{
+    const wchar_t* flag;
+    int (*run)(const std::string& path);  //!< 次の引数をパスとして渡す（省略時は空文字列）
+};
+
+constexpr ToolOption kToolOptions[] = {
+    { L"--inspect-events", &RunEventTraceInspector },
+};
+
+//! 引数と完全一致する起動引数を検索（該当しなければnullptr）
+const ToolOption* FindToolOption(const std::wstring& arg)
+{
+    for (const ToolOption& option : kToolOptions) {
+        if (arg == option.flag) {
+            return &option;
+        }
+    }
+    return nullptr;
+}
+
+//! コマンドラインを引数ごとに分割（先頭のプログラム名は除く）
+std::vector<std::wstring> GetCommandLineArgs()
+{
+    std::vector<std::wstring> args;
+    int argc = 0;
+    LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+    if (!argv) return args;
+    for (int i = 1; i < argc; ++i) {
+        args.emplace_back(argv[i]);
+    }
+    LocalFree(argv);
+    return args;
+}
+
+} // namespace
 
 //! WinMainエントリーポイント
 int WINAPI WinMain(
@@ -19,6 +65,19 @@ int WINAPI WinMain(
     (void)lpCmdLine;
     (void)nCmdShow;
 
+    // ツール用の起動引数（例: --inspect-events [path]）があれば実行して終了
+    const std::vector<std::wstring> args = GetCommandLineArgs();
+    for (size_t i = 0; i < args.size(); ++i) {
+        const ToolOption* option = FindToolOption(args[i]);
+        if (!option) continue;
+
+        std::string path;
+        if (i + 1 < args.size() && args[i + 1].rfind(L"--", 0) != 0) {
+            path = PathUtility::toNarrowString(args[i + 1]);
+        }
+        return option->run(path);
+    }
+
     // アプリケーション設定
     ApplicationDesc desc;
     desc.window.title = L"HEW2026 Game";
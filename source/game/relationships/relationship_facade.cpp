@@ -97,7 +97,7 @@ void RelationshipFacade::CutAll(const BondableEntity& entity)
     for (const EdgeData* edge : edges) {
         if (!edge) continue;
 
-        BondableEntity other = (BondableHelper::GetId(edge->entityA) == BondableHelper::GetId(entity))
+        BondableEntity other = BondableHelper::IsSame(edge->entityA, entity)
             ? edge->entityB : edge->entityA;
 
         graph_.RemoveEdge(edge->id);
@@ -4,51 +4,59 @@
 //----------------------------------------------------------------------------
 #include "relationship_graph.h"
 #include "common/logging/logging.h"
-#include <queue>
 #include <algorithm>
 
 //----------------------------------------------------------------------------
 uint32_t RelationshipGraph::AddEdge(const BondableEntity& a, const BondableEntity& b, BondType type)
 {
-    std::string idA = BondableHelper::GetId(a);
-    std::string idB = BondableHelper::GetId(b);
+    const void* keyA = GetNodeKey(a);
+    const void* keyB = GetNodeKey(b);
+
+    if (!keyA || !keyB) {
+        LOG_WARN("[RelationshipGraph] Cannot add edge with null entity");
+        return 0;
+    }
 
     // 同一ノードは不可
-    if (idA == idB) {
+    if (keyA == keyB) {
         LOG_WARN("[RelationshipGraph] Cannot add edge between same node");
         return 0;
     }
 
     // 既存エッジチェック
     if (HasEdge(a, b)) {
-        LOG_WARN("[RelationshipGraph] Edge already exists: " + idA + " <-> " + idB);
+        LOG_WARN("[RelationshipGraph] Edge already exists: " +
+                 BondableHelper::GetId(a) + " <-> " + BondableHelper::GetId(b));
         return 0;
     }
 
+    // ノード登録
+    NodeIndex nodeA = index_.InternNode(keyA);
+    NodeIndex nodeB = index_.InternNode(keyB);
+    nodeEntities_.resize(index_.GetNodeCount());
+    nodeEntities_[nodeA] = a;
+    nodeEntities_[nodeB] = b;
+
     // エッジ作成
+    uint32_t slot = index_.AddEdge(nodeA, nodeB, type);
+    if (slot == RelationshipIndex::kInvalidEdge) {
+        return 0;
+    }
+    if (slot >= edges_.size()) {
+        edges_.resize(slot + 1);
+    }
+
     uint32_t edgeId = nextEdgeId_++;
-    EdgeData edge;
+    EdgeData& edge = edges_[slot];
     edge.id = edgeId;
-    edge.nodeA = idA;
-    edge.nodeB = idB;
+    edge.nodeA = nodeA;
+    edge.nodeB = nodeB;
     edge.type = type;
     edge.entityA = a;
     edge.entityB = b;
+    edgeSlots_[edgeId] = slot;
 
-    edges_[edgeId] = edge;
-
-    // 隣接リスト更新（双方向）
-    adjacency_[idA].push_back({ idB, edgeId, type });
-    adjacency_[idB].push_back({ idA, edgeId, type });
-
-    // タイプインデックス更新
-    typeIndex_[static_cast<int>(type)].push_back(edgeId);
-
-    // ノードエンティティ登録
-    nodeEntities_[idA] = a;
-    nodeEntities_[idB] = b;
-
-    LOG_INFO("[RelationshipGraph] Edge added: " + idA + " <-> " + idB +
+    LOG_INFO("[RelationshipGraph] Edge added: " + BondableHelper::GetId(a) + " <-> " + BondableHelper::GetId(b) +
              " (type=" + std::to_string(static_cast<int>(type)) + ")");
 
     return edgeId;
@@ -57,33 +65,18 @@ uint32_t RelationshipGraph::AddEdge(const BondableEntity& a, const BondableEntit
 //----------------------------------------------------------------------------
 bool RelationshipGraph::RemoveEdge(uint32_t edgeId)
 {
-    auto it = edges_.find(edgeId);
-    if (it == edges_.end()) {
+    auto it = edgeSlots_.find(edgeId);
+    if (it == edgeSlots_.end()) {
         return false;
     }
 
-    const EdgeData& edge = it->second;
-    std::string idA = edge.nodeA;
-    std::string idB = edge.nodeB;
-    BondType type = edge.type;
-
-    // 隣接リストから削除
-    auto& adjA = adjacency_[idA];
-    adjA.erase(std::remove_if(adjA.begin(), adjA.end(),
-        [edgeId](const AdjacencyEntry& e) { return e.edgeId == edgeId; }), adjA.end());
-
-    auto& adjB = adjacency_[idB];
-    adjB.erase(std::remove_if(adjB.begin(), adjB.end(),
-        [edgeId](const AdjacencyEntry& e) { return e.edgeId == edgeId; }), adjB.end());
-
-    // タイプインデックスから削除
-    auto& typeVec = typeIndex_[static_cast<int>(type)];
-    typeVec.erase(std::remove(typeVec.begin(), typeVec.end(), edgeId), typeVec.end());
-
-    LOG_INFO("[RelationshipGraph] Edge removed: " + idA + " <-> " + idB);
+    const uint32_t slot = it->second;
+    edgeSlots_.erase(it);
+    index_.RemoveEdge(slot);
 
-    // エッジ削除
-    edges_.erase(it);
+    const EdgeData& edge = edges_[slot];
+    LOG_INFO("[RelationshipGraph] Edge removed: " +
+             BondableHelper::GetId(edge.entityA) + " <-> " + BondableHelper::GetId(edge.entityB));
 
     return true;
 }
@@ -101,15 +94,15 @@ bool RelationshipGraph::RemoveEdge(const BondableEntity& a, const BondableEntity
 //----------------------------------------------------------------------------
 void RelationshipGraph::RemoveAllEdgesFor(const BondableEntity& entity)
 {
-    std::string nodeId = BondableHelper::GetId(entity);
+    NodeIndex node = FindNode(entity);
+    if (node == RelationshipIndex::kInvalidNode) {
+        return;
+    }
 
     // このノードに関連する全エッジIDを収集
     std::vector<uint32_t> toRemove;
-    auto it = adjacency_.find(nodeId);
-    if (it != adjacency_.end()) {
-        for (const AdjacencyEntry& entry : it->second) {
-            toRemove.push_back(entry.edgeId);
-        }
+    for (const RelationshipIndex::Neighbor& n : index_.GetNeighbors(node)) {
+        toRemove.push_back(edges_[n.edge].id);
     }
 
     // 削除
@@ -121,9 +114,9 @@ void RelationshipGraph::RemoveAllEdgesFor(const BondableEntity& entity)
 //----------------------------------------------------------------------------
 void RelationshipGraph::Clear()
 {
+    index_.Clear();
     edges_.clear();
-    adjacency_.clear();
-    typeIndex_.clear();
+    edgeSlots_.clear();
     nodeEntities_.clear();
     nextEdgeId_ = 1;
     LOG_INFO("[RelationshipGraph] Cleared");
@@ -138,42 +131,22 @@ bool RelationshipGraph::HasEdge(const BondableEntity& a, const BondableEntity& b
 //----------------------------------------------------------------------------
 const EdgeData* RelationshipGraph::GetEdge(const BondableEntity& a, const BondableEntity& b) const
 {
-    std::string idA = BondableHelper::GetId(a);
-    std::string idB = BondableHelper::GetId(b);
-
-    auto it = adjacency_.find(idA);
-    if (it == adjacency_.end()) {
+    uint32_t slot = index_.FindEdge(FindNode(a), FindNode(b));
+    if (slot == RelationshipIndex::kInvalidEdge) {
         return nullptr;
     }
-
-    for (const AdjacencyEntry& entry : it->second) {
-        if (entry.neighborId == idB) {
-            auto edgeIt = edges_.find(entry.edgeId);
-            if (edgeIt != edges_.end()) {
-                return &edgeIt->second;
-            }
-        }
-    }
-
-    return nullptr;
+    return &edges_[slot];
 }
 
 //----------------------------------------------------------------------------
 std::vector<BondableEntity> RelationshipGraph::GetNeighbors(const BondableEntity& node) const
 {
     std::vector<BondableEntity> result;
-    std::string nodeId = BondableHelper::GetId(node);
+    std::span<const RelationshipIndex::Neighbor> neighbors = index_.GetNeighbors(FindNode(node));
+    result.reserve(neighbors.size());
 
-    auto it = adjacency_.find(nodeId);
-    if (it == adjacency_.end()) {
-        return result;
-    }
-
-    for (const AdjacencyEntry& entry : it->second) {
-        auto entityIt = nodeEntities_.find(entry.neighborId);
-        if (entityIt != nodeEntities_.end()) {
-            result.push_back(entityIt->second);
-        }
+    for (const RelationshipIndex::Neighbor& n : neighbors) {
+        result.push_back(nodeEntities_[n.node]);
     }
 
     return result;
@@ -183,19 +156,10 @@ std::vector<BondableEntity> RelationshipGraph::GetNeighbors(const BondableEntity
 std::vector<BondableEntity> RelationshipGraph::GetNeighborsByType(const BondableEntity& node, BondType type) const
 {
     std::vector<BondableEntity> result;
-    std::string nodeId = BondableHelper::GetId(node);
 
-    auto it = adjacency_.find(nodeId);
-    if (it == adjacency_.end()) {
-        return result;
-    }
-
-    for (const AdjacencyEntry& entry : it->second) {
-        if (entry.type == type) {
-            auto entityIt = nodeEntities_.find(entry.neighborId);
-            if (entityIt != nodeEntities_.end()) {
-                result.push_back(entityIt->second);
-            }
+    for (const RelationshipIndex::Neighbor& n : index_.GetNeighbors(FindNode(node))) {
+        if (n.type == type) {
+            result.push_back(nodeEntities_[n.node]);
         }
     }
 
@@ -206,18 +170,11 @@ std::vector<BondableEntity> RelationshipGraph::GetNeighborsByType(const Bondable
 std::vector<const EdgeData*> RelationshipGraph::GetEdgesFor(const BondableEntity& node) const
 {
     std::vector<const EdgeData*> result;
-    std::string nodeId = BondableHelper::GetId(node);
-
-    auto it = adjacency_.find(nodeId);
-    if (it == adjacency_.end()) {
-        return result;
-    }
+    std::span<const RelationshipIndex::Neighbor> neighbors = index_.GetNeighbors(FindNode(node));
+    result.reserve(neighbors.size());
 
-    for (const AdjacencyEntry& entry : it->second) {
-        auto edgeIt = edges_.find(entry.edgeId);
-        if (edgeIt != edges_.end()) {
-            result.push_back(&edgeIt->second);
-        }
+    for (const RelationshipIndex::Neighbor& n : neighbors) {
+        result.push_back(&edges_[n.edge]);
     }
 
     return result;
@@ -227,10 +184,12 @@ std::vector<const EdgeData*> RelationshipGraph::GetEdgesFor(const BondableEntity
 std::vector<const EdgeData*> RelationshipGraph::GetAllEdges() const
 {
     std::vector<const EdgeData*> result;
-    result.reserve(edges_.size());
+    result.reserve(index_.GetEdgeCount());
 
-    for (const auto& pair : edges_) {
-        result.push_back(&pair.second);
+    for (uint32_t slot = 0; slot < edges_.size(); ++slot) {
+        if (index_.GetEdge(slot).alive) {
+            result.push_back(&edges_[slot]);
+        }
     }
 
     return result;
@@ -241,15 +200,10 @@ std::vector<const EdgeData*> RelationshipGraph::GetEdgesByType(BondType type) co
 {
     std::vector<const EdgeData*> result;
 
-    auto it = typeIndex_.find(static_cast<int>(type));
-    if (it == typeIndex_.end()) {
-        return result;
-    }
-
-    for (uint32_t edgeId : it->second) {
-        auto edgeIt = edges_.find(edgeId);
-        if (edgeIt != edges_.end()) {
-            result.push_back(&edgeIt->second);
+    for (uint32_t slot = 0; slot < edges_.size(); ++slot) {
+        const RelationshipIndex::Edge& edge = index_.GetEdge(slot);
+        if (edge.alive && edge.type == type) {
+            result.push_back(&edges_[slot]);
         }
     }
 
@@ -259,78 +213,49 @@ std::vector<const EdgeData*> RelationshipGraph::GetEdgesByType(BondType type) co
 //----------------------------------------------------------------------------
 bool RelationshipGraph::AreConnected(const BondableEntity& a, const BondableEntity& b) const
 {
-    Cluster cluster = GetConnectedComponent(a);
-    std::string targetId = BondableHelper::GetId(b);
-
-    for (const std::string& nodeId : cluster.nodeIds) {
-        if (nodeId == targetId) {
-            return true;
-        }
-    }
-
-    return false;
+    return index_.IsReachable(FindNode(a), FindNode(b), nullptr);
 }
 
 //----------------------------------------------------------------------------
 bool RelationshipGraph::AreConnectedByType(const BondableEntity& a, const BondableEntity& b, BondType type) const
 {
-    Cluster cluster = GetConnectedComponentByType(a, type);
-    std::string targetId = BondableHelper::GetId(b);
-
-    for (const std::string& nodeId : cluster.nodeIds) {
-        if (nodeId == targetId) {
-            return true;
-        }
-    }
-
-    return false;
+    return index_.IsReachable(FindNode(a), FindNode(b), &type);
 }
 
 //----------------------------------------------------------------------------
 Cluster RelationshipGraph::GetConnectedComponent(const BondableEntity& start) const
 {
-    std::string startId = BondableHelper::GetId(start);
-    return BFS(startId, nullptr);
+    return MakeCluster(FindNode(start), nullptr);
 }
 
 //----------------------------------------------------------------------------
 Cluster RelationshipGraph::GetConnectedComponentByType(const BondableEntity& start, BondType type) const
 {
-    std::string startId = BondableHelper::GetId(start);
-    BondType filterType = type;
-    return BFS(startId, &filterType);
+    return MakeCluster(FindNode(start), &type);
 }
 
 //----------------------------------------------------------------------------
 std::vector<Cluster> RelationshipGraph::FindClustersByType(BondType type) const
 {
     std::vector<Cluster> clusters;
-    std::unordered_set<std::string> visited;
+    std::vector<bool> visited(index_.GetNodeCount(), false);
 
     // 指定タイプのエッジを持つノードを全て探索
-    auto it = typeIndex_.find(static_cast<int>(type));
-    if (it == typeIndex_.end()) {
-        return clusters;
-    }
-
-    for (uint32_t edgeId : it->second) {
-        auto edgeIt = edges_.find(edgeId);
-        if (edgeIt == edges_.end()) continue;
-
-        const EdgeData& edge = edgeIt->second;
+    for (uint32_t slot = 0; slot < edges_.size(); ++slot) {
+        const RelationshipIndex::Edge& edge = index_.GetEdge(slot);
+        if (!edge.alive || edge.type != type) continue;
 
         // まだ訪問していないノードからBFS
-        if (visited.find(edge.nodeA) == visited.end()) {
-            BondType filterType = type;
-            Cluster cluster = BFS(edge.nodeA, &filterType);
+        if (!visited[edge.a]) {
+            Cluster cluster = MakeCluster(edge.a, &type);
 
             // 訪問済みに追加
-            for (const std::string& nodeId : cluster.nodeIds) {
-                visited.insert(nodeId);
+            for (NodeIndex node : cluster.nodes) {
+                visited[node] = true;
             }
 
             // 2ノード以上のクラスターのみ追加
-            if (cluster.nodeIds.size() > 1) {
+            if (cluster.nodes.size() > 1) {
                 clusters.push_back(std::move(cluster));
             }
         }
@@ -340,53 +265,28 @@ std::vector<Cluster> RelationshipGraph::FindClustersByType(BondType type) const
 }
 
 //----------------------------------------------------------------------------
-Cluster RelationshipGraph::BFS(const std::string& startId, BondType* filterType) const
+const void* RelationshipGraph::GetNodeKey(const BondableEntity& entity)
 {
-    Cluster result;
-
-    // ノードが存在しない場合
-    auto startIt = adjacency_.find(startId);
-    if (startIt == adjacency_.end()) {
-        // 孤立ノードとして返す
-        auto entityIt = nodeEntities_.find(startId);
-        if (entityIt != nodeEntities_.end()) {
-            result.nodeIds.push_back(startId);
-            result.entities.push_back(entityIt->second);
-        }
-        return result;
-    }
-
-    std::queue<std::string> toVisit;
-    std::unordered_set<std::string> visited;
+    return std::visit([](auto* ptr) -> const void* { return ptr; }, entity);
+}
 
-    toVisit.push(startId);
-    visited.insert(startId);
+//----------------------------------------------------------------------------
+RelationshipGraph::NodeIndex RelationshipGraph::FindNode(const BondableEntity& entity) const
+{
+    return index_.FindNode(GetNodeKey(entity));
+}
 
-    while (!toVisit.empty()) {
-        std::string current = toVisit.front();
-        toVisit.pop();
+//----------------------------------------------------------------------------
+Cluster RelationshipGraph::MakeCluster(NodeIndex start, const BondType* filterType) const
+{
+    Cluster result;
 
-        result.nodeIds.push_back(current);
-        auto entityIt = nodeEntities_.find(current);
-        if (entityIt != nodeEntities_.end()) {
-            result.entities.push_back(entityIt->second);
-        }
+    // 未登録のノードは空
+    index_.CollectComponent(start, filterType, result.nodes);
 
-        // 隣接ノードを探索
-        auto adjIt = adjacency_.find(current);
-        if (adjIt != adjacency_.end()) {
-            for (const AdjacencyEntry& entry : adjIt->second) {
-                // タイプフィルター
-                if (filterType && entry.type != *filterType) {
-                    continue;
-                }
-
-                if (visited.find(entry.neighborId) == visited.end()) {
-                    visited.insert(entry.neighborId);
-                    toVisit.push(entry.neighborId);
-                }
-            }
-        }
+    result.entities.reserve(result.nodes.size());
+    for (NodeIndex node : result.nodes) {
+        result.entities.push_back(nodeEntities_[node]);
     }
 
     return result;
@@ -6,10 +6,10 @@
 
 #include "game/bond/bond.h"
 #include "game/bond/bondable_entity.h"
+#include "game/relationships/relationship_index.h"
+#include <deque>
 #include <vector>
 #include <unordered_map>
-#include <unordered_set>
-#include <string>
 #include <cstdint>
 
 //----------------------------------------------------------------------------
@@ -18,8 +18,8 @@
 struct EdgeData
 {
     uint32_t id = 0;            //!< エッジID
-    std::string nodeA;          //!< ノードA（エンティティID）
-    std::string nodeB;          //!< ノードB（エンティティID）
+    uint32_t nodeA = 0;         //!< ノードA（ノード番号）
+    uint32_t nodeB = 0;         //!< ノードB（ノード番号）
     BondType type = BondType::Basic;  //!< 縁タイプ
     BondableEntity entityA;     //!< エンティティA（実体参照）
     BondableEntity entityB;     //!< エンティティB（実体参照）
@@ -30,7 +30,7 @@ struct EdgeData
 //----------------------------------------------------------------------------
 struct Cluster
 {
-    std::vector<std::string> nodeIds;       //!< ノードIDリスト
+    std::vector<uint32_t> nodes;            //!< ノード番号リスト
     std::vector<BondableEntity> entities;   //!< エンティティリスト
 };
 
@@ -40,6 +40,10 @@ struct Cluster
 //!          - 隣接リストによる効率的なクエリ
 //!          - タイプ別のエッジ検索
 //!          - クラスター（連結成分）検出
+//!
+//!          エンティティはアドレスで識別し、RelationshipIndexでノード番号に
+//!          登録する。グラフ本体は番号で引く配列なので、クエリで文字列IDは使わない。
+//!          返すEdgeDataのアドレスは、そのエッジを削除するかClear()するまで変わらない。
 //----------------------------------------------------------------------------
 class RelationshipGraph
 {
@@ -97,7 +101,7 @@ public:
     [[nodiscard]] std::vector<const EdgeData*> GetEdgesFor(const BondableEntity& node) const;
 
     //! @brief エッジ数を取得
-    [[nodiscard]] size_t GetEdgeCount() const { return edges_.size(); }
+    [[nodiscard]] size_t GetEdgeCount() const { return index_.GetEdgeCount(); }
 
     //! @brief 全エッジを取得
     [[nodiscard]] std::vector<const EdgeData*> GetAllEdges() const;
@@ -125,28 +129,28 @@ public:
     [[nodiscard]] std::vector<Cluster> FindClustersByType(BondType type) const;
 
 private:
-    //! @brief 隣接ノード情報
-    struct AdjacencyEntry
-    {
-        std::string neighborId;     //!< 隣接ノードID
-        uint32_t edgeId;            //!< エッジID
-        BondType type;              //!< 縁タイプ
-    };
+    using NodeIndex = RelationshipIndex::NodeIndex;
 
-    //! @brief BFSで連結成分を探索
-    Cluster BFS(const std::string& startId, BondType* filterType) const;
+    //! @brief エンティティのキー（実体のアドレス）
+    [[nodiscard]] static const void* GetNodeKey(const BondableEntity& entity);
+
+    //! @brief 登録済みのノード番号（未登録ならkInvalidNode）
+    [[nodiscard]] NodeIndex FindNode(const BondableEntity& entity) const;
+
+    //! @brief 連結成分をClusterに変換
+    [[nodiscard]] Cluster MakeCluster(NodeIndex start, const BondType* filterType) const;
 
     uint32_t nextEdgeId_ = 1;  //!< 次のエッジID
 
-    //! @brief 全エッジ（ID→データ）
-    std::unordered_map<uint32_t, EdgeData> edges_;
+    //! @brief ノード番号と隣接（グラフ本体）
+    RelationshipIndex index_;
 
-    //! @brief 隣接リスト（ノードID→隣接情報リスト）
-    std::unordered_map<std::string, std::vector<AdjacencyEntry>> adjacency_;
+    //! @brief 辺スロット→エッジデータ（dequeなので追加してもアドレスが変わらない）
+    std::deque<EdgeData> edges_;
 
-    //! @brief タイプ別エッジインデックス（タイプ→エッジIDリスト）
-    std::unordered_map<int, std::vector<uint32_t>> typeIndex_;
+    //! @brief エッジID→辺スロット
+    std::unordered_map<uint32_t, uint32_t> edgeSlots_;
 
-    //! @brief ノードID→エンティティ マッピング
-    std::unordered_map<std::string, BondableEntity> nodeEntities_;
+    //! @brief ノード番号→エンティティ
+    std::vector<BondableEntity> nodeEntities_;
 };
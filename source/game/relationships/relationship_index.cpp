@@ -0,0 +1,197 @@
+//----------------------------------------------------------------------------
+//! @file   relationship_index.cpp
+//! @brief  関係グラフの整数インデックス実装
+//----------------------------------------------------------------------------
+#include "relationship_index.h"
+#include <algorithm>
+
+namespace {
+
+//! @brief 探索の作業領域（スレッドごと、呼び出し間で再利用）
+//! @details 訪問済みはノード番号ごとの印で管理し、探索のたびに印の値を変えて
+//!          クリアを省く。値が一周したときだけ配列をクリアする。
+struct SearchScratch
+{
+    std::vector<uint32_t> marks;
+    std::vector<RelationshipIndex::NodeIndex> queue;
+    uint32_t mark = 0;
+
+    //! 新しい印を発行（ノード数に合わせて配列を広げる）
+    uint32_t Begin(size_t nodeCount) {
+        if (marks.size() < nodeCount) {
+            marks.resize(nodeCount, 0);
+        }
+        if (++mark == 0) {
+            std::fill(marks.begin(), marks.end(), 0);
+            mark = 1;
+        }
+        queue.clear();
+        return mark;
+    }
+};
+
+thread_local SearchScratch t_scratch;
+
+} // namespace
+
+//----------------------------------------------------------------------------
+RelationshipIndex::NodeIndex RelationshipIndex::InternNode(const void* key)
+{
+    auto [it, inserted] = nodeLookup_.try_emplace(key, static_cast<NodeIndex>(nodeKeys_.size()));
+    if (inserted) {
+        nodeKeys_.push_back(key);
+        adjacency_.emplace_back();
+    }
+    return it->second;
+}
+
+//----------------------------------------------------------------------------
+RelationshipIndex::NodeIndex RelationshipIndex::FindNode(const void* key) const
+{
+    auto it = nodeLookup_.find(key);
+    return it != nodeLookup_.end() ? it->second : kInvalidNode;
+}
+
+//----------------------------------------------------------------------------
+uint32_t RelationshipIndex::AddEdge(NodeIndex a, NodeIndex b, BondType type)
+{
+    if (a == b || a >= nodeKeys_.size() || b >= nodeKeys_.size()) {
+        return kInvalidEdge;
+    }
+    if (FindEdge(a, b) != kInvalidEdge) {
+        return kInvalidEdge;
+    }
+
+    uint32_t edge;
+    if (!freeEdges_.empty()) {
+        edge = freeEdges_.back();
+        freeEdges_.pop_back();
+    } else {
+        edge = static_cast<uint32_t>(edges_.size());
+        edges_.emplace_back();
+    }
+    edges_[edge] = { a, b, type, true };
+    ++edgeCount_;
+
+    // 隣接リスト更新（双方向）
+    adjacency_[a].push_back({ b, edge, type });
+    adjacency_[b].push_back({ a, edge, type });
+
+    return edge;
+}
+
+//----------------------------------------------------------------------------
+bool RelationshipIndex::RemoveEdge(uint32_t edge)
+{
+    if (edge >= edges_.size() || !edges_[edge].alive) {
+        return false;
+    }
+
+    Edge& slot = edges_[edge];
+    auto unlink = [edge](std::vector<Neighbor>& neighbors) {
+        neighbors.erase(std::find_if(neighbors.begin(), neighbors.end(),
+                                     [edge](const Neighbor& n) { return n.edge == edge; }));
+    };
+    unlink(adjacency_[slot.a]);
+    unlink(adjacency_[slot.b]);
+
+    slot.alive = false;
+    freeEdges_.push_back(edge);
+    --edgeCount_;
+    return true;
+}
+
+//----------------------------------------------------------------------------
+uint32_t RelationshipIndex::FindEdge(NodeIndex a, NodeIndex b) const
+{
+    if (a >= adjacency_.size() || b >= adjacency_.size()) {
+        return kInvalidEdge;
+    }
+
+    // 隣接の少ない側を走査
+    const std::vector<Neighbor>& adjA = adjacency_[a];
+    const std::vector<Neighbor>& adjB = adjacency_[b];
+    const bool scanA = adjA.size() <= adjB.size();
+    const NodeIndex target = scanA ? b : a;
+    for (const Neighbor& n : scanA ? adjA : adjB) {
+        if (n.node == target) {
+            return n.edge;
+        }
+    }
+    return kInvalidEdge;
+}
+
+//----------------------------------------------------------------------------
+std::span<const RelationshipIndex::Neighbor> RelationshipIndex::GetNeighbors(NodeIndex node) const
+{
+    if (node >= adjacency_.size()) {
+        return {};
+    }
+    return adjacency_[node];
+}
+
+//----------------------------------------------------------------------------
+void RelationshipIndex::CollectComponent(NodeIndex start, const BondType* filterType,
+                                         std::vector<NodeIndex>& nodes) const
+{
+    nodes.clear();
+    if (start >= adjacency_.size()) {
+        return;
+    }
+
+    SearchScratch& scratch = t_scratch;
+    const uint32_t mark = scratch.Begin(adjacency_.size());
+
+    // 結果配列をそのまま訪問キューとして使う
+    nodes.push_back(start);
+    scratch.marks[start] = mark;
+
+    for (size_t head = 0; head < nodes.size(); ++head) {
+        for (const Neighbor& n : adjacency_[nodes[head]]) {
+            if (filterType && n.type != *filterType) continue;
+            if (scratch.marks[n.node] == mark) continue;
+            scratch.marks[n.node] = mark;
+            nodes.push_back(n.node);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+bool RelationshipIndex::IsReachable(NodeIndex from, NodeIndex to, const BondType* filterType) const
+{
+    if (from >= adjacency_.size() || to >= adjacency_.size()) {
+        return false;
+    }
+    if (from == to) {
+        return true;
+    }
+
+    SearchScratch& scratch = t_scratch;
+    const uint32_t mark = scratch.Begin(adjacency_.size());
+    std::vector<NodeIndex>& queue = scratch.queue;
+
+    queue.push_back(from);
+    scratch.marks[from] = mark;
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        for (const Neighbor& n : adjacency_[queue[head]]) {
+            if (filterType && n.type != *filterType) continue;
+            if (n.node == to) return true;
+            if (scratch.marks[n.node] == mark) continue;
+            scratch.marks[n.node] = mark;
+            queue.push_back(n.node);
+        }
+    }
+    return false;
+}
+
+//----------------------------------------------------------------------------
+void RelationshipIndex::Clear()
+{
+    nodeLookup_.clear();
+    nodeKeys_.clear();
+    adjacency_.clear();
+    edges_.clear();
+    freeEdges_.clear();
+    edgeCount_ = 0;
+}
@@ -0,0 +1,129 @@
+//----------------------------------------------------------------------------
+//! @file   relationship_index.h
+//! @brief  関係グラフの整数インデックス実装
+//!
+//! @details ノードを連番の32bit番号に登録し、隣接リストを番号で引く配列で持つ。
+//!          クエリ・探索では文字列の生成もハッシュも行わない。
+//!          エンティティ型に依存しないため、RelationshipGraphの内部実装として使い、
+//!          単体でもテスト・計測できる。
+//----------------------------------------------------------------------------
+#pragma once
+
+#include "game/bond/bond.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+//----------------------------------------------------------------------------
+//! @brief 関係グラフの整数インデックス
+//! @details
+//!   - ノード: キー（エンティティのアドレス）を初回登録順に0, 1, 2...へ割り当てる。
+//!             番号はClear()まで変わらない（辺が無くなっても残る）。
+//!   - 辺: スロット配列に格納し、削除したスロットは再利用する。
+//!   - 隣接: ノード番号で引く配列。各ノードの隣接は追加順の連続配列。
+//!
+//! @note const関数の探索作業領域はスレッドごとに持つため、
+//!       読み取り同士は複数スレッドから同時に呼んでよい。
+//----------------------------------------------------------------------------
+class RelationshipIndex
+{
+public:
+    using NodeIndex = uint32_t;
+
+    static constexpr NodeIndex kInvalidNode = (std::numeric_limits<uint32_t>::max)();
+    static constexpr uint32_t kInvalidEdge = (std::numeric_limits<uint32_t>::max)();
+
+    //! @brief 隣接情報
+    struct Neighbor
+    {
+        NodeIndex node;     //!< 隣接ノード
+        uint32_t edge;      //!< 辺スロット
+        BondType type;      //!< 縁タイプ
+    };
+
+    //! @brief 辺スロット
+    struct Edge
+    {
+        NodeIndex a = kInvalidNode;
+        NodeIndex b = kInvalidNode;
+        BondType type = BondType::Basic;
+        bool alive = false;
+    };
+
+    //----------------------------------------------------------
+    //! @name   ノード
+    //----------------------------------------------------------
+    //! @{
+
+    //! @brief ノードを登録（登録済みなら既存の番号）
+    NodeIndex InternNode(const void* key);
+
+    //! @brief ノード番号を検索（未登録ならkInvalidNode）
+    [[nodiscard]] NodeIndex FindNode(const void* key) const;
+
+    //! @brief ノードのキー
+    [[nodiscard]] const void* GetNodeKey(NodeIndex node) const { return nodeKeys_[node]; }
+
+    //! @brief 登録済みノード数
+    [[nodiscard]] size_t GetNodeCount() const { return nodeKeys_.size(); }
+
+    //! @}
+    //----------------------------------------------------------
+    //! @name   辺
+    //----------------------------------------------------------
+    //! @{
+
+    //! @brief 辺を追加
+    //! @return 辺スロット（同一ノード・既存の辺・未登録ノードならkInvalidEdge）
+    uint32_t AddEdge(NodeIndex a, NodeIndex b, BondType type);
+
+    //! @brief 辺を削除
+    //! @return 削除したらtrue
+    bool RemoveEdge(uint32_t edge);
+
+    //! @brief 2ノード間の辺を検索（なければkInvalidEdge）
+    [[nodiscard]] uint32_t FindEdge(NodeIndex a, NodeIndex b) const;
+
+    //! @brief 辺スロット
+    [[nodiscard]] const Edge& GetEdge(uint32_t edge) const { return edges_[edge]; }
+
+    //! @brief 辺スロット数（削除済みスロットを含む）
+    [[nodiscard]] size_t GetEdgeSlotCount() const { return edges_.size(); }
+
+    //! @brief 有効な辺の数
+    [[nodiscard]] size_t GetEdgeCount() const { return edgeCount_; }
+
+    //! @brief ノードの隣接（追加順）
+    [[nodiscard]] std::span<const Neighbor> GetNeighbors(NodeIndex node) const;
+
+    //! @}
+    //----------------------------------------------------------
+    //! @name   探索
+    //----------------------------------------------------------
+    //! @{
+
+    //! @brief 連結成分を幅優先で収集
+    //! @param filterType 辿る縁タイプ（nullptrで全て）
+    //! @param[out] nodes 訪問順のノード（クリアしてから追加、startが先頭）
+    void CollectComponent(NodeIndex start, const BondType* filterType, std::vector<NodeIndex>& nodes) const;
+
+    //! @brief 2ノードが推移的に接続されているか（見つかった時点で打ち切る）
+    [[nodiscard]] bool IsReachable(NodeIndex from, NodeIndex to, const BondType* filterType) const;
+
+    //! @}
+
+    //! @brief 全ノード・全辺を破棄
+    void Clear();
+
+private:
+    std::unordered_map<const void*, NodeIndex> nodeLookup_;    //!< キー→ノード番号
+    std::vector<const void*> nodeKeys_;                        //!< ノード番号→キー
+    std::vector<std::vector<Neighbor>> adjacency_;             //!< ノード番号→隣接
+
+    std::vector<Edge> edges_;           //!< 辺スロット
+    std::vector<uint32_t> freeEdges_;   //!< 空き辺スロット
+    size_t edgeCount_ = 0;
+};
@@ -36,6 +36,7 @@
 #include "game/systems/faction_manager.h"
 #include "game/systems/event/event_bus.h"
 #include "game/systems/event/game_events.h"
+#include "engine/fs/file_system_manager.h"
 #include "game/ui/radial_menu.h"
 #include "game/systems/love_bond_system.h"
 #include "game/relationships/relationship_facade.h"
@@ -71,6 +72,10 @@ void TestScene::OnEnter()
     float stageHeight = 4000.0f;
     stageBackground_.Initialize("stage1", stageWidth, stageHeight);
 
+    // ステージ範囲が確定したので衝突判定を密グリッドに切り替え
+    CollisionManager::Get().SetWorldBounds(AABB(0.0f, 0.0f,
+        stageBackground_.GetStageWidth(), stageBackground_.GetStageHeight()));
+
     // CSVからステージデータ読み込み
     StageData stageData = StageLoader::LoadFromCSV("stages:/stage1");
     if (!stageData.IsValid()) {
@@ -153,6 +158,9 @@ void TestScene::OnEnter()
         enemyGroups_.push_back(std::move(group));
     }
 
+    // イベント記録用のエンティティID（ステージ上の並び順で決まる）
+    eventEntities_.Build(player_.get(), enemyGroups_);
+
     // システム初期化
     RelationshipContext::Get().Initialize();
     RelationshipFacade::Get().Initialize();
@@ -230,6 +238,7 @@ void TestScene::OnEnter()
     LOG_INFO("  Right Click: Bind mode (create bonds)");
     LOG_INFO("  Left Click: Cut mode (cut bonds)");
     LOG_INFO("  ESC: Cancel mode");
+    LOG_INFO("  F2: Start/stop event recording");
 
     // テスト: 起動時に矢を1本発射
     if (!enemyGroups_.empty()) {
@@ -305,12 +314,17 @@ void TestScene::OnExit()
     }
 
     stageBackground_.Shutdown();
+    CollisionManager::Get().ClearWorldBounds();
     cameraObj_.reset();
     whiteTexture_.reset();
 
     // ========================================================================
     // Phase 5: EventBusクリア（最後に実行）
     // ========================================================================
+    if (eventRecorder_.IsRecording()) {
+        ToggleEventRecording();
+    }
+    eventEntities_.Clear();
     eventSubscriptions_.clear();
     EventBus::Get().Clear();
 }
@@ -321,6 +335,7 @@ void TestScene::Update()
     float rawDt = Application::Get().GetDeltaTime();
     float dt = TimeManager::Get().GetScaledDeltaTime(rawDt);
     time_ += dt;
+    eventRecorder_.BeginFrame();
 
     // FPS計測
     frameCount_++;
@@ -388,6 +403,9 @@ void TestScene::Update()
         }
     }
 
+    // AI状態の変化をCombatMediatorへ配送（戦闘判定の前）
+    EventBus::Get().Flush();
+
     // グループ更新
     for (std::unique_ptr<Group>& group : enemyGroups_) {
         group->Update(dt);
@@ -398,6 +416,9 @@ void TestScene::Update()
         CombatSystem::Get().Update(dt);
     }
 
+    // 戦闘で発生した全滅などを配送
+    EventBus::Get().Flush();
+
     // 硬直システム更新
     StaggerSystem::Get().Update(dt);
 
@@ -534,6 +555,13 @@ void TestScene::HandleInput(float /*dt*/)
         LOG_INFO("[TestScene] Debug draw: " + std::string(showDebugDraw_ ? "ON" : "OFF"));
     }
 
+    //------------------------------------------------------------------------
+    // F2キー: イベント記録の開始・停止
+    //------------------------------------------------------------------------
+    if (kb.IsKeyDown(Key::F2)) {
+        ToggleEventRecording();
+    }
+
     //------------------------------------------------------------------------
     // 切モード中: プレイヤーが縁を通過したら切断
     //------------------------------------------------------------------------
@@ -541,21 +569,22 @@ void TestScene::HandleInput(float /*dt*/)
         Collider2D* playerCollider = player_->GetCollider();
         Bond* bondToCut = nullptr;
 
+        // 全ての縁を1回のバッチクエリでまとめて判定
         const std::vector<std::unique_ptr<Bond>>& bonds = BondManager::Get().GetAllBonds();
+        bondSegments_.clear();
         for (const std::unique_ptr<Bond>& bond : bonds) {
-            Vector2 posA = BondableHelper::GetPosition(bond->GetEntityA());
-            Vector2 posB = BondableHelper::GetPosition(bond->GetEntityB());
-
-            std::vector<Collider2D*> hits;
-            CollisionManager::Get().QueryLineSegment(posA, posB, hits, CollisionLayer::Player);
+            bondSegments_.emplace_back(BondableHelper::GetPosition(bond->GetEntityA()),
+                                       BondableHelper::GetPosition(bond->GetEntityB()));
+        }
+        CollisionManager::Get().QueryLineSegmentBatch(bondSegments_, bondHits_, CollisionLayer::Player);
 
-            for (Collider2D* hitCollider : hits) {
+        for (size_t i = 0; i < bonds.size() && bondToCut == nullptr; ++i) {
+            for (Collider2D* hitCollider : bondHits_.Get(i)) {
                 if (hitCollider == playerCollider) {
-                    bondToCut = bond.get();
+                    bondToCut = bonds[i].get();
                     break;
                 }
             }
-            if (bondToCut != nullptr) break;
         }
 
         if (bondToCut != nullptr) {
@@ -770,16 +799,23 @@ void TestScene::Render()
     }
 #endif
 
-    // ラジアルメニュー描画
-    RadialMenu::Get().Render(spriteBatch);
-
     spriteBatch.End();
 
 #ifdef _DEBUG
+    // 円は全てこのパスで描く（検知範囲・ラジアルメニューを1回の描画コールで）
+    CircleRenderer& circles = CircleRenderer::Get();
+    circles.Begin(*camera_);
     if (showDebugDraw_) {
-        CircleRenderer::Get().Begin(*camera_);
         DrawDetectionRanges();
-        CircleRenderer::Get().End();
+    }
+    RadialMenu::Get().RenderCircles();
+    circles.End();
+
+    // ラジアルメニューの境界線（円の上に重ねる）
+    if (RadialMenu::Get().IsOpen()) {
+        spriteBatch.Begin();
+        RadialMenu::Get().Render(spriteBatch);
+        spriteBatch.End();
     }
 #endif
 }
@@ -899,6 +935,19 @@ void TestScene::DrawUI()
         DEBUG_RECT_FILL(fpsPos + Vector2(barWidth * 0.5f, 0.0f), Vector2(barWidth, 15.0f), fpsColor);
     }
 
+    // ステートバインド数（FPSバーの下）- 白=発行、シアン=キャッシュで省略（1bindで1px、最大200px）
+    {
+        const StateBindStats& bindStats = GraphicsContext::Get().GetFrameStateStats();
+        Vector2 issuedPos = camera_->ScreenToWorld(Vector2(30.0f, 40.0f));
+        Vector2 skippedPos = camera_->ScreenToWorld(Vector2(30.0f, 52.0f));
+        float issuedWidth = (std::min)(static_cast<float>(bindStats.TotalIssued()), 200.0f);
+        float skippedWidth = (std::min)(static_cast<float>(bindStats.TotalSkipped()), 200.0f);
+        DEBUG_RECT_FILL(issuedPos + Vector2(issuedWidth * 0.5f, 0.0f), Vector2(issuedWidth, 8.0f),
+                        Color(1.0f, 1.0f, 1.0f, 0.8f));
+        DEBUG_RECT_FILL(skippedPos + Vector2(skippedWidth * 0.5f, 0.0f), Vector2(skippedWidth, 8.0f),
+                        Color(0.0f, 1.0f, 1.0f, 0.8f));
+    }
+
     // HP/FEバー表示（画面右上）
     if (player_) {
         float hpRatio = player_->GetHpRatio();
@@ -975,6 +1024,16 @@ void TestScene::LogAIStatus()
 
     // 縁の数
     LOG_INFO("  Bonds: " + std::to_string(BondManager::Get().GetAllBonds().size()));
+
+    // 直前フレームのステートバインド（発行/省略）
+    const StateBindStats& bindStats = GraphicsContext::Get().GetFrameStateStats();
+    std::string binds = "  Binds:";
+    for (size_t i = 0; i < StateBindStats::kCategoryCount; ++i) {
+        binds += " ";
+        binds += GetStateBindCategoryName(static_cast<StateBindCategory>(i));
+        binds += " " + std::to_string(bindStats.issued[i]) + "/" + std::to_string(bindStats.skipped[i]);
+    }
+    LOG_INFO(binds);
 }
 
 //----------------------------------------------------------------------------
@@ -1033,5 +1092,47 @@ void TestScene::SetupEventSubscriptions()
         })
     );
 
+    // 戦闘中に発生するイベントは遅延配送し、Update内の区切りでまとめて配送する
+    // （配送順: 全滅 → AI状態 → Love追従）
+    EventBus::Get().SetDispatchMode<GroupDefeatedEvent>(EventDispatchMode::Deferred);
+    EventBus::Get().SetDispatchMode<AIStateChangedEvent>(EventDispatchMode::Deferred);
+    EventBus::Get().SetDispatchMode<LoveFollowingChangedEvent>(EventDispatchMode::Deferred);
+
     LOG_INFO("[TestScene] EventBus subscriptions registered");
 }
+
+//----------------------------------------------------------------------------
+void TestScene::ToggleEventRecording()
+{
+    if (!eventRecorder_.IsRecording()) {
+        eventRecorder_.SetEntityMap(&eventEntities_);
+        eventRecorder_.Start(kEventTraceCapacity, static_cast<uint32_t>(EventBus::kEventTypeCount));
+        EventBus::Get().SetRecorder(&eventRecorder_);
+        LOG_INFO("[TestScene] Event recording started");
+        return;
+    }
+
+    EventBus::Get().SetRecorder(nullptr);
+    eventRecorder_.Stop();
+
+    std::span<const std::byte> data = eventRecorder_.GetData();
+    LOG_INFO("[TestScene] Event recording stopped: " + std::to_string(eventRecorder_.GetRecordCount()) +
+             " events (" + std::to_string(eventRecorder_.GetOpaqueCount()) + " without payload), " +
+             std::to_string(eventRecorder_.GetFrame()) + " frames, " + std::to_string(data.size()) + " bytes");
+    if (eventRecorder_.GetDroppedCount() > 0) {
+        LOG_WARN("[TestScene] Event trace buffer full, dropped " +
+                 std::to_string(eventRecorder_.GetDroppedCount()) + " events");
+    }
+
+    IWritableFileSystem* fs = FileSystemManager::Get().GetWritableFileSystem("captures");
+    if (!fs) {
+        LOG_WARN("[TestScene] captures is not mounted, event trace not saved");
+        return;
+    }
+    FileOperationResult result = fs->writeFile("event_trace.bin", data);
+    if (!result.success) {
+        LOG_ERROR("[TestScene] Failed to save event trace: " + result.errorMessage());
+        return;
+    }
+    LOG_INFO("[TestScene] Event trace saved: captures:/event_trace.bin (inspect with --inspect-events)");
+}
@@ -17,6 +17,8 @@
 #include "game/ai/group_ai.h"
 #include "game/bond/bondable_entity.h"
 #include "game/bond/bond.h"
+#include "game/systems/event/event_trace.h"
+#include "game/systems/event/game_event_entities.h"
 #include <memory>
 #include <vector>
 #include <cstdint>
@@ -108,9 +110,25 @@ private:
     // EventBus購読ID
     std::vector<uint32_t> eventSubscriptions_;
 
+    // 切断判定のバッチクエリ用（フレーム間で再利用）
+    std::vector<LineSegment> bondSegments_;
+    QueryBatchResult bondHits_;
+
     // EventBus購読を設定
     void SetupEventSubscriptions();
 
+    //! @brief イベント記録の開始・停止（F2、停止時にcaptures:/event_trace.binへ保存、--inspect-eventsで集計）
+    void ToggleEventRecording();
+
+    //! @brief イベント記録（記録中はフレームごとの発行をバッファへ書き込む）
+    EventTraceRecorder eventRecorder_;
+
+    //! @brief イベント記録でPlayer/Group/IndividualをIDに置き換える表
+    GameEventEntityMap eventEntities_;
+
+    //! @brief イベント記録のバッファ容量
+    static constexpr size_t kEventTraceCapacity = 4 * 1024 * 1024;
+
     //------------------------------------------------------------------------
     // 縁タイプ選択UI
     //------------------------------------------------------------------------
@@ -140,6 +140,23 @@ void StageBackground::Initialize(const std::string& stageId, float screenWidth,
     // 装飾を配置
     PlaceDecorations(stageId, screenWidth, screenHeight);
 
+    // 同じレイヤーの装飾をX順に並べ、静的ブロックの範囲を空間的にまとまらせる
+    // （配置はランダムなので重なり順に意味はない）
+    std::stable_sort(decorations_.begin(), decorations_.end(),
+        [](const DecorationObject& a, const DecorationObject& b) {
+            if (a.sortingLayer != b.sortingLayer) return a.sortingLayer < b.sortingLayer;
+            return a.position.x < b.position.x;
+        });
+
+    // 初期化後は変化しないため、整列・頂点展開済みの静的ブロックにする
+    SpriteBatch& spriteBatch = SpriteBatch::Get();
+    spriteBatch.BeginStatic();
+    Submit(spriteBatch);
+    staticBlock_ = spriteBatch.EndStatic();
+    if (staticBlock_ == SpriteBatch::kInvalidStaticBlock) {
+        LOG_WARN("[StageBackground] Static block unavailable, drawing per frame");
+    }
+
     LOG_INFO("[StageBackground] Initialized with " + std::to_string(decorations_.size()) + " decorations");
 }
 
@@ -249,6 +266,18 @@ void StageBackground::PlaceDecorations(const std::string& stageId, float screenW
             AddDecoration(bonfire, pos, -80, Vector2::One, 0.0f);
         }
     }
+
+    // 装飾テクスチャをアトラスにまとめる（テクスチャ切り替えによる描画コール分割を減らす）
+    std::vector<TexturePtr> textures;
+    textures.reserve(decorations_.size());
+    for (const DecorationObject& obj : decorations_) {
+        textures.push_back(obj.texture);
+    }
+    std::vector<TextureRegion> regions;
+    TextureManager::Get().AddToAtlas(textures, regions);
+    for (size_t i = 0; i < decorations_.size(); ++i) {
+        decorations_[i].region = regions[i];
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -348,6 +377,7 @@ void StageBackground::BakeGroundTexture()
         // RTを復元して終了
         d3dCtx->OMSetRenderTargets(1, savedRTV.GetAddressOf(), savedDSV.Get());
         d3dCtx->RSSetViewports(1, &savedViewport);
+        ctx.InvalidateStateCache();
         return;
     }
 
@@ -382,6 +412,7 @@ void StageBackground::BakeGroundTexture()
     // === 復元 ===
     d3dCtx->OMSetRenderTargets(1, savedRTV.GetAddressOf(), savedDSV.Get());
     d3dCtx->RSSetViewports(1, &savedViewport);
+    ctx.InvalidateStateCache();  // RT変更でSRVが外れている可能性がある
 
     // ベイク完了後、不要なリソースを解放
     accumulationRT_.reset();
@@ -457,6 +488,17 @@ void StageBackground::SplitIntoChunks()
 
 //----------------------------------------------------------------------------
 void StageBackground::Render(SpriteBatch& spriteBatch, [[maybe_unused]] const Camera2D& camera)
+{
+    // 静的ブロックは表示範囲に掛かる範囲だけがEnd()で描画される
+    if (staticBlock_ != SpriteBatch::kInvalidStaticBlock) {
+        spriteBatch.DrawStatic(staticBlock_);
+        return;
+    }
+    Submit(spriteBatch);
+}
+
+//----------------------------------------------------------------------------
+void StageBackground::Submit(SpriteBatch& spriteBatch)
 {
     // 1. ベース地面カラーを描画（1x1テクスチャをステージ全体にスケール）
     if (baseGroundTexture_) {
@@ -491,15 +533,15 @@ void StageBackground::Render(SpriteBatch& spriteBatch, [[maybe_unused]] const Ca
 
     // 3. 装飾描画
     for (const DecorationObject& obj : decorations_) {
-        if (!obj.texture) continue;
+        if (!obj.region.IsValid()) continue;
 
-        float texW = static_cast<float>(obj.texture->Width());
-        float texH = static_cast<float>(obj.texture->Height());
-        Vector2 origin(texW * 0.5f, texH * 0.5f);
+        const Vector4 sourceRect = obj.region.SourceRect();
+        Vector2 origin(sourceRect.z * 0.5f, sourceRect.w * 0.5f);
 
         spriteBatch.Draw(
-            obj.texture.get(),
+            obj.region.texture,
             obj.position,
+            sourceRect,
             Color(1.0f, 1.0f, 1.0f, 1.0f),
             obj.rotation,
             origin,
@@ -513,6 +555,9 @@ void StageBackground::Render(SpriteBatch& spriteBatch, [[maybe_unused]] const Ca
 //----------------------------------------------------------------------------
 void StageBackground::Shutdown()
 {
+    SpriteBatch::Get().ReleaseStatic(staticBlock_);
+    staticBlock_ = SpriteBatch::kInvalidStaticBlock;
+
     // チャンクをクリア
     for (GroundChunk& chunk : chunks_) {
         chunk.texture.reset();
@@ -528,5 +573,8 @@ void StageBackground::Shutdown()
     normalizePixelShader_.reset();
     accumulationRT_.reset();
 
+    // 装飾テクスチャだけが載っていたアトラスページを回収（再入場のたびに増えないように）
+    TextureManager::Get().ReleaseUnusedAtlasPages();
+
     LOG_INFO("[StageBackground] Shutdown");
 }
@@ -8,12 +8,13 @@
 #include "dx11/gpu/shader.h"
 #include "engine/math/math_types.h"
 #include "engine/math/color.h"
+#include "engine/texture/texture_atlas.h"
+#include "engine/c_systems/sprite_batch.h"
 #include <vector>
 #include <string>
 #include <random>
 
 // 前方宣言
-class SpriteBatch;
 class Camera2D;
 
 //----------------------------------------------------------------------------
@@ -49,6 +50,12 @@ public:
     //! @brief リソース解放
     void Shutdown();
 
+    //! @brief ステージ幅を取得
+    [[nodiscard]] float GetStageWidth() const { return stageWidth_; }
+
+    //! @brief ステージ高さを取得
+    [[nodiscard]] float GetStageHeight() const { return stageHeight_; }
+
 private:
     //! @brief 地面タイル（回転/反転付き）
     struct GroundTile
@@ -71,6 +78,7 @@ private:
     struct DecorationObject
     {
         TexturePtr texture;         //!< テクスチャ
+        TextureRegion region;       //!< 描画する領域（アトラスページ上）
         Vector2 position;           //!< 位置
         Vector2 scale;              //!< スケール
         float rotation;             //!< 回転（ラジアン）
@@ -92,6 +100,10 @@ private:
     void AddDecoration(TexturePtr texture, const Vector2& position, int sortingLayer,
                        const Vector2& scale = Vector2::One, float rotation = 0.0f);
 
+    //! @brief 地面・装飾をスプライトバッチへ投入（静的ブロックの記録にも使う）
+    //! @param spriteBatch スプライトバッチ
+    void Submit(SpriteBatch& spriteBatch);
+
     //! @brief 地面テクスチャをプリベイク
     void BakeGroundTexture();
 
@@ -136,6 +148,9 @@ private:
     // 装飾オブジェクト
     std::vector<DecorationObject> decorations_;
 
+    // 地面・装飾の静的ブロック
+    SpriteBatch::StaticBlockId staticBlock_ = SpriteBatch::kInvalidStaticBlock;
+
     // 乱数生成器
     std::mt19937 rng_;
 
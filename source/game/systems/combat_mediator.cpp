@@ -12,6 +12,7 @@
 #include "game/systems/game_constants.h"
 #include "game/relationships/relationship_facade.h"
 #include "common/logging/logging.h"
+#include <algorithm>
 
 //----------------------------------------------------------------------------
 CombatMediator& CombatMediator::Get()
@@ -25,8 +26,8 @@ void CombatMediator::Initialize()
 {
     EventBus& bus = EventBus::Get();
 
-    stateSubscriptionId_ = bus.Subscribe<AIStateChangedEvent>(
-        [this](const AIStateChangedEvent& e) { OnAIStateChanged(e); });
+    stateSubscriptionId_ = bus.SubscribeBatch<AIStateChangedEvent>(
+        [this](std::span<const AIStateChangedEvent> events) { OnAIStateChanged(events); });
 
     loveSubscriptionId_ = bus.Subscribe<LoveFollowingChangedEvent>(
         [this](const LoveFollowingChangedEvent& e) { OnLoveFollowingChanged(e); });
@@ -62,19 +63,30 @@ void CombatMediator::SetPlayer(Player* player)
 }
 
 //----------------------------------------------------------------------------
-void CombatMediator::OnAIStateChanged(const AIStateChangedEvent& event)
+void CombatMediator::OnAIStateChanged(std::span<const AIStateChangedEvent> events)
 {
-    if (!event.group) return;
+    changedGroups_.clear();
 
     {
         std::unique_lock lock(mutex_);
-        groupStates_[event.group] = event.newState;
+        for (const AIStateChangedEvent& event : events) {
+            if (!event.group) continue;
+            groupStates_[event.group] = event.newState;
+            if (std::find(changedGroups_.begin(), changedGroups_.end(), event.group) == changedGroups_.end()) {
+                changedGroups_.push_back(event.group);
+            }
+        }
     }
 
-    UpdateAttackPermission(event.group);
+    for (Group* group : changedGroups_) {
+        UpdateAttackPermission(group);
+    }
 
-    LOG_DEBUG("[CombatMediator] State changed: " + event.group->GetId() +
-              " -> " + std::to_string(static_cast<int>(event.newState)));
+    for (const AIStateChangedEvent& event : events) {
+        if (!event.group) continue;
+        LOG_DEBUG("[CombatMediator] State changed: " + event.group->GetId() +
+                  " -> " + std::to_string(static_cast<int>(event.newState)));
+    }
 }
 
 //----------------------------------------------------------------------------
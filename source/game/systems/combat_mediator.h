@@ -8,6 +8,7 @@
 #include <unordered_set>
 #include <shared_mutex>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 class Group;
@@ -70,7 +71,8 @@ private:
     //------------------------------------------------------------------------
 
     //! @brief AI状態変更イベントハンドラ
-    void OnAIStateChanged(const AIStateChangedEvent& event);
+    //! @details 同じグループの変更は最後の状態だけを反映し、攻撃許可の再計算は1回にまとめる
+    void OnAIStateChanged(std::span<const AIStateChangedEvent> events);
 
     //! @brief Love追従状態変更イベントハンドラ
     void OnLoveFollowingChanged(const LoveFollowingChangedEvent& event);
@@ -100,6 +102,7 @@ private:
     std::unordered_map<Group*, AIState> groupStates_;      //!< グループごとのAI状態
     std::unordered_map<Group*, bool> loveFollowingFlags_;  //!< グループごとのLove追従フラグ
     Player* player_ = nullptr;                             //!< プレイヤー参照
+    std::vector<Group*> changedGroups_;                    //!< OnAIStateChangedの作業領域
 
     uint32_t stateSubscriptionId_ = 0;     //!< AIStateChangedEvent購読ID
     uint32_t loveSubscriptionId_ = 0;      //!< LoveFollowingChangedEvent購読ID
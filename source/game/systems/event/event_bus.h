@@ -4,13 +4,27 @@
 //----------------------------------------------------------------------------
 #pragma once
 
+#include "game/systems/event/event_trace.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
 #include <functional>
-#include <unordered_map>
 #include <vector>
-#include <typeindex>
 #include <memory>
 #include <cstdint>
 #include <mutex>
+#include <span>
+#include <type_traits>
+
+//----------------------------------------------------------------------------
+//! @brief イベントの配送方式（イベント型ごとに設定）
+//----------------------------------------------------------------------------
+enum class EventDispatchMode : uint8_t
+{
+    Immediate,  //!< Publish時にその場で購読者を呼ぶ
+    Deferred,   //!< 型ごとのキューに溜め、Flush時にまとめて呼ぶ
+};
 
 //----------------------------------------------------------------------------
 //! @brief イベントハンドラの基底クラス
@@ -19,62 +33,251 @@ class IEventHandler
 {
 public:
     virtual ~IEventHandler() = default;
+
+    //! @brief 全購読者と未配送のイベントを破棄し、即時配送に戻す
+    virtual void Clear() = 0;
+
+    //! @brief キューに溜まったイベントを配送
+    virtual void Flush() = 0;
 };
 
 //----------------------------------------------------------------------------
 //! @brief 型付きイベントハンドラ
+//! @details 購読者は不変の連続配列（スナップショット）で保持する。
+//!          Add/Removeは新しい配列を作って差し替え（コピーオンライト）、
+//!          Invokeは現在の配列を取得して順に呼ぶだけで、購読者リストのコピーも
+//!          writeMutex_の待ちもしない。ただしstd::atomic<std::shared_ptr>は
+//!          ロックフリーではなく（MSVC/libstdc++とも内部で短いロックを使う）、
+//!          取得のたびに内部ロック1回と参照カウントの増減が発生する。
+//!          呼び出し中の購読・解除は次の発行から反映される
+//!          （解除された購読者も、開始済みの発行では呼ばれる）。
+//!
+//!          遅延配送では、イベントを連続配列のキューへ溜めておき、Flushで
+//!          購読者ごとにまとめて渡す（バッチ購読者は配列のまま、通常の購読者は
+//!          1件ずつ）。キューは配送用の配列と入れ替えて使い回すため、
+//!          容量が足りていれば確保は発生しない。
 //----------------------------------------------------------------------------
 template<typename TEvent>
 class EventHandler : public IEventHandler
 {
 public:
     using CallbackType = std::function<void(const TEvent&)>;
+    using BatchCallbackType = std::function<void(std::span<const TEvent>)>;
+
+    //! @brief 購読者（購読順に並ぶ。callbackとbatchはどちらか一方のみ）
+    struct Subscriber {
+        uint32_t id;
+        CallbackType callback;
+        BatchCallbackType batch;
+    };
+    using SubscriberList = std::vector<Subscriber>;
 
     void Add(uint32_t id, CallbackType callback) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        callbacks_[id] = std::move(callback);
+        Insert({ id, std::move(callback), {} });
+    }
+
+    void AddBatch(uint32_t id, BatchCallbackType batch) {
+        Insert({ id, {}, std::move(batch) });
     }
 
     void Remove(uint32_t id) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        callbacks_.erase(id);
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        auto current = subscribers_.load(std::memory_order_acquire);
+        if (!current) return;
+        auto it = std::find_if(current->begin(), current->end(),
+                               [id](const Subscriber& subscriber) { return subscriber.id == id; });
+        if (it == current->end()) return;
+
+        std::shared_ptr<const SubscriberList> next;
+        if (current->size() > 1) {
+            auto list = std::make_shared<SubscriberList>();
+            list->reserve(current->size() - 1);
+            list->insert(list->end(), current->begin(), it);
+            list->insert(list->end(), it + 1, current->end());
+            next = std::move(list);
+        }
+        subscribers_.store(std::move(next), std::memory_order_release);
     }
 
-    void Invoke(const TEvent& event) {
-        // コールバック中の変更に備えてコピー（mutex保護下）
-        std::unordered_map<uint32_t, CallbackType> callbacksCopy;
+    void Clear() override {
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            callbacksCopy = callbacks_;
+            std::lock_guard<std::mutex> lock(writeMutex_);
+            subscribers_.store(nullptr, std::memory_order_release);
+        }
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        pending_.clear();
+        mode_.store(EventDispatchMode::Immediate, std::memory_order_relaxed);
+    }
+
+    void SetMode(EventDispatchMode mode) {
+        mode_.store(mode, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] EventDispatchMode GetMode() const {
+        return mode_.load(std::memory_order_relaxed);
+    }
+
+    //! @brief 配送方式に従って発行（遅延ならキューへ積む）
+    void Publish(const TEvent& event) {
+        if (GetMode() == EventDispatchMode::Deferred) {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            pending_.push_back(event);
+            return;
+        }
+        Invoke(event);
+    }
+
+    //! @brief 即座に全購読者を呼ぶ
+    void Invoke(const TEvent& event) {
+        // 呼び出し中に差し替えられても、取得したスナップショットは生存する
+        const auto snapshot = subscribers_.load(std::memory_order_acquire);
+        if (!snapshot) return;
+        for (const Subscriber& subscriber : *snapshot) {
+            if (subscriber.callback) {
+                subscriber.callback(event);
+            } else {
+                subscriber.batch(std::span<const TEvent>(&event, 1));
+            }
+        }
+    }
+
+    //! @brief 複数のイベントを購読者ごとにまとめて渡す
+    void InvokeBatch(std::span<const TEvent> events) {
+        if (events.empty()) return;
+        const auto snapshot = subscribers_.load(std::memory_order_acquire);
+        if (!snapshot) return;
+        for (const Subscriber& subscriber : *snapshot) {
+            if (subscriber.batch) {
+                subscriber.batch(events);
+            } else {
+                for (const TEvent& event : events) {
+                    subscriber.callback(event);
+                }
+            }
         }
-        for (auto& [id, callback] : callbacksCopy) {
-            callback(event);
+    }
+
+    //! @note メインスレッドから呼ぶこと。配送中に積まれたイベントは次のFlushで配送する
+    void Flush() override {
+        if (flushing_) return;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            if (pending_.empty()) return;
+            pending_.swap(dispatching_);
         }
+        flushing_ = true;
+        InvokeBatch(dispatching_);
+        dispatching_.clear();
+        flushing_ = false;
+    }
+
+    //! @brief 未配送のイベント数
+    [[nodiscard]] size_t GetPendingCount() const {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        return pending_.size();
     }
 
     [[nodiscard]] bool IsEmpty() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return callbacks_.empty();
+        const auto snapshot = subscribers_.load(std::memory_order_acquire);
+        return !snapshot || snapshot->empty();
+    }
+
+    //! @brief 購読者数
+    [[nodiscard]] size_t GetSubscriberCount() const {
+        const auto snapshot = subscribers_.load(std::memory_order_acquire);
+        return snapshot ? snapshot->size() : 0;
     }
 
 private:
-    std::unordered_map<uint32_t, CallbackType> callbacks_;
-    mutable std::mutex mutex_;
+    void Insert(Subscriber subscriber) {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        auto current = subscribers_.load(std::memory_order_acquire);
+        auto next = std::make_shared<SubscriberList>();
+        next->reserve((current ? current->size() : 0) + 1);
+        if (current) {
+            for (const Subscriber& existing : *current) {
+                if (existing.id != subscriber.id) next->push_back(existing);
+            }
+        }
+        next->push_back(std::move(subscriber));
+        subscribers_.store(std::move(next), std::memory_order_release);
+    }
+
+    std::atomic<std::shared_ptr<const SubscriberList>> subscribers_;
+    std::mutex writeMutex_;     //!< Add/Remove同士の直列化（Invokeは取らない）
+
+    std::atomic<EventDispatchMode> mode_{ EventDispatchMode::Immediate };
+    std::vector<TEvent> pending_;       //!< 次のFlushで配送するイベント
+    std::vector<TEvent> dispatching_;   //!< Flush中に配送しているイベント
+    mutable std::mutex queueMutex_;     //!< pending_の保護
+    bool flushing_ = false;
+};
+
+//----------------------------------------------------------------------------
+//! @brief イベント型の一覧
+//! @details 一覧内の位置がそのままイベント型ID（0から連続）になる。
+//!          IDはコンパイル時に決まり、ハンドラ配列の添字として使う。
+//----------------------------------------------------------------------------
+template<typename... TEvents>
+struct EventTypeList
+{
+    //! 登録されているイベント型の数
+    static constexpr size_t kCount = sizeof...(TEvents);
+
+    //! 一覧に含まれるか
+    template<typename TEvent>
+    static constexpr bool Contains = (std::is_same_v<TEvent, TEvents> || ...);
+
+    //! イベント型IDを取得
+    template<typename TEvent>
+    static constexpr uint32_t IdOf() noexcept {
+        static_assert(Contains<TEvent>, "イベント型がイベント一覧に登録されていません");
+        static_assert((static_cast<int>(std::is_same_v<TEvent, TEvents>) + ...) == 1,
+                      "イベント型がイベント一覧に重複して登録されています");
+        uint32_t index = 0;
+        uint32_t id = 0;
+        ((std::is_same_v<TEvent, TEvents> ? (id = index++) : index++), ...);
+        return id;
+    }
 };
 
+template<typename TEventList>
+class BasicEventBus;
+
 //----------------------------------------------------------------------------
 //! @brief EventBus - システム間イベント通信
 //! @details 型安全なPublish/Subscribeパターンを提供
+//!          イベント型ごとに即時配送と遅延配送を選べる。遅延配送の型は
+//!          Publishでキューに積まれ、Flush()を呼んだ時点でまとめて配送される。
+//!
+//!          扱うイベント型はEventTypeListで固定し、ハンドラは型IDを添字とする
+//!          配列に構築時に全て用意する。ハンドラの検索は配列の参照だけで済むため、
+//!          購読・解除・発行でバス全体のロックを取らない（同期は型ごとのハンドラ内の
+//!          購読者リスト取得・差し替えとキュー操作のみ）。
+//! @tparam TEvents 扱うイベント型（ゲームではGameEventList）
 //----------------------------------------------------------------------------
-class EventBus
+template<typename... TEvents>
+class BasicEventBus<EventTypeList<TEvents...>>
 {
 public:
+    using EventList = EventTypeList<TEvents...>;
+
+    //! 扱うイベント型の数
+    static constexpr size_t kEventTypeCount = EventList::kCount;
+    static_assert(kEventTypeCount < EventTraceRecordHeader::kOpaqueFlag, "イベント型が多すぎます");
+
     //! @brief シングルトン取得
-    static EventBus& Get() {
-        static EventBus instance;
+    static BasicEventBus& Get() {
+        static BasicEventBus instance;
         return instance;
     }
 
+    //! @brief イベント型IDを取得（0からkEventTypeCount未満）
+    template<typename TEvent>
+    static constexpr uint32_t GetTypeId() noexcept {
+        return EventList::template IdOf<TEvent>();
+    }
+
     //------------------------------------------------------------------------
     // 購読
     //------------------------------------------------------------------------
@@ -85,9 +288,20 @@ public:
     //! @return 購読ID（解除時に使用）
     template<typename TEvent>
     uint32_t Subscribe(std::function<void(const TEvent&)> callback) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        uint32_t id = nextSubscriptionId_++;
-        GetOrCreateHandlerLocked<TEvent>()->Add(id, std::move(callback));
+        uint32_t id = nextSubscriptionId_.fetch_add(1, std::memory_order_relaxed);
+        GetHandler<TEvent>().Add(id, std::move(callback));
+        return id;
+    }
+
+    //! @brief イベントをまとめて購読
+    //! @tparam TEvent イベント型
+    //! @param callback コールバック関数（遅延配送ではFlush時に溜まった分を一度に、
+    //!                 即時配送では1件ずつ受け取る）
+    //! @return 購読ID（解除時に使用）
+    template<typename TEvent>
+    uint32_t SubscribeBatch(std::function<void(std::span<const TEvent>)> callback) {
+        uint32_t id = nextSubscriptionId_.fetch_add(1, std::memory_order_relaxed);
+        GetHandler<TEvent>().AddBatch(id, std::move(callback));
         return id;
     }
 
@@ -96,11 +310,7 @@ public:
     //! @param subscriptionId 購読ID
     template<typename TEvent>
     void Unsubscribe(uint32_t subscriptionId) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto* handler = GetHandlerLocked<TEvent>();
-        if (handler) {
-            handler->Remove(subscriptionId);
-        }
+        GetHandler<TEvent>().Remove(subscriptionId);
     }
 
     //------------------------------------------------------------------------
@@ -112,14 +322,10 @@ public:
     //! @param event イベントデータ
     template<typename TEvent>
     void Publish(const TEvent& event) {
-        EventHandler<TEvent>* handler = nullptr;
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            handler = GetHandlerLocked<TEvent>();
-        }
-        if (handler) {
-            handler->Invoke(event);
+        if (EventTraceRecorder* recorder = recorder_.load(std::memory_order_acquire)) {
+            recorder->Record(GetTypeId<TEvent>(), event);
         }
+        GetHandler<TEvent>().Publish(event);
     }
 
     //! @brief イベントを発行（引数から構築）
@@ -131,48 +337,137 @@ public:
         Publish(event);
     }
 
+    //------------------------------------------------------------------------
+    // 遅延配送
+    //------------------------------------------------------------------------
+
+    //! @brief イベント型の配送方式を設定
+    //! @tparam TEvent イベント型
+    //! @note 即時配送に戻しても、溜まっているイベントは次のFlushで配送される
+    template<typename TEvent>
+    void SetDispatchMode(EventDispatchMode mode) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        IEventHandler* handler = handlers_[GetTypeId<TEvent>()].get();
+        if (mode == EventDispatchMode::Deferred &&
+            std::find(deferredHandlers_.begin(), deferredHandlers_.end(), handler) == deferredHandlers_.end()) {
+            deferredHandlers_.push_back(handler);
+        }
+        GetHandler<TEvent>().SetMode(mode);
+    }
+
+    //! @brief 指定型の溜まったイベントを配送
+    template<typename TEvent>
+    void Flush() {
+        GetHandler<TEvent>().Flush();
+    }
+
+    //! @brief 全ての溜まったイベントを配送
+    //! @details 遅延配送を設定した順に型ごとに配送する。
+    //!          配送中に後の型へ積まれたイベントは同じFlushで、
+    //!          配送中の型や前の型へ積まれたイベントは次のFlushで配送される。
+    //! @note メインスレッドから呼ぶこと。購読者の中から呼んだ場合は何もしない
+    void Flush() {
+        if (flushing_) return;
+        flushing_ = true;
+        for (size_t i = 0;; ++i) {
+            IEventHandler* handler = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (i >= deferredHandlers_.size()) break;
+                handler = deferredHandlers_[i];
+            }
+            handler->Flush();
+        }
+        flushing_ = false;
+    }
+
+    //------------------------------------------------------------------------
+    // 記録・再生
+    //------------------------------------------------------------------------
+
+    //! @brief 発行を記録する記録器を設定（nullptrで解除）
+    //! @details 全ての型の発行を記録する（記録方法は型ごとにEventTraceRecorder::Recordが選ぶ）
+    //! @note 記録器はバスから外すまで生存していること
+    void SetRecorder(EventTraceRecorder* recorder) {
+        recorder_.store(recorder, std::memory_order_release);
+    }
+
+    //! @brief 記録したイベントを購読者へ配送（ReplayEventTraceから使用）
+    //! @details 配送方式に関わらずその場で購読者を呼び、記録器には記録しない
+    //! @param entities EventTraceCodecで記録した型のIDをポインタへ戻す表
+    //! @return 型IDが範囲外か、再生できない型か、中身のサイズが一致しないか、
+    //!         IDをポインタへ戻せない場合false
+    bool DispatchRecorded(uint32_t typeId, std::span<const std::byte> payload,
+                          const IEventEntityMap* entities = nullptr) {
+        if (typeId >= kEventTypeCount) return false;
+        return kReplayTable[typeId](*this, payload, entities);
+    }
+
     //------------------------------------------------------------------------
     // 管理
     //------------------------------------------------------------------------
 
-    //! @brief 全購読をクリア
+    //! @brief 全購読と未配送のイベントをクリアし、全型を即時配送に戻す
+    //! @note ハンドラ自体は破棄しない（発行中のハンドラを解放しないため）
     void Clear() {
         std::lock_guard<std::mutex> lock(mutex_);
-        handlers_.clear();
+        for (auto& handler : handlers_) {
+            handler->Clear();
+        }
+        deferredHandlers_.clear();
     }
 
 private:
-    EventBus() = default;
-    ~EventBus() = default;
-    EventBus(const EventBus&) = delete;
-    EventBus& operator=(const EventBus&) = delete;
+    BasicEventBus() = default;
+    ~BasicEventBus() = default;
+    BasicEventBus(const BasicEventBus&) = delete;
+    BasicEventBus& operator=(const BasicEventBus&) = delete;
 
-    //! @note mutex_を保持した状態で呼び出すこと
+    using ReplayFunction = bool (*)(BasicEventBus&, std::span<const std::byte>, const IEventEntityMap*);
+
+    //! @brief バイト列から型を復元して購読者を呼ぶ
     template<typename TEvent>
-    EventHandler<TEvent>* GetHandlerLocked() {
-        std::type_index typeIndex(typeid(TEvent));
-        auto it = handlers_.find(typeIndex);
-        if (it == handlers_.end()) {
-            return nullptr;
+    static bool ReplayAs(BasicEventBus& bus, std::span<const std::byte> payload, const IEventEntityMap* entities) {
+        if constexpr (kEventTraceable<TEvent>) {
+            if (payload.size() != sizeof(TEvent)) return false;
+            TEvent event{};
+            std::memcpy(&event, payload.data(), sizeof(TEvent));
+            bus.GetHandler<TEvent>().Invoke(event);
+            return true;
+        } else if constexpr (EventTraceEncodable<TEvent>) {
+            using Encoded = typename EventTraceCodec<TEvent>::Record;
+            if (!entities || payload.size() != sizeof(Encoded)) return false;
+            Encoded encoded{};
+            std::memcpy(&encoded, payload.data(), sizeof(Encoded));
+            TEvent event{};
+            if (!EventTraceCodec<TEvent>::Decode(encoded, *entities, event)) return false;
+            bus.GetHandler<TEvent>().Invoke(event);
+            return true;
+        } else {
+            // 中身を記録しない型（手で作られたログでも配送しない）
+            (void)bus;
+            (void)payload;
+            (void)entities;
+            return false;
         }
-        return static_cast<EventHandler<TEvent>*>(it->second.get());
     }
 
-    //! @note mutex_を保持した状態で呼び出すこと
+    //! 型IDを添字とする再生関数表
+    static constexpr std::array<ReplayFunction, kEventTypeCount> kReplayTable{ &ReplayAs<TEvents>... };
+
+    //! @brief 型IDの位置にあるハンドラ（構築時に作成済み）
     template<typename TEvent>
-    EventHandler<TEvent>* GetOrCreateHandlerLocked() {
-        std::type_index typeIndex(typeid(TEvent));
-        auto it = handlers_.find(typeIndex);
-        if (it == handlers_.end()) {
-            auto handler = std::make_unique<EventHandler<TEvent>>();
-            auto* ptr = handler.get();
-            handlers_[typeIndex] = std::move(handler);
-            return ptr;
-        }
-        return static_cast<EventHandler<TEvent>*>(it->second.get());
+    EventHandler<TEvent>& GetHandler() {
+        return static_cast<EventHandler<TEvent>&>(*handlers_[GetTypeId<TEvent>()]);
     }
 
-    std::unordered_map<std::type_index, std::unique_ptr<IEventHandler>> handlers_;
-    mutable std::mutex mutex_;
-    uint32_t nextSubscriptionId_ = 1;
+    //! 型IDを添字とするハンドラ配列（構築後は変更しない）
+    std::array<std::unique_ptr<IEventHandler>, kEventTypeCount> handlers_{
+        std::make_unique<EventHandler<TEvents>>()...
+    };
+    std::vector<IEventHandler*> deferredHandlers_;  //!< Flush()の配送順
+    bool flushing_ = false;                         //!< Flush()の再入防止
+    std::mutex mutex_;                              //!< deferredHandlers_の保護
+    std::atomic<uint32_t> nextSubscriptionId_{ 1 };
+    std::atomic<EventTraceRecorder*> recorder_{ nullptr };
 };
@@ -0,0 +1,394 @@
+//----------------------------------------------------------------------------
+//! @file   event_trace.h
+//! @brief  EventBusの発行記録と再生
+//!
+//! @details 発行されたイベントをフレーム番号・イベント型ID・中身のバイト列として
+//!          事前確保したバッファへ書き込み、後からバイナリログとして保存・再生する。
+//!          記録中の確保は行わないため、製品ビルドのキャプチャでも有効にしておける。
+//!
+//!          イベント型ごとの記録方法:
+//!          - kEventTraceableをtrueに特殊化した型: 中身をそのままコピーする
+//!          - EventTraceCodecを特殊化した型: ポインタをIEventEntityMapで安定したIDに
+//!            置き換えた形式で記録し、再生時にIDからポインタへ戻す
+//!          - それ以外: 中身を持たないレコード（フレーム・型ID・サイズのみ）を残す。
+//!            再生はできないが、どのフレームで何件発行されたかはログから分かる
+//!
+//!          ログ形式（リトルエンディアン、パディングなし）:
+//!          - EventTraceFileHeader
+//!          - EventTraceRecordHeader + 中身（size バイト、中身なしのレコードは0バイト）の繰り返し
+//----------------------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+//----------------------------------------------------------------------------
+//! @brief 記録・再生できるイベント型か（既定はfalse）
+//! @details ポインタ・参照・ハンドル等を含まないトリビアルな型だけを、
+//!          イベント定義の近くでtrueに特殊化する。
+//!          falseの型はEventBus::Publishで記録されず、ログに含まれていても再生しない。
+//! @code
+//!   template<> inline constexpr bool kEventTraceable<GameOverEvent> = true;
+//! @endcode
+//----------------------------------------------------------------------------
+template<typename TEvent>
+inline constexpr bool kEventTraceable = false;
+
+//----------------------------------------------------------------------------
+//! @brief エンティティのポインタと、ログに書く安定したIDの相互変換
+//! @details IDの割り当て方はゲーム側で決める（ステージ内の並び順など、
+//!          同じステージを読み込めば別プロセスでも同じIDになるもの）。
+//!          記録中は複数スレッドから参照されるため、記録中に変更しないこと。
+//----------------------------------------------------------------------------
+class IEventEntityMap
+{
+public:
+    //! nullptrを表すID
+    static constexpr uint32_t kNullId = 0;
+
+    virtual ~IEventEntityMap() = default;
+
+    //! @brief ポインタをIDへ（nullptrはkNullId）
+    //! @return 登録されていないポインタならfalse
+    virtual bool ToId(const void* entity, uint32_t& id) const = 0;
+
+    //! @brief IDをポインタへ（kNullIdはnullptr）
+    //! @return 該当するエンティティがなければfalse
+    virtual bool FromId(uint32_t id, void*& entity) const = 0;
+};
+
+//----------------------------------------------------------------------------
+//! @brief ポインタを含むイベントの記録形式（既定は未定義）
+//! @details 特殊化では以下を定義する（Recordはトリビアルにコピー可能な型）。
+//! @code
+//!   template<>
+//!   struct EventTraceCodec<GroupDefeatedEvent>
+//!   {
+//!       struct Record { uint32_t group; };
+//!       static bool Encode(const GroupDefeatedEvent& event, const IEventEntityMap& map, Record& out);
+//!       static bool Decode(const Record& record, const IEventEntityMap& map, GroupDefeatedEvent& out);
+//!   };
+//! @endcode
+//!          Encode/DecodeはIDに変換できないエンティティがあればfalseを返す
+//!          （記録では中身なしのレコードに、再生ではrejectedになる）。
+//----------------------------------------------------------------------------
+template<typename TEvent>
+struct EventTraceCodec;
+
+//! @brief EventTraceCodecを特殊化したイベント型か
+template<typename TEvent>
+concept EventTraceEncodable = requires { typename EventTraceCodec<TEvent>::Record; };
+
+//----------------------------------------------------------------------------
+//! @brief ログ先頭のヘッダー
+//----------------------------------------------------------------------------
+struct EventTraceFileHeader
+{
+    static constexpr char kMagic[4] = { 'E', 'V', 'T', 'R' };
+    static constexpr uint16_t kVersion = 2;
+
+    char magic[4];
+    uint16_t version;
+    uint16_t typeCount;  //!< 記録したバスのイベント型数
+};
+static_assert(sizeof(EventTraceFileHeader) == 8);
+
+//----------------------------------------------------------------------------
+//! @brief 1イベント分のヘッダー（直後に中身が続く）
+//----------------------------------------------------------------------------
+struct EventTraceRecordHeader
+{
+    //! typeIdに立てる、中身を記録していないレコードの印（sizeは元のイベントのサイズ）
+    static constexpr uint16_t kOpaqueFlag = 0x8000;
+
+    uint32_t frame;   //!< 発行時のフレーム番号
+    uint16_t typeId;  //!< イベント型ID（中身なしのレコードはkOpaqueFlag付き）
+    uint16_t size;    //!< 中身のバイト数（中身なしのレコードは元のイベントのサイズ）
+};
+static_assert(sizeof(EventTraceRecordHeader) == 8);
+
+//----------------------------------------------------------------------------
+//! @brief 読み出した1イベント
+//----------------------------------------------------------------------------
+struct EventTraceRecord
+{
+    uint32_t frame;
+    uint16_t typeId;
+    bool opaque;                          //!< 中身を記録していないレコードか
+    uint16_t eventSize;                   //!< 元のイベントのサイズ（中身なしのレコードのみ）
+    std::span<const std::byte> payload;   //!< 中身（中身なしのレコードでは空）
+};
+
+//----------------------------------------------------------------------------
+//! @brief イベント発行の記録
+//! @details Start()でバッファを確保し、以降のRecord()はバッファへの書き込みだけを行う。
+//!          書き込み位置は原子的に確保するので、複数スレッドから記録してよい。
+//!          容量を超えたイベントは捨てて数だけ数える。
+//!          EventTraceCodecを持つ型はSetEntityMap()した表でIDに変換して記録する
+//!          （表がない・変換できない場合は中身なしのレコードになる）。
+//!
+//! @code
+//!   recorder.SetEntityMap(&entityMap);
+//!   recorder.Start(4 * 1024 * 1024, EventBus::kEventTypeCount);
+//!   EventBus::Get().SetRecorder(&recorder);
+//!   // 毎フレーム recorder.BeginFrame();
+//!   EventBus::Get().SetRecorder(nullptr);
+//!   recorder.Stop();
+//!   SaveFile(recorder.GetData());
+//! @endcode
+//----------------------------------------------------------------------------
+class EventTraceRecorder
+{
+public:
+    //! @brief 記録を開始（前回の記録は破棄）
+    //! @param capacityBytes ログ全体の最大バイト数（ヘッダー込み）
+    //! @param typeCount 記録するバスのイベント型数
+    void Start(size_t capacityBytes, uint32_t typeCount) {
+        capacityBytes = (std::max)(capacityBytes, sizeof(EventTraceFileHeader));
+        if (buffer_.size() < capacityBytes) {
+            buffer_.resize(capacityBytes);
+        }
+        capacity_ = capacityBytes;
+
+        EventTraceFileHeader header{};
+        std::memcpy(header.magic, EventTraceFileHeader::kMagic, sizeof(header.magic));
+        header.version = EventTraceFileHeader::kVersion;
+        header.typeCount = static_cast<uint16_t>(typeCount);
+        std::memcpy(buffer_.data(), &header, sizeof(header));
+
+        used_.store(sizeof(header), std::memory_order_relaxed);
+        validSize_.store(capacity_, std::memory_order_relaxed);
+        frame_.store(0, std::memory_order_relaxed);
+        recordCount_.store(0, std::memory_order_relaxed);
+        droppedCount_.store(0, std::memory_order_relaxed);
+        opaqueCount_.store(0, std::memory_order_relaxed);
+        recording_.store(true, std::memory_order_release);
+    }
+
+    //! @brief 記録を停止（記録済みのデータは保持）
+    void Stop() {
+        recording_.store(false, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool IsRecording() const {
+        return recording_.load(std::memory_order_acquire);
+    }
+
+    //! @brief ポインタをIDへ変換する表を設定（nullptrで解除）
+    //! @note 記録中は変更しないこと。表は記録を止めるまで生存していること
+    void SetEntityMap(const IEventEntityMap* entities) {
+        entities_ = entities;
+    }
+
+    //! @brief フレームを進める（毎フレームの先頭で呼ぶ）
+    void BeginFrame() {
+        frame_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //! @brief イベントを記録
+    //! @details 型に応じて中身のコピー・IDへの変換・中身なしのいずれかで記録する
+    //! @param typeId イベント型ID
+    template<typename TEvent>
+    void Record(uint32_t typeId, const TEvent& event) {
+        static_assert(sizeof(TEvent) <= (std::numeric_limits<uint16_t>::max)(), "イベントが大きすぎます");
+
+        if (!IsRecording()) return;
+
+        if constexpr (kEventTraceable<TEvent>) {
+            static_assert(std::is_trivially_copyable_v<TEvent>, "記録するイベントはトリビアルにコピー可能である必要があります");
+            Write(typeId, &event, sizeof(TEvent));
+        } else if constexpr (EventTraceEncodable<TEvent>) {
+            using Encoded = typename EventTraceCodec<TEvent>::Record;
+            static_assert(std::is_trivially_copyable_v<Encoded>, "記録形式はトリビアルにコピー可能である必要があります");
+            static_assert(sizeof(Encoded) <= (std::numeric_limits<uint16_t>::max)(), "記録形式が大きすぎます");
+
+            Encoded encoded{};
+            if (entities_ && EventTraceCodec<TEvent>::Encode(event, *entities_, encoded)) {
+                Write(typeId, &encoded, sizeof(Encoded));
+            } else {
+                WriteOpaque(typeId, sizeof(TEvent));
+            }
+        } else {
+            WriteOpaque(typeId, sizeof(TEvent));
+        }
+    }
+
+    //! @brief 記録したログ（Stop()後に参照すること）
+    [[nodiscard]] std::span<const std::byte> GetData() const {
+        if (capacity_ == 0) return {};
+        const size_t used = (std::min)(used_.load(std::memory_order_acquire),
+                                       validSize_.load(std::memory_order_acquire));
+        return std::span<const std::byte>(buffer_.data(), used);
+    }
+
+    [[nodiscard]] uint32_t GetFrame() const { return frame_.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint32_t GetRecordCount() const { return recordCount_.load(std::memory_order_relaxed); }
+    //! @brief 記録したうち、中身なしのレコード数
+    [[nodiscard]] uint32_t GetOpaqueCount() const { return opaqueCount_.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint32_t GetDroppedCount() const { return droppedCount_.load(std::memory_order_relaxed); }
+    [[nodiscard]] size_t GetCapacity() const { return capacity_; }
+
+private:
+    //! @brief 中身を持たないレコードを書く
+    void WriteOpaque(uint32_t typeId, size_t eventSize) {
+        if (Write(typeId | EventTraceRecordHeader::kOpaqueFlag, nullptr, eventSize)) {
+            opaqueCount_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    //! @brief ヘッダーと中身を書く（payloadがnullptrなら中身は書かずsizeだけ残す）
+    //! @return 容量内に書けた場合true
+    bool Write(uint32_t typeId, const void* payload, size_t size) {
+        const size_t recordSize = sizeof(EventTraceRecordHeader) + (payload ? size : 0);
+        const size_t offset = used_.fetch_add(recordSize, std::memory_order_relaxed);
+        if (offset + recordSize > capacity_) {
+            // 以降の書き込みは全て溢れるので、最初に溢れた位置で打ち切る
+            size_t valid = validSize_.load(std::memory_order_relaxed);
+            while (offset < valid &&
+                   !validSize_.compare_exchange_weak(valid, offset, std::memory_order_relaxed)) {
+            }
+            droppedCount_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        const EventTraceRecordHeader header{
+            frame_.load(std::memory_order_relaxed),
+            static_cast<uint16_t>(typeId),
+            static_cast<uint16_t>(size)
+        };
+        std::byte* dst = buffer_.data() + offset;
+        std::memcpy(dst, &header, sizeof(header));
+        if (payload) {
+            std::memcpy(dst + sizeof(header), payload, size);
+        }
+        recordCount_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    std::vector<std::byte> buffer_;
+    size_t capacity_ = 0;
+    const IEventEntityMap* entities_ = nullptr;
+    std::atomic<size_t> used_{ 0 };          //!< 確保済みの書き込み位置
+    std::atomic<size_t> validSize_{ 0 };     //!< 最初に溢れた位置（溢れていなければ容量）
+    std::atomic<uint32_t> frame_{ 0 };
+    std::atomic<uint32_t> recordCount_{ 0 };
+    std::atomic<uint32_t> droppedCount_{ 0 };
+    std::atomic<uint32_t> opaqueCount_{ 0 };
+    std::atomic<bool> recording_{ false };
+};
+
+//----------------------------------------------------------------------------
+//! @brief ログの読み出し
+//----------------------------------------------------------------------------
+class EventTraceReader
+{
+public:
+    explicit EventTraceReader(std::span<const std::byte> data)
+        : data_(data)
+    {
+        if (data_.size() < sizeof(EventTraceFileHeader)) return;
+        std::memcpy(&header_, data_.data(), sizeof(header_));
+        valid_ = std::memcmp(header_.magic, EventTraceFileHeader::kMagic, sizeof(header_.magic)) == 0 &&
+                 header_.version == EventTraceFileHeader::kVersion;
+        offset_ = sizeof(EventTraceFileHeader);
+    }
+
+    //! @brief ヘッダーが正しいか
+    [[nodiscard]] bool IsValid() const { return valid_; }
+
+    //! @brief 記録したバスのイベント型数
+    [[nodiscard]] uint32_t GetTypeCount() const { return header_.typeCount; }
+
+    //! @brief 次のイベントを読む
+    //! @return 末尾または途中で切れている場合false
+    bool Next(EventTraceRecord& record) {
+        if (!valid_ || data_.size() - offset_ < sizeof(EventTraceRecordHeader)) return false;
+
+        EventTraceRecordHeader header;
+        std::memcpy(&header, data_.data() + offset_, sizeof(header));
+        const bool opaque = (header.typeId & EventTraceRecordHeader::kOpaqueFlag) != 0;
+        const size_t payloadSize = opaque ? 0 : header.size;
+        const size_t payloadOffset = offset_ + sizeof(header);
+        if (data_.size() - payloadOffset < payloadSize) return false;
+
+        record.frame = header.frame;
+        record.typeId = static_cast<uint16_t>(header.typeId & ~EventTraceRecordHeader::kOpaqueFlag);
+        record.opaque = opaque;
+        record.eventSize = opaque ? header.size : 0;
+        record.payload = data_.subspan(payloadOffset, payloadSize);
+        offset_ = payloadOffset + payloadSize;
+        return true;
+    }
+
+private:
+    std::span<const std::byte> data_;
+    EventTraceFileHeader header_{};
+    size_t offset_ = 0;
+    bool valid_ = false;
+};
+
+//----------------------------------------------------------------------------
+//! @brief 再生結果
+//----------------------------------------------------------------------------
+struct EventReplayResult
+{
+    bool valid = false;         //!< ログのヘッダーがバスと一致したか
+    uint32_t dispatched = 0;    //!< 購読者へ配送したイベント数
+    uint32_t skipped = 0;       //!< 中身を記録していないため配送しなかったイベント数
+    uint32_t rejected = 0;      //!< 型ID・サイズが一致しない、またはIDをポインタへ戻せず捨てたイベント数
+    uint32_t frames = 0;        //!< 含まれていたフレーム数
+};
+
+//----------------------------------------------------------------------------
+//! @brief ログを購読者へ再生（描画・ゲーム更新なし）
+//! @details 記録順に、配送方式に関わらずその場で購読者を呼ぶ。
+//!          バスに記録器が設定されていても再生したイベントは記録しない。
+//!          中身なしのレコードは配送せずskippedに数える。
+//!          EventTraceCodecで記録した型は、entitiesでIDをポインタへ戻して配送する
+//!          （entitiesがない・戻せない場合はrejected）。
+//! @param bus 再生先のバス（記録時と同じイベント一覧であること）
+//! @param data ログ
+//! @param onFrameEnd フレームの区切りごとに呼ぶ（フレーム番号を渡す、省略可）
+//! @param entities IDをポインタへ戻す表（記録時と同じIDを割り当てたもの、省略可）
+//----------------------------------------------------------------------------
+template<typename TBus>
+EventReplayResult ReplayEventTrace(TBus& bus, std::span<const std::byte> data,
+                                   const std::function<void(uint32_t)>& onFrameEnd = {},
+                                   const IEventEntityMap* entities = nullptr)
+{
+    EventReplayResult result;
+    EventTraceReader reader(data);
+    if (!reader.IsValid() || reader.GetTypeCount() != TBus::kEventTypeCount) {
+        return result;
+    }
+    result.valid = true;
+
+    EventTraceRecord record{};
+    bool hasFrame = false;
+    uint32_t frame = 0;
+    while (reader.Next(record)) {
+        if (!hasFrame || record.frame != frame) {
+            if (hasFrame && onFrameEnd) onFrameEnd(frame);
+            frame = record.frame;
+            hasFrame = true;
+            ++result.frames;
+        }
+        if (record.opaque) {
+            ++result.skipped;
+        } else if (bus.DispatchRecorded(record.typeId, record.payload, entities)) {
+            ++result.dispatched;
+        } else {
+            ++result.rejected;
+        }
+    }
+    if (hasFrame && onFrameEnd) onFrameEnd(frame);
+    return result;
+}
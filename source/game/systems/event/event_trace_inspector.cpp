@@ -0,0 +1,114 @@
+//----------------------------------------------------------------------------
+//! @file   event_trace_inspector.cpp
+//! @brief  イベントトレースの集計表示
+//----------------------------------------------------------------------------
+#include "event_trace_inspector.h"
+#include "game/systems/event/game_events.h"
+#include "engine/fs/file_system_manager.h"
+#include "engine/fs/host_file_system.h"
+#include "common/logging/logging.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+//! 発行数を表示するフレーム数（多い順）
+constexpr size_t kBusiestFrameCount = 5;
+
+//! イベント型ごとの集計
+struct TypeStats
+{
+    uint64_t records = 0;
+    uint64_t opaque = 0;  //!< 中身なしのレコード数
+};
+
+//! 型IDを添字とするイベント型名
+template<typename... TEvents>
+std::vector<std::string> GetEventTypeNames(EventTypeList<TEvents...>)
+{
+    return { typeid(TEvents).name()... };
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
+int RunEventTraceInspector(const std::string& pathArg)
+{
+    const std::string path = pathArg.empty() ? "event_trace.bin" : pathArg;
+
+    auto& fsManager = FileSystemManager::Get();
+    if (!fsManager.IsMounted("captures")) {
+        std::wstring capturesRoot = FileSystemManager::GetProjectRoot() + L"captures/";
+        fsManager.Mount("captures", std::make_unique<HostFileSystem>(capturesRoot));
+    }
+
+    FileReadResult file = fsManager.ReadFile("captures:/" + path);
+    if (!file.success) {
+        LOG_ERROR("[EventTrace] Failed to read captures:/" + path);
+        return 1;
+    }
+
+    EventTraceReader reader(file.bytes);
+    if (!reader.IsValid() || reader.GetTypeCount() != EventBus::kEventTypeCount) {
+        LOG_ERROR("[EventTrace] captures:/" + path + " is not an event trace for this build");
+        return 1;
+    }
+
+    // 型ごと・フレームごとに数える
+    std::vector<TypeStats> types(EventBus::kEventTypeCount);
+    std::vector<std::pair<uint32_t, uint64_t>> frames;  // (フレーム番号, 発行数)、記録順
+    uint64_t total = 0;
+    uint64_t opaque = 0;
+    uint64_t unknown = 0;
+
+    EventTraceRecord record{};
+    while (reader.Next(record)) {
+        ++total;
+        if (frames.empty() || frames.back().first != record.frame) {
+            frames.emplace_back(record.frame, 0);
+        }
+        ++frames.back().second;
+
+        if (record.typeId >= types.size()) {
+            ++unknown;
+            continue;
+        }
+        ++types[record.typeId].records;
+        if (record.opaque) {
+            ++types[record.typeId].opaque;
+            ++opaque;
+        }
+    }
+
+    LOG_INFO("[EventTrace] captures:/" + path + ": " + std::to_string(total) + " events (" +
+             std::to_string(opaque) + " without payload), " + std::to_string(frames.size()) + " frames");
+    if (unknown > 0) {
+        LOG_WARN("[EventTrace]   " + std::to_string(unknown) + " records with unknown type ID");
+    }
+
+    const std::vector<std::string> names = GetEventTypeNames(GameEventList{});
+    for (size_t typeId = 0; typeId < types.size(); ++typeId) {
+        const TypeStats& stats = types[typeId];
+        if (stats.records == 0) continue;
+        std::string line = "[EventTrace]   " + names[typeId] + ": " + std::to_string(stats.records);
+        if (stats.opaque > 0) {
+            line += " (" + std::to_string(stats.opaque) + " without payload)";
+        }
+        LOG_INFO(line);
+    }
+
+    // 発行の多いフレーム（イベントの連鎖が起きた箇所の目安）
+    const size_t busiestCount = (std::min)(kBusiestFrameCount, frames.size());
+    std::partial_sort(frames.begin(), frames.begin() + busiestCount, frames.end(),
+                      [](const auto& a, const auto& b) { return a.second > b.second; });
+    for (size_t i = 0; i < busiestCount; ++i) {
+        LOG_INFO("[EventTrace]   frame " + std::to_string(frames[i].first) + ": " +
+                 std::to_string(frames[i].second) + " events");
+    }
+    return 0;
+}
@@ -0,0 +1,22 @@
+//----------------------------------------------------------------------------
+//! @file   event_trace_inspector.h
+//! @brief  イベントトレースの集計表示
+//----------------------------------------------------------------------------
+#pragma once
+
+#include <string>
+
+//----------------------------------------------------------------------------
+//! @brief 保存したイベントトレースをウィンドウ・デバイスなしで集計してログへ出す
+//! @details captures:/（プロジェクトルートのcaptures/）からログを読み、
+//!          イベント型ごとの件数（うち中身なし）と、発行の多いフレームを出力する。
+//!          起動引数 --inspect-events [path] から使用。
+//!
+//!          レコードを読むだけで購読者・ゲームの各システムは動かさないため、
+//!          配送にかかる時間は測れない。購読者を動かして再生する場合は、
+//!          同じステージを読み込んだ状態でGameEventEntityMapを作り、
+//!          ReplayEventTrace(EventBus::Get(), data, onFrameEnd, &entityMap)を呼ぶ。
+//! @param path captures:/からの相対パス（空ならevent_trace.bin）
+//! @return 集計できた場合0、読めない・このビルドのイベント一覧と形式が違う場合1
+//----------------------------------------------------------------------------
+int RunEventTraceInspector(const std::string& path);
@@ -0,0 +1,127 @@
+//----------------------------------------------------------------------------
+//! @file   game_event_entities.cpp
+//! @brief  イベントトレース用のエンティティID実装
+//----------------------------------------------------------------------------
+#include "game_event_entities.h"
+#include "game/entities/player.h"
+#include "game/entities/group.h"
+#include "game/entities/individual.h"
+#include <algorithm>
+#include <variant>
+
+namespace
+{
+
+constexpr uint32_t kMaxGroups = 1u << 12;           //!< Individualの番号に入るグループ数
+constexpr uint32_t kMaxGroupIndividuals = 1u << 12; //!< Individualの番号に入るグループ内の個体数
+
+} // namespace
+
+//----------------------------------------------------------------------------
+void GameEventEntityMap::Build(Player* player, const std::vector<std::unique_ptr<Group>>& groups)
+{
+    Clear();
+
+    player_ = player;
+    if (player_) {
+        ids_[player_] = MakeId(EventEntityKind::Player, 0);
+    }
+
+    groups_.reserve(groups.size());
+    for (const std::unique_ptr<Group>& group : groups) {
+        const uint32_t groupIndex = static_cast<uint32_t>(groups_.size());
+        groups_.push_back(group.get());
+        ids_[group.get()] = MakeId(EventEntityKind::Group, groupIndex);
+
+        // 番号に収まらない個体はIDを持たない（その個体を含むイベントは中身なしで記録される）
+        if (groupIndex >= kMaxGroups) continue;
+        const auto& individuals = group->GetIndividuals();
+        const size_t count = (std::min)(individuals.size(), static_cast<size_t>(kMaxGroupIndividuals));
+        for (size_t i = 0; i < count; ++i) {
+            ids_[individuals[i].get()] =
+                MakeId(EventEntityKind::Individual, (groupIndex << 12) | static_cast<uint32_t>(i));
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+void GameEventEntityMap::Clear()
+{
+    player_ = nullptr;
+    groups_.clear();
+    ids_.clear();
+}
+
+//----------------------------------------------------------------------------
+bool GameEventEntityMap::ToId(const void* entity, uint32_t& id) const
+{
+    if (!entity) {
+        id = kNullId;
+        return true;
+    }
+    auto it = ids_.find(entity);
+    if (it == ids_.end()) return false;
+    id = it->second;
+    return true;
+}
+
+//----------------------------------------------------------------------------
+bool GameEventEntityMap::FromId(uint32_t id, void*& entity) const
+{
+    const uint32_t index = id & 0x00FFFFFFu;
+    switch (GetKind(id)) {
+    case EventEntityKind::None:
+        entity = nullptr;
+        return index == 0;
+
+    case EventEntityKind::Player:
+        entity = player_;
+        return index == 0 && player_ != nullptr;
+
+    case EventEntityKind::Group:
+        if (index >= groups_.size()) return false;
+        entity = groups_[index];
+        return true;
+
+    case EventEntityKind::Individual: {
+        const uint32_t groupIndex = index >> 12;
+        const uint32_t individualIndex = index & (kMaxGroupIndividuals - 1);
+        if (groupIndex >= groups_.size()) return false;
+        const auto& individuals = groups_[groupIndex]->GetIndividuals();
+        if (individualIndex >= individuals.size()) return false;
+        entity = individuals[individualIndex].get();
+        return true;
+    }
+    }
+    return false;
+}
+
+//----------------------------------------------------------------------------
+bool EncodeEventEntity(const IEventEntityMap& map, const BondableEntity& entity, uint32_t& id)
+{
+    return std::visit([&](auto* ptr) { return EncodeEventEntity(map, ptr, id); }, entity);
+}
+
+//----------------------------------------------------------------------------
+bool DecodeEventEntity(const IEventEntityMap& map, uint32_t id, BondableEntity& entity)
+{
+    switch (GameEventEntityMap::GetKind(id)) {
+    case EventEntityKind::None:
+        entity = static_cast<Player*>(nullptr);
+        return id == IEventEntityMap::kNullId;
+    case EventEntityKind::Player: {
+        Player* player = nullptr;
+        if (!DecodeEventEntity(map, id, player)) return false;
+        entity = player;
+        return true;
+    }
+    case EventEntityKind::Group: {
+        Group* group = nullptr;
+        if (!DecodeEventEntity(map, id, group)) return false;
+        entity = group;
+        return true;
+    }
+    default:
+        return false;
+    }
+}
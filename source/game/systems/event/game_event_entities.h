@@ -0,0 +1,108 @@
+//----------------------------------------------------------------------------
+//! @file   game_event_entities.h
+//! @brief  イベントトレース用のエンティティID
+//!
+//! @details ポインタを含むゲームイベントをログへ書くため、Player/Group/Individualに
+//!          ステージ上の並び順から決まるIDを割り当てる。同じステージを読み込めば
+//!          別プロセスでも同じIDになるので、記録したログを別の実行へ再生できる。
+//----------------------------------------------------------------------------
+#pragma once
+
+#include "game/bond/bondable_entity.h"
+#include "game/systems/event/event_trace.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// 前方宣言
+class Player;
+class Group;
+class Individual;
+
+//----------------------------------------------------------------------------
+//! @brief エンティティIDの種別（IDの上位8ビット）
+//----------------------------------------------------------------------------
+enum class EventEntityKind : uint8_t
+{
+    None = 0,    //!< nullptr（IEventEntityMap::kNullId）
+    Player,
+    Group,
+    Individual,
+};
+
+//! @brief ポインタ型に対応する種別（対応しない型はNone）
+template<typename T>
+inline constexpr EventEntityKind kEventEntityKind = EventEntityKind::None;
+template<> inline constexpr EventEntityKind kEventEntityKind<Player> = EventEntityKind::Player;
+template<> inline constexpr EventEntityKind kEventEntityKind<Group> = EventEntityKind::Group;
+template<> inline constexpr EventEntityKind kEventEntityKind<Individual> = EventEntityKind::Individual;
+
+//----------------------------------------------------------------------------
+//! @brief ステージ上のエンティティとIDの対応表
+//! @details IDは種別（上位8ビット）と番号（下位24ビット）から作る。
+//!          - Player: 番号0
+//!          - Group: 敵グループの並び順
+//!          - Individual: グループ番号（上位12ビット）とグループ内の並び順（下位12ビット）
+//!          個体は死亡してもグループから取り除かれないため、並び順はステージ中変わらない。
+//!          Build()で表を作った後は読み取りだけなので、記録中に複数スレッドから参照してよい。
+//----------------------------------------------------------------------------
+class GameEventEntityMap : public IEventEntityMap
+{
+public:
+    //! @brief ステージのエンティティからIDを作り直す（記録・再生の開始前に呼ぶ）
+    void Build(Player* player, const std::vector<std::unique_ptr<Group>>& groups);
+
+    //! @brief 表を空にする
+    void Clear();
+
+    bool ToId(const void* entity, uint32_t& id) const override;
+    bool FromId(uint32_t id, void*& entity) const override;
+
+    //! @brief 種別と番号からIDを作る
+    [[nodiscard]] static constexpr uint32_t MakeId(EventEntityKind kind, uint32_t index) {
+        return (static_cast<uint32_t>(kind) << 24) | (index & 0x00FFFFFFu);
+    }
+
+    //! @brief IDの種別
+    [[nodiscard]] static constexpr EventEntityKind GetKind(uint32_t id) {
+        return static_cast<EventEntityKind>(id >> 24);
+    }
+
+private:
+    Player* player_ = nullptr;
+    std::vector<Group*> groups_;
+    std::unordered_map<const void*, uint32_t> ids_;  //!< ポインタ→ID
+};
+
+//----------------------------------------------------------------------------
+// EventTraceCodecから使う変換ヘルパー
+//----------------------------------------------------------------------------
+
+//! @brief エンティティをIDへ
+template<typename T>
+bool EncodeEventEntity(const IEventEntityMap& map, const T* entity, uint32_t& id)
+{
+    static_assert(kEventEntityKind<T> != EventEntityKind::None, "IDを割り当てられない型です");
+    return map.ToId(entity, id);
+}
+
+//! @brief IDをエンティティへ（種別が一致しないIDはfalse）
+template<typename T>
+bool DecodeEventEntity(const IEventEntityMap& map, uint32_t id, T*& entity)
+{
+    static_assert(kEventEntityKind<T> != EventEntityKind::None, "IDを割り当てられない型です");
+    if (id != IEventEntityMap::kNullId && GameEventEntityMap::GetKind(id) != kEventEntityKind<T>) {
+        return false;
+    }
+    void* found = nullptr;
+    if (!map.FromId(id, found)) return false;
+    entity = static_cast<T*>(found);
+    return true;
+}
+
+//! @brief 縁を結べるエンティティをIDへ
+bool EncodeEventEntity(const IEventEntityMap& map, const BondableEntity& entity, uint32_t& id);
+
+//! @brief IDを縁を結べるエンティティへ（Player/Group以外のIDはfalse）
+bool DecodeEventEntity(const IEventEntityMap& map, uint32_t id, BondableEntity& entity);
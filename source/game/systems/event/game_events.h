@@ -6,6 +6,8 @@
 
 #include "game/bond/bond.h"
 #include "game/bond/bondable_entity.h"
+#include "game/systems/event/event_bus.h"
+#include "game/systems/event/game_event_entities.h"
 
 // 前方宣言
 class Player;
@@ -175,3 +177,227 @@ struct LoveFollowingChangedEvent
     Group* group;      //!< 対象グループ
     bool isFollowing;  //!< 追従中かどうか
 };
+
+//============================================================================
+// イベント一覧
+//============================================================================
+
+//! @brief ゲームで扱う全イベント型（並び順がイベント型IDになる）
+//! @note 新しいイベント型はここに追加しないとEventBusで扱えない
+using GameEventList = EventTypeList<
+    BindModeChangedEvent,
+    CutModeChangedEvent,
+    EntityMarkedEvent,
+    MarkCancelledEvent,
+    BondTypeSelectedEvent,
+    BondCreatedEvent,
+    BondRemovedEvent,
+    BondMarkedForCutEvent,
+    DamageDealtEvent,
+    PlayerDamagedEvent,
+    IndividualDiedEvent,
+    GroupDefeatedEvent,
+    PlayerDiedEvent,
+    StaggerAppliedEvent,
+    StaggerRemovedEvent,
+    ThreatChangedEvent,
+    FEChangedEvent,
+    GameOverEvent,
+    AIStateChangedEvent,
+    LoveFollowingChangedEvent
+>;
+
+//============================================================================
+// イベントトレースの記録形式
+//============================================================================
+
+//! @brief 中身をそのまま記録・再生するイベント（ポインタを含まない型）
+template<> inline constexpr bool kEventTraceable<BindModeChangedEvent> = true;
+template<> inline constexpr bool kEventTraceable<CutModeChangedEvent> = true;
+template<> inline constexpr bool kEventTraceable<MarkCancelledEvent> = true;
+template<> inline constexpr bool kEventTraceable<BondTypeSelectedEvent> = true;
+template<> inline constexpr bool kEventTraceable<GameOverEvent> = true;
+
+// Player/Group/Individualを含むイベントはGameEventEntityMapのIDに置き換えて記録する。
+// Bond*を含むBondCreatedEvent/BondMarkedForCutEventは縁にIDがないため中身なしで記録する。
+
+template<>
+struct EventTraceCodec<EntityMarkedEvent>
+{
+    struct Record { uint32_t entity; };
+    static bool Encode(const EntityMarkedEvent& e, const IEventEntityMap& map, Record& out) {
+        return EncodeEventEntity(map, e.entity, out.entity);
+    }
+    static bool Decode(const Record& r, const IEventEntityMap& map, EntityMarkedEvent& out) {
+        return DecodeEventEntity(map, r.entity, out.entity);
+    }
+};
+
+template<>
+struct EventTraceCodec<BondRemovedEvent>
+{
+    struct Record { uint32_t entityA; uint32_t entityB; };
+    static bool Encode(const BondRemovedEvent& e, const IEventEntityMap& map, Record& out) {
+        return EncodeEventEntity(map, e.entityA, out.entityA) && EncodeEventEntity(map, e.entityB, out.entityB);
+    }
+    static bool Decode(const Record& r, const IEventEntityMap& map, BondRemovedEvent& out) {
+        return DecodeEventEntity(map, r.entityA, out.entityA) && DecodeEventEntity(map, r.entityB, out.entityB);
+    }
+};
+
+template<>
+struct EventTraceCodec<DamageDealtEvent>
+{
+    struct Record { uint32_t attacker; uint32_t target; float damage; };
+    static bool Encode(const DamageDealtEvent& e, const IEventEntityMap& map, Record& out) {
+        out.damage = e.damage;
+        return EncodeEventEntity(map, e.attacker, out.attacker) && EncodeEventEntity(map, e.target, out.target);
+    }
+    static bool Decode(const Record& r, const IEventEntityMap& map, DamageDealtEvent& out) {
+        out.damage = r.damage;
+        return DecodeEventEntity(map, r.attacker, out.attacker) && DecodeEventEntity(map, r.target, out.target);
+    }
+};
+
+template<>
+struct EventTraceCodec<PlayerDamagedEvent>
+{
+    struct Record { uint32_t player; float damage; float remainingHp; };
+    static bool Encode(const PlayerDamagedEvent& e, const IEventEntityMap& map, Record& out) {
+        out.damage = e.damage;
+        out.remainingHp = e.remainingHp;
+        return EncodeEventEntity(map, e.player, out.player);
+    }
+    static bool Decode(const Record& r, const IEventEntityMap& map, PlayerDamagedEvent& out) {
+        out.damage = r.damage;
+        out.remainingHp = r.remainingHp;
+        return DecodeEventEntity(map, r.player, out.player);
+    }
+};
+
+template<>
+struct EventTraceCodec<IndividualDiedEvent>
+{
+    struct Record { uint32_t individual; uint32_t ownerGroup; };
+    static bool Encode(const IndividualDiedEvent& e, const IEventEntityMap& map, Record& out) {
+        return EncodeEventEntity(map, e.individual, out.individual) &&
+               EncodeEventEntity(map, e.ownerGroup, out.ownerGroup);
+    }
+    static bool Decode(const Record& r, const IEventEntityMap& map, IndividualDiedEvent& out) {
+        return DecodeEventEntity(map, r.individual, out.individual) &&
+               DecodeEventEntity(map, r.ownerGroup, out.ownerGroup);
+    }
+};
+
+template<>
+struct EventTraceCodec<GroupDefeatedEvent>
+{
+    struct Record { uint32_t group; };
+    static bool Encode(const GroupDefeatedEvent& e, const IEventEntityMap& map, Record& out) {
+        return EncodeEventEntity(map, e.group, out.group);
+    }
+    static bool Decode(const Record& r, const IEventEntityMap& map, GroupDefeatedEvent& out) {
+        return DecodeEventEntity(map, r.group, out.group);
+    }
+};
+
+template<>
+struct EventTraceCodec<PlayerDiedEvent>
+{
+    struct Record { uint32_t player; };
+    static bool Encode(const PlayerDiedEvent& e, const IEventEntityMap& map, Record& out) {
+        return EncodeEventEntity(map, e.player, out.player);
+    }
+    static bool Decode(const Record& r, const IEventEntityMap& map, PlayerDiedEvent& out) {
+        return DecodeEventEntity(map, r.player, out.player);
+    }
+};
+
+template<>
+struct EventTraceCodec<StaggerAppliedEvent>
+{
+    struct Record { uint32_t entity; float duration; };
+    static bool Encode(const StaggerAppliedEvent& e, const IEventEntityMap& map, Record& out) {
+        out.duration = e.duration;
+        return EncodeEventEntity(map, e.entity, out.entity);
+    }
+    static bool Decode(const Record& r, const IEventEntityMap& map, StaggerAppliedEvent& out) {
+        out.duration = r.duration;
+        return DecodeEventEntity(map, r.entity, out.entity);
+    }
+};
+
+template<>
+struct EventTraceCodec<StaggerRemovedEvent>
+{
+    struct Record { uint32_t entity; };
+    static bool Encode(const StaggerRemovedEvent& e, const IEventEntityMap& map, Record& out) {
+        return EncodeEventEntity(map, e.entity, out.entity);
+    }
+    static bool Decode(const Record& r, const IEventEntityMap& map, StaggerRemovedEvent& out) {
+        return DecodeEventEntity(map, r.entity, out.entity);
+    }
+};
+
+template<>
+struct EventTraceCodec<ThreatChangedEvent>
+{
+    struct Record { uint32_t group; float oldThreat; float newThreat; };
+    static bool Encode(const ThreatChangedEvent& e, const IEventEntityMap& map, Record& out) {
+        out.oldThreat = e.oldThreat;
+        out.newThreat = e.newThreat;
+        return EncodeEventEntity(map, e.group, out.group);
+    }
+    static bool Decode(const Record& r, const IEventEntityMap& map, ThreatChangedEvent& out) {
+        out.oldThreat = r.oldThreat;
+        out.newThreat = r.newThreat;
+        return DecodeEventEntity(map, r.group, out.group);
+    }
+};
+
+template<>
+struct EventTraceCodec<FEChangedEvent>
+{
+    struct Record { uint32_t player; float oldFE; float newFE; };
+    static bool Encode(const FEChangedEvent& e, const IEventEntityMap& map, Record& out) {
+        out.oldFE = e.oldFE;
+        out.newFE = e.newFE;
+        return EncodeEventEntity(map, e.player, out.player);
+    }
+    static bool Decode(const Record& r, const IEventEntityMap& map, FEChangedEvent& out) {
+        out.oldFE = r.oldFE;
+        out.newFE = r.newFE;
+        return DecodeEventEntity(map, r.player, out.player);
+    }
+};
+
+template<>
+struct EventTraceCodec<AIStateChangedEvent>
+{
+    struct Record { uint32_t group; AIState newState; };
+    static bool Encode(const AIStateChangedEvent& e, const IEventEntityMap& map, Record& out) {
+        out.newState = e.newState;
+        return EncodeEventEntity(map, e.group, out.group);
+    }
+    static bool Decode(const Record& r, const IEventEntityMap& map, AIStateChangedEvent& out) {
+        out.newState = r.newState;
+        return DecodeEventEntity(map, r.group, out.group);
+    }
+};
+
+template<>
+struct EventTraceCodec<LoveFollowingChangedEvent>
+{
+    struct Record { uint32_t group; bool isFollowing; };
+    static bool Encode(const LoveFollowingChangedEvent& e, const IEventEntityMap& map, Record& out) {
+        out.isFollowing = e.isFollowing;
+        return EncodeEventEntity(map, e.group, out.group);
+    }
+    static bool Decode(const Record& r, const IEventEntityMap& map, LoveFollowingChangedEvent& out) {
+        out.isFollowing = r.isFollowing;
+        return DecodeEventEntity(map, r.group, out.group);
+    }
+};
+
+//! @brief ゲームのイベントバス
+using EventBus = BasicEventBus<GameEventList>;
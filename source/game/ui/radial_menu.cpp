@@ -56,7 +56,7 @@ void RadialMenu::Update(const Vector2& cursorPos)
 }
 
 //----------------------------------------------------------------------------
-void RadialMenu::Render(SpriteBatch& /*spriteBatch*/)
+void RadialMenu::RenderCircles()
 {
 #ifdef _DEBUG
     if (!isOpen_) return;
@@ -70,23 +70,12 @@ void RadialMenu::Render(SpriteBatch& /*spriteBatch*/)
     // 背景の暗い円
     debug.DrawCircleFilled(centerPos_, radius_ + 10.0f, Color(0.1f, 0.1f, 0.1f, 0.7f));
 
-    // 各セクターを描画
+    // 各セクターに大きな色付き円を描画（扇形の代わり）
     for (int i = 0; i < numItems; ++i) {
-        float startAngle = static_cast<float>(i) * sectorAngle - kPi / 2.0f - sectorAngle / 2.0f;
-        float endAngle = startAngle + sectorAngle;
-        float midAngle = (startAngle + endAngle) / 2.0f;
+        float midAngle = static_cast<float>(i) * sectorAngle - kPi / 2.0f;
 
-        // セクターの色
         Color baseColor = items_[i].color;
 
-        // セクター境界線（中心から外側へ）
-        Vector2 lineEnd(
-            centerPos_.x + std::cos(startAngle) * radius_,
-            centerPos_.y + std::sin(startAngle) * radius_
-        );
-        debug.DrawLine(centerPos_, lineEnd, Color(0.9f, 0.9f, 0.9f, 0.9f), 3.0f);
-
-        // セクター内に大きな色付き円を描画（扇形の代わり）
         float iconDist = (deadZone_ + radius_) / 2.0f;
         Vector2 iconPos(
             centerPos_.x + std::cos(midAngle) * iconDist,
@@ -118,6 +107,30 @@ void RadialMenu::Render(SpriteBatch& /*spriteBatch*/)
 #endif
 }
 
+//----------------------------------------------------------------------------
+void RadialMenu::Render(SpriteBatch& /*spriteBatch*/)
+{
+#ifdef _DEBUG
+    if (!isOpen_) return;
+
+    DebugDraw& debug = DebugDraw::Get();
+    int numItems = static_cast<int>(items_.size());
+    if (numItems == 0) return;
+
+    float sectorAngle = kTwoPi / static_cast<float>(numItems);
+
+    // セクター境界線（中心から外側へ）
+    for (int i = 0; i < numItems; ++i) {
+        float startAngle = static_cast<float>(i) * sectorAngle - kPi / 2.0f - sectorAngle / 2.0f;
+        Vector2 lineEnd(
+            centerPos_.x + std::cos(startAngle) * radius_,
+            centerPos_.y + std::sin(startAngle) * radius_
+        );
+        debug.DrawLine(centerPos_, lineEnd, Color(0.9f, 0.9f, 0.9f, 0.9f), 3.0f);
+    }
+#endif
+}
+
 //----------------------------------------------------------------------------
 BondType RadialMenu::GetHoveredBondType() const
 {
@@ -47,8 +47,13 @@ public:
     //! @param cursorPos カーソル位置（スクリーン座標）
     void Update(const Vector2& cursorPos);
 
-    //! @brief 描画
+    //! @brief 円（背景・選択肢・枠線）を描画
+    //! @note CircleRendererのBegin()～End()の間で呼ぶ（1回の描画コールにまとまる）
+    void RenderCircles();
+
+    //! @brief セクター境界線を描画
     //! @param spriteBatch SpriteBatch参照
+    //! @note 円の上に重ねるため、RenderCircles()の描画後のSpriteBatchパスで呼ぶ
     void Render(SpriteBatch& spriteBatch);
 
     //! @brief メニューが開いているか
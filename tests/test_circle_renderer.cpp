@@ -0,0 +1,239 @@
+//----------------------------------------------------------------------------
+//! @file   test_circle_renderer.cpp
+//! @brief  CircleRenderer CPUステージ テストスイート
+//!
+//! @details
+//! CircleRendererのインスタンスパックと描画範囲の分割をテストします。
+//!
+//! テストカテゴリ:
+//! - Pack: 塗りつぶし・枠線のインスタンス値とバイト配置
+//! - Cull: 描画不要な円の除外と表示範囲の判定
+//! - Plan: リングバッファへの転送範囲（容量内は1描画コール）
+//! - Benchmark: 円のパックと転送範囲の計算時間
+//!
+//! @note D3D11デバイスは不要
+//----------------------------------------------------------------------------
+#include "test_circle_renderer.h"
+#include "test_common.h"
+#include "engine/debug/circle_geometry.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace tests {
+
+//----------------------------------------------------------------------------
+// テストユーティリティ（共通ヘッダーから使用）
+//----------------------------------------------------------------------------
+
+// グローバルカウンターを使用（後方互換性のため）
+#define s_testCount tests::GetGlobalTestCount()
+#define s_passCount tests::GetGlobalPassCount()
+
+using CircleGeometry::CircleInstance;
+using CircleGeometry::DrawRange;
+
+//----------------------------------------------------------------------------
+// Packテスト
+//----------------------------------------------------------------------------
+
+//! 塗りつぶし・枠線の値
+static void TestPack_Values()
+{
+    std::cout << "\n=== Pack: インスタンス値 ===" << std::endl;
+
+    const Color color(0.25f, 0.5f, 0.75f, 0.8f);
+
+    CircleInstance filled = CircleGeometry::MakeFilled(Vector2(10.0f, 20.0f), 30.0f, color);
+    TEST_ASSERT(filled.center[0] == 10.0f && filled.center[1] == 20.0f, "中心");
+    TEST_ASSERT(filled.radius == 30.0f && filled.thickness == 0.0f, "塗りつぶしは太さ0");
+    TEST_ASSERT(filled.color[0] == 0.25f && filled.color[1] == 0.5f &&
+                filled.color[2] == 0.75f && filled.color[3] == 0.8f, "色");
+
+    // 線は半径の内外に半分ずつ掛かる（線分近似と同じ）
+    CircleInstance outline = CircleGeometry::MakeOutline(Vector2(0.0f, 0.0f), 30.0f, color, 4.0f);
+    TEST_ASSERT(outline.radius == 32.0f, "外側の半径は線幅の半分だけ大きい");
+    TEST_ASSERT(outline.thickness == 4.0f, "輪の太さは線幅");
+
+    CircleInstance thick = CircleGeometry::MakeOutline(Vector2(0.0f, 0.0f), 3.0f, color, 8.0f);
+    TEST_ASSERT(thick.radius == 7.0f && thick.thickness == 0.0f, "線が中心まで届けば塗りつぶし");
+
+    CircleInstance negative = CircleGeometry::MakeOutline(Vector2(0.0f, 0.0f), 10.0f, color, -2.0f);
+    TEST_ASSERT(negative.radius == 10.0f && negative.thickness == 0.0f, "負の線幅は0として扱う");
+
+    // circle_vs.hlslの入力レイアウトと同じ配置でバッファへ並ぶか
+    std::vector<CircleInstance> packed = { filled, outline };
+    float raw[16];
+    std::memcpy(raw, packed.data(), sizeof(raw));
+    TEST_ASSERT(raw[2] == 30.0f && raw[8] == 0.0f && raw[10] == 32.0f && raw[11] == 4.0f,
+                "32バイト単位で連続する");
+}
+
+//----------------------------------------------------------------------------
+// Cullテスト
+//----------------------------------------------------------------------------
+
+//! 描画不要な円と表示範囲
+static void TestCull_Visibility()
+{
+    std::cout << "\n=== Cull: 表示範囲 ===" << std::endl;
+
+    const Color color(1.0f, 1.0f, 1.0f, 1.0f);
+    TEST_ASSERT(!CircleGeometry::IsDrawable(CircleGeometry::MakeFilled(Vector2(0, 0), 0.0f, color)),
+                "半径0は描画しない");
+    TEST_ASSERT(!CircleGeometry::IsDrawable(CircleGeometry::MakeFilled(Vector2(0, 0), 10.0f, Color(1, 1, 1, 0))),
+                "完全に透明な円は描画しない");
+    TEST_ASSERT(CircleGeometry::IsDrawable(CircleGeometry::MakeOutline(Vector2(0, 0), 0.0f, color, 2.0f)),
+                "半径0でも線幅があれば描画する");
+
+    const SpriteGeometry::ViewRect view = { 0.0f, 0.0f, 100.0f, 100.0f };
+    TEST_ASSERT(CircleGeometry::IsVisible(CircleGeometry::MakeFilled(Vector2(50, 50), 5.0f, color), view),
+                "範囲内");
+    TEST_ASSERT(CircleGeometry::IsVisible(CircleGeometry::MakeFilled(Vector2(-9, 50), 10.0f, color), view),
+                "中心が範囲外でも縁が掛かれば表示");
+    TEST_ASSERT(!CircleGeometry::IsVisible(CircleGeometry::MakeFilled(Vector2(-11, 50), 10.0f, color), view),
+                "縁まで範囲外なら除外");
+    TEST_ASSERT(CircleGeometry::IsVisible(CircleGeometry::MakeOutline(Vector2(105, 50), 4.0f, color, 2.0f), view),
+                "枠線は線の外側まで含めて判定");
+    TEST_ASSERT(CircleGeometry::IsVisible(CircleGeometry::MakeFilled(Vector2(50, 50), 500.0f, color), view),
+                "表示範囲を覆う円");
+}
+
+//----------------------------------------------------------------------------
+// Planテスト
+//----------------------------------------------------------------------------
+
+//! 容量内は1描画コール、超えた分だけ分割
+static void TestPlan_Ranges()
+{
+    std::cout << "\n=== Plan: 転送範囲 ===" << std::endl;
+
+    SpriteRing::Cursor ring;
+    ring.Reset(256);
+    std::vector<DrawRange> ranges;
+
+    CircleGeometry::PlanDraws(0, ring, ranges);
+    TEST_ASSERT(ranges.empty(), "円が無ければ範囲なし");
+
+    CircleGeometry::PlanDraws(100, ring, ranges);
+    TEST_ASSERT(ranges.size() == 1, "容量内は1描画コール");
+    TEST_ASSERT(ranges[0].source == 0 && ranges[0].ringFirst == 0 && ranges[0].count == 100 &&
+                ranges[0].discard, "最初の転送は先頭からDISCARD");
+
+    CircleGeometry::PlanDraws(100, ring, ranges);
+    TEST_ASSERT(ranges.size() == 1 && ranges[0].ringFirst == 100 && !ranges[0].discard,
+                "次のフレームは続きへNO_OVERWRITE");
+
+    CircleGeometry::PlanDraws(100, ring, ranges);
+    TEST_ASSERT(ranges.size() == 1 && ranges[0].ringFirst == 0 && ranges[0].discard,
+                "末尾を越える場合は先頭に戻ってDISCARD");
+
+    ring.Reset(256);
+    CircleGeometry::PlanDraws(600, ring, ranges);
+    bool split = ranges.size() == 3;
+    uint32_t covered = 0;
+    for (const DrawRange& range : ranges) {
+        split = split && range.source == covered && range.ringFirst == 0 && range.discard;
+        covered += range.count;
+    }
+    TEST_ASSERT(split && covered == 600, "容量を超える分は容量単位で分割");
+    TEST_ASSERT(ranges.size() == 3 && ranges[2].count == 88, "最後の範囲は残り");
+
+    SpriteRing::Cursor empty;
+    CircleGeometry::PlanDraws(10, empty, ranges);
+    TEST_ASSERT(ranges.empty(), "容量0では範囲を作らない");
+}
+
+//----------------------------------------------------------------------------
+// ベンチマーク
+//----------------------------------------------------------------------------
+
+//! 探知範囲とUI相当の円をパック・カリングして転送範囲を計算
+static void BenchmarkPackAndPlan()
+{
+    std::cout << "\n=== Benchmark: パックと転送範囲 ===" << std::endl;
+
+    constexpr int kFrames = 200;
+    const SpriteGeometry::ViewRect view = { -960.0f, -540.0f, 960.0f, 540.0f };
+
+    for (uint32_t count : { 256u, 4096u, 65536u }) {
+        std::mt19937 rng(count);
+        std::uniform_real_distribution<float> pos(-2000.0f, 2000.0f);
+        std::uniform_real_distribution<float> radius(4.0f, 300.0f);
+        std::vector<Vector2> centers(count);
+        std::vector<float> radii(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            centers[i] = Vector2(pos(rng), pos(rng));
+            radii[i] = radius(rng);
+        }
+
+        std::vector<CircleInstance> queue;
+        queue.reserve(count);
+        std::vector<DrawRange> ranges;
+        SpriteRing::Cursor ring;
+        ring.Reset(SpriteRing::GrowCapacity(256, count));
+        const Color color(0.3f, 0.6f, 1.0f, 0.3f);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        size_t drawn = 0;
+        for (int frame = 0; frame < kFrames; ++frame) {
+            queue.clear();
+            for (uint32_t i = 0; i < count; ++i) {
+                CircleInstance circle = (i & 1)
+                    ? CircleGeometry::MakeOutline(centers[i], radii[i], color, 3.0f)
+                    : CircleGeometry::MakeFilled(centers[i], radii[i], color);
+                if (CircleGeometry::IsDrawable(circle) && CircleGeometry::IsVisible(circle, view)) {
+                    queue.push_back(circle);
+                }
+            }
+            CircleGeometry::PlanDraws(static_cast<uint32_t>(queue.size()), ring, ranges);
+            drawn += ranges.size();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        std::cout << "  " << count << " circles: " << ms / kFrames << " ms/frame"
+                  << "  visible " << queue.size()
+                  << "  draws/frame " << static_cast<double>(drawn) / kFrames << std::endl;
+    }
+}
+
+//----------------------------------------------------------------------------
+// 公開インターフェース
+//----------------------------------------------------------------------------
+
+//! CircleRenderer CPUステージ テストスイートを実行
+//! @param runBenchmarks ベンチマークも実行するか
+//! @return 全テスト成功時true、それ以外false
+bool RunCircleRendererTests(bool runBenchmarks)
+{
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "  CircleRenderer CPUステージ テスト" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    ResetGlobalCounters();
+
+    // Packテスト
+    TestPack_Values();
+
+    // Cullテスト
+    TestCull_Visibility();
+
+    // Planテスト
+    TestPlan_Ranges();
+
+    // ベンチマーク（--bench指定時のみ）
+    if (runBenchmarks) {
+        BenchmarkPackAndPlan();
+    }
+
+    std::cout << "\n----------------------------------------" << std::endl;
+    std::cout << "CircleRendererテスト: " << s_passCount << "/" << s_testCount << " 成功" << std::endl;
+    std::cout << "----------------------------------------" << std::endl;
+
+    return s_passCount == s_testCount;
+}
+
+} // namespace tests
@@ -0,0 +1,15 @@
+//----------------------------------------------------------------------------
+//! @file   test_circle_renderer.h
+//! @brief  Circle renderer CPU stage test declarations
+//----------------------------------------------------------------------------
+#pragma once
+
+namespace tests {
+
+//! Run all circle renderer CPU stage tests
+//! @param [in] runBenchmarks Also run timing benchmarks
+//! @return true if all tests passed
+//! @note Does not require D3D11 device
+bool RunCircleRendererTests(bool runBenchmarks = false);
+
+} // namespace tests
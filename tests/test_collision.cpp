@@ -0,0 +1,1535 @@
+//----------------------------------------------------------------------------
+//! @file   test_collision.cpp
+//! @brief  衝突判定 テストスイート
+//!
+//! @details
+//! CollisionManagerのブロードフェーズとイベント発火のテストを提供します。
+//!
+//! テストカテゴリ:
+//! - Broadphase: グリッドとSweep and PruneのEnter/Stay/Exit一致
+//! - DenseGrid: 境界付き密グリッドと空間ハッシュのイベント・クエリ一致
+//! - Parallel: 並列ペア収集とシングルスレッドのイベント一致・発火スレッド
+//! - Simd: SIMD重なり判定カーネルとスカラー実装の一致
+//! - Shape: 円/カプセルの形状ペア判定・イベント・クエリ
+//! - Query: バッチクエリと単発クエリの一致・結果の順序・作業領域の再利用
+//! - Bullet: 弾丸コライダーの掃引判定（すり抜け防止・衝突時刻順）
+//! - Contact: 接触イベント列とコールバックの一致・レイヤー絞り込み
+//! - Sleep: 静的/スリープ中コライダーの分離（イベント一致・内訳・Stay継続・セルサイズ変更）
+//! - Handle: 世代による古いハンドル検出、登録上限、大量登録/解除
+//! - Benchmark: 多数のIndividual相当コライダーでのステップ時間計測
+//!
+//! @note D3D11デバイスは不要
+//----------------------------------------------------------------------------
+#include "test_collision.h"
+#include "test_common.h"
+#include "engine/c_systems/collision_manager.h"
+#include "engine/c_systems/collision_simd.h"
+#include "engine/c_systems/collision_shapes.h"
+#include "engine/component/collider2d.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace tests {
+
+//----------------------------------------------------------------------------
+// テストユーティリティ（共通ヘッダーから使用）
+//----------------------------------------------------------------------------
+
+// グローバルカウンターを使用（後方互換性のため）
+#define s_testCount tests::GetGlobalTestCount()
+#define s_passCount tests::GetGlobalPassCount()
+
+//----------------------------------------------------------------------------
+// シミュレーション用ヘルパー
+//----------------------------------------------------------------------------
+
+//! 衝突イベント種別
+enum class EventKind { Enter, Stay, Exit };
+
+//! 記録した衝突イベント（step, kind, 小さいID, 大きいID）
+using RecordedEvent = std::tuple<int, EventKind, int, int>;
+
+//! ランダムに動くコライダー群
+struct ColliderScene
+{
+    std::vector<std::unique_ptr<Collider2D>> colliders;
+    std::vector<ColliderHandle> handles;
+    std::vector<Vector2> positions;
+    std::vector<Vector2> velocities;
+};
+
+//! Individual相当（32px）のコライダー群を作成
+//! @param count コライダー数
+//! @param worldW ワールド幅
+//! @param worldH ワールド高さ
+//! @param seed 乱数シード
+static ColliderScene CreateScene(int count, float worldW, float worldH, uint32_t seed)
+{
+    ColliderScene scene;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> distX(0.0f, worldW);
+    std::uniform_real_distribution<float> distY(0.0f, worldH);
+    std::uniform_real_distribution<float> distV(-2.0f, 2.0f);
+
+    for (int i = 0; i < count; ++i) {
+        scene.colliders.push_back(std::make_unique<Collider2D>());
+        scene.colliders.back()->SetUserData(reinterpret_cast<void*>(static_cast<intptr_t>(i)));
+        scene.positions.emplace_back(distX(rng), distY(rng));
+        scene.velocities.emplace_back(distV(rng), distV(rng));
+    }
+    return scene;
+}
+
+//! 全コライダーをCollisionManagerに登録
+static void RegisterScene(ColliderScene& scene, std::vector<RecordedEvent>* events, const int* step)
+{
+    auto& mgr = CollisionManager::Get();
+    scene.handles.clear();
+
+    for (size_t i = 0; i < scene.colliders.size(); ++i) {
+        ColliderHandle h = mgr.Register(scene.colliders[i].get());
+        mgr.SetSize(h, 32.0f, 32.0f);
+        mgr.SetPosition(h, scene.positions[i].x, scene.positions[i].y);
+        mgr.SetLayer(h, 0x04);
+        mgr.SetMask(h, 0x05);
+        scene.handles.push_back(h);
+
+        if (!events) continue;
+
+        // 片側（自分のIDが小さい側）だけ記録して重複を避ける
+        auto record = [events, step](EventKind kind) {
+            return [events, step, kind](Collider2D* self, Collider2D* other) {
+                int a = static_cast<int>(reinterpret_cast<intptr_t>(self->GetUserData()));
+                int b = static_cast<int>(reinterpret_cast<intptr_t>(other->GetUserData()));
+                if (a < b) events->emplace_back(*step, kind, a, b);
+            };
+        };
+        mgr.SetOnCollisionEnter(h, record(EventKind::Enter));
+        mgr.SetOnCollision(h, record(EventKind::Stay));
+        mgr.SetOnCollisionExit(h, record(EventKind::Exit));
+    }
+}
+
+//! 1ステップ分コライダーを移動
+static void MoveScene(ColliderScene& scene)
+{
+    auto& mgr = CollisionManager::Get();
+    for (size_t i = 0; i < scene.handles.size(); ++i) {
+        scene.positions[i] += scene.velocities[i];
+        mgr.SetPosition(scene.handles[i], scene.positions[i].x, scene.positions[i].y);
+    }
+}
+
+//! 指定ブロードフェーズでシミュレーションしイベント列を取得
+//! @param dense trueなら境界付き密グリッドを使用
+//! @param workers ペア収集のスレッド数
+//! @param useStream trueならコールバックを止め、接触イベント列から記録する
+static std::vector<RecordedEvent> RunSimulation(BroadphaseMode mode, int count, int steps, uint32_t seed,
+                                                bool dense = false, uint32_t workers = 1,
+                                                bool useStream = false)
+{
+    auto& mgr = CollisionManager::Get();
+    mgr.Initialize(64);
+    mgr.SetBroadphaseMode(mode);
+    mgr.SetWorkerCount(workers);
+    mgr.SetCallbacksEnabled(!useStream);
+    if (dense) {
+        // 一部のコライダーが範囲外に出るよう、ワールドより少し狭くする
+        mgr.SetWorldBounds(AABB(0.0f, 0.0f, 960.0f, 700.0f));
+    }
+
+    std::vector<RecordedEvent> events;
+    int step = 0;
+    ColliderScene scene = CreateScene(count, 1024.0f, 768.0f, seed);
+    RegisterScene(scene, useStream ? nullptr : &events, &step);
+
+    for (step = 0; step < steps; ++step) {
+        MoveScene(scene);
+
+        // 途中で一部を無効化・解除してSAPの端点再生成も通す
+        if (step == steps / 2) {
+            for (size_t i = 0; i < scene.handles.size(); i += 7) {
+                mgr.SetEnabled(scene.handles[i], false);
+            }
+            for (size_t i = 3; i < scene.handles.size(); i += 11) {
+                mgr.Unregister(scene.handles[i]);
+            }
+        }
+
+        mgr.Update(CollisionManager::GetFixedDeltaTime());
+
+        if (!useStream) continue;
+
+        // コールバックと同じ形式に変換（Enter時はStayも発火する）
+        for (const ContactEvent& ev : mgr.GetContactEvents()) {
+            int a = static_cast<int>(reinterpret_cast<intptr_t>(mgr.GetCollider(ev.a)->GetUserData()));
+            int b = static_cast<int>(reinterpret_cast<intptr_t>(mgr.GetCollider(ev.b)->GetUserData()));
+            if (a > b) std::swap(a, b);
+            if (ev.type == ContactType::Enter) events.emplace_back(step, EventKind::Enter, a, b);
+            if (ev.type != ContactType::Exit) events.emplace_back(step, EventKind::Stay, a, b);
+            if (ev.type == ContactType::Exit) events.emplace_back(step, EventKind::Exit, a, b);
+        }
+    }
+
+    mgr.Shutdown();
+    mgr.SetBroadphaseMode(BroadphaseMode::Grid);
+    mgr.SetCallbacksEnabled(true);
+    mgr.ClearWorldBounds();
+
+    std::sort(events.begin(), events.end());
+    return events;
+}
+
+//----------------------------------------------------------------------------
+// Broadphase テスト
+//----------------------------------------------------------------------------
+
+//! グリッドとSweep and Pruneのイベント一致テスト
+static void TestBroadphase_SweepAndPruneMatchesGrid()
+{
+    std::cout << "\n=== Sweep and Prune / グリッド一致テスト ===" << std::endl;
+
+    constexpr int kCount = 600;
+    constexpr int kSteps = 40;
+
+    auto gridEvents = RunSimulation(BroadphaseMode::Grid, kCount, kSteps, 1234);
+    auto sapEvents = RunSimulation(BroadphaseMode::SweepAndPrune, kCount, kSteps, 1234);
+
+    auto countKind = [](const std::vector<RecordedEvent>& events, EventKind kind) {
+        return std::count_if(events.begin(), events.end(),
+            [kind](const RecordedEvent& e) { return std::get<1>(e) == kind; });
+    };
+
+    TEST_ASSERT(countKind(gridEvents, EventKind::Enter) > 0, "グリッドでEnterイベントが発生すること");
+    TEST_ASSERT(countKind(gridEvents, EventKind::Exit) > 0, "グリッドでExitイベントが発生すること");
+    TEST_ASSERT(gridEvents.size() == sapEvents.size(), "イベント数が一致すること");
+    TEST_ASSERT(gridEvents == sapEvents, "Enter/Stay/Exitのペア集合が全ステップで一致すること");
+}
+
+//! 接触のみ（辺が一致）のペアは衝突扱いしないテスト
+static void TestBroadphase_TouchingIsNotOverlap()
+{
+    std::cout << "\n=== 接触ペア除外テスト ===" << std::endl;
+
+    auto& mgr = CollisionManager::Get();
+    mgr.Initialize(64);
+    mgr.SetBroadphaseMode(BroadphaseMode::SweepAndPrune);
+
+    Collider2D a, b;
+    int enterCount = 0;
+    ColliderHandle ha = mgr.Register(&a);
+    ColliderHandle hb = mgr.Register(&b);
+    mgr.SetSize(ha, 10.0f, 10.0f);
+    mgr.SetSize(hb, 10.0f, 10.0f);
+    mgr.SetPosition(ha, 0.0f, 0.0f);
+    mgr.SetPosition(hb, 10.0f, 0.0f);
+    mgr.SetOnCollisionEnter(ha, [&enterCount](Collider2D*, Collider2D*) { ++enterCount; });
+
+    mgr.Update(CollisionManager::GetFixedDeltaTime());
+    TEST_ASSERT(enterCount == 0, "辺が接しているだけではEnterが発生しないこと");
+
+    mgr.SetPosition(hb, 9.0f, 0.0f);
+    mgr.Update(CollisionManager::GetFixedDeltaTime());
+    TEST_ASSERT(enterCount == 1, "重なった時点でEnterが1回発生すること");
+
+    mgr.Shutdown();
+    mgr.SetBroadphaseMode(BroadphaseMode::Grid);
+}
+
+//----------------------------------------------------------------------------
+// DenseGrid テスト
+//----------------------------------------------------------------------------
+
+//! 密グリッドと空間ハッシュのイベント一致テスト
+static void TestDenseGrid_MatchesHashGrid()
+{
+    std::cout << "\n=== 密グリッド / 空間ハッシュ一致テスト ===" << std::endl;
+
+    auto hashEvents = RunSimulation(BroadphaseMode::Grid, 600, 40, 99, false);
+    auto denseEvents = RunSimulation(BroadphaseMode::Grid, 600, 40, 99, true);
+
+    TEST_ASSERT(!hashEvents.empty(), "空間ハッシュでイベントが発生すること");
+    TEST_ASSERT(hashEvents == denseEvents, "範囲外コライダーを含めてイベントが一致すること");
+}
+
+//! コライダーポインタをID順に並べ替え
+static std::vector<int> ToSortedIds(const std::vector<Collider2D*>& colliders)
+{
+    std::vector<int> ids;
+    for (Collider2D* c : colliders) {
+        ids.push_back(static_cast<int>(reinterpret_cast<intptr_t>(c->GetUserData())));
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+//! 空間クエリの結果をまとめて取得
+static std::vector<std::vector<int>> RunQueries(uint32_t seed)
+{
+    auto& mgr = CollisionManager::Get();
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> distX(-100.0f, 1100.0f);
+    std::uniform_real_distribution<float> distY(-100.0f, 850.0f);
+
+    std::vector<std::vector<int>> out;
+    std::vector<Collider2D*> hits;
+    for (int i = 0; i < 200; ++i) {
+        Vector2 a(distX(rng), distY(rng));
+        Vector2 b(distX(rng), distY(rng));
+
+        mgr.QueryAABB(AABB((std::min)(a.x, b.x), (std::min)(a.y, b.y),
+                           std::abs(b.x - a.x) * 0.25f, std::abs(b.y - a.y) * 0.25f), hits);
+        out.push_back(ToSortedIds(hits));
+
+        mgr.QueryPoint(a, hits);
+        out.push_back(ToSortedIds(hits));
+
+        mgr.QueryLineSegment(a, b, hits);
+        out.push_back(ToSortedIds(hits));
+
+        auto hit = mgr.RaycastFirst(a, b);
+        out.push_back(hit ? std::vector<int>{ static_cast<int>(hit->distance * 16.0f) } : std::vector<int>{});
+    }
+    return out;
+}
+
+//! 密グリッドと空間ハッシュのクエリ結果一致テスト
+static void TestDenseGrid_QueriesMatchHashGrid()
+{
+    std::cout << "\n=== 密グリッド クエリ一致テスト ===" << std::endl;
+
+    auto& mgr = CollisionManager::Get();
+    std::vector<std::vector<int>> results[2];
+
+    for (int dense = 0; dense < 2; ++dense) {
+        mgr.Initialize(64);
+        if (dense) {
+            mgr.SetWorldBounds(AABB(0.0f, 0.0f, 960.0f, 700.0f));
+        }
+        ColliderScene scene = CreateScene(800, 1024.0f, 768.0f, 7);
+        RegisterScene(scene, nullptr, nullptr);
+        mgr.Update(CollisionManager::GetFixedDeltaTime());
+
+        results[dense] = RunQueries(2024);
+
+        mgr.Shutdown();
+        mgr.ClearWorldBounds();
+    }
+
+    size_t nonEmpty = std::count_if(results[0].begin(), results[0].end(),
+        [](const std::vector<int>& r) { return !r.empty(); });
+    TEST_ASSERT(nonEmpty > 0, "クエリが何かにヒットすること");
+    TEST_ASSERT(results[0] == results[1], "QueryAABB/QueryPoint/QueryLineSegment/RaycastFirstの結果が一致すること");
+}
+
+//----------------------------------------------------------------------------
+// Parallel テスト
+//----------------------------------------------------------------------------
+
+//! 並列ペア収集とシングルスレッドのイベント一致テスト
+static void TestParallel_MatchesSingleThread()
+{
+    std::cout << "\n=== 並列ペア収集 一致テスト ===" << std::endl;
+
+    auto single = RunSimulation(BroadphaseMode::Grid, 800, 30, 555, false, 1);
+    auto hashParallel = RunSimulation(BroadphaseMode::Grid, 800, 30, 555, false, 4);
+    auto denseParallel = RunSimulation(BroadphaseMode::Grid, 800, 30, 555, true, 4);
+    auto denseSingle = RunSimulation(BroadphaseMode::Grid, 800, 30, 555, true, 1);
+
+    TEST_ASSERT(!single.empty(), "シングルスレッドでイベントが発生すること");
+    TEST_ASSERT(single == hashParallel, "空間ハッシュ: 4スレッドの結果がシングルスレッドと一致すること");
+    TEST_ASSERT(denseSingle == denseParallel, "密グリッド: 4スレッドの結果がシングルスレッドと一致すること");
+}
+
+//! コールバックが呼び出し元スレッドで発火するテスト
+static void TestParallel_CallbacksOnCallingThread()
+{
+    std::cout << "\n=== 並列モード コールバックスレッドテスト ===" << std::endl;
+
+    auto& mgr = CollisionManager::Get();
+    mgr.Initialize(64);
+    mgr.SetWorkerCount(4);
+    TEST_ASSERT(mgr.GetWorkerCount() == 4, "ワーカー数が設定値と一致すること");
+
+    ColliderScene scene = CreateScene(400, 512.0f, 512.0f, 11);
+    RegisterScene(scene, nullptr, nullptr);
+
+    const std::thread::id mainId = std::this_thread::get_id();
+    int calls = 0;
+    bool allOnMain = true;
+    for (ColliderHandle h : scene.handles) {
+        mgr.SetOnCollision(h, [&](Collider2D*, Collider2D*) {
+            ++calls;
+            allOnMain = allOnMain && std::this_thread::get_id() == mainId;
+        });
+    }
+
+    for (int i = 0; i < 5; ++i) {
+        MoveScene(scene);
+        mgr.Update(CollisionManager::GetFixedDeltaTime());
+    }
+
+    TEST_ASSERT(calls > 0, "並列モードでもコールバックが呼ばれること");
+    TEST_ASSERT(allOnMain, "全コールバックが呼び出し元スレッドで発火すること");
+
+    mgr.Shutdown();
+    TEST_ASSERT(mgr.GetWorkerCount() == 1, "Shutdown後はシングルスレッドに戻ること");
+}
+
+//----------------------------------------------------------------------------
+// Simd テスト
+//----------------------------------------------------------------------------
+
+//! ランダムな候補ブロックを生成
+//! @details 座標を4px単位に量子化し、辺が一致する（接触のみの）ケースも含める
+static void FillRandomBlock(CollisionSimd::CandidateBlock& block, size_t count, std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> distPos(0, 64);
+    std::uniform_int_distribution<int> distHalf(1, 8);
+    std::uniform_int_distribution<int> distBits(0, 7);
+
+    block.Resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        block.posX[i] = static_cast<float>(distPos(rng) * 4);
+        block.posY[i] = static_cast<float>(distPos(rng) * 4);
+        block.halfW[i] = static_cast<float>(distHalf(rng) * 4);
+        block.halfH[i] = static_cast<float>(distHalf(rng) * 4);
+        block.layer[i] = 1u << distBits(rng);
+        block.mask[i] = static_cast<uint32_t>(distBits(rng) * 37) & 0xFF;
+        block.flags[i] = (distBits(rng) == 0) ? 0u : CollisionSimd::kFlagEnabled;
+    }
+}
+
+//! SIMDカーネルとスカラー実装の一致テスト（ランダム入力）
+static void TestSimd_MatchesScalar()
+{
+    std::cout << "\n=== SIMDカーネル / スカラー一致テスト (レーン幅 "
+              << CollisionSimd::GetLaneWidth() << ") ===" << std::endl;
+
+#if COLLISION_SIMD
+    std::mt19937 rng(31337);
+    std::uniform_int_distribution<size_t> distCount(1, 70);
+
+    CollisionSimd::CandidateBlock block;
+    std::vector<uint32_t> scalarOut, simdOut;
+    bool allMatch = true;
+    size_t totalHits = 0;
+
+    for (int iter = 0; iter < 5000; ++iter) {
+        size_t count = distCount(rng);
+        FillRandomBlock(block, count, rng);
+        scalarOut.assign(count, 0);
+        simdOut.assign(count, 0);
+
+        std::uniform_int_distribution<size_t> distBegin(0, count - 1);
+        size_t begin = distBegin(rng);
+
+        CollisionSimd::Probe probe;
+        probe.posX = block.posX[begin];
+        probe.posY = block.posY[begin];
+        probe.halfW = block.halfW[begin];
+        probe.halfH = block.halfH[begin];
+        probe.layer = block.layer[begin];
+        probe.mask = block.mask[begin];
+
+        size_t n0 = CollisionSimd::OverlapBlockScalar(probe, block, begin + 1, count, scalarOut.data());
+        size_t n1 = CollisionSimd::OverlapBlockSimd(probe, block, begin + 1, count, simdOut.data());
+        totalHits += n0;
+
+        if (n0 != n1 || !std::equal(scalarOut.begin(), scalarOut.begin() + n0, simdOut.begin())) {
+            allMatch = false;
+        }
+    }
+
+    TEST_ASSERT(totalHits > 0, "ランダム入力で重なりが検出されること");
+    TEST_ASSERT(allMatch, "SIMDとスカラーのヒット集合と順序が一致すること");
+#else
+    std::cout << "[スキップ] COLLISION_SIMD=0 のためスカラー実装のみ" << std::endl;
+#endif
+}
+
+//----------------------------------------------------------------------------
+// Shape テスト
+//----------------------------------------------------------------------------
+
+//! 形状データを作成するヘルパー
+static CollisionShapes::ShapeData MakeBox(float x, float y, float halfW, float halfH)
+{
+    CollisionShapes::ShapeData s;
+    s.x = x; s.y = y; s.halfW = halfW; s.halfH = halfH;
+    return s;
+}
+
+static CollisionShapes::ShapeData MakeCircle(float x, float y, float r)
+{
+    CollisionShapes::ShapeData s;
+    s.shape = ColliderShape::Circle;
+    s.x = x; s.y = y; s.halfW = r; s.halfH = r; s.radius = r;
+    return s;
+}
+
+static CollisionShapes::ShapeData MakeCapsule(float x, float y, float ax, float ay, float r)
+{
+    CollisionShapes::ShapeData s;
+    s.shape = ColliderShape::Capsule;
+    s.x = x; s.y = y; s.axisX = ax; s.axisY = ay; s.radius = r;
+    s.halfW = std::abs(ax) + r; s.halfH = std::abs(ay) + r;
+    return s;
+}
+
+//! 形状ペア判定の基本ケース
+static void TestShape_PairOverlaps()
+{
+    std::cout << "\n=== 形状ペア判定テスト ===" << std::endl;
+
+    using CollisionShapes::Overlap;
+
+    // 円同士
+    TEST_ASSERT(Overlap(MakeCircle(0, 0, 5), MakeCircle(8, 0, 5)), "円同士: 重なり");
+    TEST_ASSERT(!Overlap(MakeCircle(0, 0, 5), MakeCircle(10, 0, 5)), "円同士: 接触のみは重ならない");
+    TEST_ASSERT(!Overlap(MakeCircle(0, 0, 5), MakeCircle(7.5f, 7.5f, 5)), "円同士: AABBが重なっても対角では重ならない");
+
+    // 矩形と円（角の近く）
+    TEST_ASSERT(!Overlap(MakeBox(0, 0, 10, 10), MakeCircle(12, 12, 2.5f)), "矩形-円: 角の外側は重ならない");
+    TEST_ASSERT(Overlap(MakeBox(0, 0, 10, 10), MakeCircle(12, 12, 3.0f)), "矩形-円: 角に食い込めば重なる");
+    TEST_ASSERT(Overlap(MakeCircle(12, 12, 3.0f), MakeBox(0, 0, 10, 10)), "矩形-円: 引数順に依存しない");
+    TEST_ASSERT(Overlap(MakeBox(0, 0, 10, 10), MakeCircle(0, 0, 1)), "矩形-円: 内包も重なり");
+
+    // カプセル（X方向に長さ20、半径2）
+    auto capsule = MakeCapsule(0, 0, 10, 0, 2);
+    TEST_ASSERT(Overlap(capsule, MakeCircle(0, 4, 2.5f)), "カプセル-円: 側面で重なる");
+    TEST_ASSERT(!Overlap(capsule, MakeCircle(0, 5, 2.5f)), "カプセル-円: 側面から離れれば重ならない");
+    TEST_ASSERT(!Overlap(capsule, MakeCircle(13, 3, 1.5f)), "カプセル-円: 端の丸みの外側は重ならない");
+    TEST_ASSERT(Overlap(capsule, MakeCapsule(0, 0, 0, 10, 1)), "カプセル同士: 交差");
+    TEST_ASSERT(!Overlap(capsule, MakeCapsule(0, 10, 0, 5, 2)), "カプセル同士: 離れていれば重ならない");
+    TEST_ASSERT(Overlap(capsule, MakeBox(0, 5, 4, 4)), "矩形-カプセル: 重なり");
+    TEST_ASSERT(!Overlap(MakeCapsule(0, 0, 10, 10, 1), MakeBox(-9, 9, 4, 4)), "矩形-カプセル: 斜めカプセルの脇は重ならない");
+}
+
+//! 形状を混在させたシーンで、全方式の衝突ペアが総当たりと一致するテスト
+static void TestShape_BroadphaseMatchesBruteForce()
+{
+    std::cout << "\n=== 形状混在 ブロードフェーズ一致テスト ===" << std::endl;
+
+    constexpr int kCount = 400;
+    std::mt19937 rng(777);
+    std::uniform_real_distribution<float> distPos(0.0f, 600.0f);
+    std::uniform_real_distribution<float> distSize(4.0f, 24.0f);
+    std::uniform_int_distribution<int> distShape(0, 2);
+
+    std::vector<CollisionShapes::ShapeData> shapes;
+    for (int i = 0; i < kCount; ++i) {
+        float x = distPos(rng), y = distPos(rng), a = distSize(rng), b = distSize(rng);
+        switch (distShape(rng)) {
+        case 0: shapes.push_back(MakeBox(x, y, a, b)); break;
+        case 1: shapes.push_back(MakeCircle(x, y, a)); break;
+        default: shapes.push_back(MakeCapsule(x, y, a - 12.0f, b - 12.0f, 4.0f)); break;
+        }
+    }
+
+    // 総当たりの期待値
+    std::vector<std::pair<int, int>> expected;
+    for (int i = 0; i < kCount; ++i) {
+        for (int j = i + 1; j < kCount; ++j) {
+            if (CollisionShapes::Overlap(shapes[i], shapes[j])) expected.emplace_back(i, j);
+        }
+    }
+
+    auto collect = [&](BroadphaseMode mode, bool dense) {
+        auto& mgr = CollisionManager::Get();
+        mgr.Initialize(64);
+        mgr.SetBroadphaseMode(mode);
+        if (dense) mgr.SetWorldBounds(AABB(0.0f, 0.0f, 600.0f, 600.0f));
+
+        std::vector<std::unique_ptr<Collider2D>> colliders;
+        std::vector<std::pair<int, int>> pairs;
+        for (int i = 0; i < kCount; ++i) {
+            colliders.push_back(std::make_unique<Collider2D>());
+            colliders.back()->SetUserData(reinterpret_cast<void*>(static_cast<intptr_t>(i)));
+            ColliderHandle h = mgr.Register(colliders.back().get());
+            const auto& s = shapes[i];
+            if (s.shape == ColliderShape::Box) mgr.SetSize(h, s.halfW * 2.0f, s.halfH * 2.0f);
+            if (s.shape == ColliderShape::Circle) mgr.SetCircle(h, s.radius);
+            if (s.shape == ColliderShape::Capsule) mgr.SetCapsule(h, Vector2(s.axisX, s.axisY), s.radius);
+            mgr.SetPosition(h, s.x, s.y);
+            mgr.SetOnCollisionEnter(h, [&pairs](Collider2D* self, Collider2D* other) {
+                int a = static_cast<int>(reinterpret_cast<intptr_t>(self->GetUserData()));
+                int b = static_cast<int>(reinterpret_cast<intptr_t>(other->GetUserData()));
+                if (a < b) pairs.emplace_back(a, b);
+            });
+        }
+        mgr.Update(CollisionManager::GetFixedDeltaTime());
+        mgr.Shutdown();
+        mgr.SetBroadphaseMode(BroadphaseMode::Grid);
+        mgr.ClearWorldBounds();
+
+        std::sort(pairs.begin(), pairs.end());
+        return pairs;
+    };
+
+    TEST_ASSERT(!expected.empty(), "形状混在シーンで重なりが発生すること");
+    TEST_ASSERT(collect(BroadphaseMode::Grid, false) == expected, "空間ハッシュの結果が総当たりと一致すること");
+    TEST_ASSERT(collect(BroadphaseMode::Grid, true) == expected, "密グリッドの結果が総当たりと一致すること");
+    TEST_ASSERT(collect(BroadphaseMode::SweepAndPrune, false) == expected, "Sweep and Pruneの結果が総当たりと一致すること");
+}
+
+//! 形状を考慮した空間クエリのテスト
+static void TestShape_Queries()
+{
+    std::cout << "\n=== 形状クエリテスト ===" << std::endl;
+
+    auto& mgr = CollisionManager::Get();
+    mgr.Initialize(64);
+
+    Collider2D circle, capsule;
+    ColliderHandle hc = mgr.Register(&circle);
+    ColliderHandle hk = mgr.Register(&capsule);
+    mgr.SetCircle(hc, 10.0f);
+    mgr.SetPosition(hc, 100.0f, 100.0f);
+    mgr.SetCapsule(hk, Vector2(0.0f, 20.0f), 5.0f);
+    mgr.SetPosition(hk, 200.0f, 100.0f);
+
+    TEST_ASSERT(mgr.GetShape(hc) == ColliderShape::Circle, "円形状が設定されること");
+    TEST_ASSERT(mgr.GetSize(hk).y == 50.0f, "カプセルのサイズがバウンディングになること");
+
+    std::vector<Collider2D*> results;
+
+    // バウンディングの角は円に含まれない
+    mgr.QueryPoint(Vector2(91.0f, 91.0f), results);
+    TEST_ASSERT(results.empty(), "QueryPoint: 円のバウンディングの角はヒットしないこと");
+    mgr.QueryPoint(Vector2(105.0f, 105.0f), results);
+    TEST_ASSERT(results.size() == 1 && results[0] == &circle, "QueryPoint: 円の内側はヒットすること");
+
+    mgr.QueryAABB(AABB(108.0f, 108.0f, 10.0f, 10.0f), results);
+    TEST_ASSERT(results.empty(), "QueryAABB: 円の外側の角領域はヒットしないこと");
+
+    mgr.QueryCircle(Vector2(150.0f, 100.0f), 46.0f, results);
+    TEST_ASSERT(results.size() == 2, "QueryCircle: 円とカプセルの両方にヒットすること");
+    mgr.QueryCircle(Vector2(150.0f, 100.0f), 39.0f, results);
+    TEST_ASSERT(results.empty(), "QueryCircle: 届かなければヒットしないこと");
+
+    // 左からのレイは円の表面（x=90）で止まる
+    auto hit = mgr.RaycastFirst(Vector2(0.0f, 100.0f), Vector2(300.0f, 100.0f));
+    TEST_ASSERT(hit && hit->collider == &circle && std::abs(hit->distance - 90.0f) < 0.01f,
+                "RaycastFirst: 円の表面までの距離を返すこと");
+
+    // 円の上を通るレイはカプセルの側面（x=195）に当たる
+    hit = mgr.RaycastFirst(Vector2(0.0f, 115.0f), Vector2(300.0f, 115.0f));
+    TEST_ASSERT(hit && hit->collider == &capsule && std::abs(hit->point.x - 195.0f) < 0.01f,
+                "RaycastFirst: カプセル側面の交点を返すこと");
+
+    // カプセル上端の丸みの外側を斜めに通るレイ
+    mgr.QueryLineSegment(Vector2(190.0f, 80.0f), Vector2(200.0f, 70.0f), results);
+    TEST_ASSERT(results.empty(), "QueryLineSegment: カプセル端の丸みの外側はヒットしないこと");
+
+    // SetSizeで矩形に戻る
+    mgr.SetSize(hc, 20.0f, 20.0f);
+    mgr.QueryPoint(Vector2(91.0f, 91.0f), results);
+    TEST_ASSERT(results.size() == 1, "SetSize後は矩形としてヒットすること");
+
+    mgr.Shutdown();
+}
+
+//----------------------------------------------------------------------------
+// Query テスト
+//----------------------------------------------------------------------------
+
+//! ランダムな線分を生成（ワールド外にはみ出すものを含む）
+static std::vector<LineSegment> MakeRandomSegments(size_t count, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> distX(-100.0f, 1100.0f);
+    std::uniform_real_distribution<float> distY(-100.0f, 850.0f);
+    std::uniform_real_distribution<float> distD(-200.0f, 200.0f);
+
+    std::vector<LineSegment> segments;
+    for (size_t i = 0; i < count; ++i) {
+        Vector2 a(distX(rng), distY(rng));
+        segments.emplace_back(a, Vector2(a.x + distD(rng), a.y + distD(rng)));
+    }
+    return segments;
+}
+
+//! バッチクエリと単発クエリの結果一致テスト
+static void TestQuery_BatchMatchesSingle()
+{
+    std::cout << "\n=== バッチクエリ / 単発クエリ一致テスト ===" << std::endl;
+
+    auto& mgr = CollisionManager::Get();
+    mgr.Initialize(64);
+    ColliderScene scene = CreateScene(800, 1024.0f, 768.0f, 99);
+    RegisterScene(scene, nullptr, nullptr);
+    mgr.Update(CollisionManager::GetFixedDeltaTime());
+
+    std::vector<LineSegment> segments = MakeRandomSegments(300, 5);
+    std::vector<AABB> boxes;
+    std::vector<Vector2> points;
+    for (const LineSegment& seg : segments) {
+        boxes.emplace_back((std::min)(seg.start.x, seg.end.x), (std::min)(seg.start.y, seg.end.y),
+                           std::abs(seg.end.x - seg.start.x), std::abs(seg.end.y - seg.start.y));
+        points.push_back(seg.start);
+    }
+
+    QueryBatchResult batch;
+    std::vector<Collider2D*> single;
+    auto matches = [&](auto&& runSingle) {
+        if (batch.GetQueryCount() != segments.size()) return false;
+        for (size_t i = 0; i < segments.size(); ++i) {
+            runSingle(i);
+            auto span = batch.Get(i);
+            std::vector<Collider2D*> fromBatch(span.begin(), span.end());
+            if (ToSortedIds(fromBatch) != ToSortedIds(single)) return false;
+        }
+        return true;
+    };
+
+    mgr.QueryAABBBatch(boxes, batch);
+    TEST_ASSERT(!batch.hits.empty(), "バッチAABBクエリが何かにヒットすること");
+    TEST_ASSERT(matches([&](size_t i) { mgr.QueryAABB(boxes[i], single); }),
+                "QueryAABBBatchの結果がQueryAABBと一致すること");
+
+    mgr.QueryPointBatch(points, batch);
+    TEST_ASSERT(matches([&](size_t i) { mgr.QueryPoint(points[i], single); }),
+                "QueryPointBatchの結果がQueryPointと一致すること");
+
+    mgr.QueryLineSegmentBatch(segments, batch);
+    TEST_ASSERT(matches([&](size_t i) { mgr.QueryLineSegment(segments[i].start, segments[i].end, single); }),
+                "QueryLineSegmentBatchの結果がQueryLineSegmentと一致すること");
+
+    // 複数セルにまたがるコライダーが重複しないこと
+    bool noDuplicates = true;
+    for (size_t i = 0; i < batch.GetQueryCount(); ++i) {
+        auto span = batch.Get(i);
+        std::vector<Collider2D*> sorted(span.begin(), span.end());
+        std::sort(sorted.begin(), sorted.end());
+        noDuplicates = noDuplicates && std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end();
+    }
+    TEST_ASSERT(noDuplicates, "バッチ結果にコライダーの重複がないこと");
+
+    std::vector<RaycastHit> rayHits;
+    mgr.RaycastFirstBatch(segments, rayHits);
+    bool raysMatch = rayHits.size() == segments.size();
+    for (size_t i = 0; raysMatch && i < segments.size(); ++i) {
+        auto hit = mgr.RaycastFirst(segments[i].start, segments[i].end);
+        raysMatch = hit ? (rayHits[i].collider == hit->collider && rayHits[i].distance == hit->distance)
+                        : rayHits[i].collider == nullptr;
+    }
+    TEST_ASSERT(raysMatch, "RaycastFirstBatchの結果がRaycastFirstと一致すること");
+
+    mgr.Shutdown();
+}
+
+//! クエリ結果がセルの走査順ではなくインデックス順になるテスト
+static void TestQuery_ResultsInIndexOrder()
+{
+    std::cout << "\n=== クエリ結果の順序テスト ===" << std::endl;
+
+    auto& mgr = CollisionManager::Get();
+    mgr.Initialize(64);
+
+    // 登録順と逆向き（右から左）に並べ、奇数番目を静的にして静止インデックスへ入れる
+    constexpr int kCount = 8;
+    Collider2D colliders[kCount];
+    std::vector<Collider2D*> expected;
+    for (int i = 0; i < kCount; ++i) {
+        ColliderHandle h = mgr.Register(&colliders[i]);
+        mgr.SetSize(h, 64.0f, 48.0f);
+        mgr.SetPosition(h, 480.0f - 60.0f * i, 32.0f);
+        if (i % 2) mgr.SetStatic(h, true);
+        expected.push_back(&colliders[i]);
+    }
+    mgr.Update(CollisionManager::GetFixedDeltaTime());
+    TEST_ASSERT(mgr.GetStaticCount() == kCount / 2, "静的コライダーが静止インデックスにいること");
+
+    std::vector<Collider2D*> results;
+    mgr.QueryAABB(AABB(0.0f, 0.0f, 600.0f, 64.0f), results);
+    TEST_ASSERT(results == expected, "QueryAABBの結果がインデックス順であること");
+    mgr.QueryLineSegment(Vector2(0.0f, 32.0f), Vector2(600.0f, 32.0f), results);
+    TEST_ASSERT(results == expected, "QueryLineSegmentの結果がインデックス順であること");
+    mgr.QueryCircle(Vector2(300.0f, 32.0f), 300.0f, results);
+    TEST_ASSERT(results == expected, "QueryCircleの結果がインデックス順であること");
+
+    // 起きている2番と静的な1番が重なる点
+    mgr.QueryPoint(Vector2(390.0f, 32.0f), results);
+    TEST_ASSERT(results.size() == 2 && results[0] == &colliders[1] && results[1] == &colliders[2],
+                "QueryPointの結果がインデックス順であること");
+
+    QueryBatchResult batch;
+    const AABB boxes[] = { AABB(0.0f, 0.0f, 600.0f, 64.0f) };
+    mgr.QueryAABBBatch(boxes, batch);
+    auto span = batch.Get(0);
+    TEST_ASSERT(std::vector<Collider2D*>(span.begin(), span.end()) == expected,
+                "バッチクエリの結果がインデックス順であること");
+
+    mgr.Shutdown();
+}
+
+//! バッチクエリが呼び出し側のバッファを再利用するテスト
+static void TestQuery_BatchReusesBuffers()
+{
+    std::cout << "\n=== バッチクエリ バッファ再利用テスト ===" << std::endl;
+
+    auto& mgr = CollisionManager::Get();
+    mgr.Initialize(64);
+    ColliderScene scene = CreateScene(500, 1024.0f, 768.0f, 3);
+    RegisterScene(scene, nullptr, nullptr);
+
+    std::vector<LineSegment> segments = MakeRandomSegments(200, 8);
+    QueryBatchResult batch;
+
+    // 同じ入力を繰り返し処理しても再確保されない
+    mgr.QueryLineSegmentBatch(segments, batch);
+    const Collider2D* const* hitsData = batch.hits.data();
+    const uint32_t* offsetsData = batch.offsets.data();
+    const size_t firstCount = batch.hits.size();
+
+    bool stable = true;
+    for (int i = 0; i < 10; ++i) {
+        mgr.QueryLineSegmentBatch(segments, batch);
+        stable = stable && batch.hits.data() == hitsData && batch.offsets.data() == offsetsData &&
+                 batch.hits.size() == firstCount;
+    }
+    TEST_ASSERT(firstCount > 0, "線分バッチクエリが何かにヒットすること");
+    TEST_ASSERT(stable, "2回目以降のバッチクエリで結果バッファが再確保されないこと");
+
+    // 空のバッチ
+    mgr.QueryLineSegmentBatch(std::span<const LineSegment>{}, batch);
+    TEST_ASSERT(batch.GetQueryCount() == 0 && batch.hits.empty(), "空のバッチでは結果が空になること");
+
+    mgr.Shutdown();
+}
+
+//----------------------------------------------------------------------------
+// Bullet テスト
+//----------------------------------------------------------------------------
+
+//! 1ステップで32pxの標的を飛び越える弾のすり抜けテスト
+static void TestBullet_NoTunneling()
+{
+    std::cout << "\n=== 弾丸 すり抜け防止テスト ===" << std::endl;
+
+    for (int mode = 0; mode < 2; ++mode) {
+        auto& mgr = CollisionManager::Get();
+        mgr.Initialize(64);
+        mgr.SetBroadphaseMode(mode == 0 ? BroadphaseMode::Grid : BroadphaseMode::SweepAndPrune);
+
+        for (int bullet = 0; bullet < 2; ++bullet) {
+            Collider2D arrow, target;
+            ColliderHandle ha = mgr.Register(&arrow);
+            ColliderHandle ht = mgr.Register(&target);
+            mgr.SetSize(ha, 20.0f, 10.0f);
+            mgr.SetSize(ht, 32.0f, 32.0f);
+            mgr.SetPosition(ha, 0.0f, 0.0f);
+            mgr.SetPosition(ht, 150.0f, 0.0f);
+            mgr.SetBullet(ha, bullet != 0);
+
+            int enters = 0, exits = 0;
+            mgr.SetOnCollisionEnter(ha, [&enters](Collider2D*, Collider2D*) { ++enters; });
+            mgr.SetOnCollisionExit(ha, [&exits](Collider2D*, Collider2D*) { ++exits; });
+
+            // 1ステップ100px（標的の手前 → 標的の先）
+            for (int step = 1; step <= 3; ++step) {
+                mgr.Update(CollisionManager::GetFixedDeltaTime());
+                mgr.SetPosition(ha, step * 100.0f, 0.0f);
+            }
+            mgr.Update(CollisionManager::GetFixedDeltaTime());
+
+            if (bullet) {
+                TEST_ASSERT(enters == 1 && exits == 1, "弾丸モードでは標的の通過でEnter/Exitが1回ずつ発生すること");
+            } else {
+                TEST_ASSERT(enters == 0, "通常モードでは高速な物体が標的をすり抜けること");
+            }
+            mgr.Unregister(ha);
+            mgr.Unregister(ht);
+        }
+
+        mgr.Shutdown();
+        mgr.SetBroadphaseMode(BroadphaseMode::Grid);
+    }
+}
+
+//! 1ステップで複数の標的を通過したとき、衝突時刻順にEnterが発火するテスト
+static void TestBullet_HitsInTimeOrder()
+{
+    std::cout << "\n=== 弾丸 衝突時刻順テスト ===" << std::endl;
+
+    auto& mgr = CollisionManager::Get();
+    mgr.Initialize(64);
+
+    // 登録順（インデックス順）と通過順が逆になるよう配置
+    Collider2D targets[3];
+    for (int i = 0; i < 3; ++i) {
+        ColliderHandle h = mgr.Register(&targets[i]);
+        mgr.SetSize(h, 16.0f, 16.0f);
+        mgr.SetPosition(h, 100.0f + 100.0f * i, 0.0f);
+    }
+
+    Collider2D arrow;
+    ColliderHandle ha = mgr.Register(&arrow);
+    mgr.SetSize(ha, 8.0f, 8.0f);
+    mgr.SetPosition(ha, 400.0f, 0.0f);
+    mgr.SetBullet(ha, true);
+
+    std::vector<Collider2D*> order;
+    mgr.SetOnCollisionEnter(ha, [&order](Collider2D*, Collider2D* other) { order.push_back(other); });
+
+    mgr.Update(CollisionManager::GetFixedDeltaTime());
+    TEST_ASSERT(order.empty(), "静止中の弾丸は何にも当たらないこと");
+
+    // 右から左へ一気に通過
+    mgr.SetPosition(ha, 0.0f, 0.0f);
+    mgr.Update(CollisionManager::GetFixedDeltaTime());
+
+    TEST_ASSERT(order.size() == 3, "通過した全ての標的でEnterが発生すること");
+    TEST_ASSERT(order.size() == 3 && order[0] == &targets[2] && order[1] == &targets[1] && order[2] == &targets[0],
+                "Enterが衝突時刻順（近い順）に発火すること");
+
+    mgr.Shutdown();
+}
+
+//! 登録直後の弾丸が原点からの掃引で誤検出しないテスト
+static void TestBullet_FirstStepIsDiscrete()
+{
+    std::cout << "\n=== 弾丸 初回ステップテスト ===" << std::endl;
+
+    auto& mgr = CollisionManager::Get();
+    mgr.Initialize(64);
+
+    Collider2D wall, arrow;
+    ColliderHandle hw = mgr.Register(&wall);
+    mgr.SetSize(hw, 32.0f, 32.0f);
+    mgr.SetPosition(hw, 250.0f, 0.0f);
+
+    ColliderHandle ha = mgr.Register(&arrow);
+    mgr.SetSize(ha, 20.0f, 10.0f);
+    mgr.SetBullet(ha, true);
+    mgr.SetPosition(ha, 500.0f, 0.0f);
+
+    int enters = 0;
+    mgr.SetOnCollisionEnter(ha, [&enters](Collider2D*, Collider2D*) { ++enters; });
+    mgr.Update(CollisionManager::GetFixedDeltaTime());
+
+    TEST_ASSERT(mgr.IsBullet(ha), "弾丸フラグが設定されること");
+    TEST_ASSERT(enters == 0, "登録直後は前回位置が無いため掃引判定しないこと");
+
+    mgr.Shutdown();
+}
+
+//----------------------------------------------------------------------------
+// Contact テスト
+//----------------------------------------------------------------------------
+
+//! 接触イベント列がコールバックと同じEnter/Stay/Exitを出力するテスト
+static void TestContact_StreamMatchesCallbacks()
+{
+    std::cout << "\n=== 接触イベント列 / コールバック一致テスト ===" << std::endl;
+
+    auto callbacks = RunSimulation(BroadphaseMode::Grid, 600, 40, 4321);
+    auto stream = RunSimulation(BroadphaseMode::Grid, 600, 40, 4321, false, 1, true);
+
+    TEST_ASSERT(!callbacks.empty(), "コールバックでイベントが発生すること");
+    TEST_ASSERT(callbacks == stream, "イベント列の内容がコールバックと一致すること");
+}
+
+//! イベント列のクリア・レイヤー絞り込み・コールバック停止のテスト
+static void TestContact_StreamLifetimeAndFilter()
+{
+    std::cout << "\n=== 接触イベント列 寿命・絞り込みテスト ===" << std::endl;
+
+    auto& mgr = CollisionManager::Get();
+    mgr.Initialize(64);
+    mgr.SetCallbacksEnabled(false);
+
+    Collider2D player, enemy, arrow;
+    ColliderHandle hp = mgr.Register(&player);
+    ColliderHandle he = mgr.Register(&enemy);
+    ColliderHandle ha = mgr.Register(&arrow);
+    mgr.SetLayer(hp, 0x01);
+    mgr.SetLayer(he, 0x04);
+    mgr.SetLayer(ha, 0x08);
+    for (ColliderHandle h : { hp, he, ha }) {
+        mgr.SetSize(h, 32.0f, 32.0f);
+        mgr.SetPosition(h, 0.0f, 0.0f);
+    }
+
+    int calls = 0;
+    mgr.SetOnCollisionEnter(hp, [&calls](Collider2D*, Collider2D*) { ++calls; });
+
+    // 2ステップ分まとめて進めると両ステップのイベントが残る
+    mgr.Update(CollisionManager::GetFixedDeltaTime() * 2.0f + 0.0001f);
+    auto events = mgr.GetContactEvents();
+    auto countType = [&](ContactType type) {
+        return std::count_if(events.begin(), events.end(), [type](const ContactEvent& e) { return e.type == type; });
+    };
+    TEST_ASSERT(countType(ContactType::Enter) == 3 && countType(ContactType::Stay) == 3,
+                "1回のUpdateで実行した全ステップのイベントが残ること");
+    TEST_ASSERT(calls == 0, "コールバック無効時は呼ばれないこと");
+
+    auto playerEnemy = std::count_if(events.begin(), events.end(),
+        [](const ContactEvent& e) { return e.type == ContactType::Enter && e.Matches(0x04, 0x01); });
+    TEST_ASSERT(playerEnemy == 1, "レイヤーの組み合わせで絞り込めること");
+
+    bool ordered = std::all_of(events.begin(), events.end(),
+        [](const ContactEvent& e) { return e.a.index < e.b.index; });
+    TEST_ASSERT(ordered, "aが常にインデックスの小さい側であること");
+
+    // ステップが走らないUpdateではクリアのみ
+    mgr.Update(0.0f);
+    TEST_ASSERT(mgr.GetContactEvents().empty(), "次のUpdateの開始時にクリアされること");
+
+    mgr.SetCallbacksEnabled(true);
+    mgr.SetPosition(hp, 500.0f, 0.0f);
+    mgr.Update(CollisionManager::GetFixedDeltaTime());
+    mgr.SetPosition(hp, 0.0f, 0.0f);
+    mgr.Update(CollisionManager::GetFixedDeltaTime());
+    TEST_ASSERT(calls == 2, "コールバック有効に戻すとイベント列から配信されること");
+
+    mgr.Shutdown();
+}
+
+//----------------------------------------------------------------------------
+// Sleep テスト
+//----------------------------------------------------------------------------
+
+//! 止まったり動いたりするコライダー群でシミュレーションしイベント列を取得
+//! @param sleepThreshold スリープまでのステップ数（0でスリープ無効）
+//! @param useStatic trueなら動かない一部のコライダーを静的にする
+//! @param[out] restedPeak 静止インデックスにいたコライダー数の最大値（省略可）
+static std::vector<RecordedEvent> RunIdleSimulation(BroadphaseMode mode, bool dense,
+                                                    uint32_t sleepThreshold, bool useStatic,
+                                                    size_t* restedPeak = nullptr)
+{
+    constexpr int kCount = 500;
+    constexpr int kSteps = 120;
+
+    auto& mgr = CollisionManager::Get();
+    mgr.Initialize(64);
+    mgr.SetBroadphaseMode(mode);
+    mgr.SetSleepThreshold(sleepThreshold);
+    if (dense) {
+        mgr.SetWorldBounds(AABB(0.0f, 0.0f, 600.0f, 600.0f));
+    }
+
+    std::vector<RecordedEvent> events;
+    int step = 0;
+    ColliderScene scene = CreateScene(kCount, 600.0f, 600.0f, 555);
+    RegisterScene(scene, &events, &step);
+    for (int i = 0; useStatic && i < kCount; i += 5) {
+        mgr.SetStatic(scene.handles[i], true);
+    }
+
+    for (step = 0; step < kSteps; ++step) {
+        for (int i = 0; i < kCount; ++i) {
+            // 5の倍数は常に静止、それ以外は区間毎に動いたり止まったりする
+            bool moving = (i % 5) != 0 && ((step / 15 + i) % 3) == 0;
+            if (!moving) continue;
+            scene.positions[i] += scene.velocities[i];
+            mgr.SetPosition(scene.handles[i], scene.positions[i].x, scene.positions[i].y);
+        }
+
+        // 途中でスリープ中のコライダーを無効化・レイヤー変更して起こす
+        if (step == kSteps / 2) {
+            for (int i = 1; i < kCount; i += 13) mgr.SetEnabled(scene.handles[i], false);
+            for (int i = 2; i < kCount; i += 17) mgr.SetLayer(scene.handles[i], 0x02);
+            for (int i = 5; i < kCount; i += 35) mgr.Unregister(scene.handles[i]);
+        }
+
+        mgr.Update(CollisionManager::GetFixedDeltaTime());
+        if (restedPeak) *restedPeak = (std::max)(*restedPeak, mgr.GetSleepingCount() + mgr.GetStaticCount());
+    }
+
+    mgr.Shutdown();
+    mgr.SetBroadphaseMode(BroadphaseMode::Grid);
+    mgr.SetSleepThreshold(CollisionConstants::kDefaultSleepSteps);
+    mgr.ClearWorldBounds();
+
+    std::sort(events.begin(), events.end());
+    return events;
+}
+
+//! スリープ/静的の有無でイベントが変わらないテスト
+static void TestSleep_MatchesAlwaysAwake()
+{
+    std::cout << "\n=== スリープ / 常時判定 一致テスト ===" << std::endl;
+
+    auto reference = RunIdleSimulation(BroadphaseMode::Grid, false, 0, false);
+    TEST_ASSERT(!reference.empty(), "イベントが発生すること");
+    size_t restedPeak = 0;
+    TEST_ASSERT(RunIdleSimulation(BroadphaseMode::Grid, false, 5, true, &restedPeak) == reference,
+                "空間ハッシュ: スリープ/静的ありでもイベントが一致すること");
+    TEST_ASSERT(restedPeak > 250, "シミュレーション中に多数のコライダーが静止すること");
+    TEST_ASSERT(RunIdleSimulation(BroadphaseMode::Grid, true, 5, true) == reference,
+                "密グリッド: スリープ/静的ありでもイベントが一致すること");
+    TEST_ASSERT(RunIdleSimulation(BroadphaseMode::SweepAndPrune, false, 5, true) == reference,
+                "Sweep and Prune: スリープ/静的ありでもイベントが一致すること");
+}
+
+//! 内訳カウンターと、静止中コライダーへのクエリのテスト
+static void TestSleep_CountersAndQueries()
+{
+    std::cout << "\n=== スリープ 内訳・クエリテスト ===" << std::endl;
+
+    auto& mgr = CollisionManager::Get();
+    mgr.Initialize(64);
+    mgr.SetSleepThreshold(10);
+
+    std::vector<std::unique_ptr<Collider2D>> colliders;
+    std::vector<ColliderHandle> handles;
+    for (int i = 0; i < 35; ++i) {
+        colliders.push_back(std::make_unique<Collider2D>());
+        ColliderHandle h = mgr.Register(colliders.back().get());
+        mgr.SetSize(h, 16.0f, 16.0f);
+        mgr.SetPosition(h, 40.0f * i, 0.0f);
+        if (i < 10) mgr.SetStatic(h, true);  // 壁
+        handles.push_back(h);
+    }
+
+    // 30-34は毎ステップ動く
+    for (int step = 0; step < 20; ++step) {
+        for (int i = 30; i < 35; ++i) {
+            mgr.SetPosition(handles[i], 40.0f * i, static_cast<float>(step));
+        }
+        mgr.Update(CollisionManager::GetFixedDeltaTime());
+    }
+
+    TEST_ASSERT(mgr.GetStaticCount() == 10, "静的コライダー数が集計されること");
+    TEST_ASSERT(mgr.GetSleepingCount() == 20, "変化の無い動的コライダーがスリープすること");
+    TEST_ASSERT(mgr.GetAwakeCount() == 5, "動いているコライダーは起きていること");
+    TEST_ASSERT(mgr.IsSleeping(handles[15]) && mgr.IsStatic(handles[0]), "状態を個別に取得できること");
+
+    std::vector<Collider2D*> results;
+    mgr.QueryPoint(Vector2(0.0f, 0.0f), results);
+    TEST_ASSERT(results.size() == 1 && results[0] == colliders[0].get(), "静的コライダーがクエリにヒットすること");
+    mgr.QueryAABB(AABB(590.0f, -10.0f, 60.0f, 20.0f), results);
+    TEST_ASSERT(results.size() == 2, "スリープ中のコライダーがクエリにヒットすること");
+
+    // 同じ値の再設定では起きず、変化すると起きる
+    mgr.SetPosition(handles[15], 600.0f, 0.0f);
+    TEST_ASSERT(mgr.IsSleeping(handles[15]), "同じ位置の再設定ではスリープしたままであること");
+    mgr.SetPosition(handles[15], 600.0f, 1.0f);
+    TEST_ASSERT(!mgr.IsSleeping(handles[15]), "位置が変わると起きること");
+    mgr.SetSize(handles[16], 20.0f, 20.0f);
+    TEST_ASSERT(!mgr.IsSleeping(handles[16]), "サイズが変わると起きること");
+
+    mgr.Update(CollisionManager::GetFixedDeltaTime());
+    TEST_ASSERT(mgr.GetAwakeCount() == 7 && mgr.GetSleepingCount() == 18, "起きたコライダーが内訳に反映されること");
+
+    mgr.Shutdown();
+}
+
+//! 重なったまま静止したペアがStayを出し続けるテスト
+static void TestSleep_RestedPairsStay()
+{
+    std::cout << "\n=== スリープ Stay継続テスト ===" << std::endl;
+
+    auto& mgr = CollisionManager::Get();
+    mgr.Initialize(64);
+    mgr.SetSleepThreshold(5);
+
+    Collider2D a, b, wall;
+    ColliderHandle ha = mgr.Register(&a);
+    ColliderHandle hb = mgr.Register(&b);
+    ColliderHandle hw = mgr.Register(&wall);
+    for (ColliderHandle h : { ha, hb, hw }) mgr.SetSize(h, 32.0f, 32.0f);
+    mgr.SetPosition(ha, 0.0f, 0.0f);
+    mgr.SetPosition(hb, 10.0f, 0.0f);
+    mgr.SetPosition(hw, 20.0f, 0.0f);
+    mgr.SetStatic(hw, true);
+
+    int stays = 0, exits = 0;
+    mgr.SetOnCollision(ha, [&stays](Collider2D*, Collider2D*) { ++stays; });
+    mgr.SetOnCollisionExit(ha, [&exits](Collider2D*, Collider2D*) { ++exits; });
+
+    constexpr int kSteps = 60;
+    for (int i = 0; i < kSteps; ++i) {
+        mgr.Update(CollisionManager::GetFixedDeltaTime());
+    }
+
+    TEST_ASSERT(mgr.GetSleepingCount() == 2 && mgr.GetStaticCount() == 1, "全てが静止していること");
+    TEST_ASSERT(stays == kSteps * 2, "静止後もStayが毎ステップ発火すること");
+    TEST_ASSERT(exits == 0, "静止してもExitが発生しないこと");
+
+    // 起こして離すとExit
+    mgr.SetPosition(ha, -500.0f, 0.0f);
+    mgr.Update(CollisionManager::GetFixedDeltaTime());
+    TEST_ASSERT(exits == 2, "起きて離れたらExitが発生すること");
+
+    mgr.Shutdown();
+    mgr.SetSleepThreshold(CollisionConstants::kDefaultSleepSteps);
+}
+
+//! 静止中にセルサイズ/ワールド範囲を変えても静的コライダーを見失わないテスト
+static void TestSleep_CellSizeChange()
+{
+    std::cout << "\n=== スリープ セルサイズ変更テスト ===" << std::endl;
+
+    auto& mgr = CollisionManager::Get();
+    for (bool dense : { false, true }) {
+        for (int newCellSize : { 16, 512 }) {
+            mgr.Initialize(64);
+            if (dense) mgr.SetWorldBounds(AABB(0.0f, 0.0f, 1024.0f, 1024.0f));
+
+            Collider2D wall, mover;
+            ColliderHandle hw = mgr.Register(&wall);
+            ColliderHandle hm = mgr.Register(&mover);
+            mgr.SetSize(hw, 32.0f, 32.0f);
+            mgr.SetSize(hm, 32.0f, 32.0f);
+            mgr.SetPosition(hw, 100.0f, 100.0f);
+            mgr.SetPosition(hm, 700.0f, 700.0f);
+            mgr.SetStatic(hw, true);
+
+            int enters = 0;
+            mgr.SetOnCollisionEnter(hm, [&enters](Collider2D*, Collider2D*) { ++enters; });
+            // 1ステップ目で静止し、2ステップ目で静止インデックスが構築される
+            mgr.Update(CollisionManager::GetFixedDeltaTime());
+            mgr.Update(CollisionManager::GetFixedDeltaTime());
+
+            // 静止インデックスが古いセルサイズのまま残っていると、ここで見失う
+            mgr.SetCellSize(newCellSize);
+            mgr.SetPosition(hm, 110.0f, 110.0f);
+            mgr.Update(CollisionManager::GetFixedDeltaTime());
+
+            std::vector<Collider2D*> results;
+            mgr.QueryPoint(Vector2(100.0f, 100.0f), results);
+            bool found = enters == 1 && results.size() == 2 && mgr.IsSleeping(hw);
+            if (dense) {
+                TEST_ASSERT(found, "密グリッド: セルサイズ変更後も静的コライダーとのペアとクエリが見つかること");
+            } else {
+                TEST_ASSERT(found, "空間ハッシュ: セルサイズ変更後も静的コライダーとのペアとクエリが見つかること");
+            }
+
+            mgr.Shutdown();
+            mgr.ClearWorldBounds();
+        }
+    }
+    mgr.SetCellSize(CollisionConstants::kDefaultCellSize);
+}
+
+//----------------------------------------------------------------------------
+// Handle テスト
+//----------------------------------------------------------------------------
+
+//! 同じスロットを繰り返し再利用しても古いハンドルが蘇らないテスト
+static void TestHandle_StaleHandleNeverRevives()
+{
+    std::cout << "\n=== 古いハンドル無効化テスト ===" << std::endl;
+
+    auto& mgr = CollisionManager::Get();
+    mgr.Initialize(64);
+
+    Collider2D collider;
+    ColliderHandle first = mgr.Register(&collider);
+    mgr.Unregister(first);
+
+    // 世代の一巡を超える回数だけ登録/解除を繰り返す
+    constexpr size_t kCycles = static_cast<size_t>(UINT16_MAX) * 2 + 10;
+    bool revived = false;
+    bool allValid = true;
+    for (size_t i = 0; i < kCycles; ++i) {
+        ColliderHandle h = mgr.Register(&collider);
+        allValid = allValid && mgr.IsValid(h);
+        revived = revived || mgr.IsValid(first);
+        mgr.Unregister(h);
+    }
+
+    TEST_ASSERT(allValid, "再登録したハンドルが毎回有効であること");
+    TEST_ASSERT(!revived, "世代が一巡しても最初のハンドルが有効に戻らないこと");
+    TEST_ASSERT(mgr.GetColliderCount() == 0, "全解除後のコライダー数が0であること");
+
+    mgr.Shutdown();
+}
+
+//! 100万コライダーの登録/解除ストレステスト
+static void TestHandle_MillionColliderStress()
+{
+    std::cout << "\n=== 100万コライダー ストレステスト ===" << std::endl;
+
+    constexpr size_t kTotal = 1000000;
+
+    auto& mgr = CollisionManager::Get();
+    mgr.Initialize(64);
+
+    // 同時登録数はハンドル幅の上限まで
+    const size_t batch = (std::min)(kTotal, CollisionConstants::kMaxColliders);
+    std::vector<Collider2D> colliders(batch);
+    std::vector<ColliderHandle> handles;
+    handles.reserve(batch);
+
+    size_t registered = 0;
+    bool allValid = true;
+    while (registered < kTotal) {
+        size_t n = (std::min)(batch, kTotal - registered);
+        for (size_t i = 0; i < n; ++i) {
+            ColliderHandle h = mgr.Register(&colliders[i]);
+            allValid = allValid && mgr.IsValid(h);
+            mgr.SetSize(h, 4.0f, 4.0f);
+            mgr.SetPosition(h, static_cast<float>(i % 1024) * 8.0f, static_cast<float>(i / 1024) * 8.0f);
+            handles.push_back(h);
+        }
+        if (registered == 0) {
+            TEST_ASSERT(mgr.GetColliderCount() == n, "バッチ登録後のコライダー数が一致すること");
+            mgr.Update(CollisionManager::GetFixedDeltaTime());
+        }
+        for (ColliderHandle h : handles) {
+            mgr.Unregister(h);
+        }
+        handles.clear();
+        registered += n;
+    }
+
+    TEST_ASSERT(allValid, "100万回の登録で全ハンドルが有効であること");
+    TEST_ASSERT(mgr.GetColliderCount() == 0, "全解除後のコライダー数が0であること");
+
+#if COLLISION_LARGE_HANDLES
+    TEST_ASSERT(batch == kTotal, "32bitハンドルでは100万コライダーを同時に登録できること");
+#else
+    // 上限を超えた登録は無効ハンドルを返す
+    for (size_t i = 0; i < batch; ++i) {
+        handles.push_back(mgr.Register(&colliders[i]));
+    }
+    Collider2D overflow;
+    TEST_ASSERT(!mgr.Register(&overflow).IsValid(), "16bitハンドルでは上限を超えた登録が無効ハンドルを返すこと");
+#endif
+
+    mgr.Shutdown();
+}
+
+//----------------------------------------------------------------------------
+// ベンチマーク
+//----------------------------------------------------------------------------
+
+//! ブロードフェーズのステップ時間を計測
+//! @param mode ブロードフェーズ方式
+//! @param count コライダー数
+//! @return 1ステップあたりの平均時間（ミリ秒）
+static double MeasureStep(BroadphaseMode mode, int count, bool dense = false, uint32_t workers = 1)
+{
+    constexpr int kWarmup = 5;
+    constexpr int kSteps = 120;
+
+    auto& mgr = CollisionManager::Get();
+    mgr.Initialize(64);
+    mgr.SetBroadphaseMode(mode);
+    mgr.SetWorkerCount(workers);
+    if (dense) {
+        mgr.SetWorldBounds(AABB(0.0f, 0.0f, 5120.0f, 2880.0f));
+    }
+
+    ColliderScene scene = CreateScene(count, 5120.0f, 2880.0f, 42);
+    RegisterScene(scene, nullptr, nullptr);
+
+    for (int i = 0; i < kWarmup; ++i) {
+        MoveScene(scene);
+        mgr.Update(CollisionManager::GetFixedDeltaTime());
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < kSteps; ++i) {
+        MoveScene(scene);
+        mgr.Update(CollisionManager::GetFixedDeltaTime());
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    mgr.Shutdown();
+    mgr.SetBroadphaseMode(BroadphaseMode::Grid);
+    mgr.ClearWorldBounds();
+
+    return std::chrono::duration<double, std::milli>(end - begin).count() / kSteps;
+}
+
+//! グリッドとSweep and Pruneの比較ベンチマーク
+static void BenchmarkBroadphase()
+{
+    std::cout << "\n=== ブロードフェーズ ベンチマーク (5120x2880, 32px) ===" << std::endl;
+
+    for (int count : { 1000, 2000, 5000, 10000 }) {
+        double grid = MeasureStep(BroadphaseMode::Grid, count);
+        double dense = MeasureStep(BroadphaseMode::Grid, count, true);
+        double sap = MeasureStep(BroadphaseMode::SweepAndPrune, count);
+        std::cout << "  " << count << " colliders: Grid " << grid << " ms, DenseGrid " << dense
+                  << " ms, SAP " << sap << " ms" << std::endl;
+    }
+}
+
+//! 並列ペア収集のスケーリングベンチマーク
+static void BenchmarkParallel()
+{
+    uint32_t maxThreads = (std::max)(1u, std::thread::hardware_concurrency());
+    std::cout << "\n=== 並列ペア収集 ベンチマーク (密グリッド, 最大 " << maxThreads << " スレッド) ===" << std::endl;
+
+    for (int count : { 1000, 5000, 10000, 25000, 50000 }) {
+        std::cout << "  " << count << " colliders:";
+        for (uint32_t threads = 1; threads <= maxThreads; threads *= 2) {
+            std::cout << "  " << threads << "T " << MeasureStep(BroadphaseMode::Grid, count, true, threads) << " ms";
+        }
+        std::cout << std::endl;
+    }
+}
+
+//! SIMDカーネルのマイクロベンチマーク
+static void BenchmarkSimdKernel()
+{
+    std::cout << "\n=== 重なり判定カーネル ベンチマーク ===" << std::endl;
+
+    std::mt19937 rng(7);
+    CollisionSimd::CandidateBlock block;
+    std::vector<uint32_t> out;
+
+    for (size_t count : { 8, 32, 128, 512 }) {
+        FillRandomBlock(block, count, rng);
+        out.assign(count, 0);
+        const size_t iterations = 4000000 / count;
+
+        auto measure = [&](auto kernel) {
+            size_t sink = 0;
+            auto begin = std::chrono::steady_clock::now();
+            for (size_t it = 0; it < iterations; ++it) {
+                CollisionSimd::Probe probe;
+                size_t p = it % count;
+                probe.posX = block.posX[p];
+                probe.posY = block.posY[p];
+                probe.halfW = block.halfW[p];
+                probe.halfH = block.halfH[p];
+                probe.layer = block.layer[p];
+                probe.mask = block.mask[p];
+                sink += kernel(probe, block, 0, count, out.data());
+            }
+            auto end = std::chrono::steady_clock::now();
+            double ns = std::chrono::duration<double, std::nano>(end - begin).count();
+            return std::make_pair(ns / static_cast<double>(iterations * count), sink);
+        };
+
+        auto scalar = measure(CollisionSimd::OverlapBlockScalar);
+        std::cout << "  block " << count << ": scalar " << scalar.first << " ns/test";
+#if COLLISION_SIMD
+        auto simd = measure(CollisionSimd::OverlapBlockSimd);
+        std::cout << ", simd " << simd.first << " ns/test";
+#endif
+        std::cout << std::endl;
+    }
+}
+
+//! 大半が止まっているシーンでのスリープ有無の比較ベンチマーク
+static void BenchmarkSleep()
+{
+    std::cout << "\n=== スリープ ベンチマーク (5120x2880, 32px, 1割のみ移動) ===" << std::endl;
+
+    constexpr int kSteps = 120;
+
+    for (int count : { 2000, 5000, 10000 }) {
+        std::cout << "  " << count << " colliders:";
+        for (uint32_t threshold : { 0u, CollisionConstants::kRecommendedSleepSteps }) {
+            auto& mgr = CollisionManager::Get();
+            mgr.Initialize(64);
+            mgr.SetSleepThreshold(threshold);
+
+            ColliderScene scene = CreateScene(count, 5120.0f, 2880.0f, 42);
+            RegisterScene(scene, nullptr, nullptr);
+
+            auto stepMoving = [&]() {
+                for (size_t i = 0; i < scene.handles.size(); i += 10) {
+                    scene.positions[i] += scene.velocities[i];
+                    mgr.SetPosition(scene.handles[i], scene.positions[i].x, scene.positions[i].y);
+                }
+                mgr.Update(CollisionManager::GetFixedDeltaTime());
+            };
+
+            // スリープに入るまで進めてから計測
+            for (uint32_t i = 0; i <= CollisionConstants::kRecommendedSleepSteps; ++i) stepMoving();
+
+            auto begin = std::chrono::steady_clock::now();
+            for (int i = 0; i < kSteps; ++i) stepMoving();
+            auto end = std::chrono::steady_clock::now();
+
+            std::cout << (threshold == 0 ? "  always awake " : "  sleep ")
+                      << std::chrono::duration<double, std::milli>(end - begin).count() / kSteps << " ms"
+                      << " (awake " << mgr.GetAwakeCount() << ")";
+            mgr.Shutdown();
+        }
+        std::cout << std::endl;
+    }
+    CollisionManager::Get().SetSleepThreshold(CollisionConstants::kDefaultSleepSteps);
+}
+
+//----------------------------------------------------------------------------
+// 公開インターフェース
+//----------------------------------------------------------------------------
+
+//! 衝突判定テストスイートを実行
+//! @param runBenchmarks ベンチマークも実行するか
+//! @return 全テスト成功時true、それ以外false
+bool RunCollisionTests(bool runBenchmarks)
+{
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "  衝突判定 テスト" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    ResetGlobalCounters();
+
+    // Broadphaseテスト
+    TestBroadphase_SweepAndPruneMatchesGrid();
+    TestBroadphase_TouchingIsNotOverlap();
+
+    // DenseGridテスト
+    TestDenseGrid_MatchesHashGrid();
+    TestDenseGrid_QueriesMatchHashGrid();
+
+    // Parallelテスト
+    TestParallel_MatchesSingleThread();
+    TestParallel_CallbacksOnCallingThread();
+
+    // Simdテスト
+    TestSimd_MatchesScalar();
+
+    // Shapeテスト
+    TestShape_PairOverlaps();
+    TestShape_BroadphaseMatchesBruteForce();
+    TestShape_Queries();
+
+    // Queryテスト
+    TestQuery_BatchMatchesSingle();
+    TestQuery_ResultsInIndexOrder();
+    TestQuery_BatchReusesBuffers();
+
+    // Bulletテスト
+    TestBullet_NoTunneling();
+    TestBullet_HitsInTimeOrder();
+    TestBullet_FirstStepIsDiscrete();
+
+    // Contactテスト
+    TestContact_StreamMatchesCallbacks();
+    TestContact_StreamLifetimeAndFilter();
+
+    // Sleepテスト
+    TestSleep_MatchesAlwaysAwake();
+    TestSleep_CountersAndQueries();
+    TestSleep_RestedPairsStay();
+    TestSleep_CellSizeChange();
+
+    // Handleテスト
+    TestHandle_StaleHandleNeverRevives();
+    TestHandle_MillionColliderStress();
+
+    // ベンチマーク（--bench指定時のみ）
+    if (runBenchmarks) {
+        BenchmarkBroadphase();
+        BenchmarkParallel();
+        BenchmarkSimdKernel();
+        BenchmarkSleep();
+    }
+
+    std::cout << "\n----------------------------------------" << std::endl;
+    std::cout << "衝突判定テスト: " << s_passCount << "/" << s_testCount << " 成功" << std::endl;
+    std::cout << "----------------------------------------" << std::endl;
+
+    return s_passCount == s_testCount;
+}
+
+} // namespace tests
@@ -0,0 +1,15 @@
+//----------------------------------------------------------------------------
+//! @file   test_collision.h
+//! @brief  CollisionManager test declarations
+//----------------------------------------------------------------------------
+#pragma once
+
+namespace tests {
+
+//! Run all collision tests
+//! @param [in] runBenchmarks Also run timing benchmarks
+//! @return true if all tests passed
+//! @note Does not require D3D11 device
+bool RunCollisionTests(bool runBenchmarks = false);
+
+} // namespace tests
@@ -0,0 +1,469 @@
+//----------------------------------------------------------------------------
+//! @file   test_command_buffer.cpp
+//! @brief  コマンドバッファ テストスイート
+//!
+//! @details
+//! CommandBufferの記録・再生とnullバックエンド、
+//! GraphicsContextのシャドウステートキャッシュのテストを提供します。
+//!
+//! テストカテゴリ:
+//! - Replay: 記録順の再生と描画時ステート
+//! - Filter: 冗長バインドの除外・Invalidate・追跡外スロット
+//! - Payload: 定数バッファ更新・バッファ書き込みのデータ
+//! - Equivalence: ランダムなコマンド列で、除外の有無により描画時ステートが変わらないか
+//! - StateCache: 発行/省略の判定・分類ごとの統計・出力変更時の無効化
+//! - Benchmark: スプライト描画相当のコマンド列の記録・再生時間
+//!
+//! @note D3D11デバイスは不要
+//----------------------------------------------------------------------------
+#include "test_command_buffer.h"
+#include "test_common.h"
+#include "dx11/command_buffer.h"
+#include "dx11/state_cache.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace tests {
+
+//----------------------------------------------------------------------------
+// テストユーティリティ（共通ヘッダーから使用）
+//----------------------------------------------------------------------------
+
+// グローバルカウンターを使用（後方互換性のため）
+#define s_testCount tests::GetGlobalTestCount()
+#define s_passCount tests::GetGlobalPassCount()
+
+//----------------------------------------------------------------------------
+// ヘルパー
+//----------------------------------------------------------------------------
+
+//! テスト用のダミーオブジェクトポインタ（参照はしない）
+template<typename T>
+static T* Fake(uintptr_t id)
+{
+    return reinterpret_cast<T*>(id * 64);
+}
+
+constexpr uint32_t kTriangleList = 4;   // D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST
+constexpr uint32_t kTriangleStrip = 5;  // D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP
+constexpr uint32_t kR32Uint = 42;       // DXGI_FORMAT_R32_UINT
+constexpr uint32_t kWriteDiscard = 4;   // D3D11_MAP_WRITE_DISCARD
+
+//! SpriteBatch::BindVertexPipeline相当のバインド
+static void BindSpritePipeline(ICommandBackend& out, Buffer* vertexBuffer)
+{
+    out.SetInputLayout(Fake<ID3D11InputLayout>(1));
+    out.SetPrimitiveTopology(kTriangleList);
+    out.SetVertexBuffer(0, vertexBuffer, 24);
+    out.SetIndexBuffer(Fake<Buffer>(2), kR32Uint);
+    out.SetShader(ShaderType::Vertex, Fake<Shader>(1));
+    out.SetConstantBuffer(ShaderType::Vertex, 0, Fake<Buffer>(3));
+    out.SetShader(ShaderType::Pixel, Fake<Shader>(2));
+    out.SetSampler(ShaderType::Pixel, 0, Fake<SamplerState>(1));
+    out.SetBlendState(Fake<BlendState>(1));
+    out.SetDepthStencilState(Fake<DepthStencilState>(1));
+    out.SetRasterizerState(Fake<RasterizerState>(1));
+}
+
+//! 描画時ステートが一致するか
+static bool SameDraws(const std::vector<NullCommandBackend::DrawRecord>& a,
+                      const std::vector<NullCommandBackend::DrawRecord>& b)
+{
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        const auto& x = a[i];
+        const auto& y = b[i];
+        if (x.type != y.type || x.count != y.count || x.instanceCount != y.instanceCount ||
+            x.start != y.start || x.baseVertex != y.baseVertex || x.startInstance != y.startInstance ||
+            x.vertexShader != y.vertexShader || x.pixelShader != y.pixelShader ||
+            x.texture != y.texture || x.vertexBuffer != y.vertexBuffer || x.blendState != y.blendState) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------
+// Replayテスト
+//----------------------------------------------------------------------------
+
+//! 記録した順に再生され、描画時のステートが正しいか
+static void TestReplay_Order()
+{
+    std::cout << "\n=== Replay: 記録順の再生 ===" << std::endl;
+
+    CommandBuffer commands;
+    BindSpritePipeline(commands, Fake<Buffer>(10));
+    commands.SetShaderResource(ShaderType::Pixel, 0, Fake<Texture>(1));
+    commands.DrawIndexed(12, 0, 0);
+    commands.SetShaderResource(ShaderType::Pixel, 0, Fake<Texture>(2));
+    commands.DrawIndexed(6, 12, 0);
+    commands.DrawInstanced(4, 100, 0, 7);
+
+    NullCommandBackend capture;
+    commands.Submit(capture);
+
+    TEST_ASSERT(capture.GetTrace().size() == commands.GetStats().recorded, "記録数と再生数が一致");
+    TEST_ASSERT(capture.GetTrace().front() == CommandType::SetInputLayout, "先頭は最初に記録したコマンド");
+    TEST_ASSERT(capture.GetTrace().back() == CommandType::DrawInstanced, "末尾は最後に記録したコマンド");
+    TEST_ASSERT(capture.GetCount(CommandType::DrawIndexed) == 2 && commands.GetStats().draws == 3, "描画数");
+
+    const auto& draws = capture.GetDraws();
+    TEST_ASSERT(draws.size() == 3, "描画記録数");
+    TEST_ASSERT(draws[0].texture == Fake<Texture>(1) && draws[1].texture == Fake<Texture>(2),
+                "描画ごとのテクスチャ");
+    TEST_ASSERT(draws[1].count == 6 && draws[1].start == 12, "インデックス範囲");
+    TEST_ASSERT(draws[2].instanceCount == 100 && draws[2].startInstance == 7, "インスタンス範囲");
+    TEST_ASSERT(draws[0].vertexBuffer == Fake<Buffer>(10) && draws[0].vertexShader == Fake<Shader>(1),
+                "パイプラインのステート");
+
+    // 2回再生しても同じ
+    NullCommandBackend again;
+    commands.Submit(again);
+    TEST_ASSERT(again.GetTrace() == capture.GetTrace(), "再生は記録内容を変えない");
+
+    commands.Reset();
+    TEST_ASSERT(commands.IsEmpty() && commands.GetStats().recorded == 0, "Reset()で空になる");
+}
+
+//----------------------------------------------------------------------------
+// Filterテスト
+//----------------------------------------------------------------------------
+
+//! 直前と同じバインドを除外するか
+static void TestFilter_RedundantBinds()
+{
+    std::cout << "\n=== Filter: 冗長バインドの除外 ===" << std::endl;
+
+    CommandBuffer commands;
+    BindSpritePipeline(commands, Fake<Buffer>(10));
+    const uint32_t first = commands.GetStats().recorded;
+    BindSpritePipeline(commands, Fake<Buffer>(10));
+    TEST_ASSERT(commands.GetStats().recorded == first, "同じパイプラインの再設定は記録しない");
+    TEST_ASSERT(commands.GetStats().filtered == first, "除外数");
+
+    BindSpritePipeline(commands, Fake<Buffer>(11));
+    TEST_ASSERT(commands.GetStats().recorded == first + 1, "頂点バッファだけが変われば1コマンド");
+
+    commands.SetVertexBuffer(0, Fake<Buffer>(11), 24, 96);
+    TEST_ASSERT(commands.GetStats().recorded == first + 2, "オフセットの違いは記録する");
+
+    commands.SetDepthStencilState(Fake<DepthStencilState>(1), 1);
+    TEST_ASSERT(commands.GetStats().recorded == first + 3, "ステンシル参照値の違いは記録する");
+
+    commands.SetShaderResource(ShaderType::Pixel, 1, Fake<Texture>(1));
+    commands.SetShaderResource(ShaderType::Vertex, 0, Fake<Texture>(1));
+    TEST_ASSERT(commands.GetStats().recorded == first + 5, "スロット・ステージは別々に追跡");
+
+    commands.SetShaderResource(ShaderType::Pixel, 1, nullptr);
+    commands.SetShaderResource(ShaderType::Pixel, 1, nullptr);
+    TEST_ASSERT(commands.GetStats().recorded == first + 6, "nullのアンバインドも1回だけ記録");
+
+    const uint32_t beyond = CommandBuffer::kMaxShaderResourceSlots;
+    commands.SetShaderResource(ShaderType::Pixel, beyond, Fake<Texture>(1));
+    commands.SetShaderResource(ShaderType::Pixel, beyond, Fake<Texture>(1));
+    TEST_ASSERT(commands.GetStats().recorded == first + 8, "追跡外のスロットは常に記録");
+
+    commands.Invalidate();
+    BindSpritePipeline(commands, Fake<Buffer>(11));
+    TEST_ASSERT(commands.GetStats().recorded == first * 2 + 8, "Invalidate()後は全て記録");
+
+    commands.Reset();
+    BindSpritePipeline(commands, Fake<Buffer>(11));
+    TEST_ASSERT(commands.GetStats().recorded == first && commands.GetStats().filtered == 0,
+                "Reset()は記録済みステートと統計も破棄");
+}
+
+//----------------------------------------------------------------------------
+// Payloadテスト
+//----------------------------------------------------------------------------
+
+//! 定数バッファ更新とバッファ書き込みのデータが再生先へ届くか
+static void TestPayload_RoundTrip()
+{
+    std::cout << "\n=== Payload: 書き込みデータ ===" << std::endl;
+
+    CommandBuffer commands;
+
+    float matrix[16];
+    for (int i = 0; i < 16; ++i) matrix[i] = static_cast<float>(i) * 0.5f;
+    commands.UpdateConstantBuffer(Fake<Buffer>(3), matrix, sizeof(matrix));
+    matrix[0] = 999.0f;  // 記録後の変更は反映されない
+
+    // 8バイト境界に揃わないサイズ
+    constexpr uint32_t kOddSize = 13;
+    auto* dst = static_cast<uint8_t*>(commands.BeginWrite(Fake<Buffer>(10), kWriteDiscard, 48, kOddSize));
+    for (uint32_t i = 0; i < kOddSize; ++i) dst[i] = static_cast<uint8_t>(0xA0 + i);
+    commands.EndWrite(Fake<Buffer>(10));
+    commands.DrawIndexed(6, 0, 0);
+
+    TEST_ASSERT(commands.GetStats().uploadBytes == sizeof(matrix) + kOddSize, "転送量の統計");
+    TEST_ASSERT(commands.GetByteSize() % 8 == 0, "コマンドは8バイト境界に揃う");
+
+    NullCommandBackend capture;
+    commands.Submit(capture);
+
+    const auto& writes = capture.GetWrites();
+    const auto& data = capture.GetWriteData();
+    TEST_ASSERT(writes.size() == 2, "書き込み数");
+    float replayed[16];
+    std::memcpy(replayed, data.data() + writes[0].dataOffset, sizeof(replayed));
+    TEST_ASSERT(replayed[0] == 0.0f && replayed[15] == 7.5f, "定数バッファは記録時点の値");
+
+    bool sameBytes = writes[1].size == kOddSize && writes[1].offset == 48 && writes[1].mapType == kWriteDiscard;
+    for (uint32_t i = 0; sameBytes && i < kOddSize; ++i) {
+        sameBytes = static_cast<uint8_t>(data[writes[1].dataOffset + i]) == 0xA0 + i;
+    }
+    TEST_ASSERT(sameBytes, "バッファ書き込みの内容・オフセット・マップ種別");
+    TEST_ASSERT(capture.GetDraws().size() == 1 && capture.GetDraws()[0].count == 6,
+                "可変長データの後のコマンドも読める");
+}
+
+//----------------------------------------------------------------------------
+// Equivalenceテスト
+//----------------------------------------------------------------------------
+
+//! ランダムなコマンド列を直接発行した場合と記録・再生した場合で描画時ステートが一致するか
+static void TestEquivalence_RandomStreams()
+{
+    std::cout << "\n=== Equivalence: 除外前後の描画時ステート ===" << std::endl;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> op(0, 7);
+    std::uniform_int_distribution<int> id(1, 3);
+
+    NullCommandBackend direct;
+    NullCommandBackend replayed;
+    CommandBuffer commands;
+
+    for (int i = 0; i < 20000; ++i) {
+        auto emit = [&](auto&& fn) { fn(static_cast<ICommandBackend&>(direct)); fn(static_cast<ICommandBackend&>(commands)); };
+        const uintptr_t n = static_cast<uintptr_t>(id(rng));
+        switch (op(rng)) {
+        case 0: emit([&](ICommandBackend& o) { o.SetShader(ShaderType::Vertex, Fake<Shader>(n)); }); break;
+        case 1: emit([&](ICommandBackend& o) { o.SetShader(ShaderType::Pixel, Fake<Shader>(n + 8)); }); break;
+        case 2: emit([&](ICommandBackend& o) { o.SetShaderResource(ShaderType::Pixel, 0, Fake<Texture>(n)); }); break;
+        case 3: emit([&](ICommandBackend& o) { o.SetVertexBuffer(0, Fake<Buffer>(n), 24); }); break;
+        case 4: emit([&](ICommandBackend& o) { o.SetBlendState(n == 3 ? nullptr : Fake<BlendState>(n)); }); break;
+        case 5: emit([&](ICommandBackend& o) { o.SetPrimitiveTopology(n == 1 ? kTriangleStrip : kTriangleList); }); break;
+        case 6: emit([&](ICommandBackend& o) { o.DrawIndexed(static_cast<uint32_t>(n) * 6, 0, 0); }); break;
+        default: emit([&](ICommandBackend& o) { o.DrawInstanced(4, static_cast<uint32_t>(n), 0, 0); }); break;
+        }
+    }
+    commands.Submit(replayed);
+
+    const auto& stats = commands.GetStats();
+    std::cout << "  直接 " << direct.GetTrace().size() << " コマンド / 記録 " << stats.recorded
+              << " (除外 " << stats.filtered << ")" << std::endl;
+    TEST_ASSERT(SameDraws(direct.GetDraws(), replayed.GetDraws()), "全ての描画で同じステート");
+    TEST_ASSERT(stats.recorded + stats.filtered == direct.GetTrace().size(), "記録数 + 除外数 = 発行数");
+    TEST_ASSERT(stats.filtered > 0, "冗長なバインドを除外");
+}
+
+//----------------------------------------------------------------------------
+// ベンチマーク
+//----------------------------------------------------------------------------
+
+//! スプライト描画相当（バッチごとにパイプラインを再設定）の記録・再生時間
+static void BenchmarkRecordReplay()
+{
+    std::cout << "\n=== 記録・再生 ベンチマーク ===" << std::endl;
+
+    constexpr int kRepeat = 50;
+    for (uint32_t batches : { 1000u, 10000u, 50000u }) {
+        CommandBuffer commands;
+        NullCommandBackend capture;
+
+        double recordMs = 0.0;
+        double replayMs = 0.0;
+        for (int r = 0; r < kRepeat; ++r) {
+            commands.Reset();
+            capture.Clear();
+
+            auto begin = std::chrono::steady_clock::now();
+            for (uint32_t b = 0; b < batches; ++b) {
+                BindSpritePipeline(commands, Fake<Buffer>(10 + (b & 1)));
+                commands.SetShaderResource(ShaderType::Pixel, 0, Fake<Texture>(1 + b % 8));
+                commands.DrawIndexed(6 * 16, b * 96, 0);
+            }
+            auto mid = std::chrono::steady_clock::now();
+            commands.Submit(capture);
+            auto end = std::chrono::steady_clock::now();
+
+            recordMs += std::chrono::duration<double, std::milli>(mid - begin).count();
+            replayMs += std::chrono::duration<double, std::milli>(end - mid).count();
+        }
+
+        const auto& stats = commands.GetStats();
+        std::cout << "  " << batches << " batches:"
+                  << "  record " << recordMs / kRepeat << " ms"
+                  << "  replay " << replayMs / kRepeat << " ms"
+                  << "  " << commands.GetByteSize() / 1024 << " KB"
+                  << "  recorded " << stats.recorded << " / filtered " << stats.filtered << std::endl;
+    }
+}
+
+//----------------------------------------------------------------------------
+// StateCacheテスト
+//----------------------------------------------------------------------------
+
+//! 同じ値の再設定を省略し、分類ごとに数えるか
+static void TestStateCache_SkipRedundant()
+{
+    std::cout << "\n=== StateCache: 冗長バインドの省略 ===" << std::endl;
+
+    StateCache cache;
+    const void* layout = Fake<ID3D11InputLayout>(1);
+    const void* srv = Fake<Texture>(1);
+
+    TEST_ASSERT(cache.SetInputLayout(layout), "最初の設定は発行");
+    TEST_ASSERT(!cache.SetInputLayout(layout), "同じ値は省略");
+    TEST_ASSERT(cache.SetShaderResource(ShaderType::Pixel, 0, srv), "SRVの最初の設定は発行");
+    TEST_ASSERT(!cache.SetShaderResource(ShaderType::Pixel, 0, srv), "SRVの再設定は省略");
+    TEST_ASSERT(cache.SetShaderResource(ShaderType::Vertex, 0, srv), "ステージは別々に追跡");
+    TEST_ASSERT(cache.SetShaderResource(ShaderType::Pixel, 0, nullptr), "nullへの変更は発行");
+
+    TEST_ASSERT(cache.SetVertexBuffer(0, Fake<Buffer>(1), 24, 0), "頂点バッファ");
+    TEST_ASSERT(cache.SetVertexBuffer(0, Fake<Buffer>(1), 24, 96), "オフセットの違いは発行");
+
+    const float white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    const float half[4] = { 0.5f, 0.5f, 0.5f, 0.5f };
+    TEST_ASSERT(cache.SetBlendState(Fake<BlendState>(1), white, 0xFFFFFFFF), "ブレンドステート");
+    TEST_ASSERT(!cache.SetBlendState(Fake<BlendState>(1), white, 0xFFFFFFFF), "同じブレンドは省略");
+    TEST_ASSERT(cache.SetBlendState(Fake<BlendState>(1), half, 0xFFFFFFFF), "ブレンド係数の違いは発行");
+    TEST_ASSERT(cache.SetDepthStencilState(Fake<DepthStencilState>(1), 0), "深度ステンシル");
+    TEST_ASSERT(cache.SetDepthStencilState(Fake<DepthStencilState>(1), 1), "ステンシル参照値の違いは発行");
+
+    const uint32_t beyond = StateCache::kMaxShaderResourceSlots;
+    TEST_ASSERT(cache.SetShaderResource(ShaderType::Pixel, beyond, srv) &&
+                cache.SetShaderResource(ShaderType::Pixel, beyond, srv), "追跡外のスロットは常に発行");
+
+    const StateBindStats& stats = cache.GetStats();
+    TEST_ASSERT(stats.GetIssued(StateBindCategory::InputAssembler) == 3 &&
+                stats.GetSkipped(StateBindCategory::InputAssembler) == 1, "入力アセンブラの統計");
+    TEST_ASSERT(stats.GetIssued(StateBindCategory::ShaderResource) == 5 &&
+                stats.GetSkipped(StateBindCategory::ShaderResource) == 1, "SRVの統計");
+    TEST_ASSERT(stats.GetIssued(StateBindCategory::PipelineState) == 4 &&
+                stats.GetSkipped(StateBindCategory::PipelineState) == 1, "パイプラインステートの統計");
+    TEST_ASSERT(stats.TotalIssued() == 12 && stats.TotalSkipped() == 3, "合計");
+
+    cache.ResetStats();
+    TEST_ASSERT(cache.GetStats().TotalIssued() == 0 && cache.GetStats().TotalSkipped() == 0,
+                "ResetStats()で統計を破棄");
+    TEST_ASSERT(!cache.SetInputLayout(layout), "ResetStats()は記録済みステートを残す");
+}
+
+//! 無効化で記録を忘れるか
+static void TestStateCache_Invalidate()
+{
+    std::cout << "\n=== StateCache: 無効化 ===" << std::endl;
+
+    StateCache cache;
+    const void* srv = Fake<Texture>(1);
+    (void)cache.SetShader(ShaderType::Pixel, Fake<Shader>(1));
+    (void)cache.SetSampler(ShaderType::Pixel, 0, Fake<SamplerState>(1));
+    (void)cache.SetShaderResource(ShaderType::Pixel, 0, srv);
+    (void)cache.SetVertexBuffer(0, Fake<Buffer>(1), 24, 0);
+    (void)cache.SetVertexBuffer(1, Fake<Buffer>(2), 16, 0);
+    (void)cache.SetIndexBuffer(Fake<Buffer>(3), kR32Uint, 0);
+
+    // レンダーターゲット変更相当
+    cache.InvalidateResources();
+    TEST_ASSERT(cache.SetShaderResource(ShaderType::Pixel, 0, srv), "InvalidateResources()後のSRVは発行");
+    TEST_ASSERT(cache.SetVertexBuffer(0, Fake<Buffer>(1), 24, 0), "InvalidateResources()後の頂点バッファは発行");
+    TEST_ASSERT(cache.SetIndexBuffer(Fake<Buffer>(3), kR32Uint, 0), "InvalidateResources()後のインデックスバッファは発行");
+    TEST_ASSERT(!cache.SetShader(ShaderType::Pixel, Fake<Shader>(1)), "シェーダーは残す");
+    TEST_ASSERT(!cache.SetSampler(ShaderType::Pixel, 0, Fake<SamplerState>(1)), "サンプラーは残す");
+
+    // 範囲指定の頂点バッファ設定相当
+    (void)cache.SetVertexBuffer(1, Fake<Buffer>(2), 16, 0);
+    cache.ForgetVertexBuffers(1, 1);
+    TEST_ASSERT(!cache.SetVertexBuffer(0, Fake<Buffer>(1), 24, 0), "範囲外のスロットは残す");
+    TEST_ASSERT(cache.SetVertexBuffer(1, Fake<Buffer>(2), 16, 0), "範囲内のスロットは発行");
+
+    cache.Invalidate();
+    TEST_ASSERT(cache.SetShader(ShaderType::Pixel, Fake<Shader>(1)), "Invalidate()後のシェーダーは発行");
+    TEST_ASSERT(cache.SetSampler(ShaderType::Pixel, 0, Fake<SamplerState>(1)), "Invalidate()後のサンプラーは発行");
+    TEST_ASSERT(cache.SetShaderResource(ShaderType::Pixel, 0, srv), "Invalidate()後のSRVは発行");
+}
+
+//! 毎フレーム同じパイプラインを設定した場合、2フレーム目の発行が減るか
+static void TestStateCache_RepeatedFrames()
+{
+    std::cout << "\n=== StateCache: フレームをまたぐ再バインド ===" << std::endl;
+
+    StateCache cache;
+    auto bindFrame = [&cache]() {
+        (void)cache.SetInputLayout(Fake<ID3D11InputLayout>(1));
+        (void)cache.SetPrimitiveTopology(kTriangleList);
+        (void)cache.SetVertexBuffer(0, Fake<Buffer>(10), 24, 0);
+        (void)cache.SetIndexBuffer(Fake<Buffer>(2), kR32Uint, 0);
+        (void)cache.SetShader(ShaderType::Vertex, Fake<Shader>(1));
+        (void)cache.SetShader(ShaderType::Pixel, Fake<Shader>(2));
+        (void)cache.SetConstantBuffer(ShaderType::Vertex, 0, Fake<Buffer>(3));
+        (void)cache.SetSampler(ShaderType::Pixel, 0, Fake<SamplerState>(1));
+        (void)cache.SetRasterizerState(Fake<RasterizerState>(1));
+        for (uintptr_t t = 1; t <= 4; ++t) {
+            (void)cache.SetShaderResource(ShaderType::Pixel, 0, Fake<Texture>(t));
+        }
+    };
+
+    bindFrame();
+    const uint32_t firstIssued = cache.GetStats().TotalIssued();
+    cache.ResetStats();
+    bindFrame();
+    const StateBindStats& stats = cache.GetStats();
+
+    TEST_ASSERT(firstIssued == 13, "1フレーム目は全て発行");
+    TEST_ASSERT(stats.TotalIssued() == 4, "2フレーム目はテクスチャ切り替えだけ発行");
+    TEST_ASSERT(stats.TotalSkipped() == 9, "固定ステートは省略");
+}
+
+//----------------------------------------------------------------------------
+// 公開インターフェース
+//----------------------------------------------------------------------------
+
+//! コマンドバッファ テストスイートを実行
+//! @param runBenchmarks ベンチマークも実行するか
+//! @return 全テスト成功時true、それ以外false
+bool RunCommandBufferTests(bool runBenchmarks)
+{
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "  コマンドバッファ テスト" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    ResetGlobalCounters();
+
+    // Replayテスト
+    TestReplay_Order();
+
+    // Filterテスト
+    TestFilter_RedundantBinds();
+
+    // Payloadテスト
+    TestPayload_RoundTrip();
+
+    // Equivalenceテスト
+    TestEquivalence_RandomStreams();
+
+    // StateCacheテスト
+    TestStateCache_SkipRedundant();
+    TestStateCache_Invalidate();
+    TestStateCache_RepeatedFrames();
+
+    // ベンチマーク（--bench指定時のみ）
+    if (runBenchmarks) {
+        BenchmarkRecordReplay();
+    }
+
+    std::cout << "\n----------------------------------------" << std::endl;
+    std::cout << "コマンドバッファテスト: " << s_passCount << "/" << s_testCount << " 成功" << std::endl;
+    std::cout << "----------------------------------------" << std::endl;
+
+    return s_passCount == s_testCount;
+}
+
+} // namespace tests
@@ -0,0 +1,15 @@
+//----------------------------------------------------------------------------
+//! @file   test_command_buffer.h
+//! @brief  Command buffer record/replay test declarations
+//----------------------------------------------------------------------------
+#pragma once
+
+namespace tests {
+
+//! Run all command buffer tests
+//! @param [in] runBenchmarks Also run timing benchmarks
+//! @return true if all tests passed
+//! @note Does not require D3D11 device
+bool RunCommandBufferTests(bool runBenchmarks = false);
+
+} // namespace tests
@@ -0,0 +1,925 @@
+//----------------------------------------------------------------------------
+//! @file   test_event_bus.cpp
+//! @brief  EventBus テストスイート
+//!
+//! @details
+//! EventBus/EventHandlerの購読・発行をテストします。
+//!
+//! テストカテゴリ:
+//! - Subscribe: 購読順の呼び出し、解除、クリア
+//! - Dispatch: 発行中の購読・解除（次の発行から反映）
+//! - Deferred: 遅延配送のキュー、バッチ購読、Flushの順序
+//! - TypeId: イベント型IDの割り当て
+//! - Trace: 発行の記録とログからの再生
+//! - Benchmark: 購読者数ごとの発行コスト、型検索のコスト（旧実装との比較）
+//!
+//! @note D3D11デバイスは不要
+//----------------------------------------------------------------------------
+#include "test_event_bus.h"
+#include "test_common.h"
+#include "game/systems/event/event_bus.h"
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace tests {
+
+//----------------------------------------------------------------------------
+// テストユーティリティ（共通ヘッダーから使用）
+//----------------------------------------------------------------------------
+
+// グローバルカウンターを使用（後方互換性のため）
+#define s_testCount tests::GetGlobalTestCount()
+#define s_passCount tests::GetGlobalPassCount()
+
+namespace {
+
+struct TestEvent {
+    int value;
+};
+
+struct OtherEvent {
+    int value;
+};
+
+struct UnusedEvent {
+    float value;
+};
+
+//! ポインタを含む（記録形式のない）イベント
+struct PointerEvent {
+    int* target;
+};
+
+//! ポインタを含み、EventTraceCodecでIDに置き換えて記録するイベント
+struct TargetedEvent {
+    int* target;
+    int amount;
+};
+
+//! 配列の要素にID（添字+1）を割り当てる表
+class ArrayEntityMap : public IEventEntityMap
+{
+public:
+    explicit ArrayEntityMap(std::span<int> entities) : entities_(entities) {}
+
+    bool ToId(const void* entity, uint32_t& id) const override {
+        if (!entity) {
+            id = kNullId;
+            return true;
+        }
+        for (size_t i = 0; i < entities_.size(); ++i) {
+            if (&entities_[i] == entity) {
+                id = static_cast<uint32_t>(i + 1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool FromId(uint32_t id, void*& entity) const override {
+        if (id > entities_.size()) return false;
+        entity = id == kNullId ? nullptr : &entities_[id - 1];
+        return true;
+    }
+
+private:
+    std::span<int> entities_;
+};
+
+using TestEventBus = BasicEventBus<EventTypeList<TestEvent, OtherEvent, UnusedEvent>>;
+
+} // namespace
+} // namespace tests
+
+template<> inline constexpr bool kEventTraceable<tests::TestEvent> = true;
+template<> inline constexpr bool kEventTraceable<tests::OtherEvent> = true;
+template<> inline constexpr bool kEventTraceable<tests::UnusedEvent> = true;
+
+template<>
+struct EventTraceCodec<tests::TargetedEvent>
+{
+    struct Record { uint32_t target; int amount; };
+    static bool Encode(const tests::TargetedEvent& e, const IEventEntityMap& map, Record& out) {
+        out.amount = e.amount;
+        return map.ToId(e.target, out.target);
+    }
+    static bool Decode(const Record& r, const IEventEntityMap& map, tests::TargetedEvent& out) {
+        void* target = nullptr;
+        if (!map.FromId(r.target, target)) return false;
+        out.target = static_cast<int*>(target);
+        out.amount = r.amount;
+        return true;
+    }
+};
+
+namespace tests {
+
+//----------------------------------------------------------------------------
+// Subscribeテスト
+//----------------------------------------------------------------------------
+
+//! 購読順の呼び出しと解除
+static void TestSubscribe_OrderAndRemove()
+{
+    std::cout << "\n=== Subscribe: 購読順と解除 ===" << std::endl;
+
+    EventHandler<TestEvent> handler;
+    TEST_ASSERT(handler.IsEmpty(), "初期状態は空");
+
+    std::vector<int> calls;
+    handler.Add(1, [&](const TestEvent& e) { calls.push_back(100 + e.value); });
+    handler.Add(2, [&](const TestEvent& e) { calls.push_back(200 + e.value); });
+    handler.Add(3, [&](const TestEvent& e) { calls.push_back(300 + e.value); });
+    TEST_ASSERT(handler.GetSubscriberCount() == 3, "購読者数");
+
+    handler.Invoke(TestEvent{ 1 });
+    TEST_ASSERT(calls == std::vector<int>({ 101, 201, 301 }), "購読順に呼ばれる");
+
+    calls.clear();
+    handler.Remove(2);
+    handler.Remove(99);
+    handler.Invoke(TestEvent{ 2 });
+    TEST_ASSERT(calls == std::vector<int>({ 102, 302 }), "解除した購読者は呼ばれない");
+    TEST_ASSERT(handler.GetSubscriberCount() == 2, "存在しないIDの解除は無視");
+
+    handler.Remove(1);
+    handler.Remove(3);
+    TEST_ASSERT(handler.IsEmpty(), "最後の購読者を解除すると空");
+
+    calls.clear();
+    handler.Invoke(TestEvent{ 3 });
+    TEST_ASSERT(calls.empty(), "空のハンドラは何も呼ばない");
+
+    handler.Add(4, [&](const TestEvent& e) { calls.push_back(400 + e.value); });
+    handler.Clear();
+    handler.Invoke(TestEvent{ 4 });
+    TEST_ASSERT(calls.empty() && handler.IsEmpty(), "クリア後は呼ばれない");
+}
+
+//! EventBus経由の購読・発行・クリア
+static void TestSubscribe_Bus()
+{
+    std::cout << "\n=== Subscribe: EventBus ===" << std::endl;
+
+    TestEventBus& bus = TestEventBus::Get();
+    bus.Clear();
+
+    int testSum = 0;
+    int otherSum = 0;
+    uint32_t a = bus.Subscribe<TestEvent>([&](const TestEvent& e) { testSum += e.value; });
+    uint32_t b = bus.Subscribe<OtherEvent>([&](const OtherEvent& e) { otherSum += e.value; });
+    TEST_ASSERT(a != b, "購読IDは一意");
+
+    bus.Publish(TestEvent{ 5 });
+    bus.Publish<OtherEvent>(7);
+    TEST_ASSERT(testSum == 5 && otherSum == 7, "型ごとに配送される");
+
+    bus.Unsubscribe<TestEvent>(a);
+    bus.Publish(TestEvent{ 5 });
+    TEST_ASSERT(testSum == 5, "解除後は呼ばれない");
+
+    bus.Clear();
+    bus.Publish(OtherEvent{ 1 });
+    TEST_ASSERT(otherSum == 7, "クリア後は呼ばれない");
+
+    bus.Subscribe<OtherEvent>([&](const OtherEvent& e) { otherSum += e.value; });
+    bus.Publish(OtherEvent{ 1 });
+    TEST_ASSERT(otherSum == 8, "クリア後も再購読できる");
+
+    bus.Clear();
+}
+
+//----------------------------------------------------------------------------
+// Dispatchテスト
+//----------------------------------------------------------------------------
+
+//! 発行中の購読・解除は次の発行から反映
+static void TestDispatch_ChangesDuringInvoke()
+{
+    std::cout << "\n=== Dispatch: 発行中の購読・解除 ===" << std::endl;
+
+    EventHandler<TestEvent> handler;
+    std::vector<int> calls;
+
+    // 発行中に追加した購読者は、その発行では呼ばれない
+    bool added = false;
+    handler.Add(1, [&](const TestEvent&) {
+        calls.push_back(1);
+        if (!added) {
+            added = true;
+            handler.Add(2, [&](const TestEvent&) { calls.push_back(2); });
+        }
+    });
+    handler.Invoke(TestEvent{ 0 });
+    TEST_ASSERT(calls == std::vector<int>({ 1 }), "発行中の購読は現在の発行に含まれない");
+
+    calls.clear();
+    handler.Invoke(TestEvent{ 0 });
+    TEST_ASSERT(calls == std::vector<int>({ 1, 2 }), "次の発行から呼ばれる");
+
+    // 発行中に解除した購読者も、開始済みの発行では呼ばれる
+    handler.Clear();
+    calls.clear();
+    handler.Add(1, [&](const TestEvent&) { calls.push_back(1); handler.Remove(2); });
+    handler.Add(2, [&](const TestEvent&) { calls.push_back(2); });
+    handler.Invoke(TestEvent{ 0 });
+    TEST_ASSERT(calls == std::vector<int>({ 1, 2 }), "発行中に解除されても現在の発行では呼ばれる");
+
+    calls.clear();
+    handler.Invoke(TestEvent{ 0 });
+    TEST_ASSERT(calls == std::vector<int>({ 1 }), "次の発行からは呼ばれない");
+
+    // 自分自身の解除とクリア
+    handler.Clear();
+    calls.clear();
+    handler.Add(1, [&](const TestEvent&) { calls.push_back(1); handler.Clear(); });
+    handler.Add(2, [&](const TestEvent&) { calls.push_back(2); });
+    handler.Invoke(TestEvent{ 0 });
+    TEST_ASSERT(calls == std::vector<int>({ 1, 2 }), "発行中のクリアは現在の発行に影響しない");
+    TEST_ASSERT(handler.IsEmpty(), "クリアは反映される");
+
+    // EventBus経由でも同じ
+    TestEventBus& bus = TestEventBus::Get();
+    bus.Clear();
+    int count = 0;
+    uint32_t self = 0;
+    self = bus.Subscribe<TestEvent>([&](const TestEvent&) {
+        ++count;
+        bus.Unsubscribe<TestEvent>(self);
+        bus.Publish(OtherEvent{ 0 });
+    });
+    bus.Publish(TestEvent{ 0 });
+    bus.Publish(TestEvent{ 0 });
+    TEST_ASSERT(count == 1, "発行中にバスを操作してもデッドロックしない");
+    bus.Clear();
+}
+
+//----------------------------------------------------------------------------
+// Deferredテスト
+//----------------------------------------------------------------------------
+
+//! キューへの積み込みとFlushでの一括配送
+static void TestDeferred_Queue()
+{
+    std::cout << "\n=== Deferred: キューと一括配送 ===" << std::endl;
+
+    TestEventBus& bus = TestEventBus::Get();
+    bus.Clear();
+
+    std::vector<int> single;
+    std::vector<size_t> batchSizes;
+    std::vector<int> batched;
+    bus.Subscribe<TestEvent>([&](const TestEvent& e) { single.push_back(e.value); });
+    bus.SubscribeBatch<TestEvent>([&](std::span<const TestEvent> events) {
+        batchSizes.push_back(events.size());
+        for (const TestEvent& e : events) batched.push_back(e.value);
+    });
+
+    // 即時配送ではバッチ購読者も1件ずつ受け取る
+    bus.Publish(TestEvent{ 1 });
+    TEST_ASSERT(single == std::vector<int>({ 1 }), "即時配送は発行時に呼ばれる");
+    TEST_ASSERT(batchSizes == std::vector<size_t>({ 1 }), "即時配送のバッチは1件");
+
+    single.clear();
+    batchSizes.clear();
+    batched.clear();
+    bus.SetDispatchMode<TestEvent>(EventDispatchMode::Deferred);
+    bus.Publish(TestEvent{ 10 });
+    bus.Publish(TestEvent{ 11 });
+    bus.Publish(TestEvent{ 12 });
+    TEST_ASSERT(single.empty() && batchSizes.empty(), "遅延配送はFlushまで呼ばれない");
+
+    bus.Flush();
+    TEST_ASSERT(single == std::vector<int>({ 10, 11, 12 }), "通常の購読者は発行順に1件ずつ受け取る");
+    TEST_ASSERT(batchSizes == std::vector<size_t>({ 3 }), "バッチ購読者は一度に受け取る");
+    TEST_ASSERT(batched == std::vector<int>({ 10, 11, 12 }), "バッチの中身は発行順");
+
+    bus.Flush();
+    TEST_ASSERT(batchSizes.size() == 1, "空のキューでは呼ばれない");
+
+    // 型ごとに独立
+    int other = 0;
+    bus.Subscribe<OtherEvent>([&](const OtherEvent& e) { other += e.value; });
+    bus.Publish(OtherEvent{ 3 });
+    TEST_ASSERT(other == 3, "遅延設定していない型は即時配送");
+
+    // 即時に戻しても溜まった分は次のFlushで配送
+    single.clear();
+    bus.Publish(TestEvent{ 20 });
+    bus.SetDispatchMode<TestEvent>(EventDispatchMode::Immediate);
+    bus.Publish(TestEvent{ 21 });
+    TEST_ASSERT(single == std::vector<int>({ 21 }), "即時に戻すと発行時に呼ばれる");
+    bus.Flush<TestEvent>();
+    TEST_ASSERT(single == std::vector<int>({ 21, 20 }), "溜まっていた分は型指定のFlushで配送");
+
+    // クリアで未配送のイベントは破棄され、即時配送に戻る
+    bus.SetDispatchMode<TestEvent>(EventDispatchMode::Deferred);
+    bus.Publish(TestEvent{ 30 });
+    bus.Clear();
+    single.clear();
+    bus.Subscribe<TestEvent>([&](const TestEvent& e) { single.push_back(e.value); });
+    bus.Flush();
+    TEST_ASSERT(single.empty(), "クリアで未配送のイベントは破棄");
+    bus.Publish(TestEvent{ 31 });
+    TEST_ASSERT(single == std::vector<int>({ 31 }), "クリア後は即時配送");
+
+    bus.Clear();
+}
+
+//! 配送中に発行したイベントの扱い
+static void TestDeferred_PublishDuringFlush()
+{
+    std::cout << "\n=== Deferred: 配送中の発行 ===" << std::endl;
+
+    TestEventBus& bus = TestEventBus::Get();
+    bus.Clear();
+    bus.SetDispatchMode<TestEvent>(EventDispatchMode::Deferred);
+    bus.SetDispatchMode<OtherEvent>(EventDispatchMode::Deferred);
+
+    std::vector<int> calls;
+    bus.Subscribe<TestEvent>([&](const TestEvent& e) {
+        calls.push_back(e.value);
+        if (e.value == 1) {
+            bus.Publish(TestEvent{ 2 });     // 配送中の型 → 次のFlush
+            bus.Publish(OtherEvent{ 100 });  // 後の型 → 同じFlush
+        }
+    });
+    bus.Subscribe<OtherEvent>([&](const OtherEvent& e) {
+        calls.push_back(e.value);
+        bus.Flush();                         // 配送中の再入は無視される
+    });
+
+    bus.Publish(TestEvent{ 1 });
+    bus.Flush();
+    TEST_ASSERT(calls == std::vector<int>({ 1, 100 }), "後の型へ積んだ分は同じFlushで配送");
+
+    calls.clear();
+    bus.Flush();
+    TEST_ASSERT(calls == std::vector<int>({ 2 }), "配送中の型へ積んだ分は次のFlushで配送");
+
+    // 容量を使い回す（2回目以降は確保しない）
+    EventHandler<TestEvent> handler;
+    handler.SetMode(EventDispatchMode::Deferred);
+    size_t delivered = 0;
+    handler.AddBatch(1, [&](std::span<const TestEvent> events) { delivered += events.size(); });
+    for (int frame = 0; frame < 3; ++frame) {
+        for (int i = 0; i < 64; ++i) handler.Publish(TestEvent{ i });
+        TEST_ASSERT(handler.GetPendingCount() == 64, "フレーム中はキューに溜まる");
+        handler.Flush();
+        TEST_ASSERT(handler.GetPendingCount() == 0, "Flushでキューが空になる");
+    }
+    TEST_ASSERT(delivered == 192, "全フレーム分を配送");
+
+    bus.Clear();
+}
+
+//----------------------------------------------------------------------------
+// TypeIdテスト
+//----------------------------------------------------------------------------
+
+//! 一覧の並び順で0から連続したIDになる
+static void TestTypeId_Dense()
+{
+    std::cout << "\n=== TypeId: イベント型ID ===" << std::endl;
+
+    static_assert(TestEventBus::GetTypeId<TestEvent>() == 0);
+    static_assert(TestEventBus::GetTypeId<OtherEvent>() == 1);
+    static_assert(TestEventBus::GetTypeId<UnusedEvent>() == 2);
+    static_assert(TestEventBus::kEventTypeCount == 3);
+    static_assert(EventTypeList<OtherEvent, TestEvent>::IdOf<TestEvent>() == 1);
+    static_assert(!EventTypeList<OtherEvent>::Contains<TestEvent>);
+
+    TEST_ASSERT(TestEventBus::GetTypeId<TestEvent>() == 0, "先頭の型はID 0");
+    TEST_ASSERT(TestEventBus::GetTypeId<UnusedEvent>() == TestEventBus::kEventTypeCount - 1,
+                "末尾の型はID 型数-1");
+
+    // 購読していない型へ発行しても何も起きない
+    TestEventBus& bus = TestEventBus::Get();
+    bus.Clear();
+    bus.Publish(UnusedEvent{ 1.0f });
+    bus.Unsubscribe<UnusedEvent>(12345);
+    bus.Flush<UnusedEvent>();
+    TEST_ASSERT(true, "未購読の型への発行・解除・Flush");
+}
+
+//----------------------------------------------------------------------------
+// Traceテスト
+//----------------------------------------------------------------------------
+
+//! 記録したログを別の購読者へ再生すると同じ順序・内容で届く
+static void TestTrace_RecordAndReplay()
+{
+    std::cout << "\n=== Trace: 記録と再生 ===" << std::endl;
+
+    TestEventBus& bus = TestEventBus::Get();
+    bus.Clear();
+    bus.SetDispatchMode<OtherEvent>(EventDispatchMode::Deferred);
+
+    EventTraceRecorder recorder;
+    recorder.Start(4096, static_cast<uint32_t>(TestEventBus::kEventTypeCount));
+    bus.SetRecorder(&recorder);
+
+    // 3フレーム分発行（遅延配送の型も発行時点で記録される）
+    std::vector<int> live;
+    bus.Subscribe<TestEvent>([&](const TestEvent& e) { live.push_back(e.value); });
+    for (int frame = 0; frame < 3; ++frame) {
+        recorder.BeginFrame();
+        bus.Publish(TestEvent{ frame * 10 });
+        bus.Publish(OtherEvent{ frame * 10 + 1 });
+        bus.Publish(TestEvent{ frame * 10 + 2 });
+        bus.Flush();
+    }
+
+    bus.SetRecorder(nullptr);
+    bus.Publish(TestEvent{ 99 });
+    recorder.Stop();
+
+    TEST_ASSERT(recorder.GetRecordCount() == 9, "全ての発行が記録される");
+    TEST_ASSERT(recorder.GetDroppedCount() == 0, "容量内なら捨てない");
+    TEST_ASSERT(recorder.GetData().size() ==
+                sizeof(EventTraceFileHeader) + 6 * (sizeof(EventTraceRecordHeader) + sizeof(TestEvent)) +
+                3 * (sizeof(EventTraceRecordHeader) + sizeof(OtherEvent)), "ログはヘッダーと中身だけ");
+
+    // ログの中身
+    EventTraceReader reader(recorder.GetData());
+    TEST_ASSERT(reader.IsValid() && reader.GetTypeCount() == TestEventBus::kEventTypeCount, "ヘッダー");
+    EventTraceRecord record{};
+    TEST_ASSERT(reader.Next(record) && record.frame == 1 &&
+                record.typeId == TestEventBus::GetTypeId<TestEvent>() &&
+                record.payload.size() == sizeof(TestEvent), "最初のレコード");
+    TEST_ASSERT(reader.Next(record) && record.typeId == TestEventBus::GetTypeId<OtherEvent>(), "2番目のレコード");
+
+    // 新しい購読者へ再生（保存したバイト列から）
+    std::vector<std::byte> saved(recorder.GetData().begin(), recorder.GetData().end());
+    bus.Clear();
+    std::vector<std::pair<int, int>> replayed;  // (型, 値)
+    std::vector<uint32_t> frameEnds;
+    bus.Subscribe<TestEvent>([&](const TestEvent& e) { replayed.emplace_back(0, e.value); });
+    bus.Subscribe<OtherEvent>([&](const OtherEvent& e) { replayed.emplace_back(1, e.value); });
+    bus.SetDispatchMode<OtherEvent>(EventDispatchMode::Deferred);
+
+    EventReplayResult result = ReplayEventTrace(bus, saved, [&](uint32_t frame) { frameEnds.push_back(frame); });
+    TEST_ASSERT(result.valid && result.dispatched == 9 && result.rejected == 0, "全て再生される");
+    TEST_ASSERT(result.frames == 3 && frameEnds == std::vector<uint32_t>({ 1, 2, 3 }), "フレームの区切り");
+
+    std::vector<std::pair<int, int>> expected;
+    for (int frame = 0; frame < 3; ++frame) {
+        expected.emplace_back(0, frame * 10);
+        expected.emplace_back(1, frame * 10 + 1);
+        expected.emplace_back(0, frame * 10 + 2);
+    }
+    TEST_ASSERT(replayed == expected, "発行順のまま、遅延配送の型もその場で配送される");
+
+    // 別のイベント一覧のバスには再生しない
+    using OtherBus = BasicEventBus<EventTypeList<TestEvent>>;
+    TEST_ASSERT(!ReplayEventTrace(OtherBus::Get(), saved).valid, "型数が違うログは拒否");
+
+    // 壊れたログ
+    saved[0] = std::byte{ 'X' };
+    TEST_ASSERT(!ReplayEventTrace(bus, saved).valid, "マジックが違うログは拒否");
+
+    bus.Clear();
+}
+
+//! 記録形式のない（ポインタを含む）型は中身なしで記録し、ログにあっても配送しない
+static void TestTrace_PointerEventOpaque()
+{
+    std::cout << "\n=== Trace: 記録形式のない型 ===" << std::endl;
+
+    using MixedBus = BasicEventBus<EventTypeList<TestEvent, PointerEvent>>;
+    static_assert(!kEventTraceable<PointerEvent> && !EventTraceEncodable<PointerEvent>,
+                  "ポインタを含む型は既定で中身を記録しない");
+
+    MixedBus& bus = MixedBus::Get();
+    bus.Clear();
+
+    EventTraceRecorder recorder;
+    recorder.Start(1024, static_cast<uint32_t>(MixedBus::kEventTypeCount));
+    bus.SetRecorder(&recorder);
+
+    int target = 0;
+    int pointerCalls = 0;
+    bus.Subscribe<PointerEvent>([&](const PointerEvent&) { ++pointerCalls; });
+    recorder.BeginFrame();
+    bus.Publish(TestEvent{ 1 });
+    bus.Publish(PointerEvent{ &target });
+    bus.Publish(TestEvent{ 2 });
+    bus.SetRecorder(nullptr);
+    recorder.Stop();
+
+    TEST_ASSERT(pointerCalls == 1, "記録形式がなくても通常の配送は行う");
+    TEST_ASSERT(recorder.GetRecordCount() == 3 && recorder.GetOpaqueCount() == 1, "中身なしのレコードを残す");
+    TEST_ASSERT(recorder.GetData().size() ==
+                sizeof(EventTraceFileHeader) + 3 * sizeof(EventTraceRecordHeader) + 2 * sizeof(TestEvent),
+                "中身なしのレコードはヘッダーだけ");
+
+    // フレーム・型ID・元のサイズは読める
+    EventTraceReader reader(recorder.GetData());
+    EventTraceRecord record{};
+    TEST_ASSERT(reader.Next(record) && !record.opaque, "記録対象の型は中身あり");
+    TEST_ASSERT(reader.Next(record) && record.opaque && record.frame == 1 &&
+                record.typeId == MixedBus::GetTypeId<PointerEvent>() &&
+                record.eventSize == sizeof(PointerEvent) && record.payload.empty(), "中身なしのレコード");
+    TEST_ASSERT(reader.Next(record) && !record.opaque && !reader.Next(record), "後続のレコードも読める");
+
+    // 中身なしのレコードは再生せずskippedに数える
+    std::vector<int> replayed;
+    bus.Subscribe<TestEvent>([&](const TestEvent& e) { replayed.push_back(e.value); });
+    EventReplayResult skippedResult = ReplayEventTrace(bus, recorder.GetData());
+    TEST_ASSERT(skippedResult.valid && skippedResult.dispatched == 2 && skippedResult.skipped == 1 &&
+                skippedResult.rejected == 0, "中身なしのレコードはskipped");
+    TEST_ASSERT(replayed == std::vector<int>({ 1, 2 }) && pointerCalls == 1, "中身なしのレコードは配送しない");
+
+    // 記録形式のない型IDに中身を付けたレコードを手で追加したログ
+    std::vector<std::byte> forged(recorder.GetData().begin(), recorder.GetData().end());
+    EventTraceRecordHeader header{ 1, MixedBus::GetTypeId<PointerEvent>(), sizeof(PointerEvent) };
+    PointerEvent payload{ &target };
+    const std::byte* headerBytes = reinterpret_cast<const std::byte*>(&header);
+    const std::byte* payloadBytes = reinterpret_cast<const std::byte*>(&payload);
+    forged.insert(forged.end(), headerBytes, headerBytes + sizeof(header));
+    forged.insert(forged.end(), payloadBytes, payloadBytes + sizeof(payload));
+
+    TEST_ASSERT(!bus.DispatchRecorded(MixedBus::GetTypeId<PointerEvent>(),
+                                      std::span<const std::byte>(payloadBytes, sizeof(payload))),
+                "DispatchRecordedは記録形式のない型を拒否");
+
+    replayed.clear();
+    EventReplayResult result = ReplayEventTrace(bus, forged);
+    TEST_ASSERT(result.valid && result.dispatched == 2 && result.skipped == 1 && result.rejected == 1,
+                "記録形式のない型の中身付きレコードはrejected");
+    TEST_ASSERT(replayed == std::vector<int>({ 1, 2 }), "記録対象の型は再生される");
+    TEST_ASSERT(pointerCalls == 1, "記録形式のない型は再生で配送されない");
+
+    bus.Clear();
+}
+
+//! EventTraceCodecを持つ型はポインタをIDに置き換えて記録し、再生でポインタへ戻す
+static void TestTrace_EncodedEvent()
+{
+    std::cout << "\n=== Trace: IDに置き換えて記録する型 ===" << std::endl;
+
+    using EncodedBus = BasicEventBus<EventTypeList<TestEvent, TargetedEvent>>;
+    static_assert(EventTraceEncodable<TargetedEvent>, "EventTraceCodecを特殊化した型");
+
+    EncodedBus& bus = EncodedBus::Get();
+    bus.Clear();
+
+    int entities[3] = {};
+    ArrayEntityMap map(entities);
+    int stray = 0;
+
+    EventTraceRecorder recorder;
+    recorder.SetEntityMap(&map);
+    recorder.Start(1024, static_cast<uint32_t>(EncodedBus::kEventTypeCount));
+    bus.SetRecorder(&recorder);
+    recorder.BeginFrame();
+    bus.Publish(TargetedEvent{ &entities[2], 5 });
+    bus.Publish(TargetedEvent{ nullptr, 6 });
+    bus.Publish(TargetedEvent{ &stray, 7 });  // 表にないポインタ
+    bus.SetRecorder(nullptr);
+    recorder.Stop();
+
+    using Encoded = EventTraceCodec<TargetedEvent>::Record;
+    TEST_ASSERT(recorder.GetRecordCount() == 3 && recorder.GetOpaqueCount() == 1, "表にないポインタは中身なし");
+    TEST_ASSERT(recorder.GetData().size() ==
+                sizeof(EventTraceFileHeader) + 3 * sizeof(EventTraceRecordHeader) + 2 * sizeof(Encoded),
+                "記録形式の大きさで書く");
+
+    EventTraceReader reader(recorder.GetData());
+    EventTraceRecord record{};
+    Encoded encoded{};
+    TEST_ASSERT(reader.Next(record) && record.payload.size() == sizeof(Encoded), "IDで記録される");
+    std::memcpy(&encoded, record.payload.data(), sizeof(encoded));
+    TEST_ASSERT(encoded.target == 3 && encoded.amount == 5, "ポインタの代わりにID");
+
+    // 再生で同じ表のポインタへ戻る
+    std::vector<std::pair<int*, int>> replayed;
+    bus.Subscribe<TargetedEvent>([&](const TargetedEvent& e) { replayed.emplace_back(e.target, e.amount); });
+    EventReplayResult result = ReplayEventTrace(bus, recorder.GetData(), {}, &map);
+    TEST_ASSERT(result.valid && result.dispatched == 2 && result.skipped == 1 && result.rejected == 0,
+                "表があれば再生される");
+    const std::vector<std::pair<int*, int>> expected = { { &entities[2], 5 }, { nullptr, 6 } };
+    TEST_ASSERT(replayed == expected, "IDからポインタへ戻る");
+
+    // 表がない、またはIDが表にない場合は配送しない
+    replayed.clear();
+    result = ReplayEventTrace(bus, recorder.GetData());
+    TEST_ASSERT(result.dispatched == 0 && result.rejected == 2 && replayed.empty(), "表がなければrejected");
+
+    int fewer[2] = {};
+    ArrayEntityMap smallMap(fewer);
+    result = ReplayEventTrace(bus, recorder.GetData(), {}, &smallMap);
+    TEST_ASSERT(result.dispatched == 1 && result.rejected == 1 && replayed.size() == 1 &&
+                replayed[0].first == nullptr, "戻せないIDはrejected");
+
+    // 表を設定していない記録器では中身なしになる
+    EventTraceRecorder noMap;
+    noMap.Start(256, static_cast<uint32_t>(EncodedBus::kEventTypeCount));
+    noMap.Record(EncodedBus::GetTypeId<TargetedEvent>(), TargetedEvent{ &entities[0], 1 });
+    noMap.Stop();
+    TEST_ASSERT(noMap.GetRecordCount() == 1 && noMap.GetOpaqueCount() == 1, "表がなければ中身なし");
+
+    bus.Clear();
+}
+
+//! 容量を超えた分は捨てて数える（記録済みの分は読める）
+static void TestTrace_Overflow()
+{
+    std::cout << "\n=== Trace: 容量超過 ===" << std::endl;
+
+    constexpr size_t kRecordSize = sizeof(EventTraceRecordHeader) + sizeof(TestEvent);
+    EventTraceRecorder recorder;
+    recorder.Start(sizeof(EventTraceFileHeader) + kRecordSize * 4 + kRecordSize / 2, 3);
+    TEST_ASSERT(recorder.GetCapacity() == sizeof(EventTraceFileHeader) + kRecordSize * 4 + kRecordSize / 2,
+                "容量");
+
+    for (int i = 0; i < 10; ++i) {
+        recorder.Record(0, TestEvent{ i });
+    }
+    recorder.Stop();
+    recorder.Record(0, TestEvent{ 100 });
+
+    TEST_ASSERT(recorder.GetRecordCount() == 4 && recorder.GetDroppedCount() == 6, "溢れた分は捨てる");
+    TEST_ASSERT(recorder.GetData().size() == sizeof(EventTraceFileHeader) + kRecordSize * 4,
+                "ログは最初に溢れた位置で終わる");
+
+    EventTraceReader reader(recorder.GetData());
+    EventTraceRecord record{};
+    int count = 0;
+    int last = -1;
+    while (reader.Next(record)) {
+        TestEvent e{};
+        std::memcpy(&e, record.payload.data(), sizeof(e));
+        last = e.value;
+        ++count;
+    }
+    TEST_ASSERT(count == 4 && last == 3, "記録済みの分は読める");
+
+    // 再開すると前回の記録は破棄
+    recorder.Start(recorder.GetCapacity(), 3);
+    TEST_ASSERT(recorder.GetRecordCount() == 0 && recorder.GetDroppedCount() == 0 &&
+                recorder.GetData().size() == sizeof(EventTraceFileHeader), "再開でリセット");
+    recorder.Stop();
+
+    // 途中で切れたログは切れる前まで読む
+    std::vector<std::byte> truncated(recorder.GetData().begin(), recorder.GetData().end());
+    TestEvent extra{ 7 };
+    EventTraceRecordHeader header{ 1, 0, sizeof(TestEvent) };
+    const std::byte* h = reinterpret_cast<const std::byte*>(&header);
+    truncated.insert(truncated.end(), h, h + sizeof(header));
+    const std::byte* p = reinterpret_cast<const std::byte*>(&extra);
+    truncated.insert(truncated.end(), p, p + sizeof(extra) - 1);
+    EventTraceReader partial(truncated);
+    TEST_ASSERT(partial.IsValid() && !partial.Next(record), "中身が欠けたレコードは読まない");
+}
+
+//----------------------------------------------------------------------------
+// ベンチマーク
+//----------------------------------------------------------------------------
+
+namespace {
+
+//! 旧実装（発行ごとにロックして購読者マップをコピー）
+template<typename TEvent>
+class CopyingEventHandler
+{
+public:
+    using CallbackType = std::function<void(const TEvent&)>;
+
+    void Add(uint32_t id, CallbackType callback) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callbacks_[id] = std::move(callback);
+    }
+
+    void Invoke(const TEvent& event) {
+        std::unordered_map<uint32_t, CallbackType> callbacksCopy;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            callbacksCopy = callbacks_;
+        }
+        for (auto& [id, callback] : callbacksCopy) {
+            callback(event);
+        }
+    }
+
+private:
+    std::unordered_map<uint32_t, CallbackType> callbacks_;
+    std::mutex mutex_;
+};
+
+//! 旧実装（std::type_indexのハッシュ表をバス全体のロック下で検索）
+class TypeIndexEventBus
+{
+public:
+    template<typename TEvent>
+    void Register() {
+        handlers_[std::type_index(typeid(TEvent))] = std::make_unique<EventHandler<TEvent>>();
+    }
+
+    template<typename TEvent>
+    uint32_t Subscribe(std::function<void(const TEvent&)> callback) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint32_t id = nextSubscriptionId_++;
+        static_cast<EventHandler<TEvent>*>(handlers_[std::type_index(typeid(TEvent))].get())->Add(id, std::move(callback));
+        return id;
+    }
+
+    template<typename TEvent>
+    void Publish(const TEvent& event) {
+        EventHandler<TEvent>* handler = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = handlers_.find(std::type_index(typeid(TEvent)));
+            if (it != handlers_.end()) {
+                handler = static_cast<EventHandler<TEvent>*>(it->second.get());
+            }
+        }
+        if (handler) {
+            handler->Publish(event);
+        }
+    }
+
+private:
+    std::unordered_map<std::type_index, std::unique_ptr<IEventHandler>> handlers_;
+    std::mutex mutex_;
+    uint32_t nextSubscriptionId_ = 1;
+};
+
+//! 1発行あたりの時間（ナノ秒）
+template<typename THandler>
+double MeasurePublish(THandler& handler, int iterations)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        handler.Invoke(TestEvent{ i });
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+} // namespace
+
+//! 1発行あたりの時間（ナノ秒、バス経由）
+template<typename TBus>
+double MeasureBusPublish(TBus& bus, int iterations)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        bus.Publish(TestEvent{ i });
+        bus.Publish(OtherEvent{ i });
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (iterations * 2.0);
+}
+
+//! 購読者数ごとの発行コスト
+static void BenchmarkPublish()
+{
+    std::cout << "\n=== Benchmark: 発行コスト ===" << std::endl;
+
+    constexpr int kIterations = 100000;
+
+    for (uint32_t subscribers : { 1u, 10u, 100u }) {
+        int64_t sink = 0;
+        EventHandler<TestEvent> snapshot;
+        CopyingEventHandler<TestEvent> copying;
+        for (uint32_t id = 1; id <= subscribers; ++id) {
+            snapshot.Add(id, [&sink](const TestEvent& e) { sink += e.value; });
+            copying.Add(id, [&sink](const TestEvent& e) { sink += e.value; });
+        }
+
+        const int iterations = kIterations / static_cast<int>(subscribers) + 1000;
+        double copyNs = MeasurePublish(copying, iterations);
+        double snapshotNs = MeasurePublish(snapshot, iterations);
+
+        std::cout << "  " << subscribers << " subscribers: copy " << copyNs << " ns"
+                  << "  snapshot " << snapshotNs << " ns"
+                  << "  (x" << (snapshotNs > 0.0 ? copyNs / snapshotNs : 0.0) << ")"
+                  << "  [" << (sink & 1) << "]" << std::endl;
+    }
+}
+
+//! 型検索を含むバス経由の発行コスト
+static void BenchmarkTypeLookup()
+{
+    std::cout << "\n=== Benchmark: 型検索 ===" << std::endl;
+
+    constexpr int kIterations = 500000;
+
+    TypeIndexEventBus hashed;
+    hashed.Register<TestEvent>();
+    hashed.Register<OtherEvent>();
+    hashed.Register<UnusedEvent>();
+
+    TestEventBus& indexed = TestEventBus::Get();
+    indexed.Clear();
+
+    int64_t sink = 0;
+    for (int subscribers : { 0, 1 }) {
+        if (subscribers > 0) {
+            hashed.Subscribe<TestEvent>([&sink](const TestEvent& e) { sink += e.value; });
+            hashed.Subscribe<OtherEvent>([&sink](const OtherEvent& e) { sink -= e.value; });
+            indexed.Subscribe<TestEvent>([&sink](const TestEvent& e) { sink += e.value; });
+            indexed.Subscribe<OtherEvent>([&sink](const OtherEvent& e) { sink -= e.value; });
+        }
+
+        double hashedNs = MeasureBusPublish(hashed, kIterations);
+        double indexedNs = MeasureBusPublish(indexed, kIterations);
+
+        std::cout << "  " << subscribers << " subscriber(s): type_index " << hashedNs << " ns"
+                  << "  type id " << indexedNs << " ns"
+                  << "  (x" << (indexedNs > 0.0 ? hashedNs / indexedNs : 0.0) << ")"
+                  << "  [" << (sink & 1) << "]" << std::endl;
+    }
+
+    indexed.Clear();
+}
+
+//! 記録有無での発行コスト
+static void BenchmarkRecording()
+{
+    std::cout << "\n=== Benchmark: 記録 ===" << std::endl;
+
+    constexpr int kIterations = 500000;
+
+    TestEventBus& bus = TestEventBus::Get();
+    bus.Clear();
+    int64_t sink = 0;
+    bus.Subscribe<TestEvent>([&sink](const TestEvent& e) { sink += e.value; });
+    bus.Subscribe<OtherEvent>([&sink](const OtherEvent& e) { sink -= e.value; });
+
+    double offNs = MeasureBusPublish(bus, kIterations);
+
+    EventTraceRecorder recorder;
+    recorder.Start(kIterations * 2 * (sizeof(EventTraceRecordHeader) + sizeof(TestEvent)) + 64,
+                   static_cast<uint32_t>(TestEventBus::kEventTypeCount));
+    bus.SetRecorder(&recorder);
+    double onNs = MeasureBusPublish(bus, kIterations);
+    bus.SetRecorder(nullptr);
+    recorder.Stop();
+
+    std::cout << "  off " << offNs << " ns  on " << onNs << " ns"
+              << "  (" << recorder.GetData().size() / 1024 << " KB, dropped "
+              << recorder.GetDroppedCount() << ")  [" << (sink & 1) << "]" << std::endl;
+
+    bus.Clear();
+}
+
+//----------------------------------------------------------------------------
+// 公開インターフェース
+//----------------------------------------------------------------------------
+
+//! EventBus テストスイートを実行
+//! @param runBenchmarks ベンチマークも実行するか
+//! @return 全テスト成功時true、それ以外false
+bool RunEventBusTests(bool runBenchmarks)
+{
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "  EventBus テスト" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    ResetGlobalCounters();
+
+    // Subscribeテスト
+    TestSubscribe_OrderAndRemove();
+    TestSubscribe_Bus();
+
+    // Dispatchテスト
+    TestDispatch_ChangesDuringInvoke();
+
+    // Deferredテスト
+    TestDeferred_Queue();
+    TestDeferred_PublishDuringFlush();
+
+    // TypeIdテスト
+    TestTypeId_Dense();
+
+    // Traceテスト
+    TestTrace_RecordAndReplay();
+    TestTrace_PointerEventOpaque();
+    TestTrace_EncodedEvent();
+    TestTrace_Overflow();
+
+    // ベンチマーク（--bench指定時のみ）
+    if (runBenchmarks) {
+        BenchmarkPublish();
+        BenchmarkTypeLookup();
+        BenchmarkRecording();
+    }
+
+    std::cout << "\n----------------------------------------" << std::endl;
+    std::cout << "EventBusテスト: " << s_passCount << "/" << s_testCount << " 成功" << std::endl;
+    std::cout << "----------------------------------------" << std::endl;
+
+    return s_passCount == s_testCount;
+}
+
+} // namespace tests
@@ -0,0 +1,15 @@
+//----------------------------------------------------------------------------
+//! @file   test_event_bus.h
+//! @brief  Event bus test declarations
+//----------------------------------------------------------------------------
+#pragma once
+
+namespace tests {
+
+//! Run all event bus tests
+//! @param [in] runBenchmarks Also run timing benchmarks
+//! @return true if all tests passed
+//! @note Does not require D3D11 device
+bool RunEventBusTests(bool runBenchmarks = false);
+
+} // namespace tests
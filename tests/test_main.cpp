@@ -10,6 +10,13 @@
 //! - Shaderテスト: シェーダーコンパイル・ロード・管理のテスト
 //! - Textureテスト: テクスチャ生成・ロード・キャッシュのテスト
 //! - Bufferテスト: バッファ生成・GPU Readback検証のテスト
+//! - Collisionテスト: 衝突判定ブロードフェーズのテスト（デバイス不要）
+//! - SpriteBatchテスト: スプライトバッチのCPUステージのテスト（デバイス不要）
+//! - TextureAtlasテスト: テクスチャアトラスの配置計算のテスト（デバイス不要）
+//! - CommandBufferテスト: 描画コマンドの記録・再生・冗長バインド除外のテスト（デバイス不要）
+//! - CircleRendererテスト: 円インスタンスのパックと描画範囲分割のテスト（デバイス不要）
+//! - EventBusテスト: 購読・発行・遅延配送・記録再生のテスト（デバイス不要）
+//! - RelationshipGraphテスト: 関係グラフ（インデックス・アダプター・Facade）のテスト（デバイス不要）
 //!
 //! コマンドライン引数:
 //!   --help           ヘルプ表示
@@ -19,18 +26,34 @@
 //!   --shader-only    Shaderテストのみ実行
 //!   --texture-only   Textureテストのみ実行
 //!   --buffer-only    Bufferテストのみ実行
+//!   --collision-only Collisionテストのみ実行
+//!   --sprite-only    SpriteBatchテストのみ実行
+//!   --atlas-only     TextureAtlasテストのみ実行
+//!   --command-only   CommandBufferテストのみ実行
+//!   --circle-only    CircleRendererテストのみ実行
+//!   --event-only     EventBusテストのみ実行
+//!   --relationship-only RelationshipGraphテストのみ実行
+//!   --bench          ベンチマークも実行
 //!   --assets-dir     テストアセットディレクトリを指定
 //----------------------------------------------------------------------------
 #include "test_file_system.h"
 #include "test_shader.h"
 #include "test_texture.h"
 #include "test_buffer.h"
+#include "test_collision.h"
+#include "test_sprite_batch.h"
+#include "test_texture_atlas.h"
+#include "test_command_buffer.h"
+#include "test_circle_renderer.h"
+#include "test_event_bus.h"
+#include "test_relationship_graph.h"
 
 #include "dx11/gpu_common.h"
 #include "dx11/graphics_device.h"
 #include "dx11/graphics_context.h"
 #include "common/logging/logging.h"
 
+#include <iomanip>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -53,6 +76,14 @@ struct TestConfig
     bool runShaderTests = true;       //!< Shaderテストを実行
     bool runTextureTests = true;      //!< Textureテストを実行
     bool runBufferTests = true;       //!< Bufferテストを実行
+    bool runCollisionTests = true;    //!< Collisionテストを実行
+    bool runSpriteBatchTests = true;  //!< SpriteBatchテストを実行
+    bool runTextureAtlasTests = true; //!< TextureAtlasテストを実行
+    bool runCommandBufferTests = true; //!< CommandBufferテストを実行
+    bool runCircleRendererTests = true; //!< CircleRendererテストを実行
+    bool runEventBusTests = true;     //!< EventBusテストを実行
+    bool runRelationshipGraphTests = true; //!< RelationshipGraphテストを実行
+    bool runBenchmarks = false;       //!< ベンチマークを実行
     bool initDevice = true;           //!< D3D11デバイスを初期化
     bool debugDevice = true;          //!< D3D11デバッグレイヤーを有効化
     std::wstring hostTestDir;         //!< HostFileSystemテスト用ディレクトリ
@@ -60,6 +91,40 @@ struct TestConfig
     std::wstring assetsDir;           //!< テストアセットディレクトリ
 };
 
+//! 単独実行の引数とテストスイートの対応
+struct SuiteOption
+{
+    const char* flag;           //!< 引数（--xxx-only）
+    bool TestConfig::* run;     //!< 実行フラグ
+    const char* description;    //!< ヘルプ表示用のスイート名
+};
+
+//! 単独実行できるテストスイート（スイートを追加したらここにも追加）
+static constexpr SuiteOption kSuiteOptions[] = {
+    { "--fs-only",           &TestConfig::runFileSystemTests,        "FileSystem" },
+    { "--shader-only",       &TestConfig::runShaderTests,            "Shader" },
+    { "--texture-only",      &TestConfig::runTextureTests,           "Texture" },
+    { "--buffer-only",       &TestConfig::runBufferTests,            "Buffer" },
+    { "--collision-only",    &TestConfig::runCollisionTests,         "Collision" },
+    { "--sprite-only",       &TestConfig::runSpriteBatchTests,       "SpriteBatch" },
+    { "--atlas-only",        &TestConfig::runTextureAtlasTests,      "TextureAtlas" },
+    { "--command-only",      &TestConfig::runCommandBufferTests,     "CommandBuffer" },
+    { "--circle-only",       &TestConfig::runCircleRendererTests,    "CircleRenderer" },
+    { "--event-only",        &TestConfig::runEventBusTests,          "EventBus" },
+    { "--relationship-only", &TestConfig::runRelationshipGraphTests, "RelationshipGraph" },
+};
+
+//! 単独実行の引数を検索（該当しなければnullptr）
+static const SuiteOption* FindSuiteOption(const std::string& arg)
+{
+    for (const SuiteOption& option : kSuiteOptions) {
+        if (arg == option.flag) {
+            return &option;
+        }
+    }
+    return nullptr;
+}
+
 //! 使用方法を表示
 static void PrintUsage(const char* programName)
 {
@@ -67,11 +132,11 @@ static void PrintUsage(const char* programName)
               << "\nオプション:\n"
               << "  --help                 このヘルプを表示\n"
               << "  --no-device            D3D11デバイス初期化をスキップ\n"
-              << "  --no-debug             D3D11デバッグレイヤーを無効化\n"
-              << "  --fs-only              FileSystemテストのみ実行\n"
-              << "  --shader-only          Shaderテストのみ実行\n"
-              << "  --texture-only         Textureテストのみ実行\n"
-              << "  --buffer-only          Bufferテストのみ実行\n"
+              << "  --no-debug             D3D11デバッグレイヤーを無効化\n";
+    for (const SuiteOption& option : kSuiteOptions) {
+        std::cout << "  " << std::left << std::setw(23) << option.flag << option.description << "テストのみ実行\n";
+    }
+    std::cout << "  --bench                ベンチマークも実行\n"
               << "  --host-dir=<パス>      HostFileSystemテスト用ディレクトリ\n"
               << "  --texture-dir=<パス>   テストテクスチャを含むディレクトリ\n"
               << "  --assets-dir=<パス>    テストアセットディレクトリ\n"
@@ -96,29 +161,14 @@ static TestConfig ParseCommandLine(int argc, char* argv[])
         else if (arg == "--no-debug") {
             config.debugDevice = false;
         }
-        else if (arg == "--fs-only") {
-            config.runFileSystemTests = true;
-            config.runShaderTests = false;
-            config.runTextureTests = false;
-            config.runBufferTests = false;
-        }
-        else if (arg == "--shader-only") {
-            config.runFileSystemTests = false;
-            config.runShaderTests = true;
-            config.runTextureTests = false;
-            config.runBufferTests = false;
-        }
-        else if (arg == "--texture-only") {
-            config.runFileSystemTests = false;
-            config.runShaderTests = false;
-            config.runTextureTests = true;
-            config.runBufferTests = false;
+        else if (const SuiteOption* only = FindSuiteOption(arg)) {
+            for (const SuiteOption& option : kSuiteOptions) {
+                config.*option.run = false;
+            }
+            config.*only->run = true;
         }
-        else if (arg == "--buffer-only") {
-            config.runFileSystemTests = false;
-            config.runShaderTests = false;
-            config.runTextureTests = false;
-            config.runBufferTests = true;
+        else if (arg == "--bench") {
+            config.runBenchmarks = true;
         }
         else if (arg.rfind("--host-dir=", 0) == 0) {
             std::string path = arg.substr(11);
@@ -253,6 +303,55 @@ int main(int argc, char* argv[])
         if (passed) passedTests++;
     }
 
+    // Collisionテストの実行
+    if (config.runCollisionTests) {
+        bool passed = tests::RunCollisionTests(config.runBenchmarks);
+        totalTests++;
+        if (passed) passedTests++;
+    }
+
+    // SpriteBatchテストの実行
+    if (config.runSpriteBatchTests) {
+        bool passed = tests::RunSpriteBatchTests(config.runBenchmarks);
+        totalTests++;
+        if (passed) passedTests++;
+    }
+
+    // TextureAtlasテストの実行
+    if (config.runTextureAtlasTests) {
+        bool passed = tests::RunTextureAtlasTests(config.runBenchmarks);
+        totalTests++;
+        if (passed) passedTests++;
+    }
+
+    // CommandBufferテストの実行
+    if (config.runCommandBufferTests) {
+        bool passed = tests::RunCommandBufferTests(config.runBenchmarks);
+        totalTests++;
+        if (passed) passedTests++;
+    }
+
+    // CircleRendererテストの実行
+    if (config.runCircleRendererTests) {
+        bool passed = tests::RunCircleRendererTests(config.runBenchmarks);
+        totalTests++;
+        if (passed) passedTests++;
+    }
+
+    // EventBusテストの実行
+    if (config.runEventBusTests) {
+        bool passed = tests::RunEventBusTests(config.runBenchmarks);
+        totalTests++;
+        if (passed) passedTests++;
+    }
+
+    // RelationshipGraphテストの実行
+    if (config.runRelationshipGraphTests) {
+        bool passed = tests::RunRelationshipGraphTests(config.runBenchmarks);
+        totalTests++;
+        if (passed) passedTests++;
+    }
+
     // クリーンアップ
     if (config.initDevice && GraphicsDevice::Get().IsValid()) {
         GraphicsContext::Get().Shutdown();
@@ -0,0 +1,561 @@
+//----------------------------------------------------------------------------
+//! @file   test_relationship_graph.cpp
+//! @brief  RelationshipIndex / RelationshipGraph テストスイート
+//!
+//! @details
+//! 関係グラフの整数インデックス（ノード番号・隣接配列・探索）と、
+//! BondableEntityを扱うRelationshipGraph/RelationshipFacadeをテストします。
+//!
+//! テストカテゴリ:
+//! - Node: キーからノード番号への登録
+//! - Edge: 辺の追加・削除・検索と隣接の順序
+//! - Search: 連結成分と到達判定（タイプ指定あり・なし）
+//! - Graph: アドレスによる識別、nullの拒否、EdgeDataのアドレス、クラスター検出
+//! - Facade: CutAllの相手側の判定
+//! - Benchmark: 10kノードのグラフで文字列キーの旧実装と比較
+//!
+//! @note D3D11デバイスは不要（Group/Playerは生成するだけで初期化しない）
+//----------------------------------------------------------------------------
+#include "test_relationship_graph.h"
+#include "test_common.h"
+#include "game/relationships/relationship_index.h"
+#include "game/relationships/relationship_graph.h"
+#include "game/relationships/relationship_facade.h"
+#include "game/entities/group.h"
+#include "game/entities/player.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace tests {
+
+//----------------------------------------------------------------------------
+// テストユーティリティ（共通ヘッダーから使用）
+//----------------------------------------------------------------------------
+
+// グローバルカウンターを使用（後方互換性のため）
+#define s_testCount tests::GetGlobalTestCount()
+#define s_passCount tests::GetGlobalPassCount()
+
+using NodeIndex = RelationshipIndex::NodeIndex;
+
+//----------------------------------------------------------------------------
+// Nodeテスト
+//----------------------------------------------------------------------------
+
+//! 登録順に0から連続した番号になる
+static void TestNode_Intern()
+{
+    std::cout << "\n=== Node: 登録 ===" << std::endl;
+
+    int keys[3] = {};
+    RelationshipIndex index;
+
+    TEST_ASSERT(index.FindNode(&keys[0]) == RelationshipIndex::kInvalidNode, "未登録はkInvalidNode");
+    TEST_ASSERT(index.InternNode(&keys[1]) == 0, "最初のノードは0");
+    TEST_ASSERT(index.InternNode(&keys[0]) == 1, "次のノードは1");
+    TEST_ASSERT(index.InternNode(&keys[1]) == 0, "登録済みは同じ番号");
+    TEST_ASSERT(index.FindNode(&keys[0]) == 1 && index.GetNodeKey(1) == &keys[0], "番号とキーの対応");
+    TEST_ASSERT(index.GetNodeCount() == 2, "ノード数");
+
+    index.Clear();
+    TEST_ASSERT(index.GetNodeCount() == 0 && index.FindNode(&keys[1]) == RelationshipIndex::kInvalidNode,
+                "クリアで全ノード破棄");
+    TEST_ASSERT(index.InternNode(&keys[2]) == 0, "クリア後は0から");
+}
+
+//----------------------------------------------------------------------------
+// Edgeテスト
+//----------------------------------------------------------------------------
+
+//! 追加・検索・削除
+static void TestEdge_AddRemove()
+{
+    std::cout << "\n=== Edge: 追加・削除 ===" << std::endl;
+
+    int keys[4] = {};
+    RelationshipIndex index;
+    NodeIndex a = index.InternNode(&keys[0]);
+    NodeIndex b = index.InternNode(&keys[1]);
+    NodeIndex c = index.InternNode(&keys[2]);
+    NodeIndex d = index.InternNode(&keys[3]);
+
+    uint32_t ab = index.AddEdge(a, b, BondType::Basic);
+    uint32_t ac = index.AddEdge(a, c, BondType::Love);
+    uint32_t ad = index.AddEdge(a, d, BondType::Friends);
+    TEST_ASSERT(ab != RelationshipIndex::kInvalidEdge && ac != ab && ad != ac, "辺を追加");
+    TEST_ASSERT(index.GetEdgeCount() == 3, "辺の数");
+
+    TEST_ASSERT(index.AddEdge(a, a, BondType::Basic) == RelationshipIndex::kInvalidEdge, "同一ノードは不可");
+    TEST_ASSERT(index.AddEdge(b, a, BondType::Love) == RelationshipIndex::kInvalidEdge, "逆向きの重複も不可");
+    TEST_ASSERT(index.AddEdge(a, 99, BondType::Basic) == RelationshipIndex::kInvalidEdge, "未登録ノードは不可");
+
+    TEST_ASSERT(index.FindEdge(a, c) == ac && index.FindEdge(c, a) == ac, "検索は双方向");
+    TEST_ASSERT(index.FindEdge(b, c) == RelationshipIndex::kInvalidEdge, "無い辺");
+    TEST_ASSERT(index.FindEdge(RelationshipIndex::kInvalidNode, a) == RelationshipIndex::kInvalidEdge,
+                "無効なノードでの検索");
+
+    const RelationshipIndex::Edge& edge = index.GetEdge(ac);
+    TEST_ASSERT(edge.alive && edge.a == a && edge.b == c && edge.type == BondType::Love, "辺スロットの中身");
+
+    auto neighbors = index.GetNeighbors(a);
+    TEST_ASSERT(neighbors.size() == 3 && neighbors[0].node == b && neighbors[1].node == c &&
+                neighbors[2].node == d, "隣接は追加順");
+    TEST_ASSERT(neighbors[1].edge == ac && neighbors[1].type == BondType::Love, "隣接の辺とタイプ");
+
+    // 途中の辺を削除しても残りの順序は保つ
+    TEST_ASSERT(index.RemoveEdge(ac), "辺を削除");
+    TEST_ASSERT(!index.RemoveEdge(ac), "削除済みの辺は削除できない");
+    neighbors = index.GetNeighbors(a);
+    TEST_ASSERT(neighbors.size() == 2 && neighbors[0].node == b && neighbors[1].node == d, "残りの順序");
+    TEST_ASSERT(index.GetNeighbors(c).empty(), "相手側からも消える");
+    TEST_ASSERT(index.GetEdgeCount() == 2 && !index.GetEdge(ac).alive, "削除後の辺の数");
+
+    // 空きスロットを再利用
+    uint32_t bc = index.AddEdge(b, c, BondType::Basic);
+    TEST_ASSERT(bc == ac && index.GetEdgeSlotCount() == 3, "空きスロットを再利用");
+    TEST_ASSERT(index.GetNeighbors(RelationshipIndex::kInvalidNode).empty(), "無効なノードの隣接は空");
+}
+
+//----------------------------------------------------------------------------
+// Searchテスト
+//----------------------------------------------------------------------------
+
+//! 連結成分と到達判定
+static void TestSearch_Components()
+{
+    std::cout << "\n=== Search: 連結成分 ===" << std::endl;
+
+    // 0 -Love- 1 -Love- 2 -Basic- 3    4 -Love- 5    6（孤立）
+    int keys[7] = {};
+    RelationshipIndex index;
+    for (int& key : keys) index.InternNode(&key);
+    index.AddEdge(0, 1, BondType::Love);
+    index.AddEdge(1, 2, BondType::Love);
+    index.AddEdge(2, 3, BondType::Basic);
+    index.AddEdge(4, 5, BondType::Love);
+
+    std::vector<NodeIndex> nodes;
+    index.CollectComponent(0, nullptr, nodes);
+    TEST_ASSERT(nodes == std::vector<NodeIndex>({ 0, 1, 2, 3 }), "全タイプの連結成分（幅優先順）");
+
+    const BondType love = BondType::Love;
+    index.CollectComponent(3, &love, nodes);
+    TEST_ASSERT(nodes == std::vector<NodeIndex>({ 3 }), "Loveで辿れないノードは自分だけ");
+    index.CollectComponent(2, &love, nodes);
+    TEST_ASSERT(nodes == std::vector<NodeIndex>({ 2, 1, 0 }), "Loveのみの連結成分");
+    index.CollectComponent(6, nullptr, nodes);
+    TEST_ASSERT(nodes == std::vector<NodeIndex>({ 6 }), "孤立ノードは自分だけ");
+    index.CollectComponent(RelationshipIndex::kInvalidNode, nullptr, nodes);
+    TEST_ASSERT(nodes.empty(), "無効なノードは空");
+
+    TEST_ASSERT(index.IsReachable(0, 3, nullptr), "推移的に接続");
+    TEST_ASSERT(!index.IsReachable(0, 3, &love), "タイプ指定で途切れる");
+    TEST_ASSERT(index.IsReachable(0, 2, &love), "タイプ指定で接続");
+    TEST_ASSERT(!index.IsReachable(0, 4, nullptr), "別の成分");
+    TEST_ASSERT(index.IsReachable(6, 6, nullptr), "自分自身");
+    TEST_ASSERT(!index.IsReachable(0, RelationshipIndex::kInvalidNode, nullptr), "無効なノード");
+
+    // 別のインスタンスと交互に探索しても結果が混ざらない
+    RelationshipIndex other;
+    for (int& key : keys) other.InternNode(&key);
+    other.AddEdge(3, 6, BondType::Basic);
+    TEST_ASSERT(other.IsReachable(3, 6, nullptr) && !index.IsReachable(3, 6, nullptr) &&
+                other.IsReachable(6, 3, nullptr), "インスタンスごとに独立");
+
+    index.RemoveEdge(index.FindEdge(1, 2));
+    TEST_ASSERT(!index.IsReachable(0, 3, nullptr), "辺の削除で分断");
+    index.CollectComponent(1, nullptr, nodes);
+    TEST_ASSERT(nodes == std::vector<NodeIndex>({ 1, 0 }), "分断後の連結成分");
+}
+
+//----------------------------------------------------------------------------
+// Graphテスト
+//----------------------------------------------------------------------------
+
+//! 同じIDでも別の実体なら別ノード、PlayerとGroupも区別する
+static void TestGraph_AddressIdentity()
+{
+    std::cout << "\n=== Graph: アドレスによる識別 ===" << std::endl;
+
+    Group a("dup");
+    Group b("dup");
+    Player player;
+    RelationshipGraph graph;
+
+    TEST_ASSERT(graph.AddEdge(&a, &b, BondType::Basic) != 0, "同じIDの別グループを結べる");
+    TEST_ASSERT(graph.HasEdge(&a, &b) && graph.HasEdge(&b, &a), "両方向から引ける");
+    TEST_ASSERT(graph.AddEdge(&a, &a, BondType::Basic) == 0, "同じ実体同士は拒否");
+    TEST_ASSERT(graph.AddEdge(&b, &a, BondType::Love) == 0, "既存の組は拒否");
+
+    TEST_ASSERT(graph.AddEdge(&player, &a, BondType::Basic) != 0, "PlayerとGroupを結べる");
+    std::vector<BondableEntity> neighbors = graph.GetNeighbors(&a);
+    TEST_ASSERT(neighbors.size() == 2 &&
+                BondableHelper::IsSame(neighbors[0], BondableEntity(&b)) &&
+                BondableHelper::IsSame(neighbors[1], BondableEntity(&player)), "隣接は追加順の実体");
+    TEST_ASSERT(!graph.HasEdge(&player, &b), "IDが同じでも別の実体には繋がらない");
+    TEST_ASSERT(graph.GetEdgeCount() == 2, "エッジ数");
+}
+
+//! nullのエンティティは登録しない
+static void TestGraph_NullRejected()
+{
+    std::cout << "\n=== Graph: nullの拒否 ===" << std::endl;
+
+    Group a("A");
+    RelationshipGraph graph;
+
+    TEST_ASSERT(graph.AddEdge(static_cast<Group*>(nullptr), &a, BondType::Basic) == 0, "null Groupは拒否");
+    TEST_ASSERT(graph.AddEdge(&a, static_cast<Player*>(nullptr), BondType::Basic) == 0, "null Playerは拒否");
+    TEST_ASSERT(graph.GetEdgeCount() == 0 && graph.GetAllEdges().empty(), "何も追加されない");
+    TEST_ASSERT(graph.GetNeighbors(&a).empty() && graph.GetConnectedComponent(&a).nodes.empty(),
+                "未登録のノードは空");
+    TEST_ASSERT(!graph.HasEdge(static_cast<Group*>(nullptr), &a), "nullとの辺はない");
+}
+
+//! EdgeDataのアドレスは他のエッジの追加・削除で変わらず、削除したスロットは再利用される
+static void TestGraph_EdgeAddressStable()
+{
+    std::cout << "\n=== Graph: EdgeDataのアドレス ===" << std::endl;
+
+    std::vector<std::unique_ptr<Group>> groups;
+    for (int i = 0; i < 64; ++i) {
+        groups.push_back(std::make_unique<Group>("G" + std::to_string(i)));
+    }
+    RelationshipGraph graph;
+
+    uint32_t first = graph.AddEdge(groups[0].get(), groups[1].get(), BondType::Basic);
+    uint32_t second = graph.AddEdge(groups[1].get(), groups[2].get(), BondType::Love);
+    const EdgeData* kept = graph.GetEdge(groups[1].get(), groups[2].get());
+    TEST_ASSERT(kept && kept->id == second && kept->type == BondType::Love, "エッジデータ");
+
+    // 他のエッジを削除・大量に追加しても同じアドレス
+    TEST_ASSERT(graph.RemoveEdge(first), "先のエッジを削除");
+    for (int i = 3; i < 64; ++i) {
+        graph.AddEdge(groups[i - 1].get(), groups[i].get(), BondType::Basic);
+    }
+    TEST_ASSERT(graph.GetEdge(groups[1].get(), groups[2].get()) == kept, "削除・追加の後も同じアドレス");
+    TEST_ASSERT(kept->id == second && BondableHelper::IsSame(kept->entityA, BondableEntity(groups[1].get())),
+                "中身も変わらない");
+
+    // 削除したスロットは次の追加で再利用される（古いIDでは引けない）
+    TEST_ASSERT(graph.RemoveEdge(groups[2].get(), groups[1].get()), "逆順の指定でも削除できる");
+    TEST_ASSERT(!graph.HasEdge(groups[1].get(), groups[2].get()), "削除後は引けない");
+    uint32_t reused = graph.AddEdge(groups[0].get(), groups[5].get(), BondType::Friends);
+    const EdgeData* edge = graph.GetEdge(groups[0].get(), groups[5].get());
+    TEST_ASSERT(edge == kept && reused != second && edge->id == reused, "空きスロットを再利用し新しいIDを振る");
+    TEST_ASSERT(!graph.RemoveEdge(second), "古いIDでは削除できない");
+    TEST_ASSERT(graph.GetEdgeCount() == 62, "エッジ数");
+
+    graph.Clear();
+    TEST_ASSERT(graph.GetEdgeCount() == 0 && !graph.HasEdge(groups[0].get(), groups[5].get()), "クリア");
+}
+
+//! 指定タイプのエッジだけで連結したクラスター（2ノード以上）を返す
+static void TestGraph_FindClustersByType()
+{
+    std::cout << "\n=== Graph: クラスター検出 ===" << std::endl;
+
+    Group a("A"), b("B"), c("C"), d("D"), e("E"), f("F");
+    RelationshipGraph graph;
+
+    // Love: A-B-C, D-E / Basic: C-D, E-F
+    graph.AddEdge(&a, &b, BondType::Love);
+    graph.AddEdge(&b, &c, BondType::Love);
+    graph.AddEdge(&d, &e, BondType::Love);
+    graph.AddEdge(&c, &d, BondType::Basic);
+    graph.AddEdge(&e, &f, BondType::Basic);
+
+    auto contains = [](const Cluster& cluster, Group* group) {
+        return std::any_of(cluster.entities.begin(), cluster.entities.end(),
+                           [&](const BondableEntity& entity) { return BondableHelper::AsGroup(entity) == group; });
+    };
+
+    std::vector<Cluster> love = graph.FindClustersByType(BondType::Love);
+    TEST_ASSERT(love.size() == 2, "Loveのクラスターは2つ");
+    TEST_ASSERT(love[0].entities.size() == 3 && contains(love[0], &a) && contains(love[0], &b) &&
+                contains(love[0], &c), "A-B-C");
+    TEST_ASSERT(love[1].entities.size() == 2 && contains(love[1], &d) && contains(love[1], &e), "D-E");
+    TEST_ASSERT(love[0].nodes.size() == love[0].entities.size(), "ノード番号と実体の数が一致");
+
+    std::vector<Cluster> basic = graph.FindClustersByType(BondType::Basic);
+    TEST_ASSERT(basic.size() == 2 && basic[0].entities.size() == 2 && basic[1].entities.size() == 2,
+                "Basicのクラスターは2つ");
+    TEST_ASSERT(graph.FindClustersByType(BondType::Friends).empty(), "エッジがないタイプは空");
+
+    // 切ると分かれる
+    graph.RemoveEdge(&b, &c);
+    TEST_ASSERT(graph.FindClustersByType(BondType::Love).size() == 2 &&
+                !graph.AreConnectedByType(&a, &c, BondType::Love), "切断後はA-BとD-E");
+    TEST_ASSERT(graph.AreConnected(&a, &b) && !graph.AreConnected(&a, &f), "任意タイプの到達判定");
+}
+
+//----------------------------------------------------------------------------
+// Facadeテスト
+//----------------------------------------------------------------------------
+
+//! CutAllは対象がエッジのどちら側でも相手を正しく通知する
+static void TestFacade_CutAll()
+{
+    std::cout << "\n=== Facade: CutAll ===" << std::endl;
+
+    Group a("same");
+    Group b("same");
+    Group other("other");
+    Player player;
+
+    RelationshipFacade& facade = RelationshipFacade::Get();
+    facade.Initialize();
+
+    std::vector<std::pair<BondableEntity, BondableEntity>> removed;
+    facade.SetOnBondRemoved([&](const BondableEntity& entity, const BondableEntity& partner) {
+        removed.emplace_back(entity, partner);
+    });
+
+    // aはB側（A側のbとはIDが同じ）とA側の両方
+    TEST_ASSERT(facade.Bind(&b, &a), "同じIDのグループを結べる");
+    TEST_ASSERT(facade.Bind(&a, &player), "Playerと結べる");
+    TEST_ASSERT(facade.Bind(&b, &other), "無関係の縁");
+
+    facade.CutAll(&a);
+    TEST_ASSERT(removed.size() == 2, "aの縁だけ2本削除");
+    bool sawB = false;
+    bool sawPlayer = false;
+    for (const auto& [entity, partner] : removed) {
+        TEST_ASSERT(BondableHelper::IsSame(entity, BondableEntity(&a)), "通知の対象はa");
+        sawB |= BondableHelper::AsGroup(partner) == &b;
+        sawPlayer |= BondableHelper::AsPlayer(partner) == &player;
+    }
+    TEST_ASSERT(sawB && sawPlayer, "相手はbとPlayer（IDが同じでもaを相手にしない）");
+    TEST_ASSERT(facade.GetEdgeCount() == 1 && facade.AreDirectlyConnected(&b, &other), "他の縁は残る");
+    TEST_ASSERT(facade.AreHostile(&a, &b), "切断後は敵");
+
+    facade.Shutdown();
+}
+
+//----------------------------------------------------------------------------
+// ベンチマーク
+//----------------------------------------------------------------------------
+
+namespace {
+
+//! 旧実装（文字列IDをキーにした隣接リスト）
+class StringKeyedGraph
+{
+public:
+    void AddEdge(const std::string& a, const std::string& b, BondType type) {
+        uint32_t edgeId = nextEdgeId_++;
+        adjacency_[a].push_back({ b, edgeId, type });
+        adjacency_[b].push_back({ a, edgeId, type });
+    }
+
+    [[nodiscard]] bool HasEdge(const std::string& a, const std::string& b) const {
+        auto it = adjacency_.find(a);
+        if (it == adjacency_.end()) return false;
+        for (const Entry& entry : it->second) {
+            if (entry.neighborId == b) return true;
+        }
+        return false;
+    }
+
+    [[nodiscard]] std::vector<std::string> GetNeighbors(const std::string& node) const {
+        std::vector<std::string> result;
+        auto it = adjacency_.find(node);
+        if (it == adjacency_.end()) return result;
+        for (const Entry& entry : it->second) {
+            result.push_back(entry.neighborId);
+        }
+        return result;
+    }
+
+    [[nodiscard]] std::vector<std::string> BFS(const std::string& startId, const BondType* filterType) const {
+        std::vector<std::string> result;
+        std::queue<std::string> toVisit;
+        std::unordered_set<std::string> visited;
+        toVisit.push(startId);
+        visited.insert(startId);
+        while (!toVisit.empty()) {
+            std::string current = toVisit.front();
+            toVisit.pop();
+            result.push_back(current);
+            auto adjIt = adjacency_.find(current);
+            if (adjIt == adjacency_.end()) continue;
+            for (const Entry& entry : adjIt->second) {
+                if (filterType && entry.type != *filterType) continue;
+                if (visited.insert(entry.neighborId).second) {
+                    toVisit.push(entry.neighborId);
+                }
+            }
+        }
+        return result;
+    }
+
+private:
+    struct Entry {
+        std::string neighborId;
+        uint32_t edgeId;
+        BondType type;
+    };
+
+    std::unordered_map<std::string, std::vector<Entry>> adjacency_;
+    uint32_t nextEdgeId_ = 1;
+};
+
+//! 経過時間（ミリ秒）
+template<typename TFunc>
+double MeasureMs(TFunc&& func)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace
+
+//! 10kノードのグラフで構築・隣接・辺検索・探索を比較
+static void BenchmarkLargeGraph()
+{
+    std::cout << "\n=== Benchmark: 10kノード ===" << std::endl;
+
+    constexpr uint32_t kNodeCount = 10000;
+    constexpr uint32_t kEdgeCount = 20000;
+    constexpr int kQueries = 100000;
+    constexpr int kSearches = 200;
+
+    // 実際のIDに近い文字列（GetIdはエンティティの名前を返す）
+    std::vector<int> entities(kNodeCount);
+    std::vector<std::string> ids(kNodeCount);
+    for (uint32_t i = 0; i < kNodeCount; ++i) {
+        ids[i] = "Group_Elf_" + std::to_string(i);
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<uint32_t> pick(0, kNodeCount - 1);
+    std::uniform_int_distribution<int> typeDist(0, 2);
+    struct EdgeSpec { uint32_t a; uint32_t b; BondType type; };
+    std::vector<EdgeSpec> specs;
+    specs.reserve(kEdgeCount);
+    while (specs.size() < kEdgeCount) {
+        uint32_t a = pick(rng);
+        uint32_t b = pick(rng);
+        if (a != b) specs.push_back({ a, b, static_cast<BondType>(typeDist(rng)) });
+    }
+    std::vector<std::pair<uint32_t, uint32_t>> queries(kQueries);
+    for (auto& q : queries) q = { pick(rng), pick(rng) };
+
+    StringKeyedGraph legacy;
+    RelationshipIndex index;
+    size_t sink = 0;
+
+    double buildLegacy = MeasureMs([&] {
+        for (const EdgeSpec& e : specs) {
+            if (!legacy.HasEdge(ids[e.a], ids[e.b])) legacy.AddEdge(ids[e.a], ids[e.b], e.type);
+        }
+    });
+    double buildIndex = MeasureMs([&] {
+        for (const EdgeSpec& e : specs) {
+            index.AddEdge(index.InternNode(&entities[e.a]), index.InternNode(&entities[e.b]), e.type);
+        }
+    });
+
+    double hasLegacy = MeasureMs([&] {
+        for (const auto& [a, b] : queries) sink += legacy.HasEdge(ids[a], ids[b]);
+    });
+    double hasIndex = MeasureMs([&] {
+        for (const auto& [a, b] : queries) {
+            sink += index.FindEdge(index.FindNode(&entities[a]), index.FindNode(&entities[b])) !=
+                    RelationshipIndex::kInvalidEdge;
+        }
+    });
+
+    double neighborsLegacy = MeasureMs([&] {
+        for (const auto& [a, b] : queries) sink += legacy.GetNeighbors(ids[a]).size();
+    });
+    double neighborsIndex = MeasureMs([&] {
+        for (const auto& [a, b] : queries) sink += index.GetNeighbors(index.FindNode(&entities[a])).size();
+    });
+
+    const BondType love = BondType::Love;
+    std::vector<NodeIndex> component;
+    double bfsLegacy = MeasureMs([&] {
+        for (int i = 0; i < kSearches; ++i) {
+            sink += legacy.BFS(ids[queries[i].first], nullptr).size();
+            sink += legacy.BFS(ids[queries[i].first], &love).size();
+        }
+    });
+    double bfsIndex = MeasureMs([&] {
+        for (int i = 0; i < kSearches; ++i) {
+            NodeIndex start = index.FindNode(&entities[queries[i].first]);
+            index.CollectComponent(start, nullptr, component);
+            sink += component.size();
+            index.CollectComponent(start, &love, component);
+            sink += component.size();
+        }
+    });
+
+    auto report = [](const char* name, double legacyMs, double indexMs) {
+        std::cout << "  " << name << ": string " << legacyMs << " ms  index " << indexMs << " ms"
+                  << "  (x" << (indexMs > 0.0 ? legacyMs / indexMs : 0.0) << ")" << std::endl;
+    };
+    std::cout << "  " << kNodeCount << " nodes, " << index.GetEdgeCount() << " edges  [" << (sink & 1) << "]"
+              << std::endl;
+    report("build", buildLegacy, buildIndex);
+    report("HasEdge x100k", hasLegacy, hasIndex);
+    report("GetNeighbors x100k", neighborsLegacy, neighborsIndex);
+    report("BFS x400", bfsLegacy, bfsIndex);
+}
+
+//----------------------------------------------------------------------------
+// 公開インターフェース
+//----------------------------------------------------------------------------
+
+//! RelationshipIndex / RelationshipGraph テストスイートを実行
+//! @param runBenchmarks ベンチマークも実行するか
+//! @return 全テスト成功時true、それ以外false
+bool RunRelationshipGraphTests(bool runBenchmarks)
+{
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "  RelationshipGraph テスト" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    ResetGlobalCounters();
+
+    // Nodeテスト
+    TestNode_Intern();
+
+    // Edgeテスト
+    TestEdge_AddRemove();
+
+    // Searchテスト
+    TestSearch_Components();
+
+    // Graphテスト
+    TestGraph_AddressIdentity();
+    TestGraph_NullRejected();
+    TestGraph_EdgeAddressStable();
+    TestGraph_FindClustersByType();
+
+    // Facadeテスト
+    TestFacade_CutAll();
+
+    // ベンチマーク（--bench指定時のみ）
+    if (runBenchmarks) {
+        BenchmarkLargeGraph();
+    }
+
+    std::cout << "\n----------------------------------------" << std::endl;
+    std::cout << "RelationshipGraphテスト: " << s_passCount << "/" << s_testCount << " 成功" << std::endl;
+    std::cout << "----------------------------------------" << std::endl;
+
+    return s_passCount == s_testCount;
+}
+
+} // namespace tests
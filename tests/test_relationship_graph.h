@@ -0,0 +1,15 @@
+//----------------------------------------------------------------------------
+//! @file   test_relationship_graph.h
+//! @brief  Relationship graph test declarations
+//----------------------------------------------------------------------------
+#pragma once
+
+namespace tests {
+
+//! Run all relationship graph tests (index, graph adapter, facade)
+//! @param [in] runBenchmarks Also run timing benchmarks
+//! @return true if all tests passed
+//! @note Does not require D3D11 device
+bool RunRelationshipGraphTests(bool runBenchmarks = false);
+
+} // namespace tests
@@ -0,0 +1,972 @@
+//----------------------------------------------------------------------------
+//! @file   test_sprite_batch.cpp
+//! @brief  スプライトバッチ CPUステージ テストスイート
+//!
+//! @details
+//! SpriteBatchのうちGPUを使わない処理のテストを提供します。
+//!
+//! テストカテゴリ:
+//! - Sort: 64bitソートキーと基数ソートが従来のstable_sortと同じ順序になるか
+//! - Instance: インスタンスのバイト配置・四角形展開の一致・バッチ分割
+//! - Ring: バッファ容量の成長とNO_OVERWRITE追記/DISCARD折り返し
+//! - Cull: 表示範囲外判定（見えるスプライトを除外しない）・カメラ範囲
+//! - Deferred: 整列後の並列頂点展開がDraw()時の直列展開とバイト単位で一致するか
+//! - Static: 静的ブロックの頂点・範囲分割・表示範囲による範囲選択
+//! - Benchmark: 10k～100kスプライトのソート・頂点展開時間計測、静的ブロックの毎フレーム処理時間
+//!
+//! @note D3D11デバイスは不要
+//----------------------------------------------------------------------------
+#include "test_sprite_batch.h"
+#include "test_common.h"
+#include "engine/c_systems/sprite_sort.h"
+#include "engine/c_systems/sprite_geometry.h"
+#include "engine/c_systems/sprite_ring.h"
+#include "engine/c_systems/sprite_static.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace tests {
+
+//----------------------------------------------------------------------------
+// テストユーティリティ（共通ヘッダーから使用）
+//----------------------------------------------------------------------------
+
+// グローバルカウンターを使用（後方互換性のため）
+#define s_testCount tests::GetGlobalTestCount()
+#define s_passCount tests::GetGlobalPassCount()
+
+//----------------------------------------------------------------------------
+// ソート用ヘルパー
+//----------------------------------------------------------------------------
+
+//! 従来のSpriteInfo相当（4頂点 + テクスチャ + 描画順、100バイト超）
+struct LegacySpriteInfo
+{
+    void* texture;
+    float vertices[4][9];
+    int sortingLayer;
+    int orderInLayer;
+};
+
+//! ランダムな描画順を持つスプライト列を作成
+//! @param count スプライト数
+//! @param layerRange sortingLayerの範囲（±）
+//! @param orderRange orderInLayerの範囲（±）
+//! @param seed 乱数シード
+static std::vector<LegacySpriteInfo> MakeSprites(size_t count, int layerRange, int orderRange, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> layer(-layerRange, layerRange);
+    std::uniform_int_distribution<int> order(-orderRange, orderRange);
+    std::uniform_int_distribution<int> texture(0, 7);
+
+    std::vector<LegacySpriteInfo> sprites(count);
+    for (auto& s : sprites) {
+        s = {};
+        s.texture = reinterpret_cast<void*>(static_cast<uintptr_t>(texture(rng) + 1) * 64);
+        s.sortingLayer = layer(rng);
+        s.orderInLayer = order(rng);
+    }
+    return sprites;
+}
+
+//! 従来のSortSpritesと同じ比較関数でインデックスを整列
+static std::vector<uint32_t> LegacySort(const std::vector<LegacySpriteInfo>& sprites)
+{
+    std::vector<uint32_t> indices(sprites.size());
+    for (uint32_t i = 0; i < indices.size(); ++i) indices[i] = i;
+    std::stable_sort(indices.begin(), indices.end(),
+        [&sprites](uint32_t a, uint32_t b) {
+            const LegacySpriteInfo& sa = sprites[a];
+            const LegacySpriteInfo& sb = sprites[b];
+            if (sa.sortingLayer != sb.sortingLayer) {
+                return sa.sortingLayer < sb.sortingLayer;
+            }
+            return sa.orderInLayer < sb.orderInLayer;
+        });
+    return indices;
+}
+
+//! キーを作成して基数ソートし、インデックス列を返す
+static std::vector<uint32_t> KeySort(const std::vector<LegacySpriteInfo>& sprites,
+                                     std::vector<uint64_t>& keys, std::vector<uint64_t>& scratch)
+{
+    keys.clear();
+    for (uint32_t i = 0; i < sprites.size(); ++i) {
+        keys.push_back(SpriteSort::MakeKey(sprites[i].sortingLayer, sprites[i].orderInLayer, 0, i));
+    }
+    SpriteSort::RadixSort(keys, scratch);
+
+    std::vector<uint32_t> indices;
+    indices.reserve(keys.size());
+    for (uint64_t k : keys) indices.push_back(SpriteSort::IndexOf(k));
+    return indices;
+}
+
+//----------------------------------------------------------------------------
+// Sortテスト
+//----------------------------------------------------------------------------
+
+//! キーのビット配置が符号付きの大小関係を保つか
+static void TestSort_KeyOrdering()
+{
+    std::cout << "\n=== Sort: キーの大小関係 ===" << std::endl;
+
+    using SpriteSort::MakeKey;
+    TEST_ASSERT(MakeKey(-1, 0, 0, 0) < MakeKey(0, 0, 0, 0), "負のsortingLayerが0より先");
+    TEST_ASSERT(MakeKey(0, 1000, 0, 0) < MakeKey(1, -1000, 0, 0), "sortingLayerがorderInLayerより優先");
+    TEST_ASSERT(MakeKey(5, -3, 0, 9) < MakeKey(5, 2, 0, 1), "orderInLayerが投入順より優先");
+    TEST_ASSERT(MakeKey(5, 2, 1, 0) > MakeKey(5, 2, 0, 9), "テクスチャIDが投入順より優先");
+    TEST_ASSERT(SpriteSort::IsSortOrderInRange(-32768) && SpriteSort::IsSortOrderInRange(32767) &&
+                !SpriteSort::IsSortOrderInRange(-32769) && !SpriteSort::IsSortOrderInRange(32768),
+                "キーで区別できる範囲は16bit");
+    TEST_ASSERT(MakeKey(100000, 0, 0, 0) == MakeKey(32767, 0, 0, 0), "範囲外のsortingLayerはクランプ");
+    TEST_ASSERT(SpriteSort::IndexOf(MakeKey(-7, 3, 5, 123456)) == 123456u, "キーから投入順を復元");
+}
+
+//! 基数ソートが従来のstable_sortと同じ順序になるか
+static void TestSort_MatchesStableSort()
+{
+    std::cout << "\n=== Sort: stable_sortとの一致 ===" << std::endl;
+
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> scratch;
+
+    struct Case { size_t count; int layerRange; int orderRange; const char* name; };
+    const Case cases[] = {
+        { 10,     100, 1000,  "少数（挿入ソート経路）" },
+        { 5000,   3,   0,     "同一orderInLayerが大量（投入順の保持）" },
+        { 20000,  100, 1000,  "想定範囲の描画順" },
+        { 20000,  0,   40000, "16bit範囲外のorderInLayerを含む" },
+    };
+
+    bool allMatch = true;
+    for (const Case& c : cases) {
+        auto sprites = MakeSprites(c.count, c.layerRange, c.orderRange, 1234);
+        // 16bit範囲外の値はクランプ後の値で比較した従来順序と一致すること
+        auto clamped = sprites;
+        for (auto& s : clamped) {
+            s.orderInLayer = std::clamp(s.orderInLayer, -32768, 32767);
+        }
+        const bool match = LegacySort(clamped) == KeySort(sprites, keys, scratch);
+        std::cout << "  " << c.name << ": " << (match ? "一致" : "不一致") << std::endl;
+        allMatch = allMatch && match;
+    }
+    TEST_ASSERT(allMatch, "基数ソートの結果がstable_sortと一致");
+}
+
+//! テクスチャIDを入れた場合、同じ描画順の中だけがテクスチャ別にまとまるか
+static void TestSort_TextureGrouping()
+{
+    std::cout << "\n=== Sort: テクスチャ別グループ化 ===" << std::endl;
+
+    auto sprites = MakeSprites(4000, 2, 2, 99);
+
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> scratch;
+    for (uint32_t i = 0; i < sprites.size(); ++i) {
+        const uint32_t tex = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(sprites[i].texture) / 64);
+        keys.push_back(SpriteSort::MakeKey(sprites[i].sortingLayer, sprites[i].orderInLayer, tex, i));
+    }
+    SpriteSort::RadixSort(keys, scratch);
+
+    bool layerOrderKept = true;
+    bool grouped = true;
+    bool sequenceKept = true;
+    for (size_t i = 1; i < keys.size(); ++i) {
+        const auto& a = sprites[SpriteSort::IndexOf(keys[i - 1])];
+        const auto& b = sprites[SpriteSort::IndexOf(keys[i])];
+        if (std::tie(a.sortingLayer, a.orderInLayer) > std::tie(b.sortingLayer, b.orderInLayer)) {
+            layerOrderKept = false;
+        }
+        if (a.sortingLayer == b.sortingLayer && a.orderInLayer == b.orderInLayer) {
+            if (a.texture > b.texture) grouped = false;
+            if (a.texture == b.texture && SpriteSort::IndexOf(keys[i - 1]) > SpriteSort::IndexOf(keys[i])) {
+                sequenceKept = false;
+            }
+        }
+    }
+    TEST_ASSERT(layerOrderKept, "sortingLayer/orderInLayerの順序を保持");
+    TEST_ASSERT(grouped, "同じ描画順の中でテクスチャ別に連続");
+    TEST_ASSERT(sequenceKept, "同じテクスチャ内は投入順");
+}
+
+//----------------------------------------------------------------------------
+// Instanceテスト
+//----------------------------------------------------------------------------
+
+//! テスト用のテクスチャポインタ（参照はしない）
+static Texture* FakeTexture(uintptr_t id)
+{
+    return reinterpret_cast<Texture*>(id * 64);
+}
+
+//! ランダムなスプライトパラメータ列を作成
+static std::vector<SpriteGeometry::SpriteParams> MakeParams(size_t count, int textureCount, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-3000.0f, 3000.0f);
+    std::uniform_real_distribution<float> size(1.0f, 300.0f);
+    std::uniform_real_distribution<float> rot(-6.3f, 6.3f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_int_distribution<int> texture(1, textureCount);
+
+    std::vector<SpriteGeometry::SpriteParams> params(count);
+    for (auto& p : params) {
+        p.texture = FakeTexture(static_cast<uintptr_t>(texture(rng)));
+        p.posX = pos(rng);
+        p.posY = pos(rng);
+        p.x0 = -size(rng) * unit(rng);
+        p.y0 = -size(rng) * unit(rng);
+        p.x1 = p.x0 + size(rng);
+        p.y1 = p.y0 + size(rng);
+        p.rotation = rot(rng);
+        p.depth = 0.1f + 0.8f * unit(rng);
+        p.u0 = unit(rng);
+        p.v0 = unit(rng);
+        p.u1 = unit(rng);
+        p.v1 = unit(rng);
+        p.color = Color(unit(rng), unit(rng), unit(rng), unit(rng));
+    }
+    return params;
+}
+
+//! sprite_vs.hlsl（SPRITE_INSTANCED）と同じ計算で1頂点を展開
+static SpriteGeometry::SpriteVertex ExpandInstanceVertex(const SpriteGeometry::SpriteInstance& inst, uint32_t vertexId)
+{
+    const float cx = static_cast<float>(vertexId & 1);
+    const float cy = static_cast<float>(vertexId >> 1);
+    const float lx = inst.rect[0] + (inst.rect[2] - inst.rect[0]) * cx;
+    const float ly = inst.rect[1] + (inst.rect[3] - inst.rect[1]) * cy;
+    const float s = std::sin(inst.rotDepth[0]);
+    const float c = std::cos(inst.rotDepth[0]);
+
+    SpriteGeometry::SpriteVertex v;
+    v.position = Vector3(lx * c - ly * s + inst.position[0], lx * s + ly * c + inst.position[1], inst.rotDepth[1]);
+    v.texCoord = Vector2(inst.uvRect[0] + (inst.uvRect[2] - inst.uvRect[0]) * cx,
+                         inst.uvRect[1] + (inst.uvRect[3] - inst.uvRect[1]) * cy);
+    v.color = Color(static_cast<float>(inst.color & 0xFF) / 255.0f,
+                    static_cast<float>((inst.color >> 8) & 0xFF) / 255.0f,
+                    static_cast<float>((inst.color >> 16) & 0xFF) / 255.0f,
+                    static_cast<float>(inst.color >> 24) / 255.0f);
+    return v;
+}
+
+//! インスタンスのバイト配置と色のパック
+static void TestInstance_ByteLayout()
+{
+    std::cout << "\n=== Instance: バイト配置 ===" << std::endl;
+
+    SpriteGeometry::SpriteParams p{};
+    p.posX = 1.0f;  p.posY = 2.0f;
+    p.x0 = -3.0f;   p.y0 = -4.0f;   p.x1 = 5.0f;   p.y1 = 6.0f;
+    p.rotation = 0.5f;
+    p.depth = 0.25f;
+    p.u0 = 0.125f;  p.v0 = 0.375f;  p.u1 = 0.625f; p.v1 = 0.875f;
+    p.color = Color(1.0f, 0.0f, 0.5f, 2.0f);
+
+    const SpriteGeometry::SpriteInstance inst = SpriteGeometry::PackInstance(p);
+    uint8_t bytes[sizeof(SpriteGeometry::SpriteInstance)];
+    std::memcpy(bytes, &inst, sizeof(bytes));
+
+    auto floatAt = [&bytes](size_t offset) {
+        float f;
+        std::memcpy(&f, bytes + offset, sizeof(f));
+        return f;
+    };
+
+    TEST_ASSERT(sizeof(SpriteGeometry::SpriteInstance) == 52, "インスタンスは52バイト");
+    TEST_ASSERT(floatAt(0) == 1.0f && floatAt(4) == 2.0f, "POSITIONはオフセット0");
+    TEST_ASSERT(floatAt(8) == -3.0f && floatAt(12) == -4.0f && floatAt(16) == 5.0f && floatAt(20) == 6.0f,
+                "TEXCOORD1（ローカル矩形）はオフセット8");
+    TEST_ASSERT(floatAt(24) == 0.5f && floatAt(28) == 0.25f, "TEXCOORD2（回転, 深度）はオフセット24");
+    TEST_ASSERT(floatAt(32) == 0.125f && floatAt(44) == 0.875f, "TEXCOORD0（UV矩形）はオフセット32");
+    TEST_ASSERT(bytes[48] == 255 && bytes[49] == 0 && bytes[50] == 128 && bytes[51] == 255,
+                "COLORはR8G8B8A8_UNORM（R先頭、範囲外はクランプ）");
+
+    const size_t vertexBytes = sizeof(SpriteGeometry::SpriteVertex) * 4;
+    std::cout << "  転送量/スプライト: 頂点 " << vertexBytes << " bytes, インスタンス "
+              << sizeof(SpriteGeometry::SpriteInstance) << " bytes" << std::endl;
+    TEST_ASSERT(vertexBytes >= sizeof(SpriteGeometry::SpriteInstance) * 2, "転送量が半分以下");
+}
+
+//! シェーダーと同じ展開式で頂点経路の4頂点と一致するか
+static void TestInstance_ExpansionMatchesVertices()
+{
+    std::cout << "\n=== Instance: 四角形展開の一致 ===" << std::endl;
+
+    auto params = MakeParams(2000, 4, 5);
+
+    float maxPosError = 0.0f;
+    float maxUvError = 0.0f;
+    float maxColorError = 0.0f;
+    bool depthExact = true;
+    for (const auto& p : params) {
+        SpriteGeometry::SpriteVertex expected[4];
+        SpriteGeometry::ExpandQuad(p, expected);
+        const SpriteGeometry::SpriteInstance inst = SpriteGeometry::PackInstance(p);
+
+        for (uint32_t v = 0; v < 4; ++v) {
+            const SpriteGeometry::SpriteVertex actual = ExpandInstanceVertex(inst, v);
+            maxPosError = (std::max)({ maxPosError,
+                std::abs(actual.position.x - expected[v].position.x),
+                std::abs(actual.position.y - expected[v].position.y) });
+            maxUvError = (std::max)({ maxUvError,
+                std::abs(actual.texCoord.x - expected[v].texCoord.x),
+                std::abs(actual.texCoord.y - expected[v].texCoord.y) });
+            maxColorError = (std::max)({ maxColorError,
+                std::abs(actual.color.x - expected[v].color.x),
+                std::abs(actual.color.w - expected[v].color.w) });
+            depthExact = depthExact && actual.position.z == expected[v].position.z;
+        }
+    }
+    std::cout << "  最大誤差: 位置 " << maxPosError << ", UV " << maxUvError
+              << ", 色 " << maxColorError << std::endl;
+    TEST_ASSERT(maxPosError < 1e-2f, "頂点位置が一致（浮動小数誤差以内）");
+    TEST_ASSERT(maxUvError < 1e-6f, "UVと反転が一致");
+    TEST_ASSERT(maxColorError <= 0.5f / 255.0f + 1e-6f, "色は8bit量子化の誤差以内");
+    TEST_ASSERT(depthExact, "深度値が一致");
+}
+
+//! テクスチャ切り替えとチャンク境界でのバッチ分割
+static void TestInstance_Batching()
+{
+    std::cout << "\n=== Instance: バッチ分割 ===" << std::endl;
+
+    // 投入順: A A B B B A （整列キーは投入順のまま）
+    std::vector<SpriteGeometry::SpriteParams> params(6);
+    const uintptr_t textures[] = { 1, 1, 2, 2, 2, 1 };
+    std::vector<uint64_t> keys;
+    for (uint32_t i = 0; i < params.size(); ++i) {
+        params[i].texture = FakeTexture(textures[i]);
+        keys.push_back(SpriteSort::MakeKey(0, 0, 0, i));
+    }
+
+    std::vector<SpriteGeometry::InstanceBatch> batches;
+    SpriteGeometry::BuildInstanceBatches(keys, params, 1024, batches);
+    TEST_ASSERT(batches.size() == 3, "テクスチャが変わる位置で分割");
+    TEST_ASSERT(batches.size() == 3 && batches[1].first == 2 && batches[1].count == 3,
+                "バッチの範囲が整列後の位置を指す");
+
+    SpriteGeometry::BuildInstanceBatches(keys, params, 4, batches);
+    TEST_ASSERT(batches.size() == 4 && batches[2].first == 4 && batches[2].count == 1,
+                "チャンク境界でも分割");
+
+    // 大量・多テクスチャで不変条件を確認
+    auto many = MakeParams(10000, 3, 11);
+    keys.clear();
+    for (uint32_t i = 0; i < many.size(); ++i) {
+        keys.push_back(SpriteSort::MakeKey(0, static_cast<int>(i % 7), 0, i));
+    }
+    std::vector<uint64_t> scratch;
+    SpriteSort::RadixSort(keys, scratch);
+
+    constexpr uint32_t kChunk = 2048;
+    SpriteGeometry::BuildInstanceBatches(keys, many, kChunk, batches);
+    uint32_t next = 0;
+    bool contiguous = true;
+    bool singleTexture = true;
+    bool withinChunk = true;
+    for (const auto& b : batches) {
+        contiguous = contiguous && b.first == next;
+        next = b.first + b.count;
+        withinChunk = withinChunk && (b.first / kChunk) == ((b.first + b.count - 1) / kChunk);
+        for (uint32_t i = b.first; i < b.first + b.count; ++i) {
+            singleTexture = singleTexture && many[SpriteSort::IndexOf(keys[i])].texture == b.texture;
+        }
+    }
+    TEST_ASSERT(contiguous && next == many.size(), "バッチが全インスタンスを隙間なく覆う");
+    TEST_ASSERT(singleTexture, "各バッチは単一テクスチャ");
+    TEST_ASSERT(withinChunk, "バッチがチャンクをまたがない");
+
+    // パック結果が整列順になっているか
+    std::vector<SpriteGeometry::SpriteInstance> packed(keys.size());
+    SpriteGeometry::PackInstances(keys, many, packed.data());
+    bool ordered = true;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        const auto& p = many[SpriteSort::IndexOf(keys[i])];
+        ordered = ordered && packed[i].position[0] == p.posX && packed[i].position[1] == p.posY;
+    }
+    TEST_ASSERT(ordered, "インスタンスは整列済みキーの順に並ぶ");
+}
+
+//----------------------------------------------------------------------------
+// Ringテスト
+//----------------------------------------------------------------------------
+
+//! 容量は必要時のみ2のべき乗で拡張され、上限で止まる
+static void TestRing_GrowCapacity()
+{
+    std::cout << "\n=== Ring: 容量の成長 ===" << std::endl;
+
+    using SpriteRing::GrowCapacity;
+    using SpriteRing::kInitialCapacity;
+    using SpriteRing::kMaxCapacity;
+
+    TEST_ASSERT(GrowCapacity(kInitialCapacity, 100) == kInitialCapacity, "収まる場合は拡張しない");
+    TEST_ASSERT(GrowCapacity(kInitialCapacity, kInitialCapacity) == kInitialCapacity, "ちょうどの場合も拡張しない");
+    TEST_ASSERT(GrowCapacity(kInitialCapacity, kInitialCapacity + 1) == kInitialCapacity * 2, "超えたら倍に拡張");
+    TEST_ASSERT(GrowCapacity(kInitialCapacity, 100000) == 131072, "必要数以上の2のべき乗");
+    TEST_ASSERT(GrowCapacity(kInitialCapacity, kMaxCapacity * 4) == kMaxCapacity, "上限でクランプ");
+    TEST_ASSERT(GrowCapacity(kMaxCapacity, kMaxCapacity * 4) == kMaxCapacity, "上限到達後は拡張しない");
+}
+
+//! 追記はNO_OVERWRITE、末尾を越えたら先頭からDISCARD
+static void TestRing_CursorAppendAndWrap()
+{
+    std::cout << "\n=== Ring: 追記と折り返し ===" << std::endl;
+
+    SpriteRing::Cursor ring;
+    ring.Reset(100);
+
+    auto a = ring.Allocate(30);
+    auto b = ring.Allocate(50);
+    auto c = ring.Allocate(20);
+    auto d = ring.Allocate(1);
+    TEST_ASSERT(a.first == 0 && a.discard, "最初の確保は先頭からDISCARD");
+    TEST_ASSERT(b.first == 30 && !b.discard, "続きはNO_OVERWRITEで追記");
+    TEST_ASSERT(c.first == 80 && !c.discard, "末尾ちょうどまで追記");
+    TEST_ASSERT(d.first == 0 && d.discard, "越える場合は先頭に戻ってDISCARD");
+
+    ring.Reset(200);
+    auto e = ring.Allocate(10);
+    TEST_ASSERT(e.first == 0 && e.discard, "作り直し後は先頭からDISCARD");
+
+    // 1フレームに複数回Begin/Endする想定で、領域が重ならないこと
+    ring.Reset(SpriteRing::kInitialCapacity);
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<uint32_t> size(1, 700);
+    uint32_t lastEnd = 0;
+    bool disjoint = true;
+    int discards = 0;
+    for (int i = 0; i < 1000; ++i) {
+        const uint32_t n = size(rng);
+        auto alloc = ring.Allocate(n);
+        if (alloc.discard) {
+            ++discards;
+        } else {
+            disjoint = disjoint && alloc.first == lastEnd;
+        }
+        disjoint = disjoint && alloc.first + n <= ring.GetCapacity();
+        lastEnd = alloc.first + n;
+    }
+    std::cout << "  1000回の確保でDISCARD " << discards << " 回" << std::endl;
+    TEST_ASSERT(disjoint, "DISCARDまでの確保領域は連続し容量内に収まる");
+}
+
+//----------------------------------------------------------------------------
+// Cullテスト
+//----------------------------------------------------------------------------
+
+//! 回転なし・負スケール・境界の判定
+static void TestCull_AxisAligned()
+{
+    std::cout << "\n=== Cull: 回転なし ===" << std::endl;
+
+    const SpriteGeometry::ViewRect view{ 0.0f, 0.0f, 1280.0f, 720.0f };
+    SpriteGeometry::SpriteParams p{};
+    p.x0 = -16.0f; p.y0 = -16.0f; p.x1 = 16.0f; p.y1 = 16.0f;
+
+    p.posX = 640.0f; p.posY = 360.0f;
+    TEST_ASSERT(SpriteGeometry::IsVisible(p, view), "画面中央は表示");
+
+    p.posX = -17.0f;
+    TEST_ASSERT(!SpriteGeometry::IsVisible(p, view), "左端より外は除外");
+
+    p.posX = -15.0f;
+    TEST_ASSERT(SpriteGeometry::IsVisible(p, view), "左端に掛かれば表示");
+
+    p.posX = 1300.0f; p.posY = 360.0f;
+    p.x0 = 0.0f; p.x1 = -32.0f;  // 負のスケール（x1 < x0）
+    TEST_ASSERT(SpriteGeometry::IsVisible(p, view), "負のスケールでも範囲を正しく扱う");
+
+    p.posY = 5000.0f;
+    TEST_ASSERT(!SpriteGeometry::IsVisible(p, view), "下方向の範囲外は除外");
+}
+
+//! ランダムなスプライトで、除外したものが実際に範囲外か
+static void TestCull_NoFalseRejects()
+{
+    std::cout << "\n=== Cull: 見えるスプライトを除外しない ===" << std::endl;
+
+    // 5120x2880ステージ上の1280x720表示範囲
+    auto params = MakeParams(20000, 4, 21);
+    std::mt19937 rng(8);
+    std::uniform_real_distribution<float> stageX(0.0f, 5120.0f);
+    std::uniform_real_distribution<float> stageY(0.0f, 2880.0f);
+    for (size_t i = 0; i < params.size(); ++i) {
+        params[i].posX = stageX(rng);
+        params[i].posY = stageY(rng);
+        if (i % 4 == 0) params[i].rotation = 0.0f;
+    }
+    const SpriteGeometry::ViewRect view = SpriteGeometry::MakeViewRect(2560.0f, 1440.0f, 640.0f, 360.0f, 0.0f);
+
+    bool noFalseReject = true;
+    size_t culled = 0;
+    for (const auto& p : params) {
+        if (SpriteGeometry::IsVisible(p, view)) continue;
+        ++culled;
+
+        SpriteGeometry::SpriteVertex v[4];
+        SpriteGeometry::ExpandQuad(p, v);
+        float minX = v[0].position.x, maxX = v[0].position.x;
+        float minY = v[0].position.y, maxY = v[0].position.y;
+        for (const auto& q : v) {
+            minX = (std::min)(minX, q.position.x);
+            maxX = (std::max)(maxX, q.position.x);
+            minY = (std::min)(minY, q.position.y);
+            maxY = (std::max)(maxY, q.position.y);
+        }
+        if (maxX >= view.minX && minX <= view.maxX && maxY >= view.minY && minY <= view.maxY) {
+            noFalseReject = false;
+        }
+    }
+    std::cout << "  除外 " << culled << " / " << params.size() << std::endl;
+    TEST_ASSERT(noFalseReject, "除外したスプライトの4頂点は全て表示範囲外");
+    TEST_ASSERT(culled > params.size() * 3 / 4, "ステージの大半は除外される");
+}
+
+//! カメラの回転を含めた表示範囲
+static void TestCull_ViewRect()
+{
+    std::cout << "\n=== Cull: カメラ表示範囲 ===" << std::endl;
+
+    const auto r0 = SpriteGeometry::MakeViewRect(100.0f, 50.0f, 640.0f, 360.0f, 0.0f);
+    TEST_ASSERT(r0.minX == -540.0f && r0.maxX == 740.0f && r0.minY == -310.0f && r0.maxY == 410.0f,
+                "回転なしは中心±半サイズ");
+
+    const auto r90 = SpriteGeometry::MakeViewRect(0.0f, 0.0f, 640.0f, 360.0f, 1.5707963f);
+    TEST_ASSERT(std::abs(r90.maxX - 360.0f) < 0.01f && std::abs(r90.maxY - 640.0f) < 0.01f,
+                "90度回転で縦横が入れ替わる");
+
+    const auto r45 = SpriteGeometry::MakeViewRect(0.0f, 0.0f, 100.0f, 100.0f, 0.78539816f);
+    TEST_ASSERT(std::abs(r45.maxX - 141.421f) < 0.01f, "45度回転は外接AABB");
+}
+
+//----------------------------------------------------------------------------
+// Deferredテスト
+//----------------------------------------------------------------------------
+
+//! パラメータ列にランダムな描画順のキーを付けて整列
+static std::vector<uint64_t> MakeSortedKeys(size_t count, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> layer(-3, 3);
+    std::uniform_int_distribution<int> order(-100, 100);
+
+    std::vector<uint64_t> keys(count);
+    for (size_t i = 0; i < count; ++i) {
+        keys[i] = SpriteSort::MakeKey(layer(rng), order(rng), 0, static_cast<uint32_t>(i));
+    }
+    std::vector<uint64_t> scratch;
+    SpriteSort::RadixSort(keys, scratch);
+    return keys;
+}
+
+//! 従来経路: Draw()ごとに展開し、End()で整列順にコピー
+static std::vector<SpriteGeometry::SpriteVertex> SerialExpand(
+    const std::vector<uint64_t>& keys, const std::vector<SpriteGeometry::SpriteParams>& params)
+{
+    struct Expanded { SpriteGeometry::SpriteVertex vertices[4]; };
+    std::vector<Expanded> queue(params.size());
+    for (size_t i = 0; i < params.size(); ++i) {
+        SpriteGeometry::ExpandQuad(params[i], queue[i].vertices);
+    }
+
+    std::vector<SpriteGeometry::SpriteVertex> out(keys.size() * 4);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        memcpy(&out[i * 4], queue[SpriteSort::IndexOf(keys[i])].vertices, sizeof(Expanded));
+    }
+    return out;
+}
+
+//! 並列展開の結果がスプライト数によらず従来経路と一致するか
+static void TestDeferred_MatchesSerial()
+{
+    std::cout << "\n=== Deferred: 直列展開との一致 ===" << std::endl;
+
+    const size_t counts[] = {
+        1,
+        SpriteGeometry::kParallelExpandThreshold - 1,
+        SpriteGeometry::kParallelExpandThreshold,
+        100000,
+    };
+    for (size_t count : counts) {
+        auto params = MakeParams(count, 8, static_cast<uint32_t>(count));
+        auto keys = MakeSortedKeys(count, 3);
+        const auto expected = SerialExpand(keys, params);
+
+        // 未書き込み領域を検出できるよう埋めておく
+        std::vector<SpriteGeometry::SpriteVertex> actual(count * 4);
+        memset(static_cast<void*>(actual.data()), 0xCD, actual.size() * sizeof(SpriteGeometry::SpriteVertex));
+        SpriteGeometry::ExpandQuadsParallel(keys, params, actual.data());
+
+        const bool identical = memcmp(expected.data(), actual.data(),
+                                      expected.size() * sizeof(SpriteGeometry::SpriteVertex)) == 0;
+        std::cout << "  " << count << " sprites" << std::endl;
+        TEST_ASSERT(identical, "並列展開が直列展開とバイト単位で一致");
+    }
+}
+
+//! チャンクの部分範囲を展開しても全体展開と一致するか（End()の容量分割）
+static void TestDeferred_ChunkedSubspans()
+{
+    std::cout << "\n=== Deferred: チャンク分割展開 ===" << std::endl;
+
+    constexpr size_t kCount = 20000;
+    constexpr size_t kChunk = 6000;
+    auto params = MakeParams(kCount, 8, 12);
+    auto keys = MakeSortedKeys(kCount, 4);
+    const auto expected = SerialExpand(keys, params);
+
+    std::vector<SpriteGeometry::SpriteVertex> actual(kCount * 4);
+    for (size_t start = 0; start < kCount; start += kChunk) {
+        const size_t n = (std::min)(kChunk, kCount - start);
+        SpriteGeometry::ExpandQuadsParallel(
+            std::span<const uint64_t>(keys).subspan(start, n), params, actual.data() + start * 4);
+    }
+    TEST_ASSERT(memcmp(expected.data(), actual.data(), expected.size() * sizeof(SpriteGeometry::SpriteVertex)) == 0,
+                "チャンク単位の展開結果を連結すると全体と一致");
+}
+
+//----------------------------------------------------------------------------
+// Staticテスト
+//----------------------------------------------------------------------------
+
+//! 5120x2880ステージの背景相当（3レイヤー、レイヤー内はX順に投入）
+static void MakeStageSprites(size_t count, uint32_t seed,
+                             std::vector<SpriteGeometry::SpriteParams>& params,
+                             std::vector<uint64_t>& keys)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> stageY(0.0f, 2880.0f);
+    std::uniform_real_distribution<float> size(16.0f, 200.0f);
+    std::uniform_real_distribution<float> rot(-0.1f, 0.1f);
+    std::uniform_int_distribution<int> texture(1, 6);
+    constexpr int kLayers[] = { -90, -100, -80 };
+
+    params.resize(count);
+    keys.resize(count);
+    const size_t perLayer = (count + 2) / 3;
+    for (size_t i = 0; i < count; ++i) {
+        auto& p = params[i];
+        const size_t layerIndex = i / perLayer;
+        const size_t inLayer = i % perLayer;
+        const uint32_t textureId = static_cast<uint32_t>(texture(rng));
+        p.texture = FakeTexture(textureId);
+        p.posX = 5120.0f * static_cast<float>(inLayer) / static_cast<float>(perLayer);
+        p.posY = stageY(rng);
+        const float w = size(rng);
+        const float h = size(rng);
+        p.x0 = -w * 0.5f; p.y0 = -h * 0.5f; p.x1 = w * 0.5f; p.y1 = h * 0.5f;
+        p.rotation = rot(rng);
+        p.depth = 0.5f;
+        p.u0 = 0.0f; p.v0 = 0.0f; p.u1 = 1.0f; p.v1 = 1.0f;
+        p.color = Color(1.0f, 1.0f, 1.0f, 1.0f);
+        keys[i] = SpriteSort::MakeKey(kLayers[layerIndex], 0, textureId, static_cast<uint32_t>(i));
+    }
+}
+
+//! 頂点は動的経路（整列→展開）と一致し、全範囲の描画は従来のバッチと一致するか
+static void TestStatic_MatchesDynamic()
+{
+    std::cout << "\n=== Static: 動的経路との一致 ===" << std::endl;
+
+    auto params = MakeParams(5000, 8, 31);
+    std::vector<uint64_t> keys(params.size());
+    std::mt19937 rng(6);
+    std::uniform_int_distribution<int> layer(-3, 3);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        const uint32_t textureId = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(params[i].texture) / 64);
+        keys[i] = SpriteSort::MakeKey(layer(rng), 0, textureId, static_cast<uint32_t>(i));
+    }
+
+    SpriteStatic::Block block;
+    SpriteStatic::Build(keys, params, 0, block);
+
+    std::vector<uint64_t> sorted = keys;
+    std::vector<uint64_t> scratch;
+    SpriteSort::RadixSort(sorted, scratch);
+    const auto expected = SerialExpand(sorted, params);
+
+    TEST_ASSERT(block.GetSpriteCount() == params.size(), "全スプライトを保持");
+    TEST_ASSERT(memcmp(expected.data(), block.vertices.data(),
+                       expected.size() * sizeof(SpriteGeometry::SpriteVertex)) == 0,
+                "頂点が整列後の直列展開とバイト単位で一致");
+
+    std::vector<SpriteGeometry::InstanceBatch> batches;
+    std::vector<SpriteGeometry::InstanceBatch> draws;
+    SpriteGeometry::BuildInstanceBatches(sorted, params, 0, batches);
+    SpriteStatic::SelectAll(block, draws);
+
+    bool same = batches.size() == draws.size();
+    for (size_t i = 0; same && i < batches.size(); ++i) {
+        same = batches[i].texture == draws[i].texture &&
+               batches[i].first == draws[i].first &&
+               batches[i].count == draws[i].count;
+    }
+    std::cout << "  描画コール " << draws.size() << " / 範囲 " << block.ranges.size() << std::endl;
+    TEST_ASSERT(same, "全範囲の描画コールが従来のテクスチャ単位バッチと一致");
+}
+
+//! 範囲は連続・単一テクスチャ・上限以下で、境界が全頂点を含むか
+static void TestStatic_Ranges()
+{
+    std::cout << "\n=== Static: 範囲分割 ===" << std::endl;
+
+    std::vector<SpriteGeometry::SpriteParams> params;
+    std::vector<uint64_t> keys;
+    MakeStageSprites(3000, 17, params, keys);
+
+    constexpr uint32_t kMax = 8;
+    SpriteStatic::Block block;
+    SpriteStatic::Build(keys, params, kMax, block);
+
+    std::vector<uint64_t> sorted = keys;
+    std::vector<uint64_t> scratch;
+    SpriteSort::RadixSort(sorted, scratch);
+
+    bool contiguous = true;
+    bool withinMax = true;
+    bool singleTexture = true;
+    bool contained = true;
+    uint32_t next = 0;
+    for (const auto& range : block.ranges) {
+        if (range.first != next || range.count == 0) contiguous = false;
+        if (range.count > kMax) withinMax = false;
+        for (uint32_t i = range.first; i < range.first + range.count; ++i) {
+            if (params[SpriteSort::IndexOf(sorted[i])].texture != range.texture) singleTexture = false;
+            for (uint32_t v = 0; v < 4; ++v) {
+                const auto& p = block.vertices[i * 4 + v].position;
+                if (p.x < range.bounds.minX || p.x > range.bounds.maxX ||
+                    p.y < range.bounds.minY || p.y > range.bounds.maxY) {
+                    contained = false;
+                }
+            }
+        }
+        next = range.first + range.count;
+    }
+    TEST_ASSERT(contiguous && next == block.GetSpriteCount(), "範囲は整列順に隙間なく並ぶ");
+    TEST_ASSERT(withinMax, "範囲のスプライト数は上限以下");
+    TEST_ASSERT(singleTexture, "範囲内のテクスチャは1種類");
+    TEST_ASSERT(contained, "範囲の境界が全頂点を含む");
+
+    SpriteStatic::Block empty;
+    SpriteStatic::Build({}, {}, 0, empty);
+    TEST_ASSERT(empty.ranges.empty() && empty.GetSpriteCount() == 0, "空の入力は空のブロック");
+}
+
+//! 表示範囲に掛かるスプライトを含む範囲は必ず選ばれるか
+static void TestStatic_SelectVisible()
+{
+    std::cout << "\n=== Static: 表示範囲による選択 ===" << std::endl;
+
+    std::vector<SpriteGeometry::SpriteParams> params;
+    std::vector<uint64_t> keys;
+    MakeStageSprites(6000, 23, params, keys);
+
+    SpriteStatic::Block block;
+    SpriteStatic::Build(keys, params, 0, block);
+
+    std::vector<uint8_t> selected(block.GetSpriteCount(), 0);
+    std::vector<SpriteGeometry::InstanceBatch> draws;
+    const auto view = SpriteGeometry::MakeViewRect(1800.0f, 1200.0f, 640.0f, 360.0f, 0.0f);
+    SpriteStatic::SelectVisible(block, view, draws);
+
+    uint32_t selectedCount = 0;
+    for (const auto& draw : draws) {
+        for (uint32_t i = draw.first; i < draw.first + draw.count; ++i) selected[i] = 1;
+        selectedCount += draw.count;
+    }
+
+    bool noFalseReject = true;
+    for (uint32_t i = 0; i < block.GetSpriteCount(); ++i) {
+        if (selected[i]) continue;
+        for (uint32_t v = 0; v < 4; ++v) {
+            const auto& p = block.vertices[i * 4 + v].position;
+            if (p.x >= view.minX && p.x <= view.maxX && p.y >= view.minY && p.y <= view.maxY) {
+                noFalseReject = false;
+            }
+        }
+    }
+    std::cout << "  選択 " << selectedCount << " / " << block.GetSpriteCount()
+              << " (描画コール " << draws.size() << ")" << std::endl;
+    TEST_ASSERT(noFalseReject, "表示範囲内に頂点を持つスプライトは選択される");
+    TEST_ASSERT(selectedCount < block.GetSpriteCount() / 2, "画面外の範囲は選択しない");
+
+    const SpriteGeometry::ViewRect far{ 100000.0f, 100000.0f, 101280.0f, 100720.0f };
+    SpriteStatic::SelectVisible(block, far, draws);
+    TEST_ASSERT(draws.empty(), "ステージ外の表示範囲では何も選択しない");
+}
+
+//----------------------------------------------------------------------------
+// ベンチマーク
+//----------------------------------------------------------------------------
+
+//! 従来のstable_sortと基数ソートの時間を比較
+static void BenchmarkSort()
+{
+    std::cout << "\n=== ソート ベンチマーク (sortingLayer ±3, orderInLayer ±1000) ===" << std::endl;
+
+    constexpr int kRepeat = 20;
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> scratch;
+
+    for (size_t count : { size_t{10000}, size_t{50000}, size_t{100000} }) {
+        auto sprites = MakeSprites(count, 3, 1000, 7);
+
+        auto begin = std::chrono::steady_clock::now();
+        size_t sink = 0;
+        for (int i = 0; i < kRepeat; ++i) sink += LegacySort(sprites)[count / 2];
+        auto mid = std::chrono::steady_clock::now();
+        for (int i = 0; i < kRepeat; ++i) sink += KeySort(sprites, keys, scratch)[count / 2];
+        auto end = std::chrono::steady_clock::now();
+
+        std::cout << "  " << count << " sprites:"
+                  << "  stable_sort " << std::chrono::duration<double, std::milli>(mid - begin).count() / kRepeat << " ms"
+                  << "  radix " << std::chrono::duration<double, std::milli>(end - mid).count() / kRepeat << " ms"
+                  << " (" << (sink & 1) << ")" << std::endl;
+    }
+}
+
+//! Draw()時の直列展開とEnd()での並列展開の時間を比較
+static void BenchmarkExpand()
+{
+    std::cout << "\n=== 頂点展開 ベンチマーク ===" << std::endl;
+
+    constexpr int kRepeat = 20;
+    for (size_t count : { size_t{10000}, size_t{50000}, size_t{100000} }) {
+        auto params = MakeParams(count, 8, 9);
+        auto keys = MakeSortedKeys(count, 5);
+        std::vector<SpriteGeometry::SpriteVertex> dst(count * 4);
+
+        auto begin = std::chrono::steady_clock::now();
+        float sink = 0.0f;
+        for (int i = 0; i < kRepeat; ++i) sink += SerialExpand(keys, params)[count].position.x;
+        auto mid = std::chrono::steady_clock::now();
+        for (int i = 0; i < kRepeat; ++i) {
+            SpriteGeometry::ExpandQuadsParallel(keys, params, dst.data());
+            sink += dst[count].position.x;
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        std::cout << "  " << count << " sprites:"
+                  << "  serial " << std::chrono::duration<double, std::milli>(mid - begin).count() / kRepeat << " ms"
+                  << "  deferred " << std::chrono::duration<double, std::milli>(end - mid).count() / kRepeat << " ms"
+                  << " (" << (sink > 0.0f) << ")" << std::endl;
+    }
+}
+
+//! 背景を毎フレーム投入する場合と静的ブロックの範囲選択の時間を比較
+static void BenchmarkStatic()
+{
+    std::cout << "\n=== 静的ブロック ベンチマーク (5120x2880ステージ, 1280x720表示) ===" << std::endl;
+
+    constexpr int kRepeat = 200;
+    const auto view = SpriteGeometry::MakeViewRect(2560.0f, 1440.0f, 640.0f, 360.0f, 0.0f);
+
+    for (size_t count : { size_t{500}, size_t{5000}, size_t{50000} }) {
+        std::vector<SpriteGeometry::SpriteParams> params;
+        std::vector<uint64_t> allKeys;
+        MakeStageSprites(count, 29, params, allKeys);
+
+        SpriteStatic::Block block;
+        SpriteStatic::Build(allKeys, params, 0, block);
+
+        // 毎フレーム: カリング→キー作成→整列→頂点展開
+        std::vector<uint64_t> keys;
+        std::vector<uint64_t> scratch;
+        std::vector<SpriteGeometry::SpriteVertex> dst(count * 4);
+        std::vector<SpriteGeometry::InstanceBatch> draws;
+
+        auto begin = std::chrono::steady_clock::now();
+        float sink = 0.0f;
+        for (int r = 0; r < kRepeat; ++r) {
+            keys.clear();
+            for (size_t i = 0; i < count; ++i) {
+                if (SpriteGeometry::IsVisible(params[i], view)) keys.push_back(allKeys[i]);
+            }
+            SpriteSort::RadixSort(keys, scratch);
+            SpriteGeometry::ExpandQuads(keys, params, dst.data());
+            sink += dst[0].position.x;
+        }
+        auto mid = std::chrono::steady_clock::now();
+        size_t drawn = 0;
+        for (int r = 0; r < kRepeat; ++r) {
+            SpriteStatic::SelectVisible(block, view, draws);
+            drawn += draws.size();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        std::cout << "  " << count << " sprites:"
+                  << "  per-frame " << std::chrono::duration<double, std::micro>(mid - begin).count() / kRepeat << " us"
+                  << "  static " << std::chrono::duration<double, std::micro>(end - mid).count() / kRepeat << " us"
+                  << " (" << (sink != 0.0f) << (drawn & 1) << ")" << std::endl;
+    }
+}
+
+//----------------------------------------------------------------------------
+// 公開インターフェース
+//----------------------------------------------------------------------------
+
+//! スプライトバッチ CPUステージ テストスイートを実行
+//! @param runBenchmarks ベンチマークも実行するか
+//! @return 全テスト成功時true、それ以外false
+bool RunSpriteBatchTests(bool runBenchmarks)
+{
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "  スプライトバッチ テスト" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    ResetGlobalCounters();
+
+    // Sortテスト
+    TestSort_KeyOrdering();
+    TestSort_MatchesStableSort();
+    TestSort_TextureGrouping();
+
+    // Instanceテスト
+    TestInstance_ByteLayout();
+    TestInstance_ExpansionMatchesVertices();
+    TestInstance_Batching();
+
+    // Ringテスト
+    TestRing_GrowCapacity();
+    TestRing_CursorAppendAndWrap();
+
+    // Cullテスト
+    TestCull_AxisAligned();
+    TestCull_NoFalseRejects();
+    TestCull_ViewRect();
+
+    // Deferredテスト
+    TestDeferred_MatchesSerial();
+    TestDeferred_ChunkedSubspans();
+
+    // Staticテスト
+    TestStatic_MatchesDynamic();
+    TestStatic_Ranges();
+    TestStatic_SelectVisible();
+
+    // ベンチマーク（--bench指定時のみ）
+    if (runBenchmarks) {
+        BenchmarkSort();
+        BenchmarkExpand();
+        BenchmarkStatic();
+    }
+
+    std::cout << "\n----------------------------------------" << std::endl;
+    std::cout << "スプライトバッチテスト: " << s_passCount << "/" << s_testCount << " 成功" << std::endl;
+    std::cout << "----------------------------------------" << std::endl;
+
+    return s_passCount == s_testCount;
+}
+
+} // namespace tests
@@ -0,0 +1,15 @@
+//----------------------------------------------------------------------------
+//! @file   test_sprite_batch.h
+//! @brief  SpriteBatch CPU stage test declarations
+//----------------------------------------------------------------------------
+#pragma once
+
+namespace tests {
+
+//! Run all sprite batch CPU stage tests
+//! @param [in] runBenchmarks Also run timing benchmarks
+//! @return true if all tests passed
+//! @note Does not require D3D11 device
+bool RunSpriteBatchTests(bool runBenchmarks = false);
+
+} // namespace tests
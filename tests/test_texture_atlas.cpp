@@ -0,0 +1,344 @@
+//----------------------------------------------------------------------------
+//! @file   test_texture_atlas.cpp
+//! @brief  テクスチャアトラス パッカー テストスイート
+//!
+//! @details
+//! TextureManagerのアトラス配置計算（GPUを使わない部分）のテストを提供します。
+//!
+//! テストカテゴリ:
+//! - Packer: 配置位置・範囲外・重なりとパディング
+//! - Efficiency: ランダムな矩形と実際の装飾サイズでの充填率
+//! - Determinism: 同じ入力から同じ配置になるか
+//! - Region: UV変換とAnimatorのフレーム矩形
+//! - Benchmark: 配置時間計測
+//!
+//! @note D3D11デバイスは不要
+//----------------------------------------------------------------------------
+#include "test_texture_atlas.h"
+#include "test_common.h"
+#include "engine/texture/texture_atlas.h"
+#include "engine/component/animator.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace tests {
+
+//----------------------------------------------------------------------------
+// テストユーティリティ（共通ヘッダーから使用）
+//----------------------------------------------------------------------------
+
+// グローバルカウンターを使用（後方互換性のため）
+#define s_testCount tests::GetGlobalTestCount()
+#define s_passCount tests::GetGlobalPassCount()
+
+//----------------------------------------------------------------------------
+// ヘルパー
+//----------------------------------------------------------------------------
+
+//! ランダムな大きさの矩形列を作成
+static std::vector<AtlasRect> MakeSizes(size_t count, uint32_t minSize, uint32_t maxSize, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32_t> dist(minSize, maxSize);
+    std::vector<AtlasRect> sizes(count);
+    for (auto& s : sizes) {
+        s.width = dist(rng);
+        s.height = dist(rng);
+    }
+    return sizes;
+}
+
+//! ステージ1の装飾テクスチャの大きさ（assets/texture/stage1）
+static std::vector<AtlasRect> DecorationSizes()
+{
+    const uint32_t table[][2] = {
+        { 342, 324 }, { 160, 97 }, { 99, 87 }, { 172, 309 },      // 遺跡・木
+        { 326, 264 }, { 71, 144 }, { 240, 247 }, { 200, 197 },    // 草・石
+        { 121, 69 }, { 198, 170 }, { 113, 140 }, { 209, 286 },
+        { 114, 83 }, { 505, 240 },
+        { 129, 90 }, { 178, 232 }, { 92, 95 }, { 326, 258 },      // 葉・木片・焚火
+        { 68, 77 }, { 83, 78 }, { 88, 124 }, { 208, 201 },
+        { 103, 230 }, { 70, 81 }, { 108, 93 }, { 130, 164 },
+        { 117, 108 }, { 119, 136 }, { 114, 89 }, { 147, 159 },
+    };
+    std::vector<AtlasRect> sizes;
+    for (const auto& wh : table) {
+        sizes.push_back({ 0, 0, wh[0], wh[1] });
+    }
+    return sizes;
+}
+
+//! 全配置がページ内に収まり、パディングを空けて重ならないか
+static bool ValidatePlacements(const std::vector<AtlasRect>& sizes,
+                               const std::vector<AtlasPlacement>& placements,
+                               uint32_t pageWidth, uint32_t pageHeight, uint32_t padding)
+{
+    for (size_t i = 0; i < placements.size(); ++i) {
+        const AtlasRect& a = placements[i].rect;
+        if (a.width != sizes[i].width || a.height != sizes[i].height) return false;
+        if (a.x < padding || a.y < padding) return false;
+        if (a.x + a.width + padding > pageWidth || a.y + a.height + padding > pageHeight) return false;
+
+        for (size_t j = i + 1; j < placements.size(); ++j) {
+            if (placements[i].page != placements[j].page) continue;
+            const AtlasRect& b = placements[j].rect;
+            // 互いにpadding以上離れていること
+            const bool apart = a.x + a.width + padding <= b.x || b.x + b.width + padding <= a.x ||
+                               a.y + a.height + padding <= b.y || b.y + b.height + padding <= a.y;
+            if (!apart) return false;
+        }
+    }
+    return true;
+}
+
+//! ページごとの充填率（パディングを含まない面積）
+static std::vector<double> PageOccupancy(const std::vector<AtlasPlacement>& placements,
+                                         uint32_t pageCount, uint32_t pageWidth, uint32_t pageHeight)
+{
+    std::vector<double> used(pageCount, 0.0);
+    for (const auto& p : placements) {
+        used[p.page] += static_cast<double>(p.rect.width) * p.rect.height;
+    }
+    for (double& u : used) {
+        u /= static_cast<double>(pageWidth) * pageHeight;
+    }
+    return used;
+}
+
+//----------------------------------------------------------------------------
+// Packerテスト
+//----------------------------------------------------------------------------
+
+//! 基本的な配置と失敗時の状態維持
+static void TestPacker_Basic()
+{
+    std::cout << "\n=== Packer: 基本配置 ===" << std::endl;
+
+    SkylinePacker packer(256, 128);
+    AtlasRect r;
+
+    TEST_ASSERT(packer.Pack(100, 50, r) && r.x == 0 && r.y == 0, "最初の矩形は左上");
+    TEST_ASSERT(packer.Pack(100, 50, r) && r.x == 100 && r.y == 0, "同じ高さは右隣");
+    TEST_ASSERT(packer.Pack(100, 50, r) && r.x == 0 && r.y == 50, "幅が足りなければ下の段");
+
+    const uint64_t used = packer.GetUsedArea();
+    TEST_ASSERT(!packer.Pack(300, 10, r), "ページより広い矩形は入らない");
+    TEST_ASSERT(!packer.Pack(10, 200, r), "ページより高い矩形は入らない");
+    TEST_ASSERT(!packer.Pack(0, 10, r), "大きさ0は入らない");
+    TEST_ASSERT(packer.GetUsedArea() == used, "失敗時は状態が変わらない");
+
+    TEST_ASSERT(packer.Pack(56, 78, r) && r.x == 200 && r.y == 0, "上端が最も低くなる右端の空きを使う");
+    TEST_ASSERT(std::abs(packer.GetOccupancy() - static_cast<float>(used + 56 * 78) / (256.0f * 128.0f)) < 1e-6f,
+                "充填率は配置面積 / ページ面積");
+}
+
+//! 多数の矩形で範囲内・重なりなし・パディング確保
+static void TestPacker_NoOverlap()
+{
+    std::cout << "\n=== Packer: 重なりとパディング ===" << std::endl;
+
+    constexpr uint32_t kPage = 512;
+    constexpr uint32_t kPadding = 2;
+    auto sizes = MakeSizes(300, 4, 96, 1);
+
+    std::vector<AtlasPlacement> placements;
+    const uint32_t pages = PackAtlasRects(sizes, kPage, kPage, kPadding, placements);
+    std::cout << "  300矩形 → " << pages << " ページ" << std::endl;
+
+    TEST_ASSERT(pages > 0, "全矩形を配置できる");
+    TEST_ASSERT(ValidatePlacements(sizes, placements, kPage, kPage, kPadding),
+                "ページ内に収まり、パディング以上離れている");
+
+    std::vector<AtlasRect> tooLarge = { { 0, 0, 600, 10 } };
+    TEST_ASSERT(PackAtlasRects(tooLarge, kPage, kPage, kPadding, placements) == 0,
+                "ページに入らない矩形があれば0を返す");
+}
+
+//----------------------------------------------------------------------------
+// Efficiencyテスト
+//----------------------------------------------------------------------------
+
+//! ランダムな小さい矩形での充填率
+static void TestEfficiency_RandomRects()
+{
+    std::cout << "\n=== Efficiency: ランダムな矩形 ===" << std::endl;
+
+    constexpr uint32_t kPage = 1024;
+    auto sizes = MakeSizes(1000, 16, 128, 2);
+
+    std::vector<AtlasPlacement> placements;
+    const uint32_t pages = PackAtlasRects(sizes, kPage, kPage, 0, placements);
+    const auto occupancy = PageOccupancy(placements, pages, kPage, kPage);
+
+    double fullPages = 0.0;
+    for (uint32_t i = 0; i + 1 < pages; ++i) fullPages += occupancy[i];
+    fullPages /= (std::max)(1u, pages - 1);
+    std::cout << "  " << pages << " ページ, 最終ページ以外の平均充填率 " << fullPages * 100.0 << "%" << std::endl;
+
+    TEST_ASSERT(pages >= 2, "複数ページに分かれる");
+    TEST_ASSERT(fullPages > 0.85, "埋まったページの充填率が85%超");
+}
+
+//! 実際の装飾テクスチャが1ページにまとまるか
+static void TestEfficiency_Decorations()
+{
+    std::cout << "\n=== Efficiency: 装飾テクスチャ ===" << std::endl;
+
+    auto sizes = DecorationSizes();
+    std::vector<AtlasPlacement> placements;
+    const uint32_t pages = PackAtlasRects(sizes, 2048, 2048, 2, placements);
+    const auto occupancy = PageOccupancy(placements, pages, 2048, 2048);
+    std::cout << "  " << sizes.size() << " テクスチャ → " << pages << " ページ ("
+              << occupancy[0] * 100.0 << "%)" << std::endl;
+
+    TEST_ASSERT(pages == 1, "ステージ1の装飾30種類が2048x2048の1ページに入る");
+    TEST_ASSERT(ValidatePlacements(sizes, placements, 2048, 2048, 2), "配置が有効");
+}
+
+//----------------------------------------------------------------------------
+// Determinismテスト
+//----------------------------------------------------------------------------
+
+//! 同じ入力なら同じ配置
+static void TestDeterminism_SameInput()
+{
+    std::cout << "\n=== Determinism: 同じ入力 ===" << std::endl;
+
+    auto sizes = MakeSizes(500, 8, 200, 3);
+    // 同じ大きさを混ぜる（並べ替えの安定性を確認）
+    for (size_t i = 0; i < sizes.size(); i += 7) {
+        sizes[i] = { 0, 0, 64, 64 };
+    }
+
+    std::vector<AtlasPlacement> first;
+    std::vector<AtlasPlacement> second;
+    const uint32_t pagesA = PackAtlasRects(sizes, 1024, 1024, 1, first);
+    const uint32_t pagesB = PackAtlasRects(sizes, 1024, 1024, 1, second);
+
+    bool identical = pagesA == pagesB && first.size() == second.size();
+    for (size_t i = 0; identical && i < first.size(); ++i) {
+        identical = first[i].page == second[i].page &&
+                    first[i].rect.x == second[i].rect.x && first[i].rect.y == second[i].rect.y;
+    }
+    TEST_ASSERT(identical, "2回の配置結果が一致");
+
+    // 同じ大きさの矩形は入力順に配置される
+    std::vector<AtlasRect> same(5, AtlasRect{ 0, 0, 32, 32 });
+    std::vector<AtlasPlacement> placements;
+    (void)PackAtlasRects(same, 256, 256, 0, placements);
+    bool ordered = true;
+    for (size_t i = 1; i < placements.size(); ++i) {
+        ordered = ordered && placements[i - 1].rect.x < placements[i].rect.x;
+    }
+    TEST_ASSERT(ordered, "同じ大きさは入力順に左から並ぶ");
+}
+
+//----------------------------------------------------------------------------
+// Regionテスト
+//----------------------------------------------------------------------------
+
+//! ページ上の矩形からUVとソース矩形を作る
+static void TestRegion_UV()
+{
+    std::cout << "\n=== Region: UV変換 ===" << std::endl;
+
+    const TextureRegion region = TextureRegion::FromRect(nullptr, { 512, 256, 128, 64 }, 2048, 1024);
+    TEST_ASSERT(region.u0 == 0.25f && region.v0 == 0.25f && region.u1 == 0.3125f && region.v1 == 0.3125f,
+                "UVはページサイズで正規化");
+
+    const Vector2 center = region.MapUV(0.5f, 0.5f);
+    TEST_ASSERT(center.x == 0.28125f && center.y == 0.28125f, "領域内の正規化座標をページUVへ変換");
+
+    const Vector4 src = region.SourceRect();
+    TEST_ASSERT(src.x == 512.0f && src.y == 256.0f && src.z == 128.0f && src.w == 64.0f,
+                "ソース矩形はピクセル単位");
+}
+
+//! Animatorのフレーム矩形が領域内に収まるか
+static void TestRegion_AnimatorSourceRect()
+{
+    std::cout << "\n=== Region: Animatorのフレーム矩形 ===" << std::endl;
+
+    Animator animator(4, 4, 1);  // 4x4のスプライトシート
+    animator.SetRow(2);
+    animator.SetColumn(3);
+
+    const TextureRegion region = TextureRegion::FromRect(nullptr, { 100, 200, 400, 320 }, 2048, 2048);
+    const Vector4 inSheet = animator.GetSourceRect(400.0f, 320.0f);
+    const Vector4 inPage = animator.GetSourceRect(region);
+
+    TEST_ASSERT(inPage.x == inSheet.x + 100.0f && inPage.y == inSheet.y + 200.0f,
+                "フレーム位置は領域の左上だけずれる");
+    TEST_ASSERT(inPage.z == 100.0f && inPage.w == 80.0f, "フレームサイズは領域を分割した大きさ");
+    TEST_ASSERT(inPage.x + inPage.z <= 500.0f && inPage.y + inPage.w <= 520.0f, "フレームは領域内");
+}
+
+//----------------------------------------------------------------------------
+// ベンチマーク
+//----------------------------------------------------------------------------
+
+//! 矩形数ごとの配置時間
+static void BenchmarkPack()
+{
+    std::cout << "\n=== アトラス配置 ベンチマーク ===" << std::endl;
+
+    for (size_t count : { size_t{100}, size_t{1000}, size_t{5000} }) {
+        auto sizes = MakeSizes(count, 8, 128, 4);
+        std::vector<AtlasPlacement> placements;
+
+        auto begin = std::chrono::steady_clock::now();
+        const uint32_t pages = PackAtlasRects(sizes, 2048, 2048, 2, placements);
+        auto end = std::chrono::steady_clock::now();
+
+        std::cout << "  " << count << " rects: "
+                  << std::chrono::duration<double, std::milli>(end - begin).count() << " ms, "
+                  << pages << " pages" << std::endl;
+    }
+}
+
+//----------------------------------------------------------------------------
+// 公開インターフェース
+//----------------------------------------------------------------------------
+
+//! テクスチャアトラス テストスイートを実行
+//! @param runBenchmarks ベンチマークも実行するか
+//! @return 全テスト成功時true、それ以外false
+bool RunTextureAtlasTests(bool runBenchmarks)
+{
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "  テクスチャアトラス テスト" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    ResetGlobalCounters();
+
+    // Packerテスト
+    TestPacker_Basic();
+    TestPacker_NoOverlap();
+
+    // Efficiencyテスト
+    TestEfficiency_RandomRects();
+    TestEfficiency_Decorations();
+
+    // Determinismテスト
+    TestDeterminism_SameInput();
+
+    // Regionテスト
+    TestRegion_UV();
+    TestRegion_AnimatorSourceRect();
+
+    // ベンチマーク（--bench指定時のみ）
+    if (runBenchmarks) {
+        BenchmarkPack();
+    }
+
+    std::cout << "\n----------------------------------------" << std::endl;
+    std::cout << "テクスチャアトラステスト: " << s_passCount << "/" << s_testCount << " 成功" << std::endl;
+    std::cout << "----------------------------------------" << std::endl;
+
+    return s_passCount == s_testCount;
+}
+
+} // namespace tests
@@ -0,0 +1,15 @@
+//----------------------------------------------------------------------------
+//! @file   test_texture_atlas.h
+//! @brief  Texture atlas packer test declarations
+//----------------------------------------------------------------------------
+#pragma once
+
+namespace tests {
+
+//! Run all texture atlas packer tests
+//! @param [in] runBenchmarks Also run timing benchmarks
+//! @return true if all tests passed
+//! @note Does not require D3D11 device
+bool RunTextureAtlasTests(bool runBenchmarks = false);
+
+} // namespace tests